@@ -6,6 +6,8 @@
 #include "sysinfo.h"
 #include "mutex.h"
 
+#include <map>
+
 ////////////////////////////////////////////////////////////////////////////////
 /// All Platforms
 ////////////////////////////////////////////////////////////////////////////////
@@ -33,17 +35,79 @@ namespace embree
   }
 
   static bool huge_pages_enabled = false;
+  static bool huge_pages_2M_pool = false; //!< explicit 2MB huge pages are reserved
+  static bool huge_pages_1G_pool = false; //!< explicit 1GB huge pages are reserved and enabled
   static MutexSys os_init_mutex;
 
-  __forceinline bool isHugePageCandidate(const size_t bytes) 
+  __forceinline bool isHugePageCandidate(const size_t bytes, const size_t pageSize = PAGE_SIZE_2M) 
   {
     if (!huge_pages_enabled)
       return false;
 
     /* use huge pages only when memory overhead is low */
-    const size_t hbytes = (bytes+PAGE_SIZE_2M-1) & ~size_t(PAGE_SIZE_2M-1);
+    const size_t hbytes = (bytes+pageSize-1) & ~(pageSize-1);
     return 66*(hbytes-bytes) < bytes; // at most 1.5% overhead
   }
+
+  /* page types of OS allocations */
+  enum OSPageType { OS_PAGES_4K, OS_PAGES_THP, OS_PAGES_2M, OS_PAGES_1G };
+
+  struct OSAllocation
+  {
+    OSAllocation (size_t bytes = 0, OSPageType type = OS_PAGES_4K)
+      : bytes(bytes), type(type) {}
+
+    size_t bytes;
+    OSPageType type;
+  };
+
+  /* all active OS allocations, used to free them with the proper page size and for statistics */
+  static MutexSys os_allocations_mutex;
+  static std::map<void*,OSAllocation> os_allocations;
+  static std::atomic<size_t> os_failed_huge_page_allocs(0);
+
+  static void os_track(void* ptr, size_t bytes, OSPageType type)
+  {
+    Lock<MutexSys> lock(os_allocations_mutex);
+    os_allocations[ptr] = OSAllocation(bytes,type);
+  }
+
+  static OSAllocation os_lookup(void* ptr)
+  {
+    Lock<MutexSys> lock(os_allocations_mutex);
+    auto i = os_allocations.find(ptr);
+    if (i == os_allocations.end()) return OSAllocation();
+    return i->second;
+  }
+
+  static void os_untrack(void* ptr)
+  {
+    Lock<MutexSys> lock(os_allocations_mutex);
+    os_allocations.erase(ptr);
+  }
+
+  static size_t os_anon_huge_page_bytes();
+
+  OSAllocStatistics os_statistics()
+  {
+    OSAllocStatistics stat;
+    memset(&stat,0,sizeof(stat));
+    {
+      Lock<MutexSys> lock(os_allocations_mutex);
+      for (const auto& a : os_allocations)
+      {
+        switch (a.second.type) {
+        case OS_PAGES_4K : stat.bytes4K  += a.second.bytes; break;
+        case OS_PAGES_THP: stat.bytesTHP += a.second.bytes; break;
+        case OS_PAGES_2M : stat.bytes2M  += a.second.bytes; break;
+        case OS_PAGES_1G : stat.bytes1G  += a.second.bytes; break;
+        }
+      }
+    }
+    stat.bytesAnonHuge = os_anon_huge_page_bytes();
+    stat.failedHugePageAllocs = os_failed_huge_page_allocs;
+    return stat;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -89,7 +153,7 @@ namespace embree
     return true;
   }
 
-  bool os_init(bool hugepages, bool verbose) 
+  bool os_init(bool hugepages, bool verbose, bool hugepages_1G) 
   {
     Lock<MutexSys> lock(os_init_mutex);
 
@@ -121,8 +185,10 @@ namespace embree
       char* ptr = (char*) VirtualAlloc(nullptr,bytes,flags,PAGE_READWRITE);
       if (ptr != nullptr) {
         hugepages = true;
+        os_track(ptr,bytes,OS_PAGES_2M);
         return ptr;
       }
+      os_failed_huge_page_allocs++;
     } 
 
     /* fall back to 4k pages */
@@ -130,6 +196,7 @@ namespace embree
     char* ptr = (char*) VirtualAlloc(nullptr,bytes,flags,PAGE_READWRITE);
     if (ptr == nullptr) throw std::bad_alloc();
     hugepages = false;
+    os_track(ptr,bytes,OS_PAGES_4K);
     return ptr;
   }
 
@@ -147,6 +214,7 @@ namespace embree
     if (!VirtualFree((char*)ptr+bytesNew,bytesOld-bytesNew,MEM_DECOMMIT))
       throw std::bad_alloc();
 
+    os_track(ptr,bytesNew,OS_PAGES_4K);
     return bytesNew;
   }
 
@@ -155,6 +223,7 @@ namespace embree
     if (bytes == 0) 
       return;
 
+    os_untrack(ptr);
     if (!VirtualFree(ptr,0,MEM_RELEASE))
       throw std::bad_alloc();
   }
@@ -162,6 +231,40 @@ namespace embree
   void os_advise(void *ptr, size_t bytes)
   {
   }
+
+  static size_t os_anon_huge_page_bytes() {
+    return 0;
+  }
+
+  void* os_map_file(const char* fileName, size_t offset, size_t bytes)
+  {
+    if (bytes == 0)
+      return nullptr;
+
+    HANDLE file = CreateFileA(fileName,GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      THROW_RUNTIME_ERROR("cannot open file "+std::string(fileName));
+
+    HANDLE mapping = CreateFileMappingA(file,nullptr,PAGE_WRITECOPY,0,0,nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+      THROW_RUNTIME_ERROR("cannot map file "+std::string(fileName));
+
+    void* ptr = MapViewOfFile(mapping,FILE_MAP_COPY,DWORD(uint64_t(offset) >> 32),DWORD(offset),bytes);
+    CloseHandle(mapping); // the view keeps the mapping alive
+    if (ptr == nullptr)
+      THROW_RUNTIME_ERROR("cannot map file "+std::string(fileName));
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes)
+  {
+    if (bytes == 0)
+      return;
+
+    if (!UnmapViewOfFile(ptr))
+      throw std::bad_alloc();
+  }
 }
 
 #endif
@@ -173,6 +276,8 @@ namespace embree
 #if defined(__UNIX__)
 
 #include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
@@ -182,12 +287,46 @@ namespace embree
 #include <mach/vm_statistics.h>
 #endif
 
+#if defined(__LINUX__) && !defined(MAP_HUGE_SHIFT)
+#define MAP_HUGE_SHIFT 26
+#endif
+
 namespace embree
 {
-  bool os_init(bool hugepages, bool verbose) 
+#if defined(__LINUX__)
+
+  /* reads the first number of a file, returns 0 if the file cannot get read */
+  static size_t readNumber(const char* fileName)
+  {
+    std::ifstream file(fileName,std::ios::in);
+    size_t value = 0;
+    if (!(file >> value)) return 0;
+    return value;
+  }
+
+  /* reads a value in kB of /proc/meminfo style files */
+  static size_t readMemInfo(const char* fileName, const std::string& tag)
+  {
+    std::ifstream file(fileName,std::ios::in);
+    std::string line;
+    while (getline(file,line))
+    {
+      std::stringstream sline(line);
+      std::string t; size_t kB = 0;
+      if (sline >> t >> kB && t == tag)
+        return kB*1024;
+    }
+    return 0;
+  }
+#endif
+
+  bool os_init(bool hugepages, bool verbose, bool hugepages_1G) 
   {
     Lock<MutexSys> lock(os_init_mutex);
 
+    huge_pages_2M_pool = false;
+    huge_pages_1G_pool = false;
+
     if (!hugepages) {
       huge_pages_enabled = false;
       return true;
@@ -195,35 +334,25 @@ namespace embree
 
 #if defined(__LINUX__)
 
-    int hugepagesize = 0;
+    /* explicit huge pages are only tried if the administrator reserved some */
+    huge_pages_2M_pool = readNumber("/sys/kernel/mm/hugepages/hugepages-2048kB/nr_hugepages") > 0;
+    huge_pages_1G_pool = hugepages_1G && readNumber("/sys/kernel/mm/hugepages/hugepages-1048576kB/nr_hugepages") > 0;
 
-    std::ifstream file; 
-    file.open("/proc/meminfo",std::ios::in);
-    if (!file.is_open()) {
-      if (verbose) std::cout << "WARNING: Could not open /proc/meminfo. Huge page support cannot get enabled!" << std::endl;
-      huge_pages_enabled = false;
-      return false;
-    }
-    
-    std::string line;
-    while (getline(file,line))
-    {
-      std::stringstream sline(line);
-      while (!sline.eof() && sline.peek() == ' ') sline.ignore();
-      std::string tag; getline(sline,tag,' ');
-      while (!sline.eof() && sline.peek() == ' ') sline.ignore();
-      std::string val; getline(sline,val,' ');
-      while (!sline.eof() && sline.peek() == ' ') sline.ignore();
-      std::string unit; getline(sline,unit,' ');
-      if (tag == "Hugepagesize:" && unit == "kB") {
-	hugepagesize = std::stoi(val)*1024;
-	break;
-      }
+    /* transparent huge pages work if enabled in always or madvise mode */
+    bool thp = true;
+    std::ifstream file("/sys/kernel/mm/transparent_hugepage/enabled",std::ios::in);
+    std::string mode;
+    if (getline(file,mode)) thp = mode.find("[never]") == std::string::npos;
+
+    if (verbose) {
+      std::cout << "huge pages: THP " << (thp ? "enabled" : "disabled")
+                << ", 2MB pool " << (huge_pages_2M_pool ? "available" : "empty")
+                << ", 1GB pool " << (huge_pages_1G_pool ? "available" : (hugepages_1G ? "empty" : "disabled")) << std::endl;
     }
-    
-    if (hugepagesize != PAGE_SIZE_2M) 
+
+    if (!thp && !huge_pages_2M_pool && !huge_pages_1G_pool)
     {
-      if (verbose) std::cout << "WARNING: Only 2MB huge pages supported. Huge page support cannot get enabled!" << std::endl;
+      if (verbose) std::cout << "WARNING: Neither transparent huge pages nor a huge page pool are available. Huge page support cannot get enabled!" << std::endl;
       huge_pages_enabled = false;
       return false;
     }
@@ -240,37 +369,74 @@ namespace embree
       return nullptr;
     }
 
+#if defined(__MACOSX__)
     /* try direct huge page allocation first */
     if (isHugePageCandidate(bytes)) 
     {
-#if defined(__MACOSX__)
       void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, VM_FLAGS_SUPERPAGE_SIZE_2MB, 0);
       if (ptr != MAP_FAILED) {
         hugepages = true;
+        os_track(ptr,bytes,OS_PAGES_2M);
         return ptr;
       }
+      os_failed_huge_page_allocs++;
+    }
 #elif defined(MAP_HUGETLB)
-      void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON | MAP_HUGETLB, -1, 0);
+    /* try the explicit 1GB and 2MB huge page pools first */
+    if (huge_pages_1G_pool && isHugePageCandidate(bytes,PAGE_SIZE_1G))
+    {
+      void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON | MAP_HUGETLB | (30 << MAP_HUGE_SHIFT), -1, 0);
+      if (ptr != MAP_FAILED) {
+        hugepages = true;
+        os_track(ptr,bytes,OS_PAGES_1G);
+        return ptr;
+      }
+      os_failed_huge_page_allocs++;
+    }
+    if (huge_pages_2M_pool && isHugePageCandidate(bytes))
+    {
+      void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON | MAP_HUGETLB | (21 << MAP_HUGE_SHIFT), -1, 0);
       if (ptr != MAP_FAILED) {
         hugepages = true;
+        os_track(ptr,bytes,OS_PAGES_2M);
         return ptr;
       }
+      os_failed_huge_page_allocs++;
+    }
 #endif
-    } 
 
-    /* fallback to 4k pages */
-    void* ptr = (char*) mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    /* fallback to 4k pages, large allocations get 2MB aligned such that transparent huge pages can back them completely */
+    const bool thp = huge_pages_enabled && bytes >= PAGE_SIZE_2M;
+    const size_t mapBytes = thp ? bytes+PAGE_SIZE_2M : bytes;
+    char* ptr = (char*) mmap(0, mapBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
     if (ptr == MAP_FAILED) throw std::bad_alloc();
     hugepages = false;
 
+    if (thp)
+    {
+      char* aptr = (char*) ((size_t(ptr)+PAGE_SIZE_2M-1) & ~size_t(PAGE_SIZE_2M-1));
+      char* end  = ptr + ((mapBytes+PAGE_SIZE_4K-1) & ~size_t(PAGE_SIZE_4K-1));
+      char* aend = aptr + ((bytes+PAGE_SIZE_4K-1) & ~size_t(PAGE_SIZE_4K-1));
+      if (aptr > ptr) munmap(ptr,aptr-ptr);
+      if (end > aend) munmap(aend,end-aend);
+      ptr = aptr;
+    }
+    os_track(ptr,bytes,thp ? OS_PAGES_THP : OS_PAGES_4K);
+
     /* advise huge page hint for THP */
     os_advise(ptr,bytes);
     return ptr;
   }
 
+  __forceinline size_t os_page_size(void* ptr, bool hugepages)
+  {
+    if (!hugepages) return PAGE_SIZE_4K;
+    return os_lookup(ptr).type == OS_PAGES_1G ? size_t(PAGE_SIZE_1G) : size_t(PAGE_SIZE_2M);
+  }
+
   size_t os_shrink(void* ptr, size_t bytesNew, size_t bytesOld, bool hugepages) 
   {
-    const size_t pageSize = hugepages ? PAGE_SIZE_2M : PAGE_SIZE_4K;
+    const size_t pageSize = os_page_size(ptr,hugepages);
     bytesNew = (bytesNew+pageSize-1) & ~(pageSize-1);
     bytesOld = (bytesOld+pageSize-1) & ~(pageSize-1);
     if (bytesNew >= bytesOld)
@@ -279,6 +445,7 @@ namespace embree
     if (munmap((char*)ptr+bytesNew,bytesOld-bytesNew) == -1)
       throw std::bad_alloc();
 
+    os_track(ptr,bytesNew,os_lookup(ptr).type);
     return bytesNew;
   }
 
@@ -288,8 +455,9 @@ namespace embree
       return;
 
     /* for hugepages we need to also align the size */
-    const size_t pageSize = hugepages ? PAGE_SIZE_2M : PAGE_SIZE_4K;
+    const size_t pageSize = os_page_size(ptr,hugepages);
     bytes = (bytes+pageSize-1) & ~(pageSize-1);
+    os_untrack(ptr);
     if (munmap(ptr,bytes) == -1)
       throw std::bad_alloc();
   }
@@ -301,6 +469,41 @@ namespace embree
     madvise(pptr,bytes,MADV_HUGEPAGE); 
 #endif
   }
+
+  static size_t os_anon_huge_page_bytes()
+  {
+#if defined(__LINUX__)
+    return readMemInfo("/proc/self/smaps_rollup","AnonHugePages:");
+#else
+    return 0;
+#endif
+  }
+
+  void* os_map_file(const char* fileName, size_t offset, size_t bytes)
+  {
+    if (bytes == 0)
+      return nullptr;
+
+    int fd = open(fileName,O_RDONLY);
+    if (fd == -1)
+      THROW_RUNTIME_ERROR("cannot open file "+std::string(fileName));
+
+    /* private mapping, pages only get copied when they are written to */
+    void* ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, (off_t) offset);
+    close(fd); // the mapping keeps the file alive
+    if (ptr == MAP_FAILED)
+      THROW_RUNTIME_ERROR("cannot map file "+std::string(fileName));
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes)
+  {
+    if (bytes == 0)
+      return;
+
+    if (munmap(ptr,bytes) == -1)
+      throw std::bad_alloc();
+  }
 }
 
 #endif
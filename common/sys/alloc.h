@@ -55,12 +55,29 @@ namespace embree
 
   /*! allocates pages directly from OS */
   bool win_enable_selockmemoryprivilege(bool verbose);
-  bool os_init(bool hugepages, bool verbose);
+  bool os_init(bool hugepages, bool verbose, bool hugepages_1G = false);
   void* os_malloc (size_t bytes, bool& hugepages);
   size_t os_shrink (void* ptr, size_t bytesNew, size_t bytesOld, bool hugepages);
   void  os_free   (void* ptr, size_t bytes, bool hugepages);
   void  os_advise (void* ptr, size_t bytes);
 
+  /*! statistics about the pages used by all currently active OS allocations */
+  struct OSAllocStatistics
+  {
+    size_t bytes4K;              //!< bytes on 4KB pages
+    size_t bytesTHP;             //!< bytes on 4KB pages that are advised to use transparent huge pages
+    size_t bytes2M;              //!< bytes on explicit 2MB huge pages
+    size_t bytes1G;              //!< bytes on explicit 1GB huge pages
+    size_t bytesAnonHuge;        //!< bytes of the process backed by transparent huge pages, as reported by the OS
+    size_t failedHugePageAllocs; //!< number of huge page allocations that fell back to smaller pages
+  };
+  OSAllocStatistics os_statistics();
+
+  /*! maps a range of a file copy-on-write into memory, offset has to be a multiple of os_map_granularity */
+  static const size_t os_map_granularity = 64*1024;
+  void* os_map_file   (const char* fileName, size_t offset, size_t bytes);
+  void  os_unmap_file (void* ptr, size_t bytes);
+
   /*! allocator that performs OS allocations */
   template<typename T>
     struct os_allocator
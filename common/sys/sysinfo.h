@@ -9,6 +9,7 @@
   #define PAGE_SIZE 4096
 #endif
 
+#define PAGE_SIZE_1G (1024*1024*1024)
 #define PAGE_SIZE_2M (2*1024*1024)
 #define PAGE_SIZE_4K (4*1024)
 
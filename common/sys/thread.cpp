@@ -164,47 +164,91 @@ namespace embree
 {
   static MutexSys mutex;
   static std::vector<size_t> threadIDs;
-  
-  /* changes thread ID mapping such that we first fill up all thread on one core */
-  size_t mapThreadID(size_t threadID)
+  static std::vector<size_t> threadsPerCore;
+  static __thread ssize_t threadCPU = -1;            //!< CPU the calling thread got bound to using setAffinity
+  static __thread ssize_t threadLocalityDomain = -1; //!< cached locality domain of the calling thread
+
+  /* parses a CPU list of the form 0-3,8-11 */
+  static std::vector<size_t> parseCPUList(const std::string& fileName)
   {
-    Lock<MutexSys> lock(mutex);
-    
-    if (threadIDs.size() == 0)
+    std::vector<size_t> cpus;
+    std::fstream fs;
+    fs.open (fileName.c_str(), std::fstream::in);
+    if (fs.fail()) return cpus;
+
+    size_t begin, end;
+    while (fs >> begin)
     {
-      /* parse thread/CPU topology */
-      for (size_t cpuID=0;;cpuID++)
-      {
-        std::fstream fs;
-        std::string cpu = std::string("/sys/devices/system/cpu/cpu") + std::to_string((long long)cpuID) + std::string("/topology/thread_siblings_list");
-        fs.open (cpu.c_str(), std::fstream::in);
-        if (fs.fail()) break;
+      end = begin;
+      if (fs.peek() == '-') { fs.ignore(); fs >> end; }
+      for (size_t cpu=begin; cpu<=end; cpu++) cpus.push_back(cpu);
+      if (fs.peek() == ',') fs.ignore();
+    }
+    fs.close();
+    return cpus;
+  }
 
-        int i;
-        while (fs >> i) 
-        {
-          if (std::none_of(threadIDs.begin(),threadIDs.end(),[&] (int id) { return id == i; }))
-            threadIDs.push_back(i);
-          if (fs.peek() == ',') 
-            fs.ignore();
-        }
-        fs.close();
-      }
+  /* parses thread/CPU topology such that all threads of a core are
+   * consecutive and cores of hybrid CPUs are ordered by performance */
+  static void parseThreadTopology()
+  {
+    if (threadIDs.size()) return;
+
+    /* efficiency cores of hybrid CPUs */
+    const std::vector<size_t> atoms = parseCPUList("/sys/devices/cpu_atom/cpus");
+
+    struct Core { std::vector<size_t> threads; bool efficient; size_t capacity; };
+    std::vector<Core> cores;
+    for (size_t cpuID=0;;cpuID++)
+    {
+      const std::string cpu = std::string("/sys/devices/system/cpu/cpu") + std::to_string((long long)cpuID);
+      const std::vector<size_t> siblings = parseCPUList(cpu + std::string("/topology/thread_siblings_list"));
+      if (siblings.empty()) break;
+      if (std::any_of(cores.begin(),cores.end(),[&] (const Core& core) { return core.threads[0] == siblings[0]; }))
+        continue;
+
+      Core core;
+      core.threads = siblings;
+      core.efficient = std::find(atoms.begin(),atoms.end(),cpuID) != atoms.end();
+      core.capacity = 1024;
+      std::fstream fs;
+      fs.open ((cpu + std::string("/cpu_capacity")).c_str(), std::fstream::in);
+      if (!fs.fail()) fs >> core.capacity;
+      cores.push_back(core);
+    }
+
+    /* fill up fast cores first */
+    std::stable_sort(cores.begin(),cores.end(),[] (const Core& a, const Core& b) {
+        if (a.efficient != b.efficient) return b.efficient;
+        return a.capacity > b.capacity;
+      });
+
+    for (const Core& core : cores) {
+      threadIDs.insert(threadIDs.end(),core.threads.begin(),core.threads.end());
+      threadsPerCore.push_back(core.threads.size());
+    }
 
 #if 0
-      for (size_t i=0;i<threadIDs.size();i++)
-        std::cout << i << " -> " << threadIDs[i] << std::endl;
+    for (size_t i=0;i<threadIDs.size();i++)
+      std::cout << i << " -> " << threadIDs[i] << std::endl;
 #endif
 
-      /* verify the mapping and do not use it if the mapping has errors */
-      for (size_t i=0;i<threadIDs.size();i++) {
-        for (size_t j=0;j<threadIDs.size();j++) {
-          if (i != j && threadIDs[i] == threadIDs[j]) {
-            threadIDs.clear();
-          }
+    /* verify the mapping and do not use it if the mapping has errors */
+    for (size_t i=0;i<threadIDs.size();i++) {
+      for (size_t j=0;j<threadIDs.size();j++) {
+        if (i != j && threadIDs[i] == threadIDs[j]) {
+          threadIDs.clear();
+          threadsPerCore.clear();
         }
       }
     }
+  }
+
+  /* changes thread ID mapping such that we first fill up all thread on one core */
+  size_t mapThreadID(size_t threadID)
+  {
+    Lock<MutexSys> lock(mutex);
+    parseThreadTopology();
 
     /* re-map threadIDs if mapping is available */
     size_t ID = threadID;
@@ -238,7 +282,154 @@ namespace embree
     size_t threadID = mapThreadID(affinity);
     CPU_SET(threadID, &cset);
 
-    pthread_setaffinity_np(pthread_self(), sizeof(cset), &cset);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cset), &cset) == 0) {
+      threadCPU = threadID;
+      threadLocalityDomain = -1;
+    }
+  }
+
+  size_t getNumberOfThreadsOfCores(size_t numCores)
+  {
+    Lock<MutexSys> lock(mutex);
+    parseThreadTopology();
+    if (threadsPerCore.empty()) return numCores;
+
+    size_t numThreads = 0;
+    for (size_t i=0; i<min(numCores,threadsPerCore.size()); i++)
+      numThreads += threadsPerCore[i];
+    return numThreads;
+  }
+
+  static std::vector<size_t> numaNodeOfCPU;
+  static std::atomic<size_t> numNumaNodes(0);
+  static __thread ssize_t threadNumaNode = -1;
+
+  /* parses the CPU lists of all NUMA nodes */
+  static void parseNumaTopology()
+  {
+    if (numNumaNodes) return;
+    Lock<MutexSys> lock(mutex);
+    if (numNumaNodes) return;
+
+    size_t numNodes = 0;
+    for (size_t node=0;;node++)
+    {
+      const std::string cpus = std::string("/sys/devices/system/node/node") + std::to_string((long long)node) + std::string("/cpulist");
+      std::fstream fs;
+      fs.open (cpus.c_str(), std::fstream::in);
+      if (fs.fail()) break;
+      fs.close();
+
+      for (size_t cpu : parseCPUList(cpus)) {
+        if (numaNodeOfCPU.size() <= cpu) numaNodeOfCPU.resize(cpu+1,0);
+        numaNodeOfCPU[cpu] = node;
+      }
+      numNodes = node+1;
+    }
+    numNumaNodes = max(numNodes,size_t(1));
+  }
+
+  size_t getNumberOfNumaNodes()
+  {
+    parseNumaTopology();
+    return numNumaNodes;
+  }
+
+  size_t getNumaNode()
+  {
+    if (likely(threadNumaNode >= 0))
+      return threadNumaNode;
+
+    parseNumaTopology();
+    const int cpu = sched_getcpu();
+    threadNumaNode = (cpu >= 0 && size_t(cpu) < numaNodeOfCPU.size()) ? numaNodeOfCPU[cpu] : 0;
+    return threadNumaNode;
+  }
+
+  NumaAffinity::NumaAffinity(size_t node)
+    : prevAffinity(nullptr), prevNumaNode(threadNumaNode)
+  {
+    parseNumaTopology();
+    cpu_set_t cset;
+    CPU_ZERO(&cset);
+    bool found = false;
+    for (size_t cpu=0; cpu<numaNodeOfCPU.size() && cpu<CPU_SETSIZE; cpu++) {
+      if (numaNodeOfCPU[cpu] != node) continue;
+      CPU_SET(cpu, &cset);
+      found = true;
+    }
+    if (!found) return;
+
+    cpu_set_t* prev = new cpu_set_t;
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), prev) != 0 ||
+        pthread_setaffinity_np(pthread_self(), sizeof(cset), &cset) != 0) {
+      delete prev;
+      return;
+    }
+    prevAffinity = prev;
+    threadNumaNode = node;
+  }
+
+  NumaAffinity::~NumaAffinity()
+  {
+    if (!prevAffinity) return;
+    cpu_set_t* prev = (cpu_set_t*) prevAffinity;
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), prev);
+    threadNumaNode = prevNumaNode;
+    delete prev;
+  }
+
+  static std::vector<size_t> domainOfCPU;
+  static bool domainsParsed = false;
+
+  /* groups CPUs that share the last level cache and NUMA node into locality domains */
+  static void parseLocalityDomains()
+  {
+    parseNumaTopology();
+    Lock<MutexSys> lock(mutex);
+    if (domainsParsed) return;
+    domainsParsed = true;
+
+    std::vector<std::pair<size_t,size_t>> domains;
+    for (size_t cpuID=0;;cpuID++)
+    {
+      const std::string cpu = std::string("/sys/devices/system/cpu/cpu") + std::to_string((long long)cpuID);
+      if (parseCPUList(cpu + std::string("/topology/thread_siblings_list")).empty()) break;
+
+      /* find CPUs that share the highest cache level */
+      std::vector<size_t> shared(1,cpuID);
+      int maxLevel = -1;
+      for (size_t index=0;;index++)
+      {
+        const std::string cache = cpu + std::string("/cache/index") + std::to_string((long long)index);
+        std::fstream fs;
+        fs.open ((cache + std::string("/level")).c_str(), std::fstream::in);
+        if (fs.fail()) break;
+        int level = -1; fs >> level;
+        if (level <= maxLevel) continue;
+        const std::vector<size_t> cpus = parseCPUList(cache + std::string("/shared_cpu_list"));
+        if (cpus.empty()) continue;
+        maxLevel = level;
+        shared = cpus;
+      }
+
+      const size_t node = cpuID < numaNodeOfCPU.size() ? numaNodeOfCPU[cpuID] : 0;
+      const std::pair<size_t,size_t> domain(*std::min_element(shared.begin(),shared.end()),node);
+      const size_t index = std::find(domains.begin(),domains.end(),domain) - domains.begin();
+      if (index == domains.size()) domains.push_back(domain);
+      domainOfCPU.push_back(index);
+    }
+  }
+
+  ssize_t getLocalityDomain()
+  {
+    /* unbound threads may migrate between domains, thus they have none */
+    if (likely(threadLocalityDomain >= 0 || threadCPU < 0))
+      return threadLocalityDomain;
+
+    parseLocalityDomains();
+    threadLocalityDomain = size_t(threadCPU) < domainOfCPU.size() ? domainOfCPU[threadCPU] : 0;
+    return threadLocalityDomain;
   }
 }
 #endif
@@ -423,3 +614,34 @@ namespace embree
 }
 
 #endif
+
+////////////////////////////////////////////////////////////////////////////////
+/// Topology fallback for platforms without topology support
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(__LINUX__)
+
+namespace embree
+{
+  size_t getNumberOfThreadsOfCores(size_t numCores) {
+    return numCores;
+  }
+
+  ssize_t getLocalityDomain() {
+    return -1;
+  }
+
+  size_t getNumberOfNumaNodes() {
+    return 1;
+  }
+
+  size_t getNumaNode() {
+    return 0;
+  }
+
+  NumaAffinity::NumaAffinity(size_t node)
+    : prevAffinity(nullptr), prevNumaNode(-1) {}
+
+  NumaAffinity::~NumaAffinity() {}
+}
+#endif
@@ -23,6 +23,31 @@ namespace embree
   /*! set affinity of the calling thread */
   void setAffinity(ssize_t affinity);
 
+  /*! returns the number of logical threads of the first numCores cores in affinity order */
+  size_t getNumberOfThreadsOfCores(size_t numCores);
+
+  /*! returns the locality domain (cores sharing the last level cache and NUMA node) of the calling thread,
+   *  or -1 if the thread did not get bound to a CPU using setAffinity */
+  ssize_t getLocalityDomain();
+
+  /*! returns the number of NUMA nodes of the system */
+  size_t getNumberOfNumaNodes();
+
+  /*! returns the NUMA node of the calling thread, determined once per thread */
+  size_t getNumaNode();
+
+  /*! binds the calling thread to the CPUs of some NUMA node as long as the object lives */
+  class NumaAffinity
+  {
+  public:
+    NumaAffinity (size_t node);
+    ~NumaAffinity ();
+
+  private:
+    void* prevAffinity;   //!< affinity before binding, nullptr if the thread did not get bound
+    ssize_t prevNumaNode; //!< NUMA node of the thread before binding
+  };
+
   /*! the thread calling this function gets yielded */
   void yield();
 
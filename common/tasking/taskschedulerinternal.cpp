@@ -137,8 +137,13 @@ namespace embree
     pool->thread_loop(threadIndex);
   }
 
-  TaskScheduler::ThreadPool::ThreadPool(bool set_affinity)
-    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), running(false) {}
+  TaskScheduler::ThreadPool::ThreadPool(bool set_affinity, size_t reserved_cores)
+    : numThreads(0), numThreadsRunning(0), set_affinity(set_affinity), reservedThreads(0), running(false)
+  {
+    /* worker threads never run on the reserved cores */
+    if (reserved_cores)
+      reservedThreads = min(getNumberOfThreadsOfCores(reserved_cores), (size_t) getNumberOfLogicalThreads()-1);
+  }
 
   dll_export void TaskScheduler::ThreadPool::startThreads()
   {
@@ -150,7 +155,7 @@ namespace embree
   {
     Lock<MutexSys> lock(g_mutex);
     assert(newNumThreads);
-    newNumThreads = min(newNumThreads, (size_t) getNumberOfLogicalThreads());
+    newNumThreads = min(newNumThreads, (size_t) getNumberOfLogicalThreads()-reservedThreads);
 
     numThreads = newNumThreads;
     if (!startThreads && !running) return;
@@ -167,7 +172,7 @@ namespace embree
     {
       if (t == 0) continue;
       auto pair = new std::pair<TaskScheduler::ThreadPool*,size_t>(this,t);
-      threads.push_back(createThread((thread_func)threadPoolFunction,pair,4*1024*1024,set_affinity ? t : -1));
+      threads.push_back(createThread((thread_func)threadPoolFunction,pair,4*1024*1024,set_affinity ? ssize_t(t+reservedThreads) : -1));
     }
 
     /* stop some threads if we reduce the number of threads */
@@ -268,9 +273,9 @@ namespace embree
     return g_instance;
   }
 
-  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads)
+  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads, size_t reserved_cores)
   {
-    if (!threadPool) threadPool = new TaskScheduler::ThreadPool(set_affinity);
+    if (!threadPool) threadPool = new TaskScheduler::ThreadPool(set_affinity,reserved_cores);
     threadPool->setNumThreads(numThreads,start_threads);
   }
 
@@ -375,18 +380,30 @@ namespace embree
     const size_t threadIndex = thread.threadIndex;
     const size_t threadCount = this->threadCounter;
 
-    for (size_t i=1; i<threadCount; i++)
+    /* first try threads that share our cache and NUMA node, then all others, unbound threads steal from all threads in one pass */
+    bool remote = false;
+    for (size_t pass=0; pass<2; pass++)
     {
-      pause_cpu(32);
-      size_t otherThreadIndex = threadIndex+i;
-      if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
+      for (size_t i=1; i<threadCount; i++)
+      {
+        size_t otherThreadIndex = threadIndex+i;
+        if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
 
-      Thread* othread = threadLocal[otherThreadIndex].load();
-      if (!othread)
-        continue;
+        Thread* othread = threadLocal[otherThreadIndex].load();
+        if (!othread)
+          continue;
 
-      if (othread->tasks.steal(thread))
-        return true;
+        const bool local = thread.domain < 0 || othread->domain == thread.domain;
+        if (local != (pass == 0)) {
+          remote = true;
+          continue;
+        }
+
+        pause_cpu(32);
+        if (othread->tasks.steal(thread))
+          return true;
+      }
+      if (!remote) break;
     }
 
     return false;
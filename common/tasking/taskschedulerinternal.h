@@ -169,13 +169,14 @@ namespace embree
       ALIGNED_STRUCT_(64);
 
       Thread (size_t threadIndex, const Ref<TaskScheduler>& scheduler)
-      : threadIndex(threadIndex), task(nullptr), scheduler(scheduler) {}
+      : threadIndex(threadIndex), domain(getLocalityDomain()), task(nullptr), scheduler(scheduler) {}
 
       __forceinline size_t threadCount() {
         return scheduler->threadCounter;
       }
 
       size_t threadIndex;              //!< ID of this thread
+      ssize_t domain;                  //!< locality domain this thread is bound to, -1 if unbound
       TaskQueue tasks;                 //!< local task queue
       Task* task;                      //!< current active task
       Ref<TaskScheduler> scheduler;     //!< pointer to task scheduler
@@ -184,7 +185,7 @@ namespace embree
     /*! pool of worker threads */
     struct ThreadPool
     {
-      ThreadPool (bool set_affinity);
+      ThreadPool (bool set_affinity, size_t reserved_cores);
       ~ThreadPool ();
 
       /*! starts the threads */
@@ -209,6 +210,7 @@ namespace embree
       std::atomic<size_t> numThreads;
       std::atomic<size_t> numThreadsRunning;
       bool set_affinity;
+      size_t reservedThreads;
       std::atomic<bool> running;
       std::vector<thread_t> threads;
 
@@ -222,7 +224,7 @@ namespace embree
     ~TaskScheduler ();
 
     /*! initializes the task scheduler */
-    static void create(size_t numThreads, bool set_affinity, bool start_threads);
+    static void create(size_t numThreads, bool set_affinity, bool start_threads, size_t reserved_cores = 0);
 
     /*! destroys the task scheduler again */
     static void destroy();
@@ -240,7 +242,7 @@ namespace embree
     /*! thread loop for all worker threads */
     std::exception_ptr thread_loop(size_t threadIndex);
 
-    /*! steals a task from a different thread */
+    /*! steals a task from a different thread, preferring threads of the same locality domain */
     bool steal_from_other_threads(Thread& thread);
 
     template<typename Predicate, typename Body>
@@ -7,7 +7,7 @@ namespace embree
 {
   static bool g_ppl_threads_initialized = false;
     
-  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads)
+  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads, size_t reserved_cores)
   {
     assert(numThreads);
     
@@ -16,6 +16,13 @@ namespace embree
       g_ppl_threads_initialized = false;
     }
     
+    /* reserved cores only reduce the number of threads, as PPL does not support affinity */
+    if (reserved_cores) {
+      const size_t max_concurrency = threadCount();
+      const size_t reserved = min(getNumberOfThreadsOfCores(reserved_cores),max_concurrency-1);
+      numThreads = min(numThreads,max_concurrency-reserved);
+    }
+
     /* now either keep default settings or configure number of threads */
     if (numThreads == std::numeric_limits<size_t>::max())
     {
@@ -22,7 +22,7 @@ namespace embree
   struct TaskScheduler
   {
     /*! initializes the task scheduler */
-    static void create(size_t numThreads, bool set_affinity, bool start_threads);
+    static void create(size_t numThreads, bool set_affinity, bool start_threads, size_t reserved_cores = 0);
 
     /*! destroys the task scheduler again */
     static void destroy();
@@ -13,17 +13,19 @@ namespace embree
   static tbb::task_scheduler_init g_tbb_threads(tbb::task_scheduler_init::deferred);
 #endif
   
+  static size_t g_tbb_reserved_threads = 0;
+
   class TBBAffinity: public tbb::task_scheduler_observer
   {
   public:
     
     void on_scheduler_entry( bool ) {
-      setAffinity(TaskScheduler::threadIndex()); 
+      setAffinity(TaskScheduler::threadIndex()+g_tbb_reserved_threads); 
     }
     
   } tbb_affinity;
   
-  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads)
+  void TaskScheduler::create(size_t numThreads, bool set_affinity, bool start_threads, size_t reserved_cores)
   {
     assert(numThreads);
 
@@ -44,6 +46,14 @@ namespace embree
       tbb_affinity.observe(true);
 #endif 
     
+    /* worker threads never run on the reserved cores */
+    g_tbb_reserved_threads = 0;
+    if (reserved_cores) {
+      const size_t max_concurrency = threadCount();
+      g_tbb_reserved_threads = min(getNumberOfThreadsOfCores(reserved_cores),max_concurrency-1);
+      numThreads = min(numThreads,max_concurrency-g_tbb_reserved_threads);
+    }
+
     /* now either keep default settings or configure number of threads */
     if (numThreads == std::numeric_limits<size_t>::max()) {
       numThreads = threadCount();
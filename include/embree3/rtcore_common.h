@@ -151,6 +151,7 @@ enum RTCBuildQuality
   RTC_BUILD_QUALITY_MEDIUM = 1,
   RTC_BUILD_QUALITY_HIGH   = 2,
   RTC_BUILD_QUALITY_REFIT  = 3,
+  RTC_BUILD_QUALITY_PLOC   = 4,
 };
 
 /* Axis-aligned bounding box representation */
@@ -203,6 +204,9 @@ struct RTCIntersectContext
 #if RTC_MIN_WIDTH
   float minWidthDistanceFactor;                      // curve radius is set to this factor times distance to ray origin
 #endif
+
+  float coneWidth;                                   // width of the ray cone at the ray origin, used to select instance levels of detail
+  float coneSpread;                                  // increase of the ray cone width per unit of distance
 };
 
 /* Initializes an intersection context. */
@@ -221,6 +225,9 @@ RTC_FORCEINLINE void rtcInitIntersectContext(struct RTCIntersectContext* context
 #if RTC_MIN_WIDTH
   context->minWidthDistanceFactor = 0.0f;
 #endif
+
+  context->coneWidth = 0.0f;
+  context->coneSpread = 0.0f;
 }
 
 /* Point query structure for closest point query */
@@ -322,5 +329,14 @@ struct RTC_ALIGN(16) RTCPointQueryFunctionArguments
 };
 
 typedef bool (*RTCPointQueryFunction)(struct RTCPointQueryFunctionArguments* args);
+
+/* Primitive found by a k-nearest-neighbor or radius query */
+struct RTCPointQueryNeighbor
+{
+  float distance;                                    // world space distance of the primitive to the query point
+  unsigned int geomID;                               // geometry ID of the primitive
+  unsigned int primID;                               // primitive ID of the primitive
+  unsigned int instID[RTC_MAX_INSTANCE_LEVEL_COUNT]; // instance IDs of the primitive
+};
   
 RTC_NAMESPACE_END
@@ -223,6 +223,9 @@ RTC_API void rtcFilterOcclusion(const struct RTCOccludedFunctionNArguments* args
 /* Sets the instanced scene of an instance geometry. */
 RTC_API void rtcSetGeometryInstancedScene(RTCGeometry geometry, RTCScene scene);
 
+/* Sets the instanced scene of a coarser level of detail of an instance geometry. */
+RTC_API void rtcSetGeometryInstancedSceneLevel(RTCGeometry geometry, unsigned int level, RTCScene scene, float footprint, float blend);
+
 /* Sets the transformation of an instance for the specified time step. */
 RTC_API void rtcSetGeometryTransform(RTCGeometry geometry, unsigned int timeStep, enum RTCFormat format, const void* xfm);
 
@@ -236,6 +239,19 @@ RTC_API void rtcGetGeometryTransform(RTCGeometry geometry, float time, enum RTCF
 /* Sets the uniform tessellation rate of the geometry. */
 RTC_API void rtcSetGeometryTessellationRate(RTCGeometry geometry, float tessellationRate);
 
+/* Camera used to calculate view dependent tessellation levels. */
+struct RTCTessellationCamera
+{
+  float position[3]; // camera position in object space of the geometry
+  float pixelAngle;  // angle between the rays of neighboring pixels in radians
+  float edgeLength;  // desired length of tessellated edges in pixels
+  float minLevel;    // minimal tessellation level of each edge
+  float maxLevel;    // maximal tessellation level of each edge
+};
+
+/* Sets the camera used to calculate view dependent tessellation levels of the geometry. */
+RTC_API void rtcSetGeometryTessellationCamera(RTCGeometry geometry, const struct RTCTessellationCamera* camera);
+
 /* Sets the number of topologies of a subdivision surface. */
 RTC_API void rtcSetGeometryTopologyCount(RTCGeometry geometry, unsigned int topologyCount);
 
@@ -370,6 +386,9 @@ struct RTCInterpolateNArguments
 /* Interpolates vertex data to an array of u/v locations. */
 RTC_API void rtcInterpolateN(const struct RTCInterpolateNArguments* args);
 
+/* Interpolates vertex data to a large array of u/v locations in arbitrary order. */
+RTC_API void rtcInterpolateBatch(const struct RTCInterpolateNArguments* args);
+
 /* RTCGrid primitive for grid mesh */
 struct RTCGrid
 {
@@ -21,7 +21,9 @@ enum RTCSceneFlags
   RTC_SCENE_FLAG_DYNAMIC                 = (1 << 0),
   RTC_SCENE_FLAG_COMPACT                 = (1 << 1),
   RTC_SCENE_FLAG_ROBUST                  = (1 << 2),
-  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3)
+  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3),
+  RTC_SCENE_FLAG_QUANTIZED               = (1 << 4),
+  RTC_SCENE_FLAG_DOUBLE_BUFFERED         = (1 << 5)
 };
 
 /* Creates a new scene. */
@@ -57,6 +59,42 @@ RTC_API void rtcCommitScene(RTCScene scene);
 /* Commits the scene from multiple threads. */
 RTC_API void rtcJoinCommitScene(RTCScene scene);
 
+/* Handle of an asynchronous scene commit */
+typedef struct RTCCommitTy* RTCCommit;
+
+/* States of an asynchronous scene commit */
+enum RTCCommitState
+{
+  RTC_COMMIT_STATE_RUNNING   = 0,
+  RTC_COMMIT_STATE_DONE      = 1,
+  RTC_COMMIT_STATE_CANCELLED = 2,
+  RTC_COMMIT_STATE_FAILED    = 3
+};
+
+/* Commits the scene asynchronously using the specified number of background threads. */
+RTC_API RTCCommit rtcCommitSceneAsync(RTCScene scene, unsigned int numThreads);
+
+/* Returns the state and optionally the progress of an asynchronous commit. */
+RTC_API enum RTCCommitState rtcGetCommitState(RTCCommit commit, float* progress);
+
+/* Waits for an asynchronous commit to finish. */
+RTC_API enum RTCCommitState rtcWaitCommit(RTCCommit commit);
+
+/* Requests an asynchronous commit to terminate early. */
+RTC_API void rtcCancelCommit(RTCCommit commit);
+
+/* Retains the commit handle (increments the reference count). */
+RTC_API void rtcRetainCommit(RTCCommit commit);
+
+/* Releases the commit handle (decrements the reference count). */
+RTC_API void rtcReleaseCommit(RTCCommit commit);
+
+/* Stores the acceleration structure of a committed scene to a file. */
+RTC_API void rtcSaveSceneBVH(RTCScene scene, const char* filename);
+
+/* Commits the scene by mapping an acceleration structure stored with rtcSaveSceneBVH from a file. */
+RTC_API void rtcLoadSceneBVH(RTCScene scene, const char* filename);
+
 
 /* Progress monitor callback function */
 typedef bool (*RTCProgressMonitorFunction)(void* ptr, double n);
@@ -92,6 +130,30 @@ RTC_API bool rtcPointQuery8(const int* valid, RTCScene scene, struct RTCPointQue
 /* Perform a closest point query with a packet of 4 points with the scene. */
 RTC_API bool rtcPointQuery16(const int* valid, RTCScene scene, struct RTCPointQuery16* query, struct RTCPointQueryContext* context, RTCPointQueryFunction queryFunc, void** userPtr);
 
+/* Finds the k nearest primitives within the query radius, sorted by distance. Returns the number of neighbors found. */
+RTC_API unsigned int rtcPointQueryKNN(RTCScene scene, struct RTCPointQuery* query, unsigned int k, struct RTCPointQueryNeighbor* neighbors);
+
+/* Performs a k-nearest-neighbor query for a packet of 4 points, neighbors of point i are stored at neighbors[i*k]. */
+RTC_API void rtcPointQueryKNN4(const int* valid, RTCScene scene, struct RTCPointQuery4* query, unsigned int k, struct RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors);
+
+/* Performs a k-nearest-neighbor query for a packet of 8 points, neighbors of point i are stored at neighbors[i*k]. */
+RTC_API void rtcPointQueryKNN8(const int* valid, RTCScene scene, struct RTCPointQuery8* query, unsigned int k, struct RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors);
+
+/* Performs a k-nearest-neighbor query for a packet of 16 points, neighbors of point i are stored at neighbors[i*k]. */
+RTC_API void rtcPointQueryKNN16(const int* valid, RTCScene scene, struct RTCPointQuery16* query, unsigned int k, struct RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors);
+
+/* Finds all primitives within the query radius and stores the maxNeighbors nearest ones sorted by distance. Returns the total number of primitives found. */
+RTC_API unsigned int rtcPointQueryRadius(RTCScene scene, struct RTCPointQuery* query, unsigned int maxNeighbors, struct RTCPointQueryNeighbor* neighbors);
+
+/* Performs a radius query for a packet of 4 points, neighbors of point i are stored at neighbors[i*maxNeighbors]. */
+RTC_API void rtcPointQueryRadius4(const int* valid, RTCScene scene, struct RTCPointQuery4* query, unsigned int maxNeighbors, struct RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors);
+
+/* Performs a radius query for a packet of 8 points, neighbors of point i are stored at neighbors[i*maxNeighbors]. */
+RTC_API void rtcPointQueryRadius8(const int* valid, RTCScene scene, struct RTCPointQuery8* query, unsigned int maxNeighbors, struct RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors);
+
+/* Performs a radius query for a packet of 16 points, neighbors of point i are stored at neighbors[i*maxNeighbors]. */
+RTC_API void rtcPointQueryRadius16(const int* valid, RTCScene scene, struct RTCPointQuery16* query, unsigned int maxNeighbors, struct RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors);
+
 /* Intersects a single ray with the scene. */
 RTC_API void rtcIntersect1(RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit* rayhit);
 
@@ -140,12 +202,91 @@ RTC_API void rtcOccludedNM(RTCScene scene, struct RTCIntersectContext* context,
 /* Tests a stream of M ray packets of size N in SOA format for occlusion with the scene. */
 RTC_API void rtcOccludedNp(RTCScene scene, struct RTCIntersectContext* context, const struct RTCRayNp* ray, unsigned int N);
 
+/* Tests a group of M rays for occlusion with the scene, terminates early once maxOccluded rays are found occluded, and returns a mask of the occluded rays. */
+RTC_API unsigned int rtcOccludedGroup(RTCScene scene, struct RTCIntersectContext* context, struct RTCRay* ray, unsigned int M, unsigned int maxOccluded);
+
 /*! collision callback */
 struct RTCCollision { unsigned int geomID0; unsigned int primID0; unsigned int geomID1; unsigned int primID1; };
 typedef void (*RTCCollideFunc) (void* userPtr, struct RTCCollision* collisions, unsigned int num_collisions);
 
 /*! Performs collision detection of two scenes */
 RTC_API void rtcCollide (RTCScene scene0, RTCScene scene1, RTCCollideFunc callback, void* userPtr);
+
+/*! Writes all primitive pairs of two scenes with overlapping bounds into a buffer */
+RTC_API size_t rtcCollideBroadPhase (RTCScene scene0, RTCScene scene1, struct RTCCollision* collisions, size_t maxCollisions);
+
+/*! continuous collision callback */
+struct RTCContinuousCollision { unsigned int geomID0; unsigned int primID0; unsigned int geomID1; unsigned int primID1; float time; };
+typedef void (*RTCContinuousCollideFunc) (void* userPtr, struct RTCContinuousCollision* collisions, unsigned int num_collisions);
+
+/*! Performs continuous collision detection of two scenes over a time interval */
+RTC_API void rtcCollideContinuous (RTCScene scene0, RTCScene scene1, float time0, float time1, RTCContinuousCollideFunc callback, void* userPtr);
+
+/* Ray query types of traversal statistics */
+enum RTCRayQueryType
+{
+  RTC_RAY_QUERY_TYPE_INTERSECT = 0,
+  RTC_RAY_QUERY_TYPE_OCCLUDED  = 1
+};
+
+/* Traversal statistics gathered from sampled ray queries */
+struct RTCTraversalStatistics
+{
+  size_t numRays;                // number of sampled ray queries
+  size_t numNodes;               // number of traversed inner nodes
+  size_t numLeaves;              // number of traversed leaf nodes
+  size_t numPrimitiveTests;      // number of tested primitive blocks
+  size_t numFilterCalls;         // number of invoked filter functions
+  size_t numInstanceTransitions; // number of entered instances
+};
+
+/* Returns the traversal statistics of the scene for the specified ray query type. */
+RTC_API void rtcGetSceneTraversalStatistics(RTCScene scene, enum RTCRayQueryType type, struct RTCTraversalStatistics* stats);
+
+/* Returns the traversal statistics of sampled rays that hit the specified geometry of the scene. */
+RTC_API void rtcGetGeometryTraversalStatistics(RTCScene scene, unsigned int geomID, struct RTCTraversalStatistics* stats);
+
+/* Writes the traversal statistics of the scene as JSON string into a buffer and returns the length of the string. */
+RTC_API size_t rtcExportSceneTraversalStatistics(RTCScene scene, char* json, size_t capacity);
+
+/* Resets the traversal statistics of the scene. */
+RTC_API void rtcResetSceneTraversalStatistics(RTCScene scene);
+
+/* Maximal number of BVH levels of a BVH quality report */
+#define RTC_BVH_QUALITY_MAX_LEVELS 64
+
+/* BVH quality of a single level of the BVH */
+struct RTCBVHLevelQuality
+{
+  size_t numNodes;    // number of inner nodes
+  size_t numLeaves;   // number of leaf nodes
+  float sahCost;      // SAH cost of the inner nodes and leaves
+  float overlap;      // overlap of the children of the inner nodes
+};
+
+/* BVH quality report */
+struct RTCBVHQuality
+{
+  float sahCost;              // SAH cost of all inner nodes and leaves
+  float nodeSAHCost;          // SAH cost of the inner nodes
+  float leafSAHCost;          // SAH cost of the leaves
+  float overlap;              // surface area of overlapping child bounds relative to the scene bounds
+  float leafFillRatio;        // ratio of used primitive slots in leaf primitive blocks
+  size_t numNodes;            // number of inner nodes
+  size_t numLeaves;           // number of leaf nodes
+  size_t numPrimitives;       // number of primitives in leaves
+  size_t numPrimitiveBlocks;  // number of primitive blocks in leaves
+  size_t nodeBytes;           // memory consumption of inner nodes
+  size_t leafBytes;           // memory consumption of leaves
+  unsigned int depth;         // depth of the deepest leaf
+  struct RTCBVHLevelQuality levels[RTC_BVH_QUALITY_MAX_LEVELS]; // quality per level, the last level includes all deeper levels
+};
+
+/* Returns a quality report of the acceleration structures of the scene. */
+RTC_API void rtcGetSceneBVHQuality(RTCScene scene, struct RTCBVHQuality* quality);
+
+/* Returns a quality report of the leaves of the acceleration structures of the scene that contain primitives of the specified geometry. */
+RTC_API void rtcGetGeometryBVHQuality(RTCScene scene, unsigned int geomID, struct RTCBVHQuality* quality);
  
 #if defined(__cplusplus)
 
@@ -0,0 +1,616 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "bvh_builder_morton.h"
+#include "../../common/algorithms/parallel_for.h"
+#include "../../common/algorithms/parallel_prefix_sum.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Parallel locally-ordered clustering (PLOC) builder. Primitives
+     *  are sorted by morton code, then clusters get merged with their
+     *  nearest neighbour inside a small window of the sorted cluster
+     *  list, until a single cluster remains. The resulting binary
+     *  tree gets collapsed into a BVH of the requested branching
+     *  factor, the SAH cost of each way to distribute a subtree
+     *  over the children of a BVH node gets tracked while merging. */
+    struct BVHBuilderPLOC
+    {
+      typedef BVHBuilderMorton::BuildPrim BuildPrim;
+
+      static const size_t MAX_BRANCHING_FACTOR = 8;          //!< maximum supported BVH branching factor
+      static const size_t MIN_LARGE_LEAF_LEVELS = 8;         //!< create balanced tree of we are that many levels before the maximum tree depth
+
+      /*! settings for PLOC builder */
+      struct Settings
+      {
+        /*! default settings */
+        Settings ()
+        : branchingFactor(2), maxDepth(32), logBlockSize(0), minLeafSize(1), maxLeafSize(7), searchRadius(4),
+          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024) {}
+
+        /*! initialize settings from API settings */
+        Settings (const RTCBuildArguments& settings)
+        : branchingFactor(2), maxDepth(32), logBlockSize(0), minLeafSize(1), maxLeafSize(7), searchRadius(4),
+          travCost(1.0f), intCost(1.0f), singleThreadThreshold(1024)
+        {
+          if (RTC_BUILD_ARGUMENTS_HAS(settings,maxBranchingFactor)) branchingFactor = settings.maxBranchingFactor;
+          if (RTC_BUILD_ARGUMENTS_HAS(settings,maxDepth          )) maxDepth        = settings.maxDepth;
+          if (RTC_BUILD_ARGUMENTS_HAS(settings,sahBlockSize      )) logBlockSize    = bsr(settings.sahBlockSize);
+          if (RTC_BUILD_ARGUMENTS_HAS(settings,minLeafSize       )) minLeafSize     = settings.minLeafSize;
+          if (RTC_BUILD_ARGUMENTS_HAS(settings,maxLeafSize       )) maxLeafSize     = settings.maxLeafSize;
+          if (RTC_BUILD_ARGUMENTS_HAS(settings,traversalCost     )) travCost        = settings.traversalCost;
+          if (RTC_BUILD_ARGUMENTS_HAS(settings,intersectionCost  )) intCost         = settings.intersectionCost;
+
+          minLeafSize = min(minLeafSize,maxLeafSize);
+        }
+
+        Settings (size_t branchingFactor, size_t maxDepth, size_t sahBlockSize, size_t minLeafSize, size_t maxLeafSize, float travCost, float intCost, size_t singleThreadThreshold)
+        : branchingFactor(branchingFactor), maxDepth(maxDepth), logBlockSize(bsr(sahBlockSize)), minLeafSize(minLeafSize), maxLeafSize(maxLeafSize), searchRadius(4),
+          travCost(travCost), intCost(intCost), singleThreadThreshold(singleThreadThreshold)
+        {
+          minLeafSize = min(minLeafSize,maxLeafSize);
+        }
+
+      public:
+        size_t branchingFactor;  //!< branching factor of BVH to build
+        size_t maxDepth;         //!< maximum depth of BVH to build
+        size_t logBlockSize;     //!< log2 of blocksize for SAH heuristic
+        size_t minLeafSize;      //!< minimum size of a leaf
+        size_t maxLeafSize;      //!< maximum size of a leaf
+        size_t searchRadius;     //!< number of clusters to each side that get searched for the nearest neighbour
+        float travCost;          //!< estimated cost of one traversal step
+        float intCost;           //!< estimated cost of one primitive intersection
+        size_t singleThreadThreshold; //!< threshold when we switch to single threaded build
+      };
+
+      /*! node of the intermediate binary tree, the first nodes are the primitives in morton order, the bounds
+       *  are only stored for the active clusters */
+      struct Cluster
+      {
+        float area;              //!< half surface area of the bounds of the cluster
+        unsigned int left;       //!< left child
+        unsigned int right;      //!< right child
+        unsigned int count : 31; //!< number of primitives of the cluster
+        unsigned int leaf  : 1;  //!< cluster becomes a leaf of the final BVH when it is a single child of a node
+        float cost[MAX_BRANCHING_FACTOR]; //!< minimal SAH cost of the cluster when it gets distributed over at most i+1 children of a node
+      };
+
+      /*! bounds of the active clusters, stored per coordinate for the vectorized neighbour search */
+      struct ClusterBounds
+      {
+        /*! the arrays are padded on both sides to allow vector loads of the neighbours of all clusters */
+        void resize(size_t N, size_t padding)
+        {
+          this->padding = padding;
+          for (size_t k=0; k<3; k++)
+          {
+            lower[k].resize(N+2*padding);
+            upper[k].resize(N+2*padding);
+            for (size_t i=0; i<padding; i++) {
+              lower[k][i] = upper[k][i] = 0.0f;
+              lower[k][N+padding+i] = upper[k][N+padding+i] = 0.0f;
+            }
+          }
+        }
+
+        __forceinline BBox3fa get(size_t i) const
+        {
+          const size_t j = padding+i;
+          return BBox3fa(Vec3fa(lower[0][j],lower[1][j],lower[2][j]),Vec3fa(upper[0][j],upper[1][j],upper[2][j]));
+        }
+
+        __forceinline void set(size_t i, const BBox3fa& bounds)
+        {
+          const size_t j = padding+i;
+          for (size_t k=0; k<3; k++) {
+            lower[k][j] = bounds.lower[k];
+            upper[k][j] = bounds.upper[k];
+          }
+        }
+
+        __forceinline void copy(size_t i, const ClusterBounds& other, size_t j)
+        {
+          for (size_t k=0; k<3; k++) {
+            lower[k][padding+i] = other.lower[k][other.padding+j];
+            upper[k][padding+i] = other.upper[k][other.padding+j];
+          }
+        }
+
+        __forceinline BBox<Vec3vfx> loadu(ssize_t i) const
+        {
+          const size_t j = padding+i;
+          return BBox<Vec3vfx>(Vec3vfx(vfloatx::loadu(&lower[0][j]),vfloatx::loadu(&lower[1][j]),vfloatx::loadu(&lower[2][j])),
+                               Vec3vfx(vfloatx::loadu(&upper[0][j]),vfloatx::loadu(&upper[1][j]),vfloatx::loadu(&upper[2][j])));
+        }
+
+        size_t padding;
+        avector<float> lower[3];
+        avector<float> upper[3];
+      };
+
+      /*! number of merged clusters and of remaining clusters of one clustering step */
+      struct MergeCounts
+      {
+        __forceinline MergeCounts () {}
+        __forceinline MergeCounts (unsigned int merged, unsigned int remaining)
+          : merged(merged), remaining(remaining) {}
+
+        __forceinline friend MergeCounts operator+ (const MergeCounts& a, const MergeCounts& b) {
+          return MergeCounts(a.merged+b.merged,a.remaining+b.remaining);
+        }
+
+        unsigned int merged;
+        unsigned int remaining;
+      };
+
+      template<
+        typename ReductionTy,
+        typename Allocator,
+        typename CreateAllocator,
+        typename CreateNodeFunc,
+        typename SetNodeBoundsFunc,
+        typename CreateLeafFunc,
+        typename CalculateBounds,
+        typename ProgressMonitor>
+
+        class BuilderT : private Settings
+      {
+        ALIGNED_CLASS_(16);
+
+        static const size_t PARALLEL_BLOCK_SIZE = 256;
+
+      public:
+
+        BuilderT (CreateAllocator& createAllocator,
+                  CreateNodeFunc& createNode,
+                  SetNodeBoundsFunc& setBounds,
+                  CreateLeafFunc& createLeaf,
+                  CalculateBounds& calculateBounds,
+                  ProgressMonitor& progressMonitor,
+                  const Settings& settings)
+
+          : Settings(settings),
+          createAllocator(createAllocator),
+          createNode(createNode),
+          setBounds(setBounds),
+          createLeaf(createLeaf),
+          calculateBounds(calculateBounds),
+          progressMonitor(progressMonitor),
+          morton(nullptr), sorted(nullptr) {}
+
+        /*! SAH cost of a leaf over a cluster */
+        __forceinline float leafCost(const Cluster& c) const {
+          return intCost*c.area*float((size_t(c.count)+(size_t(1) << logBlockSize)-1) >> logBlockSize);
+        }
+
+        /*! initializes a cluster for each primitive */
+        void createPrimitiveClusters(size_t numPrimitives)
+        {
+          parallel_for(size_t(0), numPrimitives, size_t(1024), [&] (const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++)
+              {
+                Cluster& c = nodes[i];
+                const BBox3fa bounds = calculateBounds(morton[i]);
+                c.area = halfArea(bounds);
+                c.left = c.right = -1;
+                c.count = 1;
+                c.leaf = 1;
+                c.cost[0] = leafCost(c);
+                for (size_t k=1; k<branchingFactor; k++)
+                  c.cost[k] = c.cost[0];
+                clusters[i] = (unsigned int) i;
+                clusterBounds.set(i,bounds);
+              }
+            });
+        }
+
+        /*! finds the nearest neighbour of each cluster inside the search window */
+        void findNearestNeighbours(size_t numClusters)
+        {
+          const int radius = (int) searchRadius;
+          auto search = [&] (const range<size_t>& r)
+          {
+            for (size_t i=r.begin(); i<r.end(); i+=VSIZEX)
+            {
+              const vintx ids = vintx(int(i))+vintx(step);
+              const BBox<Vec3vfx> bounds = clusterBounds.loadu(i);
+              vfloatx bestArea(pos_inf);
+              vintx bestIndex = ids;
+
+              /* the candidates get visited in ascending order and ties get resolved towards the lower index, this
+               * guarantees at least one mutual pair */
+              for (int d=-radius; d<=radius; d++)
+              {
+                if (d == 0) continue;
+                const vintx candidates = ids+vintx(d);
+                const vboolx valid = (candidates >= vintx(zero)) & (candidates < vintx(int(numClusters)));
+                const vfloatx area = halfArea(merge(bounds,clusterBounds.loadu(ssize_t(i)+d)));
+                const vboolx closer = valid & (area < bestArea);
+                bestArea = select(closer,area,bestArea);
+                bestIndex = select(closer,candidates,bestIndex);
+              }
+
+              /* the last clusters of the range belong to this task only if the vector does not exceed the range */
+              if (i+VSIZEX <= r.end())
+                vintx::storeu(&neighbours[i],bestIndex);
+              else
+                for (size_t k=0; k<r.end()-i; k++)
+                  neighbours[i+k] = bestIndex[k];
+            }
+          };
+
+          if (numClusters <= singleThreadThreshold)
+            search(range<size_t>(0,numClusters));
+          else
+            parallel_for(size_t(0), numClusters, size_t(PARALLEL_BLOCK_SIZE), search);
+        }
+
+        /*! finds the number of children k+1 of the left cluster that minimizes the cost when distributing the clusters over i+1 children */
+        __forceinline std::pair<size_t,float> bestSplit(const Cluster& l, const Cluster& r, size_t i) const
+        {
+          std::pair<size_t,float> best(0,l.cost[0]+r.cost[i-1]);
+          for (size_t k=1; k<i; k++) {
+            const float cost = l.cost[k]+r.cost[i-1-k];
+            if (cost < best.second) best = std::make_pair(k,cost);
+          }
+          return best;
+        }
+
+        /*! merges cluster i with its nearest neighbour j into a new node */
+        __forceinline void mergeClusters(size_t i, size_t j, unsigned int nodeID, const BBox3fa& bounds)
+        {
+          const Cluster& l = nodes[clusters[i]];
+          const Cluster& r = nodes[clusters[j]];
+          Cluster& c = nodes[nodeID];
+          c.area = halfArea(bounds);
+          c.left = clusters[i];
+          c.right = clusters[j];
+          c.count = l.count+r.count;
+
+          /* cheapest distribution of the two subtrees over at most n+1 children */
+          float split[MAX_BRANCHING_FACTOR];
+          for (size_t n=1; n<branchingFactor; n++)
+            split[n] = bestSplit(l,r,n).second;
+
+          const float nodeCost = travCost*c.area + split[branchingFactor-1];
+          const float cost = leafCost(c);
+          c.leaf = c.count <= minLeafSize || (c.count <= maxLeafSize && cost <= nodeCost);
+          c.cost[0] = c.leaf ? cost : nodeCost;
+
+          /* small clusters never get split */
+          for (size_t n=1; n<branchingFactor; n++)
+            c.cost[n] = c.count <= minLeafSize ? c.cost[0] : min(c.cost[0],split[n]);
+        }
+
+        /*! merges all mutual nearest neighbours and compacts the cluster list, returns the new number of clusters */
+        size_t mergeAndCompact(size_t numClusters, unsigned int& numNodes)
+        {
+          auto step = [&] (const range<size_t>& r, const MergeCounts& base, bool write) -> MergeCounts
+          {
+            MergeCounts counts(0,0);
+            for (size_t i=r.begin(); i<r.end(); i++)
+            {
+              const size_t j = neighbours[i];
+              const bool mutual = j != i && neighbours[j] == i;
+              if (mutual && j < i) continue; // cluster got merged into its neighbour
+              if (write)
+              {
+                const size_t k = base.remaining+counts.remaining;
+                if (mutual) {
+                  const unsigned int cluster = numNodes+base.merged+counts.merged;
+                  const BBox3fa bounds = merge(clusterBounds.get(i),clusterBounds.get(j));
+                  mergeClusters(i,j,cluster,bounds);
+                  next[k] = cluster;
+                  nextBounds.set(k,bounds);
+                } else {
+                  next[k] = clusters[i];
+                  nextBounds.copy(k,clusterBounds,i);
+                }
+              }
+              counts.merged += mutual;
+              counts.remaining++;
+            }
+            return counts;
+          };
+
+          MergeCounts total;
+          if (numClusters <= singleThreadThreshold)
+          {
+            total = step(range<size_t>(0,numClusters),MergeCounts(0,0),true);
+          }
+          else
+          {
+            ParallelPrefixSumState<MergeCounts> state;
+            parallel_prefix_sum(state, size_t(0), numClusters, size_t(PARALLEL_BLOCK_SIZE), MergeCounts(0,0),
+                                [&] (const range<size_t>& r, const MergeCounts& base) { return step(r,base,false); },
+                                [] (const MergeCounts& a, const MergeCounts& b) { return a+b; });
+            total = parallel_prefix_sum(state, size_t(0), numClusters, size_t(PARALLEL_BLOCK_SIZE), MergeCounts(0,0),
+                                        [&] (const range<size_t>& r, const MergeCounts& base) { return step(r,base,true); },
+                                        [] (const MergeCounts& a, const MergeCounts& b) { return a+b; });
+          }
+
+          numNodes += total.merged;
+          std::swap(clusters,next);
+          std::swap(clusterBounds,nextBounds);
+          return total.remaining;
+        }
+
+        /*! writes the primitives of a subtree of the binary tree in depth first order to morton[begin] */
+        void gatherPrimitives(unsigned int nodeID, size_t begin)
+        {
+          std::vector<unsigned int> stack;
+          stack.push_back(nodeID);
+          while (!stack.empty())
+          {
+            const unsigned int n = stack.back(); stack.pop_back();
+            const Cluster& c = nodes[n];
+            if (c.count == 1) { morton[begin++] = sorted[n]; continue; }
+            stack.push_back(c.right);
+            stack.push_back(c.left);
+          }
+        }
+
+        /*! small leaves are gathered without heap allocations */
+        __forceinline void gatherLeafPrimitives(unsigned int nodeID, size_t begin)
+        {
+          if (nodes[nodeID].count > 32)
+            return gatherPrimitives(nodeID,begin);
+
+          unsigned int stack[32];
+          size_t stackPtr = 0;
+          stack[stackPtr++] = nodeID;
+          while (stackPtr)
+          {
+            const unsigned int n = stack[--stackPtr];
+            const Cluster& c = nodes[n];
+            if (c.count == 1) { morton[begin++] = sorted[n]; continue; }
+            stack[stackPtr++] = c.right;
+            stack[stackPtr++] = c.left;
+          }
+        }
+
+        ReductionTy createLargeLeaf(size_t depth, const range<unsigned>& current, Allocator alloc)
+        {
+          /* this should never occur but is a fatal error */
+          if (depth > maxDepth)
+            throw_RTCError(RTC_ERROR_UNKNOWN,"depth limit reached");
+
+          /* create leaf for few primitives */
+          if (current.size() <= maxLeafSize)
+            return createLeaf(current,alloc);
+
+          /* fill all children by always splitting the largest one */
+          range<unsigned> children[MAX_BRANCHING_FACTOR];
+          size_t numChildren = 1;
+          children[0] = current;
+
+          do {
+
+            /* find best child with largest number of primitives */
+            size_t bestChild = -1;
+            size_t bestSize = 0;
+            for (size_t i=0; i<numChildren; i++)
+            {
+              /* ignore leaves as they cannot get split */
+              if (children[i].size() <= maxLeafSize)
+                continue;
+
+              /* remember child with largest size */
+              if (children[i].size() > bestSize) {
+                bestSize = children[i].size();
+                bestChild = i;
+              }
+            }
+            if (bestChild == size_t(-1)) break;
+
+            /*! split best child into left and right child */
+            auto split = children[bestChild].split();
+
+            /* add new children left and right */
+            children[bestChild] = children[numChildren-1];
+            children[numChildren-1] = split.first;
+            children[numChildren+0] = split.second;
+            numChildren++;
+
+          } while (numChildren < branchingFactor);
+
+          /* create node */
+          auto node = createNode(alloc,numChildren);
+
+          /* recurse into each child */
+          ReductionTy bounds[MAX_BRANCHING_FACTOR];
+          for (size_t i=0; i<numChildren; i++)
+            bounds[i] = createLargeLeaf(depth+1,children[i],alloc);
+
+          return setBounds(node,bounds,numChildren);
+        }
+
+        /*! appends the children of the cheapest distribution of the subtrees of a cluster over at most i+1 children */
+        void splitChildren(const Cluster& cluster, size_t i, unsigned int* children, size_t& numChildren)
+        {
+          const Cluster& l = nodes[cluster.left];
+          const Cluster& r = nodes[cluster.right];
+          const size_t k = bestSplit(l,r,i).first;
+          addChildren(cluster.left,k,children,numChildren);
+          addChildren(cluster.right,i-1-k,children,numChildren);
+        }
+
+        /*! appends a cluster either as a single child or distributed over at most i+1 children */
+        void addChildren(unsigned int nodeID, size_t i, unsigned int* children, size_t& numChildren)
+        {
+          const Cluster& c = nodes[nodeID];
+          if (i == 0 || c.cost[i] == c.cost[0]) children[numChildren++] = nodeID;
+          else splitChildren(c,i,children,numChildren);
+        }
+
+        /*! collapses the binary tree below nodeID into a BVH, primitives of the subtree end up at morton[begin] */
+        ReductionTy recurse(size_t depth, unsigned int nodeID, unsigned begin, Allocator alloc, bool toplevel)
+        {
+          /* get thread local allocator */
+          if (!alloc)
+            alloc = createAllocator();
+
+          const Cluster& cluster = nodes[nodeID];
+          const range<unsigned> current(begin,begin+cluster.count);
+
+          /* call memory monitor function to signal progress */
+          if (toplevel && current.size() <= singleThreadThreshold)
+            progressMonitor(current.size());
+
+          /* create leaf node */
+          if (unlikely(depth+MIN_LARGE_LEAF_LEVELS >= maxDepth)) {
+            gatherPrimitives(nodeID,begin);
+            return createLargeLeaf(depth,current,alloc);
+          }
+          if (cluster.leaf) {
+            gatherLeafPrimitives(nodeID,begin);
+            return createLeaf(current,alloc);
+          }
+
+          /* fill the children with the cheapest distribution of the subtrees */
+          unsigned int children[MAX_BRANCHING_FACTOR];
+          size_t numChildren = 0;
+          splitChildren(cluster,branchingFactor-1,children,numChildren);
+
+          /* primitives of the children get stored in the order of the children */
+          unsigned int offsets[MAX_BRANCHING_FACTOR];
+          unsigned int offset = begin;
+          for (size_t i=0; i<numChildren; i++) {
+            offsets[i] = offset;
+            offset += nodes[children[i]].count;
+          }
+
+          /* allocate node */
+          auto node = createNode(alloc,numChildren);
+
+          /* process top parts of tree parallel */
+          ReductionTy bounds[MAX_BRANCHING_FACTOR];
+          if (current.size() > singleThreadThreshold)
+          {
+            /*! parallel_for is faster than spawing sub-tasks */
+            parallel_for(size_t(0), numChildren, [&] (const range<size_t>& r) {
+                for (size_t i=r.begin(); i<r.end(); i++) {
+                  bounds[i] = recurse(depth+1,children[i],offsets[i],nullptr,true);
+                  _mm_mfence(); // to allow non-temporal stores during build
+                }
+              });
+          }
+
+          /* finish tree sequentially */
+          else
+          {
+            for (size_t i=0; i<numChildren; i++)
+              bounds[i] = recurse(depth+1,children[i],offsets[i],alloc,false);
+          }
+
+          return setBounds(node,bounds,numChildren);
+        }
+
+        /* build function */
+        ReductionTy build(BuildPrim* src, BuildPrim* tmp, size_t numPrimitives)
+        {
+          /* like the morton builder we create an empty leaf for empty input */
+          morton = src;
+          if (numPrimitives == 0)
+            return createLeaf(range<unsigned>(0,0),createAllocator());
+
+          /* sort morton codes */
+          radix_sort_u32(src,tmp,numPrimitives,singleThreadThreshold);
+
+          /* cluster primitives, the binary tree has at most 2*numPrimitives-1 nodes */
+          nodes.resize(2*numPrimitives-1);
+          clusters.resize(numPrimitives);
+          next.resize(numPrimitives);
+          clusterBounds.resize(numPrimitives,searchRadius+VSIZEX);
+          nextBounds.resize(numPrimitives,searchRadius+VSIZEX);
+          neighbours.resize(numPrimitives);
+          createPrimitiveClusters(numPrimitives);
+
+          size_t numClusters = numPrimitives;
+          unsigned int numNodes = (unsigned int) numPrimitives;
+          while (numClusters > 1) {
+            findNearestNeighbours(numClusters);
+            numClusters = mergeAndCompact(numClusters,numNodes);
+          }
+          const unsigned int rootID = clusters[0];
+
+          /* tmp keeps the primitives in morton order while src gets reordered to depth first order of the final BVH */
+          parallel_for(size_t(0), numPrimitives, size_t(4096), [&] (const range<size_t>& r) {
+              for (size_t i=r.begin(); i<r.end(); i++) tmp[i] = src[i];
+            });
+          sorted = tmp;
+
+          /* build BVH */
+          const ReductionTy root = recurse(1, rootID, 0, nullptr, true);
+          _mm_mfence(); // to allow non-temporal stores during build
+          return root;
+        }
+
+      public:
+        CreateAllocator& createAllocator;
+        CreateNodeFunc& createNode;
+        SetNodeBoundsFunc& setBounds;
+        CreateLeafFunc& createLeaf;
+        CalculateBounds& calculateBounds;
+        ProgressMonitor& progressMonitor;
+
+      public:
+        BuildPrim* morton;
+        BuildPrim* sorted;
+        avector<Cluster> nodes;
+        avector<unsigned int> clusters;
+        avector<unsigned int> next;
+        ClusterBounds clusterBounds;
+        ClusterBounds nextBounds;
+        avector<unsigned int> neighbours;
+      };
+
+
+      template<
+      typename ReductionTy,
+        typename CreateAllocFunc,
+        typename CreateNodeFunc,
+        typename SetBoundsFunc,
+        typename CreateLeafFunc,
+        typename CalculateBoundsFunc,
+        typename ProgressMonitor>
+
+        static ReductionTy build(CreateAllocFunc createAllocator,
+                                 CreateNodeFunc createNode,
+                                 SetBoundsFunc setBounds,
+                                 CreateLeafFunc createLeaf,
+                                 CalculateBoundsFunc calculateBounds,
+                                 ProgressMonitor progressMonitor,
+                                 BuildPrim* src,
+                                 BuildPrim* tmp,
+                                 size_t numPrimitives,
+                                 const Settings& settings)
+        {
+          typedef BuilderT<
+            ReductionTy,
+            decltype(createAllocator()),
+            CreateAllocFunc,
+            CreateNodeFunc,
+            SetBoundsFunc,
+            CreateLeafFunc,
+            CalculateBoundsFunc,
+            ProgressMonitor> Builder;
+
+          Builder builder(createAllocator,
+                          createNode,
+                          setBounds,
+                          createLeaf,
+                          calculateBounds,
+                          progressMonitor,
+                          settings);
+
+          return builder.build(src,tmp,numPrimitives);
+        }
+    };
+  }
+}
@@ -3,6 +3,7 @@
 
 #include "bvh.h"
 #include "bvh_statistics.h"
+#include "../../common/algorithms/parallel_for.h"
 
 namespace embree
 {
@@ -10,7 +11,8 @@ namespace embree
   BVHN<N>::BVHN (const PrimitiveType& primTy, Scene* scene)
     : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : AccelData::TY_UNKNOWN),
       primTy(&primTy), device(scene->device), scene(scene),
-      root(emptyNode), alloc(scene->device,scene->isStaticAccel()), numPrimitives(0), numVertices(0)
+      root(emptyNode), alloc(scene->device,scene->isStaticAccel()), numPrimitives(0), numVertices(0),
+      mappedPtr(nullptr), mappedBytes(0)
   {
   }
 
@@ -19,6 +21,8 @@ namespace embree
   {
     for (size_t i=0; i<objects.size(); i++) 
       delete objects[i];
+    os_unmap_file(mappedPtr,mappedBytes);
+    clearReplicas();
   }
 
   template<int N>
@@ -26,11 +30,14 @@ namespace embree
   {
     set(BVHN::emptyNode,empty,0);
     alloc.clear();
+    os_unmap_file(mappedPtr,mappedBytes);
+    mappedPtr = nullptr; mappedBytes = 0;
   }
 
   template<int N>
   void BVHN<N>::set (NodeRef root, const LBBox3fa& bounds, size_t numPrimitives)
   {
+    clearReplicas();
     this->root = root;
     this->bounds = bounds;
     this->numPrimitives = numPrimitives;
@@ -109,6 +116,67 @@ namespace embree
     else return node;
   }
 
+  template<int N>
+  struct BVHNReplication
+  {
+    typedef typename BVHN<N>::NodeRef NodeRef;
+    typedef typename BVHN<N>::AABBNode AABBNode;
+
+    static size_t countNodes(NodeRef ref, size_t levels)
+    {
+      if (levels == 0 || !ref.isAABBNode()) return 0;
+      size_t num = 1;
+      for (size_t c=0; c<N; c++)
+        num += countNodes(ref.getAABBNode()->child(c),levels-1);
+      return num;
+    }
+
+    static NodeRef copyNodes(NodeRef ref, size_t levels, AABBNode*& dst)
+    {
+      if (levels == 0 || !ref.isAABBNode()) return ref;
+      AABBNode* node = dst++;
+      *node = *ref.getAABBNode();
+      for (size_t c=0; c<N; c++)
+        node->child(c) = copyNodes(node->child(c),levels-1,dst);
+      return BVHN<N>::encodeNode(node);
+    }
+  };
+
+  template<int N>
+  void BVHN<N>::replicateTopLevels()
+  {
+    clearReplicas();
+    const size_t levels = device->numa_replication_levels;
+    const size_t numNumaNodes = device->getNumNumaNodes();
+    if (levels == 0 || numNumaNodes <= 1 || !root.isAABBNode())
+      return;
+
+    const size_t bytes = BVHNReplication<N>::countNodes(root,levels)*sizeof(AABBNode);
+    device->memoryMonitor(numNumaNodes*bytes,false);
+    std::vector<NodeRef> roots(numNumaNodes);
+    numaReplicas.resize(numNumaNodes,std::make_pair((void*)nullptr,bytes));
+
+    /* the executing thread gets bound to the NUMA node while copying, such that the replica gets first touched there */
+    parallel_for(numNumaNodes, [&] (size_t i) {
+        NumaAffinity affinity(i);
+        numaReplicas[i].first = alignedMalloc(bytes,64);
+        AABBNode* dst = (AABBNode*) numaReplicas[i].first;
+        roots[i] = BVHNReplication<N>::copyNodes(root,levels,dst);
+      });
+    numaRoots = roots;
+  }
+
+  template<int N>
+  void BVHN<N>::clearReplicas()
+  {
+    numaRoots.clear();
+    for (auto& replica : numaReplicas) {
+      alignedFree(replica.first);
+      device->memoryMonitor(-ssize_t(replica.second),true);
+    }
+    numaReplicas.clear();
+  }
+
   template<int N>
   double BVHN<N>::preBuild(const std::string& builderName)
   {
@@ -131,6 +199,8 @@ namespace embree
   {
     if (t0 == double(inf))
       return;
+
+    replicateTopLevels();
     
     double dt = 0.0;
     if (device->benchmark || device->verbosity(2)) 
@@ -33,7 +33,8 @@ namespace embree
     BVH_AN1_UN1 = BVH_FLAG_ALIGNED_NODE | BVH_FLAG_UNALIGNED_NODE,
     BVH_AN2_UN2 = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB,
     BVH_AN2_AN4D_UN2 = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_ALIGNED_NODE_MB4D | BVH_FLAG_UNALIGNED_NODE_MB,
-    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE
+    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE,
+    BVH_AN1_QN1 = BVH_FLAG_ALIGNED_NODE | BVH_FLAG_QUANTIZED_NODE
   };
   
   /*! Multi BVH with N children. Each node stores the bounding box of
@@ -112,6 +113,19 @@ namespace embree
     
     /*! called by all builders after build ended */
     void postBuild(double t0);
+
+    /*! replicates the top levels of the BVH for each NUMA node */
+    void replicateTopLevels();
+
+    /*! frees all replicated top levels */
+    void clearReplicas();
+
+    /*! returns the root of the replica of the NUMA node the calling thread runs on */
+    __forceinline NodeRef getRoot() const
+    {
+      if (likely(numaRoots.empty())) return root;
+      return numaRoots[getNumaNode() % numaRoots.size()];
+    }
     
     /*! allocator class */
     struct Allocator {
@@ -228,6 +242,16 @@ namespace embree
   public:
     std::vector<BVHN*> objects;
     vector_t<char,aligned_allocator<char,32>> subdiv_patches;
+
+    /*! file mapping the BVH got loaded from */
+  public:
+    char* mappedPtr;
+    size_t mappedBytes;
+
+    /*! top levels replicated per NUMA node */
+  public:
+    std::vector<NodeRef> numaRoots;
+    std::vector<std::pair<void*,size_t>> numaReplicas;
   };
   
   typedef BVHN<4> BVH4;
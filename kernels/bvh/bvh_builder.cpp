@@ -22,7 +22,7 @@ namespace embree
 
 
     template<int N>
-    typename BVHN<N>::NodeRef BVHNBuilderQuantizedVirtual<N>::BVHNBuilderV::build(FastAllocator* allocator, BuildProgressMonitor& progressFunc, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings)
+    typename BVHN<N>::NodeRef BVHNBuilderQuantizedVirtual<N>::BVHNBuilderV::build(FastAllocator* allocator, BuildProgressMonitor& progressFunc, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings, size_t fullPrecisionLevels)
     {
       auto createLeafFunc = [&] (const PrimRef* prims, const range<size_t>& set, const Allocator& alloc) -> NodeRef {
         return createLeaf(prims,set,alloc);
@@ -30,8 +30,12 @@ namespace embree
             
       settings.branchingFactor = N;
       settings.maxDepth = BVH::maxBuildDepthLeaf;
-      return BVHBuilderBinnedSAH::build<NodeRef>
-        (FastAllocator::Create(allocator),typename BVH::QuantizedNode::Create2(),typename BVH::QuantizedNode::Set2(),createLeafFunc,progressFunc,prims,pinfo,settings);
+      if (fullPrecisionLevels == 0)
+        return BVHBuilderBinnedSAH::build<NodeRef>
+          (FastAllocator::Create(allocator),typename BVH::QuantizedNode::Create2(),typename BVH::QuantizedNode::Set2(),createLeafFunc,progressFunc,prims,pinfo,settings);
+      else
+        return BVHBuilderBinnedSAH::build<NodeRef>
+          (FastAllocator::Create(allocator),CreateHybrid(fullPrecisionLevels),SetHybrid(),createLeafFunc,progressFunc,prims,pinfo,settings);
     }
 
     template<int N>
@@ -52,9 +52,42 @@ namespace embree
         typedef BVHN<N> BVH;
         typedef typename BVH::NodeRef NodeRef;
         typedef FastAllocator::CachedAllocator Allocator;
-      
+        typedef typename BVH::AABBNode AABBNode;
+        typedef typename BVH::QuantizedNode QuantizedNode;
+
+        /*! creates full precision nodes for the top levels and quantized nodes below */
+        struct CreateHybrid
+        {
+          CreateHybrid (size_t fullPrecisionLevels)
+            : fullPrecisionLevels(fullPrecisionLevels) {}
+
+          template<typename BuildRecord>
+          __forceinline NodeRef operator() (BuildRecord* children, const size_t num, const Allocator& alloc) const
+          {
+            /* children of the root have depth 2 */
+            if (children[0].depth <= fullPrecisionLevels+1)
+              return typename AABBNode::Create2()(children,num,alloc);
+            else
+              return typename QuantizedNode::Create2()(children,num,alloc);
+          }
+
+          size_t fullPrecisionLevels;
+        };
+
+        struct SetHybrid
+        {
+          template<typename BuildRecord>
+          __forceinline NodeRef operator() (const BuildRecord& precord, const BuildRecord* crecords, NodeRef ref, NodeRef* children, const size_t num) const
+          {
+            if (ref.isAABBNode())
+              return typename AABBNode::Set2()(precord,crecords,ref,children,num);
+            else
+              return typename QuantizedNode::Set2()(precord,crecords,ref,children,num);
+          }
+        };
+
         struct BVHNBuilderV {
-          NodeRef build(FastAllocator* allocator, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings);
+          NodeRef build(FastAllocator* allocator, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings, size_t fullPrecisionLevels);
           virtual NodeRef createLeaf (const PrimRef* prims, const range<size_t>& set, const Allocator& alloc) = 0;
         };
 
@@ -72,9 +105,10 @@ namespace embree
           CreateLeafFunc createLeafFunc;
         };
 
+        /*! builds a quantized BVH, the first fullPrecisionLevels levels of the tree use full precision nodes */
         template<typename CreateLeafFunc>
-        static NodeRef build(FastAllocator* allocator, CreateLeafFunc createLeaf, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings) {
-          return BVHNBuilderT<CreateLeafFunc>(createLeaf).build(allocator,progress,prims,pinfo,settings);
+        static NodeRef build(FastAllocator* allocator, CreateLeafFunc createLeaf, BuildProgressMonitor& progress, PrimRef* prims, const PrimInfo& pinfo, GeneralBVHBuilder::Settings settings, size_t fullPrecisionLevels = 0) {
+          return BVHNBuilderT<CreateLeafFunc>(createLeaf).build(allocator,progress,prims,pinfo,settings,fullPrecisionLevels);
         }
       };
 
@@ -0,0 +1,214 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bvh.h"
+#include "bvh_builder.h"
+#include "../builders/primrefgen.h"
+#include "../builders/bvh_builder_ploc.h"
+
+#include "../geometry/triangle.h"
+#include "../geometry/trianglev.h"
+#include "../geometry/trianglei.h"
+#include "../geometry/quadv.h"
+#include "../geometry/quadi.h"
+#include "../geometry/object.h"
+#include "../geometry/instance.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int N, typename Primitive>
+    struct BVHNBuilderPLOC : public Builder
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::AABBNode AABBNode;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::NodeRecord NodeRecord;
+      typedef BVHBuilderMorton::BuildPrim BuildPrim;
+
+      /*! leaves get filled from a local copy of their primitive references */
+      static const size_t MAX_LEAF_SIZE = 4*BVH::maxLeafBlocks;
+
+      BVH* bvh;
+      Scene* scene;
+      Geometry* mesh;
+      mvector<PrimRef> prims;
+      mvector<BuildPrim> morton;
+      BVHBuilderPLOC::Settings settings;
+      Geometry::GTypeMask gtype_;
+      unsigned int geomID_ = std::numeric_limits<unsigned int>::max();
+      unsigned int numPreviousPrimitives = 0;
+
+      BVHNBuilderPLOC (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const Geometry::GTypeMask gtype)
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0), morton(scene->device,0),
+          settings(N,BVH::maxBuildDepth,sahBlockSize,minLeafSize,min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks,size_t(MAX_LEAF_SIZE)),travCost,intCost,DEFAULT_SINGLE_THREAD_THRESHOLD), gtype_(gtype) {}
+
+      BVHNBuilderPLOC (BVH* bvh, Geometry* mesh, unsigned int geomID, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const Geometry::GTypeMask gtype)
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), morton(bvh->device,0),
+          settings(N,BVH::maxBuildDepth,sahBlockSize,minLeafSize,min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks,size_t(MAX_LEAF_SIZE)),travCost,intCost,DEFAULT_SINGLE_THREAD_THRESHOLD), gtype_(gtype), geomID_(geomID) {}
+
+      void build()
+      {
+        /* we reset the allocator when the mesh size changed */
+        if (mesh && mesh->numPrimitives != numPreviousPrimitives) {
+          bvh->alloc.clear();
+        }
+
+        /* skip build for empty scene */
+        const size_t numPrimitives = mesh ? mesh->size() : scene->getNumPrimitives(gtype_,false);
+        numPreviousPrimitives = numPrimitives;
+        if (numPrimitives == 0) {
+          bvh->clear();
+          clear();
+          return;
+        }
+
+        double t0 = bvh->preBuild(mesh ? "" : TOSTRING(isa) "::BVH" + toString(N) + "BuilderPLOC");
+
+        /* enable os_malloc for two level build */
+        if (mesh)
+          bvh->alloc.setOSallocation(true);
+
+        /* initialize allocator */
+        const size_t node_bytes = numPrimitives*sizeof(AABBNode)/(4*N);
+        const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
+        bvh->alloc.init_estimate(node_bytes+leaf_bytes);
+        settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+        prims.resize(numPrimitives);
+
+        const PrimInfo pinfo = mesh ?
+          createPrimRefArray(mesh,geomID_,numPrimitives,prims,bvh->scene->progressInterface) :
+          createPrimRefArray(scene,gtype_,false,numPrimitives,prims,bvh->scene->progressInterface);
+
+        /* pinfo might has zero size due to invalid geometry */
+        if (unlikely(pinfo.size() == 0))
+        {
+          bvh->clear();
+          clear();
+          return;
+        }
+
+        /* compute morton codes, the second half of the array is temporary memory for sorting */
+        const size_t numPrims = pinfo.size();
+        morton.resize(2*numPrims);
+        BVHBuilderMorton::MortonCodeMapping mapping(pinfo.centBounds);
+        parallel_for(size_t(0), numPrims, size_t(1024), [&] (const range<size_t>& r) {
+            BVHBuilderMorton::MortonCodeGenerator generator(mapping,&morton[r.begin()]);
+            for (size_t i=r.begin(); i<r.end(); i++)
+              generator(prims[i].bounds(),(unsigned) i);
+          });
+
+        /* create leaves from the referenced primitives */
+        auto createLeaf = [&] (const range<unsigned>& current, const FastAllocator::CachedAllocator& alloc) -> NodeRecord
+        {
+          PrimRef local[MAX_LEAF_SIZE];
+          BBox3fa bounds = empty;
+          const size_t n = current.size();
+          assert(n <= MAX_LEAF_SIZE);
+          for (size_t i=0; i<n; i++) {
+            local[i] = prims[morton[current.begin()+i].index];
+            bounds.extend(local[i].bounds());
+          }
+
+          const size_t items = Primitive::blocks(n);
+          Primitive* accel = (Primitive*) alloc.malloc1(items*sizeof(Primitive),BVH::byteAlignment);
+          NodeRef node = BVH::encodeLeaf((char*)accel,items);
+          size_t start = 0;
+          for (size_t i=0; i<items; i++)
+            accel[i].fill(local,start,n,bvh->scene);
+          return NodeRecord(node,bounds);
+        };
+
+        /* sets children and bounds of a node */
+        auto setBounds = [&] (NodeRef ref, const NodeRecord* children, size_t num) -> NodeRecord
+        {
+          AABBNode* node = ref.getAABBNode();
+          BBox3fa bounds = empty;
+          for (size_t i=0; i<num; i++) {
+            node->setRef(i,children[i].ref);
+            node->setBounds(i,children[i].bounds);
+            bounds.extend(children[i].bounds);
+          }
+          return NodeRecord(ref,bounds);
+        };
+
+        auto calculateBounds = [&] (const BuildPrim& p) -> BBox3fa {
+          return prims[p.index].bounds();
+        };
+
+        /* call BVH builder */
+        NodeRecord root = BVHBuilderPLOC::build<NodeRecord>(
+          typename BVH::CreateAlloc(bvh),
+          typename AABBNode::Create(),
+          setBounds,createLeaf,calculateBounds,bvh->scene->progressInterface,
+          morton.data(),morton.data()+numPrims,numPrims,settings);
+
+        bvh->set(root.ref,LBBox3fa(pinfo.geomBounds),numPrims);
+        bvh->layoutLargeNodes(size_t(numPrims*0.005f));
+
+        /* clear temporary data for static geometry */
+        morton.clear();
+        if (scene && scene->isStaticAccel()) {
+          prims.clear();
+        }
+        bvh->cleanup();
+        bvh->postBuild(t0);
+      }
+
+      void clear() {
+        prims.clear();
+        morton.clear();
+      }
+    };
+
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
+    /************************************************************************************/
+
+#if defined(EMBREE_GEOMETRY_TRIANGLE)
+    Builder* BVH4Triangle4SceneBuilderPLOC  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderPLOC<4,Triangle4> ((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH4Triangle4vSceneBuilderPLOC (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderPLOC<4,Triangle4v>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH4Triangle4iSceneBuilderPLOC (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderPLOC<4,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+
+    Builder* BVH4Triangle4MeshBuilderPLOC  (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<4,Triangle4> ((BVH4*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH4Triangle4vMeshBuilderPLOC (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<4,Triangle4v>((BVH4*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH4Triangle4iMeshBuilderPLOC (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<4,Triangle4i>((BVH4*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
+
+#if defined(__AVX__)
+    Builder* BVH8Triangle4SceneBuilderPLOC  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderPLOC<8,Triangle4> ((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH8Triangle4vSceneBuilderPLOC (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderPLOC<8,Triangle4v>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH8Triangle4iSceneBuilderPLOC (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderPLOC<8,Triangle4i>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+
+    Builder* BVH8Triangle4MeshBuilderPLOC  (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<8,Triangle4> ((BVH8*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH8Triangle4vMeshBuilderPLOC (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<8,Triangle4v>((BVH8*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH8Triangle4iMeshBuilderPLOC (void* bvh, TriangleMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<8,Triangle4i>((BVH8*)bvh,mesh,geomID,4,1.0f,4,inf,TriangleMesh::geom_type); }
+#endif
+#endif
+
+#if defined(EMBREE_GEOMETRY_QUAD)
+    Builder* BVH4Quad4vSceneBuilderPLOC (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderPLOC<4,Quad4v>((BVH4*)bvh,scene,4,1.0f,4,inf,QuadMesh::geom_type); }
+    Builder* BVH4Quad4vMeshBuilderPLOC  (void* bvh, QuadMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<4,Quad4v>((BVH4*)bvh,mesh,geomID,4,1.0f,4,inf,QuadMesh::geom_type); }
+#if defined(__AVX__)
+    Builder* BVH8Quad4vSceneBuilderPLOC (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderPLOC<8,Quad4v>((BVH8*)bvh,scene,4,1.0f,4,inf,QuadMesh::geom_type); }
+    Builder* BVH8Quad4vMeshBuilderPLOC  (void* bvh, QuadMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<8,Quad4v>((BVH8*)bvh,mesh,geomID,4,1.0f,4,inf,QuadMesh::geom_type); }
+    Builder* BVH8Quad4iMeshBuilderPLOC  (void* bvh, QuadMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<8,Quad4i>((BVH8*)bvh,mesh,geomID,4,1.0f,4,inf,QuadMesh::geom_type); }
+#endif
+#endif
+
+#if defined(EMBREE_GEOMETRY_USER)
+    Builder* BVH4VirtualMeshBuilderPLOC (void* bvh, UserGeometry* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<4,Object>((BVH4*)bvh,mesh,geomID,4,1.0f,1,inf,UserGeometry::geom_type); }
+#if defined(__AVX__)
+    Builder* BVH8VirtualMeshBuilderPLOC (void* bvh, UserGeometry* mesh, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<8,Object>((BVH8*)bvh,mesh,geomID,8,1.0f,1,inf,UserGeometry::geom_type); }
+#endif
+#endif
+
+#if defined(EMBREE_GEOMETRY_INSTANCE)
+    Builder* BVH4InstanceMeshBuilderPLOC (void* bvh, Instance* mesh, Geometry::GTypeMask gtype, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<4,InstancePrimitive>((BVH4*)bvh,mesh,geomID,4,1.0f,1,inf,gtype); }
+#if defined(__AVX__)
+    Builder* BVH8InstanceMeshBuilderPLOC (void* bvh, Instance* mesh, Geometry::GTypeMask gtype, unsigned int geomID, size_t mode) { return new BVHNBuilderPLOC<8,InstancePrimitive>((BVH8*)bvh,mesh,geomID,8,1.0f,1,inf,gtype); }
+#endif
+#endif
+  }
+}
@@ -67,13 +67,21 @@ namespace embree
             const unsigned ly0 = y, ly1 = min(ly0+SUBGRID-1,y1);
             BBox3fa bounds;
             GridSOA* leaf = GridSOA::create(&patch,1,lx0,lx1,ly0,ly1,scene,alloc,&bounds);
-            *prims = PrimRef(bounds,BVH4::encodeTypedLeaf(leaf,1)); prims++;
+            *prims = PrimRef(bounds,BVH4::encodeTypedLeaf(leaf,SubdivPatch1::GRID_LEAF)); prims++;
             NN++;
           }
         }
         return NN;
       }
 
+      /* the grid of a lazy patch gets built when traversal reaches the patch for the first time, thus only its bounds are calculated here */
+      __forceinline static PrimRef createLazy(SubdivPatch1& patch, SubdivMesh* mesh, size_t leafType)
+      {
+        const unsigned width = patch.grid_u_res, height = patch.grid_v_res;
+        const BBox3fa bounds = evalGridBounds(patch,0,width-1,0,height-1,width,height,mesh);
+        return PrimRef(bounds,BVH4::encodeTypedLeaf(&patch,leafType));
+      }
+
       void build() 
       {
         /* skip build for empty scene */
@@ -86,6 +94,10 @@ namespace embree
  
         double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "SubdivPatch1BuilderSAH");
 
+        /* lazy patches are stored in the BVH and their grids get built during traversal */
+        const int lazyBuild = scene->device->subdiv_lazy_build;
+        const size_t lazyLeafType = lazyBuild == 2 ? SubdivPatch1::LAZY_CACHED_LEAF : SubdivPatch1::LAZY_LEAF;
+
         //bvh->alloc.reset();
         bvh->alloc.init_estimate(numPrimitives*sizeof(PrimRef));
 
@@ -108,7 +120,7 @@ namespace embree
             {
               float level[4]; SubdivPatch1Base::computeEdgeLevels(edge_level,subdiv,level);
               Vec2i grid = SubdivPatch1Base::computeGridSize(level);
-              size_t num = getNumEagerLeaves(grid.x,grid.y);
+              size_t num = lazyBuild ? 1 : getNumEagerLeaves(grid.x,grid.y);
               g+=num;
               p++;
             });
@@ -127,6 +139,9 @@ namespace embree
           return;
         }
 
+        bvh->subdiv_patches.resize(lazyBuild ? sizeof(SubdivPatch1) * numSubPatches : 0);
+        SubdivPatch1* const subdiv_patches = (SubdivPatch1*) bvh->subdiv_patches.data();
+
         PrimInfo pinfo3 = parallel_for_for_prefix_sum1( pstate, iter, PrimInfo(empty), [&](SubdivMesh* mesh, const range<size_t>& r, size_t k, size_t geomID, const PrimInfo& base) -> PrimInfo
         {
           Allocator alloc = bvh->alloc.getCachedAllocator();
@@ -137,6 +152,15 @@ namespace embree
             
             patch_eval_subdivision(mesh->getHalfEdge(0,f),[&](const Vec2f uv[4], const int subdiv[4], const float edge_level[4], int subPatch)
             {
+              if (lazyBuild)
+              {
+                SubdivPatch1* patch = new (&subdiv_patches[base.begin+s.begin]) SubdivPatch1(unsigned(geomID),unsigned(f),subPatch,mesh,0,uv,edge_level,subdiv,VSIZEX);
+                prims[base.end+s.end] = createLazy(*patch,mesh,lazyLeafType);
+                s.add_center2(prims[base.end+s.end]);
+                s.begin++;
+                return;
+              }
+
               SubdivPatch1Base patch(unsigned(geomID),unsigned(f),subPatch,mesh,0,uv,edge_level,subdiv,VSIZEX);
               size_t num = createEager(patch,scene,mesh,unsigned(f),alloc,&prims[base.end+s.end]);
               assert(num == getNumEagerLeaves(patch.grid_u_res,patch.grid_v_res));
@@ -4,6 +4,7 @@
 #include "bvh_builder_twolevel.h"
 #include "bvh_statistics.h"
 #include "../builders/bvh_builder_sah.h"
+#include "../../common/algorithms/parallel_any_of.h"
 #include "../common/scene_line_segments.h"
 #include "../common/scene_triangle_mesh.h"
 #include "../common/scene_quad_mesh.h"
@@ -15,8 +16,8 @@ namespace embree
   namespace isa
   {
     template<int N, typename Mesh, typename Primitive>
-    BVHNBuilderTwoLevel<N,Mesh,Primitive>::BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, Geometry::GTypeMask gtype, bool useMortonBuilder, const size_t singleThreadThreshold)
-      : bvh(bvh), scene(scene), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold), gtype(gtype), useMortonBuilder_(useMortonBuilder) {}
+    BVHNBuilderTwoLevel<N,Mesh,Primitive>::BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, Geometry::GTypeMask gtype, bool useMortonBuilder, bool quantized, const size_t singleThreadThreshold)
+      : bvh(bvh), scene(scene), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold), gtype(gtype), useMortonBuilder_(useMortonBuilder), quantized_(quantized) {}
     
     template<int N, typename Mesh, typename Primitive>
     BVHNBuilderTwoLevel<N,Mesh,Primitive>::~BVHNBuilderTwoLevel () {
@@ -39,6 +40,11 @@ namespace embree
             }
           });
       }
+
+      /* update BVH in place if only some objects got modified */
+      if (scene->device->twolevel_refit && refit())
+        return;
+      objectStates.clear();
       
 #if PROFILE
       while(1) 
@@ -110,6 +116,12 @@ namespace embree
       /* fast path for single geometry scenes */
       if (nextRef == 1) { 
         bvh->set(refs[0].node,LBBox3fa(refs[0].bounds()),numPrimitives);
+#if ENABLE_DIRECT_SAH_MERGE_BUILDER
+        topLeaves.resize(1);
+        topLeaves[0] = TopLeaf(refs[0].node,refs[0].geomID(),refs[0].bounds());
+        numTopLeaves.store(1);
+        recordBuild();
+#endif
       }
 
       else
@@ -174,6 +186,8 @@ namespace embree
 #if ENABLE_DIRECT_SAH_MERGE_BUILDER
             
             refs.resize(extSize); 
+            topLeaves.resize(extSize);
+            numTopLeaves.store(0);
          
             NodeRef root = BVHBuilderBinnedOpenMergeSAH::build<NodeRef,BuildRef>(
               typename BVH::CreateAlloc(bvh),
@@ -182,7 +196,9 @@ namespace embree
               
               [&] (const BuildRef* refs, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> NodeRef  {
                 assert(range.size() == 1);
-                return (NodeRef) refs[range.begin()].node;
+                const BuildRef& ref = refs[range.begin()];
+                topLeaves[numTopLeaves++] = TopLeaf(ref.node,ref.geomID(),ref.bounds());
+                return (NodeRef) ref.node;
               },
               [&] (BuildRef &bref, BuildRef *refs) -> size_t { 
                 return openBuildRef(bref,refs);
@@ -205,6 +221,9 @@ namespace embree
 
             
             bvh->set(root,LBBox3fa(pinfo.geomBounds),numPrimitives);
+#if ENABLE_DIRECT_SAH_MERGE_BUILDER
+            recordBuild();
+#endif
           }
         }
       }  
@@ -219,9 +238,130 @@ namespace embree
 
     }
     
+    template<int N, typename Mesh, typename Primitive>
+    bool BVHNBuilderTwoLevel<N,Mesh,Primitive>::refit()
+    {
+      const size_t num = scene->size();
+
+      /* object BVHs with quantized nodes cannot get refitted, thus the top level gets always rebuilt */
+      if (objectStates.size() != num || useMortonBuilder_ || quantized_)
+        return false;
+
+      /* the set of objects has to be unchanged and modified large objects have to keep their topology */
+      const bool changed = parallel_any_of(size_t(0), num, [&] (size_t objectID) -> bool
+      {
+        Mesh* mesh = scene->getSafe<Mesh>(objectID);
+        const ObjectState& state = objectStates[objectID];
+        if (mesh != state.mesh) return true;
+        if (mesh == nullptr) return false;
+        if (mesh->isEnabled() != state.enabled) return true;
+        if (!isGeometryModified(objectID)) return false;
+        if (mesh->numTimeSteps != 1 || mesh->size() != state.numPrimitives) return true;
+        if (isSmallGeometry(mesh)) return false;
+        return mesh->quality != RTC_BUILD_QUALITY_REFIT || state.quality != RTC_BUILD_QUALITY_REFIT || mesh->topologyChanged(state.topologyVersion);
+      });
+      if (changed) return false;
+
+      double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "BuilderTwoLevelRefit");
+
+      /* refit modified objects */
+      const bool objectFailed = parallel_any_of(size_t(0), num, [&] (size_t objectID) -> bool
+      {
+        const ObjectState& state = objectStates[objectID];
+        if (state.mesh == nullptr || !state.enabled || !isGeometryModified(objectID)) return false;
+        if (!builders[objectID]->refit()) return true;
+        return !isSmallGeometry(state.mesh) && getBVH(objectID)->getBounds().empty() == state.attached;
+      });
+      if (objectFailed) return false;
+
+      /* update bounds of toplevel leaves of modified objects */
+      const bool leafFailed = parallel_any_of(size_t(0), size_t(numTopLeaves), [&] (size_t i) -> bool
+      {
+        TopLeaf& leaf = topLeaves[i];
+        if (!isGeometryModified(leaf.geomID)) return false;
+
+        Mesh* mesh = getMesh(leaf.geomID);
+        if (isSmallGeometry(mesh)) {
+          size_t n; char* prims = leaf.node.leaf(n);
+          leaf.bounds = empty;
+          for (size_t j=0; j<n; j++)
+            leaf.bounds.extend(((Primitive*)prims)[j].update(mesh));
+        }
+        else if (leaf.node.isAABBNode())
+          leaf.bounds = leaf.node.getAABBNode()->bounds();
+        else if (leaf.node == getBVH(leaf.geomID)->root)
+          leaf.bounds = getBVH(leaf.geomID)->getBounds();
+        else
+          return true;
+        return false;
+      });
+      if (leafFailed) return false;
+
+      /* refit toplevel nodes and fall back to a full rebuild if the SAH cost degraded too much */
+      BBox3fa bounds;
+      const float cost = refitTopLevel(bvh->root,true,bounds);
+      if (cost > scene->device->twolevel_refit_threshold*buildCost*halfArea(bounds))
+        return false;
+
+      bvh->set(bvh->root,LBBox3fa(bounds),bvh->numPrimitives);
+      bvh->postBuild(t0);
+      return true;
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    void BVHNBuilderTwoLevel<N,Mesh,Primitive>::recordBuild()
+    {
+      topLeafIndex.clear();
+      for (size_t i=0; i<numTopLeaves; i++)
+        topLeafIndex[(size_t)topLeaves[i].node] = i;
+
+      BBox3fa bounds;
+      const float cost = refitTopLevel(bvh->root,false,bounds);
+      buildCost = halfArea(bounds) > 0.0f ? cost/halfArea(bounds) : 0.0f;
+
+      const size_t num = scene->size();
+      objectStates.resize(num);
+      parallel_for(num, [&] (size_t objectID)
+      {
+        Mesh* mesh = scene->getSafe<Mesh>(objectID);
+        ObjectState& state = objectStates[objectID];
+        state.mesh = mesh;
+        if (mesh == nullptr) return;
+        state.numPrimitives = mesh->size();
+        state.enabled = mesh->isEnabled();
+        state.quality = mesh->quality;
+        state.topologyVersion = mesh->getTopologyVersion();
+        state.attached = mesh->numTimeSteps == 1 && (isSmallGeometry(mesh) || !getBVH(objectID)->getBounds().empty());
+      });
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    float BVHNBuilderTwoLevel<N,Mesh,Primitive>::refitTopLevel(NodeRef ref, bool update, BBox3fa& bounds)
+    {
+      auto leaf = topLeafIndex.find((size_t)ref);
+      if (leaf != topLeafIndex.end()) {
+        bounds = topLeaves[leaf->second].bounds;
+        return 0.0f;
+      }
+
+      AABBNode* node = ref.getAABBNode();
+      float cost = 0.0f;
+      bounds = empty;
+      for (size_t i=0; i<N; i++)
+      {
+        if (node->child(i) == BVH::emptyNode) continue;
+        BBox3fa childBounds;
+        cost += refitTopLevel(node->child(i),update,childBounds);
+        if (update) node->setBounds(i,childBounds);
+        bounds.extend(childBounds);
+      }
+      return cost + halfArea(bounds);
+    }
+    
     template<int N, typename Mesh, typename Primitive>
     void BVHNBuilderTwoLevel<N,Mesh,Primitive>::deleteGeometry(size_t geomID)
     {
+      objectStates.clear();
       if (geomID >= bvh->objects.size()) return;
       if (builders[geomID]) builders[geomID].reset();
       delete bvh->objects [geomID]; bvh->objects [geomID] = nullptr;
@@ -237,6 +377,7 @@ namespace embree
         if (builders[i]) builders[i].reset();
 
       refs.clear();
+      objectStates.clear();
     }
 
     template<int N, typename Mesh, typename Primitive>
@@ -264,10 +405,11 @@ namespace embree
         if (ref.isLeaf()) break;
         refs.pop_back();    
         
-        AABBNode* node = ref.getAABBNode();
+        BaseNode* node = ref.baseNode();
         for (size_t i=0; i<N; i++) {
           if (node->child(i) == BVH::emptyNode) continue;
-          refs.push_back(BuildRef(node->bounds(i),node->child(i)));
+          const BBox3fa bounds = ref.isAABBNode() ? ref.getAABBNode()->bounds(i) : ref.quantizedNode()->bounds(i);
+          refs.push_back(BuildRef(bounds,node->child(i)));
          
 #if 1
           NodeRef ref_pre = node->child(i);
@@ -344,12 +486,21 @@ namespace embree
     Builder* BVH8BuilderTwoLevelTriangle4iMeshSAH (void* bvh, Scene* scene, bool useMortonBuilder) {
       return new BVHNBuilderTwoLevel<8,TriangleMesh,Triangle4i>((BVH8*)bvh,scene,TriangleMesh::geom_type,useMortonBuilder);
     }
+    Builder* BVH8BuilderTwoLevelQuantizedTriangle4MeshSAH (void* bvh, Scene* scene, bool useMortonBuilder) {
+      return new BVHNBuilderTwoLevel<8,TriangleMesh,Triangle4>((BVH8*)bvh,scene,TriangleMesh::geom_type,useMortonBuilder,true);
+    }
+    Builder* BVH8BuilderTwoLevelQuantizedTriangle4iMeshSAH (void* bvh, Scene* scene, bool useMortonBuilder) {
+      return new BVHNBuilderTwoLevel<8,TriangleMesh,Triangle4i>((BVH8*)bvh,scene,TriangleMesh::geom_type,useMortonBuilder,true);
+    }
 #endif
 
 #if defined(EMBREE_GEOMETRY_QUAD)
     Builder* BVH8BuilderTwoLevelQuadMeshSAH (void* bvh, Scene* scene, bool useMortonBuilder) {
       return new BVHNBuilderTwoLevel<8,QuadMesh,Quad4v>((BVH8*)bvh,scene,QuadMesh::geom_type,useMortonBuilder);
     }
+    Builder* BVH8BuilderTwoLevelQuantizedQuad4iMeshSAH (void* bvh, Scene* scene, bool useMortonBuilder) {
+      return new BVHNBuilderTwoLevel<8,QuadMesh,Quad4i>((BVH8*)bvh,scene,QuadMesh::geom_type,useMortonBuilder,true);
+    }
 #endif
 
 #if defined(EMBREE_GEOMETRY_USER)
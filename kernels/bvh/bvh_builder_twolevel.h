@@ -4,9 +4,11 @@
 #pragma once
 
 #include <type_traits>
+#include <unordered_map>
 
 #include "bvh_builder_twolevel_internal.h"
 #include "bvh.h"
+#include "bvh_refit.h"
 #include "../common/primref.h"
 #include "../builders/priminfo.h"
 #include "../builders/primrefgen.h"
@@ -27,6 +29,7 @@ namespace embree
     {
       typedef BVHN<N> BVH;
       typedef typename BVH::AABBNode AABBNode;
+      typedef typename BVH::BaseNode BaseNode;
       typedef typename BVH::NodeRef NodeRef;
 
       __forceinline static bool isSmallGeometry(Mesh* mesh) {
@@ -91,11 +94,12 @@ namespace embree
         NodeRef ref = bref.node;
         unsigned int geomID   = bref.geomID();
         unsigned int numPrims = max((unsigned int)bref.numPrimitives() / N,(unsigned int)1);
-        AABBNode* node = ref.getAABBNode();
         size_t n = 0;
         for (size_t i=0; i<N; i++) {
-          if (node->child(i) == BVH::emptyNode) continue;
-          refs[i] = BuildRef(node->bounds(i),node->child(i),geomID,numPrims);
+          NodeRef child = ref.baseNode()->child(i);
+          if (child == BVH::emptyNode) continue;
+          const BBox3fa bounds = ref.isAABBNode() ? ref.getAABBNode()->bounds(i) : ref.quantizedNode()->bounds(i);
+          refs[i] = BuildRef(bounds,child,geomID,numPrims);
           n++;
         }
         assert(n > 1);
@@ -103,7 +107,7 @@ namespace embree
       }
       
       /*! Constructor. */
-      BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, Geometry::GTypeMask gtype = Mesh::geom_type, bool useMortonBuilder = false, const size_t singleThreadThreshold = DEFAULT_SINGLE_THREAD_THRESHOLD);
+      BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, Geometry::GTypeMask gtype = Mesh::geom_type, bool useMortonBuilder = false, bool quantized = false, const size_t singleThreadThreshold = DEFAULT_SINGLE_THREAD_THRESHOLD);
       
       /*! Destructor */
       ~BVHNBuilderTwoLevel ();
@@ -117,11 +121,44 @@ namespace embree
       
     private:
 
+      /*! leaf of the toplevel BVH, remembered for incremental updates */
+      struct TopLeaf
+      {
+        __forceinline TopLeaf () {}
+        __forceinline TopLeaf (NodeRef node, unsigned int geomID, const BBox3fa& bounds)
+          : node(node), geomID(geomID), bounds(bounds) {}
+
+        NodeRef node;
+        unsigned int geomID;
+        BBox3fa bounds;
+      };
+
+      /*! state of an object at the last full build */
+      struct ObjectState
+      {
+        Mesh* mesh;
+        size_t numPrimitives;
+        bool enabled;
+        bool attached;
+        RTCBuildQuality quality;
+        unsigned int topologyVersion;
+      };
+
+      /*! updates the BVH in place if only few objects changed, returns false if a full rebuild is required */
+      bool refit();
+
+      /*! remembers leaves and objects after a full build */
+      void recordBuild();
+
+      /*! refits (or just measures) the toplevel nodes above the toplevel leaves, returns their summed surface area */
+      float refitTopLevel(NodeRef ref, bool update, BBox3fa& bounds);
+
       class RefBuilderBase {
       public:
         virtual ~RefBuilderBase () {}
         virtual void attachBuildRefs (BVHNBuilderTwoLevel* builder) = 0;
         virtual bool meshQualityChanged (RTCBuildQuality currQuality) = 0;
+        virtual bool refit () = 0;
       };
 
       class RefBuilderSmall : public RefBuilderBase {
@@ -159,6 +196,10 @@ namespace embree
         bool meshQualityChanged (RTCBuildQuality /*currQuality*/) {
           return false;
         }
+
+        bool refit () {
+          return true; // leaves get updated in place through the toplevel leaves
+        }
         
         size_t  objectID_;
       };
@@ -193,6 +234,15 @@ namespace embree
           return currQuality != quality_;
         }
 
+        bool refit ()
+        {
+          /* only the refit builder keeps the nodes referenced by the toplevel BVH, unless it restructured them */
+          if (quality_ != RTC_BUILD_QUALITY_REFIT) return false;
+          builder_->build();
+          BVHNRefitT<N,Mesh,Primitive>* refitter = dynamic_cast<BVHNRefitT<N,Mesh,Primitive>*>(builder_.ptr);
+          return refitter && !refitter->topologyChanged();
+        }
+
       private:
         size_t          objectID_;
         Ref<Builder>    builder_;
@@ -244,7 +294,7 @@ namespace embree
           return;
         }
 
-        __internal_two_level_builder__::MeshBuilder<N,Mesh,Primitive>()(accel, mesh, geomID, this->gtype, this->useMortonBuilder_, builder);
+        __internal_two_level_builder__::MeshBuilder<N,Mesh,Primitive>()(accel, mesh, geomID, this->gtype, this->useMortonBuilder_, this->quantized_, builder);
       }      
 
       using BuilderList = std::vector<std::unique_ptr<RefBuilderBase>>;
@@ -258,6 +308,13 @@ namespace embree
       const size_t        singleThreadThreshold;
       Geometry::GTypeMask gtype;
       bool                useMortonBuilder_ = false;
+      bool                quantized_ = false;   //!< build quantized BVHs for objects
+
+      std::vector<ObjectState> objectStates;            //!< objects at the last full build
+      avector<TopLeaf>         topLeaves;               //!< toplevel leaves of the last full build
+      std::atomic<size_t>      numTopLeaves;
+      std::unordered_map<size_t,size_t> topLeafIndex;   //!< maps toplevel leaves to their index in topLeaves
+      float                    buildCost = 0.0f;        //!< relative SAH cost of the toplevel BVH after the last full build
     };
   }
 }
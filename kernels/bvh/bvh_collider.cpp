@@ -70,43 +70,6 @@ namespace embree
       return movemask((lower_x <= upper_x) & (lower_y <= upper_y) & (lower_z <= upper_z));
     }
 
-    bool intersect_triangle_triangle (Scene* scene0, unsigned geomID0, unsigned primID0, Scene* scene1, unsigned geomID1, unsigned primID1)
-    {
-      CSTAT(bvh_collide_prim_intersections1++);
-      const TriangleMesh* mesh0 = scene0->get<TriangleMesh>(geomID0);
-      const TriangleMesh* mesh1 = scene1->get<TriangleMesh>(geomID1);
-      const TriangleMesh::Triangle& tri0 = mesh0->triangle(primID0);
-      const TriangleMesh::Triangle& tri1 = mesh1->triangle(primID1);
-      
-      /* special culling for scene intersection with itself */
-      if (scene0 == scene1 && geomID0 == geomID1)
-      {
-        /* ignore self intersections */
-        if (primID0 == primID1)
-          return false;
-      }
-      CSTAT(bvh_collide_prim_intersections2++);
-      
-      if (scene0 == scene1 && geomID0 == geomID1)
-      {
-        /* ignore intersection with topological neighbors */
-        const vint4 t0(tri0.v[0],tri0.v[1],tri0.v[2],tri0.v[2]);
-        if (any(vint4(tri1.v[0]) == t0)) return false;
-        if (any(vint4(tri1.v[1]) == t0)) return false;
-        if (any(vint4(tri1.v[2]) == t0)) return false;
-      }
-      CSTAT(bvh_collide_prim_intersections3++);
-      
-      const Vec3fa a0 = mesh0->vertex(tri0.v[0]);
-      const Vec3fa a1 = mesh0->vertex(tri0.v[1]);
-      const Vec3fa a2 = mesh0->vertex(tri0.v[2]);
-      const Vec3fa b0 = mesh1->vertex(tri1.v[0]);
-      const Vec3fa b1 = mesh1->vertex(tri1.v[1]);
-      const Vec3fa b2 = mesh1->vertex(tri1.v[2]);
-      
-      return TriangleTriangleIntersector::intersect_triangle_triangle(a0,a1,a2,b0,b1,b2);
-    }
-    
     template<int N>
     __forceinline void BVHNColliderUserGeom<N>::processLeaf(NodeRef node0, NodeRef node1)
     {
@@ -133,6 +96,108 @@ namespace embree
         this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
     }
 
+    template<int N, typename Primitive>
+    void BVHNColliderTriangles<N,Primitive>::processLeaf(NodeRef node0, NodeRef node1)
+    {
+      Scene* scene0 = this->scene0;
+      Scene* scene1 = this->scene1;
+      const bool self = scene0 == scene1;
+      
+      /* triangle pairs get gathered into SIMD batches */
+      Vec3vfx a0(zero), a1(zero), a2(zero), b0(zero), b1(zero), b2(zero);
+      Collision pairs[VSIZEX];
+      size_t num_pairs = 0;
+
+      Collision collisions[16];
+      size_t num_collisions = 0;
+
+      auto report = [&] (const Collision& c) {
+        collisions[num_collisions++] = c;
+        if (num_collisions == 16) {
+          this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
+          num_collisions = 0;
+        }
+      };
+
+      auto test_pairs = [&] ()
+      {
+        CSTAT(bvh_collide_prim_intersections4 += num_pairs);
+        vboolx valid = vintx(step) < vintx(int(num_pairs));
+        valid &= TriangleTriangleIntersector::overlap_bounds<VSIZEX>(a0,a1,a2,b0,b1,b2);
+        if (!this->broadphase)
+          valid &= TriangleTriangleIntersector::overlap_planes<VSIZEX>(a0,a1,a2,b0,b1,b2);
+        
+        for (size_t m=movemask(valid), i=bsf(m); m!=0; m=btc(m,i), i=bsf(m))
+        {
+          if (!this->broadphase) {
+            CSTAT(bvh_collide_prim_intersections5++);
+            const Vec3fa ta0(a0.x[i],a0.y[i],a0.z[i]), ta1(a1.x[i],a1.y[i],a1.z[i]), ta2(a2.x[i],a2.y[i],a2.z[i]);
+            const Vec3fa tb0(b0.x[i],b0.y[i],b0.z[i]), tb1(b1.x[i],b1.y[i],b1.z[i]), tb2(b2.x[i],b2.y[i],b2.z[i]);
+            if (!TriangleTriangleIntersector::intersect_triangle_triangle(ta0,ta1,ta2,tb0,tb1,tb2))
+              continue;
+          }
+          CSTAT(bvh_collide_prim_intersections++);
+          report(pairs[i]);
+        }
+        num_pairs = 0;
+      };
+
+      auto set = [] (Vec3vfx& v, size_t i, const Vec3fa& p) {
+        v.x[i] = p.x; v.y[i] = p.y; v.z[i] = p.z;
+      };
+
+      size_t M0; const Primitive* prims0 = (const Primitive*) node0.leaf(M0);
+      size_t M1; const Primitive* prims1 = (const Primitive*) node1.leaf(M1);
+      for (size_t bi=0; bi<M0; bi++) {
+        for (size_t i=0; i<prims0[bi].size(); i++)
+        {
+          const unsigned geomID0 = prims0[bi].geomID(i);
+          const unsigned primID0 = prims0[bi].primID(i);
+          const TriangleMesh* mesh0 = scene0->get<TriangleMesh>(geomID0);
+          const TriangleMesh::Triangle& tri0 = mesh0->triangle(primID0);
+          const vint4 t0(tri0.v[0],tri0.v[1],tri0.v[2],tri0.v[2]);
+          
+          for (size_t bj=0; bj<M1; bj++) {
+            for (size_t j=0; j<prims1[bj].size(); j++)
+            {
+              CSTAT(bvh_collide_prim_intersections1++);
+              const unsigned geomID1 = prims1[bj].geomID(j);
+              const unsigned primID1 = prims1[bj].primID(j);
+
+              /* for scene intersection with itself every pair is
+               * visited twice, thus only report ordered pairs */
+              if (self && (geomID0 > geomID1 || (geomID0 == geomID1 && primID0 >= primID1)))
+                continue;
+              CSTAT(bvh_collide_prim_intersections2++);
+              
+              const TriangleMesh* mesh1 = scene1->get<TriangleMesh>(geomID1);
+              const TriangleMesh::Triangle& tri1 = mesh1->triangle(primID1);
+
+              /* ignore intersection with topological neighbors */
+              if (self && geomID0 == geomID1) {
+                if (any(vint4(tri1.v[0]) == t0)) continue;
+                if (any(vint4(tri1.v[1]) == t0)) continue;
+                if (any(vint4(tri1.v[2]) == t0)) continue;
+              }
+              CSTAT(bvh_collide_prim_intersections3++);
+
+              set(a0,num_pairs,mesh0->vertex(tri0.v[0]));
+              set(a1,num_pairs,mesh0->vertex(tri0.v[1]));
+              set(a2,num_pairs,mesh0->vertex(tri0.v[2]));
+              set(b0,num_pairs,mesh1->vertex(tri1.v[0]));
+              set(b1,num_pairs,mesh1->vertex(tri1.v[1]));
+              set(b2,num_pairs,mesh1->vertex(tri1.v[2]));
+              pairs[num_pairs++] = Collision(geomID0,primID0,geomID1,primID1);
+              if (num_pairs == VSIZEX) test_pairs();
+            }
+          }
+        }
+      }
+      if (num_pairs) test_pairs();
+      if (num_collisions)
+        this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
+    }
+
     template<int N>
     void BVHNCollider<N>::collide_recurse(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1, size_t depth0, size_t depth1)
     {
@@ -161,20 +226,18 @@ namespace embree
       recurse_node0:
         AABBNode* node0 = ref0.getAABBNode();
         size_t mask = overlap<N>(bounds1,*node0);
-        //for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-        //for (size_t i=0; i<N; i++) {
-#if 0
-        if (depth0 < parallel_depth_threshold) 
+        
+        /* spawn tasks for the upper levels below the initial jobs */
+        if (depth0+depth1 < this->spawn_depth && (mask & (mask-1)))
         {
           parallel_for(size_t(N), [&] ( size_t i ) {
-              if (mask & ( 1 << i)) {
+              if (mask & (size_t(1) << i)) {
                 BVHN<N>::prefetch(node0->child(i),BVH_FLAG_ALIGNED_NODE);
                 collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1);
               }
             });
-        } 
+        }
         else
-#endif
         {
           for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
             BVHN<N>::prefetch(node0->child(i),BVH_FLAG_ALIGNED_NODE);
@@ -188,20 +251,18 @@ namespace embree
       recurse_node1:
         AABBNode* node1 = ref1.getAABBNode();
         size_t mask = overlap<N>(bounds0,*node1);
-        //for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-        //for (size_t i=0; i<N; i++) {
-#if 0
-        if (depth1 < parallel_depth_threshold) 
+        
+        /* spawn tasks for the upper levels below the initial jobs */
+        if (depth0+depth1 < this->spawn_depth && (mask & (mask-1)))
         {
           parallel_for(size_t(N), [&] ( size_t i ) {
-              if (mask & ( 1 << i)) {
+              if (mask & (size_t(1) << i)) {
                 BVHN<N>::prefetch(node1->child(i),BVH_FLAG_ALIGNED_NODE);
                 collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1);
               }
             });
         }
         else
-#endif
         {
           for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
             BVHN<N>::prefetch(node1->child(i),BVH_FLAG_ALIGNED_NODE);
@@ -299,6 +360,13 @@ namespace embree
         std::swap(source,target);
       }
 
+      /* jobs may still contain large subtrees, thus traversal spawns
+       * further tasks for some levels below the deepest job */
+      size_t max_depth = 0;
+      for (size_t i=0; i<jobs[source].size(); i++)
+        max_depth = max(max_depth,jobs[source][i].depth0+jobs[source][i].depth1);
+      spawn_depth = max_depth+parallel_depth_threshold;
+
       /* parallel processing of all jobs */
       parallel_for(size_t(jobs[source].size()), [&] ( size_t i ) {
           CollideJob& j = jobs[source][i];
@@ -319,12 +387,331 @@ namespace embree
     }
    
     template<int N>
-    void BVHNColliderUserGeom<N>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr)
+    void BVHNColliderUserGeom<N>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr, bool broadphase)
+    { 
+      BVHNColliderUserGeom<N>(bvh0->scene,bvh1->scene,callback,userPtr,broadphase).
+        collide_recurse_entry(bvh0->root,bvh0->bounds.bounds(),bvh1->root,bvh1->bounds.bounds());
+    }
+
+    template<int N, typename Primitive>
+    void BVHNColliderTriangles<N,Primitive>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr, bool broadphase)
     { 
-      BVHNColliderUserGeom<N>(bvh0->scene,bvh1->scene,callback,userPtr).
+      BVHNColliderTriangles<N,Primitive>(bvh0->scene,bvh1->scene,callback,userPtr,broadphase).
         collide_recurse_entry(bvh0->root,bvh0->bounds.bounds(),bvh1->root,bvh1->bounds.bounds());
     }
 
+    /* tests the linear bounds of all children of a node for overlap
+     * with some linear bounds over a time interval, and narrows the
+     * time interval of each overlapping child */
+    template<int N>
+    __forceinline size_t overlapMB(const LBBox3fa& box, const BBox1f& time, typename BVHN<N>::NodeRef ref, vfloat<N>& tlower, vfloat<N>& tupper)
+    {
+      typedef typename BVHN<N>::AABBNode AABBNode;
+      typedef typename BVHN<N>::AABBNodeMB AABBNodeMB;
+      typedef typename BVHN<N>::AABBNodeMB4D AABBNodeMB4D;
+      
+      vfloat<N> t0 = time.lower, t1 = time.upper;
+      BBox<Vec3vf<N>> c0, c1;
+      if (ref.isAABBNode())
+      {
+        const AABBNode* node = ref.getAABBNode();
+        c0.lower = c1.lower = Vec3vf<N>(node->lower_x,node->lower_y,node->lower_z);
+        c0.upper = c1.upper = Vec3vf<N>(node->upper_x,node->upper_y,node->upper_z);
+      }
+      else
+      {
+        const AABBNodeMB* node = ref.getAABBNodeMB();
+        if (ref.isAABBNodeMB4D()) {
+          const AABBNodeMB4D* node4D = ref.getAABBNodeMB4D();
+          t0 = max(t0,node4D->lower_t);
+          t1 = min(t1,node4D->upper_t);
+        }
+        c0.lower = Vec3vf<N>(madd(t0,node->lower_dx,node->lower_x),madd(t0,node->lower_dy,node->lower_y),madd(t0,node->lower_dz,node->lower_z));
+        c0.upper = Vec3vf<N>(madd(t0,node->upper_dx,node->upper_x),madd(t0,node->upper_dy,node->upper_y),madd(t0,node->upper_dz,node->upper_z));
+        c1.lower = Vec3vf<N>(madd(t1,node->lower_dx,node->lower_x),madd(t1,node->lower_dy,node->lower_y),madd(t1,node->lower_dz,node->lower_z));
+        c1.upper = Vec3vf<N>(madd(t1,node->upper_dx,node->upper_x),madd(t1,node->upper_dy,node->upper_y),madd(t1,node->upper_dz,node->upper_z));
+      }
+
+      /* the bounds are linear in time, thus each of the 6 overlap
+       * conditions holds in a sub interval of [t0,t1] */
+      const Vec3fa dlower = box.bounds1.lower-box.bounds0.lower;
+      const Vec3fa dupper = box.bounds1.upper-box.bounds0.upper;
+      const Vec3vf<N> b0lower = Vec3vf<N>(madd(t0,vfloat<N>(dlower.x),vfloat<N>(box.bounds0.lower.x)),madd(t0,vfloat<N>(dlower.y),vfloat<N>(box.bounds0.lower.y)),madd(t0,vfloat<N>(dlower.z),vfloat<N>(box.bounds0.lower.z)));
+      const Vec3vf<N> b0upper = Vec3vf<N>(madd(t0,vfloat<N>(dupper.x),vfloat<N>(box.bounds0.upper.x)),madd(t0,vfloat<N>(dupper.y),vfloat<N>(box.bounds0.upper.y)),madd(t0,vfloat<N>(dupper.z),vfloat<N>(box.bounds0.upper.z)));
+      const Vec3vf<N> b1lower = Vec3vf<N>(madd(t1,vfloat<N>(dlower.x),vfloat<N>(box.bounds0.lower.x)),madd(t1,vfloat<N>(dlower.y),vfloat<N>(box.bounds0.lower.y)),madd(t1,vfloat<N>(dlower.z),vfloat<N>(box.bounds0.lower.z)));
+      const Vec3vf<N> b1upper = Vec3vf<N>(madd(t1,vfloat<N>(dupper.x),vfloat<N>(box.bounds0.upper.x)),madd(t1,vfloat<N>(dupper.y),vfloat<N>(box.bounds0.upper.y)),madd(t1,vfloat<N>(dupper.z),vfloat<N>(box.bounds0.upper.z)));
+      const Vec3vf<N> fa0 = c0.upper-b0lower, fb0 = c1.upper-b1lower;
+      const Vec3vf<N> fa1 = b0upper-c0.lower, fb1 = b1upper-c1.lower;
+
+      vbool<N> valid = t0 <= t1;
+      tlower = t0; tupper = t1;
+      auto clip = [&] (const vfloat<N>& fa, const vfloat<N>& fb) {
+        const vbool<N> ma = fa >= 0.0f, mb = fb >= 0.0f;
+        valid &= ma | mb;
+        const vfloat<N> tc = t0 + (t1-t0)*fa/(fa-fb);
+        tlower = select(!ma & mb, max(tlower,tc), tlower);
+        tupper = select(ma & !mb, min(tupper,tc), tupper);
+      };
+      clip(fa0.x,fb0.x); clip(fa0.y,fb0.y); clip(fa0.z,fb0.z);
+      clip(fa1.x,fb1.x); clip(fa1.y,fb1.y); clip(fa1.z,fb1.z);
+      valid &= tlower <= tupper;
+      return movemask(valid);
+    }
+
+    /* returns the linear bounds and the valid time range of some child */
+    template<int N>
+    __forceinline LBBox3fa childBoundsMB(typename BVHN<N>::NodeRef ref, size_t i, BBox1f& cell)
+    {
+      if (ref.isAABBNode()) {
+        const BBox3fa bounds = ref.getAABBNode()->bounds(i);
+        return LBBox3fa(bounds,bounds);
+      }
+      if (ref.isAABBNodeMB4D())
+        cell = intersect(cell,ref.getAABBNodeMB4D()->timeRange(i));
+      return ref.getAABBNodeMB()->lbounds(i);
+    }
+
+    template<typename Primitive>
+    size_t gatherTriangles(const char* leaf, size_t num, unsigned* geomIDs, unsigned* primIDs)
+    {
+      const Primitive* prims = (const Primitive*) leaf;
+      size_t n = 0;
+      for (size_t i=0; i<num; i++) {
+        for (size_t j=0; j<prims[i].size(); j++) {
+          geomIDs[n] = prims[i].geomID(j);
+          primIDs[n] = prims[i].primID(j);
+          n++;
+        }
+      }
+      return n;
+    }
+
+    template<int N0, int N1>
+    typename BVHNContinuousCollider<N0,N1>::GatherFunc BVHNContinuousCollider<N0,N1>::selectGather(const PrimitiveType* primTy)
+    {
+      if (primTy == &Triangle4::type)   return gatherTriangles<Triangle4>;
+      if (primTy == &Triangle4v::type)  return gatherTriangles<Triangle4v>;
+      if (primTy == &Triangle4i::type)  return gatherTriangles<Triangle4i>;
+      if (primTy == &Triangle4vMB::type) return gatherTriangles<Triangle4vMB>;
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"continuous collision detection only supports triangle meshes");
+    }
+
+    /* returns the position of a vertex at some time, the geometry stays
+     * at the first and last time step outside its time range */
+    __forceinline Vec3fa vertexAtTime(const TriangleMesh* mesh, unsigned v, float t)
+    {
+      if (mesh->numTimeSteps == 1) return mesh->vertex(v);
+      float ftime; const int itime = mesh->timeSegment(t,ftime);
+      ftime = clamp(ftime,0.0f,1.0f);
+      return lerp(mesh->vertex(v,itime),mesh->vertex(v,itime+1),ftime);
+    }
+
+    template<int N0, int N1>
+    BVHNContinuousCollider<N0,N1>::BVHNContinuousCollider (BVH0* bvh0, BVH1* bvh1, const BBox1f& time_range, RTCContinuousCollideFunc callback, void* userPtr)
+      : scene0(bvh0->scene), scene1(bvh1->scene), self((void*)bvh0 == (void*)bvh1),
+        gather0(selectGather(bvh0->primTy)), gather1(selectGather(bvh1->primTy)),
+        time_range(time_range), callback(callback), userPtr(userPtr) {}
+
+    template<int N0, int N1>
+    bool BVHNContinuousCollider<N0,N1>::timeOfImpact(const TriangleMesh* mesh0, unsigned primID0, const TriangleMesh* mesh1, unsigned primID1, const BBox1f& time, float& toi) const
+    {
+      const TriangleMesh::Triangle& tri0 = mesh0->triangle(primID0);
+      const TriangleMesh::Triangle& tri1 = mesh1->triangle(primID1);
+
+      /* the vertices move linearly in between the time steps of both meshes */
+      float times[2*RTC_MAX_TIME_STEP_COUNT+2];
+      size_t num_times = 0;
+      times[num_times++] = time.lower;
+      for (unsigned i0=0, i1=0; i0<mesh0->numTimeSteps || i1<mesh1->numTimeSteps; )
+      {
+        const float s0 = i0 < mesh0->numTimeSteps && mesh0->numTimeSteps > 1 ? mesh0->timeStep(i0) : float(inf);
+        const float s1 = i1 < mesh1->numTimeSteps && mesh1->numTimeSteps > 1 ? mesh1->timeStep(i1) : float(inf);
+        const float s = min(s0,s1);
+        if (s0 <= s1) i0++; else i1++;
+        if (s == float(inf)) break;
+        if (s > times[num_times-1] && s < time.upper) times[num_times++] = s;
+      }
+      times[num_times++] = time.upper;
+
+      Vec3fa a0[3], b0[3], a1[3], b1[3];
+      for (size_t k=0; k<3; k++) {
+        a1[k] = vertexAtTime(mesh0,tri0.v[k],times[0]);
+        b1[k] = vertexAtTime(mesh1,tri1.v[k],times[0]);
+      }
+      for (size_t i=0; i+1<num_times; i++)
+      {
+        for (size_t k=0; k<3; k++) {
+          a0[k] = a1[k]; a1[k] = vertexAtTime(mesh0,tri0.v[k],times[i+1]);
+          b0[k] = b1[k]; b1[k] = vertexAtTime(mesh1,tri1.v[k],times[i+1]);
+        }
+
+        /* skip time segments with disjoint swept bounds */
+        BBox3fa bounds0 = empty, bounds1 = empty;
+        for (size_t k=0; k<3; k++) {
+          bounds0.extend(a0[k]); bounds0.extend(a1[k]);
+          bounds1.extend(b0[k]); bounds1.extend(b1[k]);
+        }
+        if (disjoint(bounds0,bounds1)) continue;
+        
+        if (TriangleTriangleIntersector::intersect_triangle_triangle(a0[0],a0[1],a0[2],b0[0],b0[1],b0[2])) {
+          toi = times[i];
+          return true;
+        }
+        
+        float u;
+        if (times[i+1] > times[i] && TriangleTriangleCCD::intersect(a0,a1,b0,b1,u)) {
+          toi = min(madd(u,times[i+1]-times[i],times[i]),times[i+1]);
+          return true;
+        }
+
+        /* contacts the exact test missed numerically, e.g. of coplanar moving triangles */
+        if (TriangleTriangleIntersector::intersect_triangle_triangle(a1[0],a1[1],a1[2],b1[0],b1[1],b1[2])) {
+          toi = times[i+1];
+          return true;
+        }
+      }
+      return false;
+    }
+    
+    template<int N0, int N1>
+    void BVHNContinuousCollider<N0,N1>::processLeaf(NodeRef0 leaf0, NodeRef1 leaf1, const BBox1f& time, const BBox1f& cell)
+    {
+      unsigned geomIDs0[maxLeafTriangles], primIDs0[maxLeafTriangles];
+      unsigned geomIDs1[maxLeafTriangles], primIDs1[maxLeafTriangles];
+      size_t num0; const char* prims0 = leaf0.leaf(num0);
+      size_t num1; const char* prims1 = leaf1.leaf(num1);
+      const size_t M0 = gather0(prims0,num0,geomIDs0,primIDs0);
+      const size_t M1 = gather1(prims1,num1,geomIDs1,primIDs1);
+
+      RTCContinuousCollision collisions[16];
+      size_t num_collisions = 0;
+      
+      for (size_t i=0; i<M0; i++)
+      {
+        const unsigned geomID0 = geomIDs0[i], primID0 = primIDs0[i];
+        const TriangleMesh* mesh0 = scene0->get<TriangleMesh>(geomID0);
+        for (size_t j=0; j<M1; j++)
+        {
+          const unsigned geomID1 = geomIDs1[j], primID1 = primIDs1[j];
+          if (self && (geomID0 > geomID1 || (geomID0 == geomID1 && primID0 >= primID1)))
+            continue;
+          
+          /* ignore intersection with topological neighbors */
+          if (scene0 == scene1 && geomID0 == geomID1) {
+            const TriangleMesh::Triangle& tri0 = mesh0->triangle(primID0);
+            const TriangleMesh::Triangle& tri1 = mesh0->triangle(primID1);
+            const vint4 t0(tri0.v[0],tri0.v[1],tri0.v[2],tri0.v[2]);
+            if (any(vint4(tri1.v[0]) == t0)) continue;
+            if (any(vint4(tri1.v[1]) == t0)) continue;
+            if (any(vint4(tri1.v[2]) == t0)) continue;
+          }
+
+          /* a pair may get visited once for each time range it got
+           * split into, thus only the visit whose time range contains
+           * the earliest time of impact reports the pair */
+          const TriangleMesh* mesh1 = scene1->get<TriangleMesh>(geomID1);
+          float toi;
+          if (!timeOfImpact(mesh0,primID0,mesh1,primID1,BBox1f(time_range.lower,time.upper),toi)) continue;
+          if (toi < cell.lower || toi >= cell.upper) continue;
+          
+          RTCContinuousCollision& c = collisions[num_collisions++];
+          c.geomID0 = geomID0; c.primID0 = primID0;
+          c.geomID1 = geomID1; c.primID1 = primID1;
+          c.time = toi;
+          if (num_collisions == 16) {
+            callback(userPtr,collisions,(unsigned int)num_collisions);
+            num_collisions = 0;
+          }
+        }
+      }
+      if (num_collisions)
+        callback(userPtr,collisions,(unsigned int)num_collisions);
+    }
+    
+    template<int N0, int N1>
+    void BVHNContinuousCollider<N0,N1>::collide_recurse(NodeRef0 ref0, const LBBox3fa& bounds0, NodeRef1 ref1, const LBBox3fa& bounds1, const BBox1f& time, const BBox1f& cell, size_t depth)
+    {
+      if (unlikely(ref0.isLeaf())) {
+        if (unlikely(ref1.isLeaf())) {
+          processLeaf(ref0,ref1,time,cell);
+          return;
+        } else goto recurse_node1;
+      } else {
+        if (unlikely(ref1.isLeaf())) {
+          goto recurse_node0;
+        } else {
+          if (area(bounds0.bounds()) > area(bounds1.bounds())) {
+            goto recurse_node0;
+          }
+          else {
+            goto recurse_node1;
+          }
+        }
+      }
+
+      {
+      recurse_node0:
+        vfloat<N0> tlower, tupper;
+        const size_t mask = overlapMB<N0>(bounds1,time,ref0,tlower,tupper);
+        auto recurse = [&] (size_t i) {
+          BBox1f child_cell = cell;
+          const LBBox3fa child_bounds = childBoundsMB<N0>(ref0,i,child_cell);
+          collide_recurse(ref0.baseNode()->child(i),child_bounds,ref1,bounds1,BBox1f(tlower[i],tupper[i]),child_cell,depth+1);
+        };
+        /* each level descends only one of the BVHs, thus spawn tasks for twice as many levels */
+        if (depth < 2*parallel_depth_threshold && (mask & (mask-1))) {
+          parallel_for(size_t(N0), [&] ( size_t i ) {
+              if (mask & (size_t(1) << i)) recurse(i);
+            });
+        } else {
+          for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m))
+            recurse(i);
+        }
+        return;
+      }
+
+      {
+      recurse_node1:
+        vfloat<N1> tlower, tupper;
+        const size_t mask = overlapMB<N1>(bounds0,time,ref1,tlower,tupper);
+        auto recurse = [&] (size_t i) {
+          BBox1f child_cell = cell;
+          const LBBox3fa child_bounds = childBoundsMB<N1>(ref1,i,child_cell);
+          collide_recurse(ref0,bounds0,ref1.baseNode()->child(i),child_bounds,BBox1f(tlower[i],tupper[i]),child_cell,depth+1);
+        };
+        if (depth < 2*parallel_depth_threshold && (mask & (mask-1))) {
+          parallel_for(size_t(N1), [&] ( size_t i ) {
+              if (mask & (size_t(1) << i)) recurse(i);
+            });
+        } else {
+          for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m))
+            recurse(i);
+        }
+        return;
+      }
+    }
+
+    template<int N0, int N1>
+    void BVHNContinuousCollider<N0,N1>::collide(BVH0* bvh0, BVH1* bvh1, const BBox1f& time_range, RTCContinuousCollideFunc callback, void* userPtr)
+    {
+      if (bvh0->root == BVH0::emptyNode || bvh1->root == BVH1::emptyNode) return;
+      BVHNContinuousCollider<N0,N1>(bvh0,bvh1,time_range,callback,userPtr).
+        collide_recurse(bvh0->root,bvh0->bounds,bvh1->root,bvh1->bounds,time_range,BBox1f(0.0f,1.0f+float(ulp)),0);
+    }
+
+    template<int N>
+    void BVHNContinuousColliderDispatch<N>::collideContinuous(BVHN<N>* bvh0, AccelData* bvh1, const BBox1f& time_range, RTCContinuousCollideFunc callback, void* userPtr)
+    {
+      if (bvh1->type == AccelData::TY_BVH4)
+        BVHNContinuousCollider<N,4>::collide(bvh0,(BVH4*)bvh1,time_range,callback,userPtr);
+#if defined(__AVX__)
+      else if (bvh1->type == AccelData::TY_BVH8)
+        BVHNContinuousCollider<N,8>::collide(bvh0,(BVH8*)bvh1,time_range,callback,userPtr);
+#endif
+      else
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"continuous collision detection only supports triangle meshes");
+    }
+
 #if defined (EMBREE_LOWEST_ISA)
     struct collision_regression_test : public RegressionTest
     {
@@ -367,9 +754,17 @@ namespace embree
     ////////////////////////////////////////////////////////////////////////////////
 
     DEFINE_COLLIDER(BVH4ColliderUserGeom,BVHNColliderUserGeom<4>);
+    DEFINE_COLLIDER_CCD(BVH4ColliderTriangle4,BVHNColliderTriangles<4 COMMA Triangle4>,BVHNContinuousColliderDispatch<4>);
+    DEFINE_COLLIDER_CCD(BVH4ColliderTriangle4v,BVHNColliderTriangles<4 COMMA Triangle4v>,BVHNContinuousColliderDispatch<4>);
+    DEFINE_COLLIDER_CCD(BVH4ColliderTriangle4i,BVHNColliderTriangles<4 COMMA Triangle4i>,BVHNContinuousColliderDispatch<4>);
+    DEFINE_COLLIDER_MB(BVH4ColliderTriangleMB,BVHNContinuousColliderDispatch<4>);
 
 #if defined(__AVX__)
     DEFINE_COLLIDER(BVH8ColliderUserGeom,BVHNColliderUserGeom<8>);
+    DEFINE_COLLIDER_CCD(BVH8ColliderTriangle4,BVHNColliderTriangles<8 COMMA Triangle4>,BVHNContinuousColliderDispatch<8>);
+    DEFINE_COLLIDER_CCD(BVH8ColliderTriangle4v,BVHNColliderTriangles<8 COMMA Triangle4v>,BVHNContinuousColliderDispatch<8>);
+    DEFINE_COLLIDER_CCD(BVH8ColliderTriangle4i,BVHNColliderTriangles<8 COMMA Triangle4i>,BVHNContinuousColliderDispatch<8>);
+    DEFINE_COLLIDER_MB(BVH8ColliderTriangleMB,BVHNContinuousColliderDispatch<8>);
 #endif
   }
 }
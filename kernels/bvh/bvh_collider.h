@@ -4,7 +4,10 @@
 #pragma once
 
 #include "bvh.h"
+#include "../geometry/triangle.h"
 #include "../geometry/trianglev.h"
+#include "../geometry/trianglei.h"
+#include "../geometry/trianglev_mb.h"
 #include "../geometry/object.h"
 
 namespace embree
@@ -39,8 +42,8 @@ namespace embree
       void split(const CollideJob& job, jobvector& jobs);
       
     public:
-      __forceinline BVHNCollider (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
-        : scene0(scene0), scene1(scene1), callback(callback), userPtr(userPtr) {}
+      __forceinline BVHNCollider (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr, bool broadphase)
+        : scene0(scene0), scene1(scene1), callback(callback), userPtr(userPtr), broadphase(broadphase), spawn_depth(0) {}
 
     public:
       virtual void processLeaf(NodeRef leaf0, NodeRef leaf1) = 0;
@@ -52,6 +55,8 @@ namespace embree
       Scene* scene1;
       RTCCollideFunc callback;
       void* userPtr;
+      bool broadphase;     //!< only report primitive pairs with overlapping bounds
+      size_t spawn_depth;  //!< traversal steps up to this depth spawn parallel tasks
     };
 
     template<int N>
@@ -61,12 +66,73 @@ namespace embree
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::AABBNode AABBNode;
 
-      __forceinline BVHNColliderUserGeom (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
-        : BVHNCollider<N>(scene0,scene1,callback,userPtr) {}
+      __forceinline BVHNColliderUserGeom (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr, bool broadphase)
+        : BVHNCollider<N>(scene0,scene1,callback,userPtr,broadphase) {}
 
       virtual void processLeaf(NodeRef leaf0, NodeRef leaf1);
     public:
-      static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr);
+      static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr, bool broadphase);
+    };
+
+    /*! collider for triangle BVHs, tests the triangle pairs of two leaves in SIMD batches */
+    template<int N, typename Primitive>
+      class BVHNColliderTriangles : public BVHNCollider<N>
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::AABBNode AABBNode;
+
+      __forceinline BVHNColliderTriangles (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr, bool broadphase)
+        : BVHNCollider<N>(scene0,scene1,callback,userPtr,broadphase) {}
+
+      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1);
+    public:
+      static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr, bool broadphase);
+    };
+
+    /*! continuous collider for triangle BVHs with and without motion
+     *  blur, walks both BVHs over a time interval and reports the
+     *  earliest time of impact of colliding triangle pairs */
+    template<int N0, int N1>
+      class BVHNContinuousCollider
+    {
+      typedef BVHN<N0> BVH0;
+      typedef BVHN<N1> BVH1;
+      typedef typename BVH0::NodeRef NodeRef0;
+      typedef typename BVH1::NodeRef NodeRef1;
+
+      /* maximal number of triangles in a leaf */
+      static const size_t maxLeafTriangles = 4*BVH0::maxLeafBlocks;
+
+      /* gathers the IDs of all triangles of a leaf */
+      typedef size_t (*GatherFunc)(const char* leaf, size_t num, unsigned* geomIDs, unsigned* primIDs);
+      static GatherFunc selectGather(const PrimitiveType* primTy);
+
+      BVHNContinuousCollider (BVH0* bvh0, BVH1* bvh1, const BBox1f& time_range, RTCContinuousCollideFunc callback, void* userPtr);
+
+      void collide_recurse(NodeRef0 ref0, const LBBox3fa& bounds0, NodeRef1 ref1, const LBBox3fa& bounds1, const BBox1f& time, const BBox1f& cell, size_t depth);
+      void processLeaf(NodeRef0 leaf0, NodeRef1 leaf1, const BBox1f& time, const BBox1f& cell);
+      bool timeOfImpact(const TriangleMesh* mesh0, unsigned primID0, const TriangleMesh* mesh1, unsigned primID1, const BBox1f& time, float& toi) const;
+
+    public:
+      static void collide(BVH0* bvh0, BVH1* bvh1, const BBox1f& time_range, RTCContinuousCollideFunc callback, void* userPtr);
+
+    private:
+      Scene* scene0;
+      Scene* scene1;
+      bool self;              //!< both BVHs are the same, thus each pair is visited twice
+      GatherFunc gather0;
+      GatherFunc gather1;
+      BBox1f time_range;
+      RTCContinuousCollideFunc callback;
+      void* userPtr;
+    };
+
+    /*! dispatches continuous collision detection on the branching factor of the second BVH */
+    template<int N>
+      struct BVHNContinuousColliderDispatch
+    {
+      static void collideContinuous(BVHN<N>* bvh0, AccelData* bvh1, const BBox1f& time_range, RTCContinuousCollideFunc callback, void* userPtr);
     };
   }
 }
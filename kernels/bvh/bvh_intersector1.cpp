@@ -45,7 +45,7 @@ namespace embree
       StackItemT<NodeRef> stack[stackSize];    // stack of nodes
       StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
       StackItemT<NodeRef>* stackEnd = stack+stackSize;
-      stack[0].ptr  = bvh->root;
+      stack[0].ptr  = bvh->getRoot();
       stack[0].dist = neg_inf;
       
       if (bvh->root == BVH::emptyNode)
@@ -66,6 +66,9 @@ namespace embree
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, types> nodeTraverser;
 
+      /* counters for traversal statistics of sampled rays */
+      size_t numNodes = 0, numLeaves = 0, numPrims = 0;
+
       /* pop loop */
       while (true) pop:
       {
@@ -86,6 +89,7 @@ namespace embree
           STAT3(normal.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          numNodes++;
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -99,6 +103,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        numLeaves++; numPrims += num;
         size_t lazy_node = 0;
         PrimitiveIntersector1::intersect(This, pre, ray, context, prim, num, tray, lazy_node);
         tray.tfar = ray.tfar;
@@ -110,6 +115,12 @@ namespace embree
           stackPtr++;
         }
       }
+
+      if (unlikely(context->stats)) {
+        context->stats->nodes += numNodes;
+        context->stats->leaves += numLeaves;
+        context->stats->prims += numPrims;
+      }
     }
 
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
@@ -134,7 +145,7 @@ namespace embree
       NodeRef stack[stackSize];    // stack of nodes that still need to get traversed
       NodeRef* stackPtr = stack+1; // current stack pointer
       NodeRef* stackEnd = stack+stackSize;
-      stack[0] = bvh->root;
+      stack[0] = bvh->getRoot();
 
       /* filter out invalid rays */
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
@@ -152,6 +163,9 @@ namespace embree
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, types> nodeTraverser;
 
+      /* counters for traversal statistics of sampled rays */
+      size_t numNodes = 0, numLeaves = 0, numPrims = 0;
+
       /* pop loop */
       while (true) pop:
       {
@@ -168,6 +182,7 @@ namespace embree
           STAT3(shadow.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+          numNodes++;
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -181,6 +196,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(shadow.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        numLeaves++; numPrims += num;
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(This, pre, ray, context, prim, num, tray, lazy_node)) {
           ray.tfar = neg_inf;
@@ -193,6 +209,12 @@ namespace embree
           stackPtr++;
         }
       }
+
+      if (unlikely(context->stats)) {
+        context->stats->nodes += numNodes;
+        context->stats->leaves += numLeaves;
+        context->stats->prims += numPrims;
+      }
     }
 
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
@@ -219,7 +241,7 @@ namespace embree
         StackItemT<NodeRef> stack[stackSize];    // stack of nodes
         StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
         StackItemT<NodeRef>* stackEnd = stack+stackSize;
-        stack[0].ptr  = bvh->root;
+        stack[0].ptr  = bvh->getRoot();
         stack[0].dist = neg_inf;
         
         /* verify correct input */
@@ -296,11 +318,6 @@ namespace embree
     };
 
     /* disable point queries for not yet supported geometry types */
-    template<int N, int types, bool robust>
-    struct PointQueryDispatch<N, types, robust, VirtualCurveIntersector1> {
-      static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context) { return false; }
-    };
-    
     template<int N, int types, bool robust>
     struct PointQueryDispatch<N, types, robust, SubdivPatch1Intersector1> {
       static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context) { return false; }
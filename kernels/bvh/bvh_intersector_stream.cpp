@@ -76,7 +76,7 @@ namespace embree
 
       stack[0].mask   = m_active;
       stack[0].parent = 0;
-      stack[0].child  = bvh->root;
+      stack[0].child  = bvh->getRoot();
 
       ///////////////////////////////////////////////////////////////////////////////////
       ///////////////////////////////////////////////////////////////////////////////////
@@ -204,7 +204,7 @@ namespace embree
 
       stack[0].mask   = m_active;
       stack[0].parent = 0;
-      stack[0].child  = bvh->root;
+      stack[0].child  = bvh->getRoot();
 
       ///////////////////////////////////////////////////////////////////////////////////
       ///////////////////////////////////////////////////////////////////////////////////
@@ -261,6 +261,7 @@ namespace embree
         size_t num; PrimitiveK<K>* prim = (PrimitiveK<K>*)cur.leaf(num);
 
         size_t bits = m_trav_active & m_active;
+        const size_t m_leaf_active = m_active;
         /*! intersect stream of rays with all primitives */
         size_t lazy_node = 0;
 #if defined(__SSE4_2__)
@@ -279,6 +280,13 @@ namespace embree
           m_active &= ~((size_t)movemask(m_hit) << (i*K));
         }
 
+        /* ray group queries terminate once enough rays are occluded */
+        if (unlikely(context->maxOccluded))
+        {
+          context->numOccluded += popcnt(m_leaf_active & ~m_active);
+          if (context->isTerminated()) break;
+        }
+
       } // traversal + intersection
     }
 
@@ -315,7 +323,7 @@ namespace embree
 
       StackItemMaskT<NodeRef> stack[stackSizeSingle]; // stack of nodes
       StackItemMaskT<NodeRef>* stackPtr = stack + 1;  // current stack pointer
-      stack[0].ptr = bvh->root;
+      stack[0].ptr = bvh->getRoot();
       stack[0].mask = m_active;
 
       size_t terminated = ~m_active;
@@ -522,6 +530,13 @@ namespace embree
         RayK<K>& ray = *(inputRays[i / K]);
         valid &= ray.tnear() <= ray.tfar;
         This->occluded(valid, ray, context);
+
+        /* ray group queries terminate once enough rays are occluded */
+        if (unlikely(context->maxOccluded))
+        {
+          context->numOccluded += popcnt(movemask(valid & (ray.tfar < 0.0f)));
+          if (context->isTerminated()) break;
+        }
       }
     }
   }
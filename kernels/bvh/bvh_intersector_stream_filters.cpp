@@ -3,11 +3,54 @@
 
 #include "bvh_intersector_stream_filters.h"
 #include "bvh_intersector_stream.h"
+#include "../../common/algorithms/parallel_sort.h"
 
 namespace embree
 {
   namespace isa
   {
+    /*! reference to a ray of a stream used for sorting */
+    struct RaySortItem
+    {
+      __forceinline operator unsigned int() const { return key; }
+
+      unsigned int key; //!< direction octant in the upper bits, morton code of the origin in the lower bits
+      unsigned int id;  //!< index of the ray in the stream
+    };
+
+    /*! sorts the valid rays of an incoherent stream by direction octant and origin, such that neighboring rays form coherent packets */
+    template<typename GetRay>
+    static size_t sortRays(Scene* scene, size_t N, const GetRay& getRay, std::vector<RaySortItem>& items)
+    {
+      /* origins get quantized to 9 bits per dimension inside the scene bounds */
+      const BBox3fa bounds = scene->bounds.bounds();
+      const Vec3fa base  = scene->isEmpty() ? Vec3fa(zero) : bounds.lower;
+      const Vec3fa scale = scene->isEmpty() ? Vec3fa(zero) : Vec3fa(511.0f)*rcp(max(bounds.size(),Vec3fa(1E-19f)));
+
+      items.resize(N);
+      size_t numRays = 0;
+      for (size_t i = 0; i < N; i++)
+      {
+        const Ray& ray = getRay(i);
+
+        /* skip invalid rays */
+        if (unlikely(ray.tnear() > ray.tfar)) continue;
+#if defined(EMBREE_IGNORE_INVALID_RAYS)
+        if (unlikely(!ray.valid())) continue;
+#endif
+
+        const Vec3fa q = min(max((Vec3fa(ray.org)-base)*scale,Vec3fa(zero)),Vec3fa(511.0f));
+        const unsigned int octantID = movemask(vfloat4(Vec3fa(ray.dir)) < 0.0f) & 0x7;
+        items[numRays].key = (octantID << 27) | bitInterleave((unsigned int)q.x,(unsigned int)q.y,(unsigned int)q.z);
+        items[numRays].id = (unsigned int)i;
+        numRays++;
+      }
+
+      std::vector<RaySortItem> temp(numRays);
+      radix_sort_u32(items.data(),temp.data(),numRays);
+      return numRays;
+    }
+
     template<int K, bool intersect>
     __noinline void RayStreamFilter::filterAOS(Scene* scene, void* _rayN, size_t N, size_t stride, IntersectContext* context)
     {
@@ -132,6 +175,27 @@ namespace embree
           raysInOctant[curOctant] = 0;
         }
       }
+      else if (unlikely(scene->device->stream_ray_sorting && N > MAX_INTERNAL_STREAM_SIZE))
+      {
+        /* sort rays and trace packets of neighboring rays */
+        std::vector<RaySortItem> items;
+        const size_t numRays = sortRays(scene, N, [&] (size_t i) -> const Ray& { return rayN.getRayByOffset(i * stride); }, items);
+
+        for (size_t i = 0; i < numRays; i += K)
+        {
+          const size_t n = min(numRays - i, size_t(K));
+          __aligned(64) int rayIDs[K];
+          for (size_t k = 0; k < K; k++)
+            rayIDs[k] = (int) items[i + min(k, n-1)].id;
+
+          const vbool<K> valid = vint<K>(step) < vint<K>(int(n));
+          const vint<K> offset = vint<K>::load(rayIDs) * int(stride);
+
+          RayTypeK<K, intersect> ray = rayN.getRayByOffset<K>(valid, offset);
+          scene->intersectors.intersect(valid, ray, context);
+          rayN.setHitByOffset<K>(valid, offset, ray);
+        }
+      }
       else
       {
         /* fallback to packets */
@@ -274,6 +338,27 @@ namespace embree
           raysInOctant[curOctant] = 0;
         }
       }
+      else if (unlikely(scene->device->stream_ray_sorting && N > MAX_INTERNAL_STREAM_SIZE))
+      {
+        /* sort rays and trace packets of neighboring rays */
+        std::vector<RaySortItem> items;
+        const size_t numRays = sortRays(scene, N, [&] (size_t i) -> const Ray& { return rayN.getRayByIndex(i); }, items);
+
+        for (size_t i = 0; i < numRays; i += K)
+        {
+          const size_t n = min(numRays - i, size_t(K));
+          __aligned(64) int rayIDs[K];
+          for (size_t k = 0; k < K; k++)
+            rayIDs[k] = (int) items[i + min(k, n-1)].id;
+
+          const vbool<K> valid = vint<K>(step) < vint<K>(int(n));
+          const vint<K> index = vint<K>::load(rayIDs);
+
+          RayTypeK<K, intersect> ray = rayN.getRayByIndex<K>(valid, index);
+          scene->intersectors.intersect(valid, ray, context);
+          rayN.setHitByIndex<K>(valid, index, ray);
+        }
+      }
       else
       {
         /* fallback to packets */
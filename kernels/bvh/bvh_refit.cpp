@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "bvh_refit.h"
+#include "bvh_restructure.h"
 #include "bvh_statistics.h"
 
 #include "../geometry/linei.h"
@@ -9,6 +10,7 @@
 #include "../geometry/trianglev.h"
 #include "../geometry/trianglei.h"
 #include "../geometry/quadv.h"
+#include "../geometry/quadi.h"
 #include "../geometry/object.h"
 #include "../geometry/instance.h"
 
@@ -168,7 +170,7 @@ namespace embree
 
     template<int N, typename Mesh, typename Primitive>
     BVHNRefitT<N,Mesh,Primitive>::BVHNRefitT (BVH* bvh, Builder* builder, Mesh* mesh, size_t mode)
-      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0) {}
+      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0), changedTopology(true) {}
 
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::clear()
@@ -183,9 +185,22 @@ namespace embree
       if (mesh->topologyChanged(topologyVersion)) {
         topologyVersion = mesh->getTopologyVersion();
         builder->build();
+        changedTopology = true;
       }
       else
+      {
         refitter->refit();
+        changedTopology = false;
+
+        /* restructure the refitted BVH to keep its SAH quality for deforming meshes */
+        const float budget = bvh->device->refit_optimization_budget;
+        if (budget > 0.0f)
+          changedTopology = BVHNRestructure<N>(bvh).optimize(1E-3*budget) != 0;
+
+        /* replicated top levels are copies and have to get updated too */
+        if (!bvh->numaRoots.empty())
+          bvh->replicateTopLevels();
+      }
     }
 
     template class BVHNRefitter<4>;
@@ -219,6 +234,8 @@ namespace embree
 #if  defined(__AVX__)
     Builder* BVH8Quad4vMeshBuilderSAH (void* bvh, QuadMesh* mesh, unsigned int geomID, size_t mode);
     Builder* BVH8Quad4vMeshRefitSAH (void* accel, QuadMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNRefitT<8,QuadMesh,Quad4v>((BVH8*)accel,BVH8Quad4vMeshBuilderSAH(accel,mesh,geomID,mode),mesh,mode); }
+    Builder* BVH8Quad4iMeshBuilderSAH (void* bvh, QuadMesh* mesh, unsigned int geomID, size_t mode);
+    Builder* BVH8Quad4iMeshRefitSAH (void* accel, QuadMesh* mesh, unsigned int geomID, size_t mode) { return new BVHNRefitT<8,QuadMesh,Quad4i>((BVH8*)accel,BVH8Quad4iMeshBuilderSAH(accel,mesh,geomID,mode),mesh,mode); }
 #endif
 
 #endif
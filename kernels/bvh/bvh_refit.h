@@ -73,6 +73,9 @@ namespace embree
       
       virtual void clear();
 
+      /*! true if the last build changed the topology of the BVH */
+      bool topologyChanged() const { return changedTopology; }
+
       virtual const BBox3fa leafBounds (NodeRef& ref) const
       {
         size_t num; char* prim = ref.leaf(num);
@@ -90,6 +93,7 @@ namespace embree
       std::unique_ptr<BVHNRefitter<N>> refitter;
       Mesh* mesh;
       unsigned int topologyVersion;
+      bool changedTopology;
     };
   }
 }
@@ -0,0 +1,313 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bvh_restructure.h"
+#include "../../common/algorithms/parallel_for.h"
+
+#include <algorithm>
+
+namespace embree
+{
+  namespace isa
+  {
+    static const size_t SINGLE_THREAD_THRESHOLD = 4*1024;
+
+    template<int N>
+    BVHNRestructure<N>::BVHNRestructure (BVH* bvh)
+      : bvh(bvh), deadline(0.0), changes(0) {}
+
+    template<int N>
+    size_t BVHNRestructure<N>::optimize(double timeBudget)
+    {
+      deadline = getSeconds()+timeBudget;
+      changes = 0;
+      if (!bvh->root.isAABBNode())
+        return 0;
+
+      /* rotate until no more improvements are found */
+      while (getSeconds() < deadline)
+      {
+        const size_t numChanges = changes;
+        if (bvh->numPrimitives <= SINGLE_THREAD_THRESHOLD)
+          rotate(bvh->root,0);
+        else
+          rotate_parallel(bvh->root,0);
+        if (changes == numChanges) break;
+      }
+
+      /* use remaining time for reinsertions */
+      if (getSeconds() < deadline)
+        reinsert();
+
+      return changes;
+    }
+
+    template<int N>
+    size_t BVHNRestructure<N>::rotate_parallel(NodeRef ref, size_t depth)
+    {
+      static const size_t MAX_PARALLEL_DEPTH = (N==4) ? 4 : 3;
+      if (depth >= MAX_PARALLEL_DEPTH || !ref.isAABBNode())
+        return rotate(ref,depth);
+
+      AABBNode* node = ref.getAABBNode();
+      size_t heights[N];
+      parallel_for(size_t(N), [&] (size_t i) {
+          heights[i] = rotate_parallel(node->child(i),depth+1);
+        });
+      return rotate_node(ref,depth,heights);
+    }
+
+    template<int N>
+    size_t BVHNRestructure<N>::rotate(NodeRef ref, size_t depth)
+    {
+      if (ref.isLeaf()) return 0;
+      if (!ref.isAABBNode()) return BVH::maxBuildDepth; // never push other node types down
+
+      AABBNode* node = ref.getAABBNode();
+      size_t heights[N];
+      for (size_t i=0; i<N; i++)
+        heights[i] = rotate(node->child(i),depth+1);
+      return rotate_node(ref,depth,heights);
+    }
+
+    template<int N>
+    size_t BVHNRestructure<N>::rotate_node(NodeRef ref, size_t depth, const size_t* heights)
+    {
+      /* once the time is over all ancestors skip rotating too, thus heights are not needed anymore */
+      if (getSeconds() > deadline) return 0;
+
+      AABBNode* parent = ref.getAABBNode();
+      size_t height = 0;
+      for (size_t i=0; i<N; i++)
+        height = max(height,heights[i]+1);
+
+      /*! Find best rotation. We pick a first child (child1) and a sub-child
+        (child2child) of a different second child (child2), and swap child1
+        and child2child. We perform the swap that reduces the area of child2
+        most. */
+      float bestGain = 0.0f;
+      size_t bestChild1 = -1, bestChild2 = -1, bestChild2Child = -1;
+      for (size_t c2=0; c2<N; c2++)
+      {
+        if (!parent->child(c2).isAABBNode()) continue;
+        AABBNode* child2 = parent->child(c2).getAABBNode();
+        const float area2 = halfArea(parent->bounds(c2));
+
+        /* bounds of all children of child2 except one */
+        BBox3fa prefix[N+1], suffix[N+1];
+        prefix[0] = suffix[N] = empty;
+        for (size_t i=0; i<N; i++) {
+          prefix[i+1] = prefix[i];
+          if (child2->child(i) != BVH::emptyNode) prefix[i+1].extend(child2->bounds(i));
+          suffix[N-1-i] = suffix[N-i];
+          if (child2->child(N-1-i) != BVH::emptyNode) suffix[N-1-i].extend(child2->bounds(N-1-i));
+        }
+
+        for (size_t c1=0; c1<N; c1++)
+        {
+          if (c1 == c2 || parent->child(c1) == BVH::emptyNode) continue;
+          if (depth+2+heights[c1] > BVH::maxBuildDepth) continue; // child1 gets pushed down one level
+
+          const BBox3fa bounds1 = parent->bounds(c1);
+          for (size_t k=0; k<N; k++)
+          {
+            if (child2->child(k) == BVH::emptyNode) continue;
+            const float gain = area2-halfArea(merge(bounds1,prefix[k],suffix[k+1]));
+            if (gain > bestGain) {
+              bestGain = gain;
+              bestChild1 = c1;
+              bestChild2 = c2;
+              bestChild2Child = k;
+            }
+          }
+        }
+      }
+
+      if (bestChild1 == size_t(-1))
+        return height;
+
+      /*! perform the best found tree rotation */
+      AABBNode* child2 = parent->child(bestChild2).getAABBNode();
+      AABBNode::swap(parent,bestChild1,child2,bestChild2Child);
+      parent->setBounds(bestChild2,child2->bounds());
+      changes++;
+
+      /*! conservative height as child1 got pushed down one level */
+      return max(height,heights[bestChild1]+2);
+    }
+
+    template<int N>
+    int BVHNRestructure<N>::gather_items(NodeRef ref, const BBox3fa& bounds, int parent, unsigned int slot)
+    {
+      const int i = (int) items.size();
+      items.push_back(Item(ref,bounds,parent,slot));
+      if (!ref.isAABBNode()) return i;
+
+      AABBNode* node = ref.getAABBNode();
+      unsigned int height = 0;
+      for (size_t c=0; c<N; c++)
+      {
+        if (node->child(c) == BVH::emptyNode) continue;
+        const int child = gather_items(node->child(c),node->bounds(c),i,(unsigned int)c);
+        items[i].children[c] = child;
+        height = max(height,items[child].height+1);
+      }
+      items[i].height = height;
+      return i;
+    }
+
+    template<int N>
+    size_t BVHNRestructure<N>::depth(int i) const
+    {
+      size_t d = 0;
+      for (int x=items[i].parent; x>=0; x=items[x].parent) d++;
+      return d;
+    }
+
+    template<int N>
+    bool BVHNRestructure<N>::is_ancestor(int a, int b) const
+    {
+      for (int x=items[b].parent; x>=0; x=items[x].parent)
+        if (x == a) return true;
+      return false;
+    }
+
+    template<int N>
+    float BVHNRestructure<N>::path_cost(int p, int child, const BBox3fa& b, int lca) const
+    {
+      float cost = 0.0f;
+      BBox3fa childBounds = b;
+      for (int x=p; x!=lca; child=x, x=items[x].parent)
+      {
+        BBox3fa bounds = childBounds;
+        for (size_t c=0; c<N; c++) {
+          const int y = items[x].children[c];
+          if (y >= 0 && y != child) bounds.extend(items[y].bounds);
+        }
+        cost += halfArea(bounds)-halfArea(items[x].bounds);
+        childBounds = bounds;
+      }
+      return cost;
+    }
+
+    template<int N>
+    float BVHNRestructure<N>::swap_cost(int a, int b) const
+    {
+      const Item& A = items[a];
+      const Item& B = items[b];
+      if (A.parent == B.parent) return 0.0f;
+
+      size_t depthA = depth(a), depthB = depth(b);
+      if (depthA+B.height > BVH::maxBuildDepth || depthB+A.height > BVH::maxBuildDepth)
+        return float(inf);
+
+      /* find lowest common ancestor, the union of its children does not change */
+      int x = a, y = b;
+      for (; depthA > depthB; depthA--) x = items[x].parent;
+      for (; depthB > depthA; depthB--) y = items[y].parent;
+      while (x != y) { x = items[x].parent; y = items[y].parent; }
+
+      return path_cost(A.parent,a,B.bounds,x) + path_cost(B.parent,b,A.bounds,x);
+    }
+
+    template<int N>
+    void BVHNRestructure<N>::update_ancestors(int i)
+    {
+      for (int x=items[i].parent; x>=0; x=items[x].parent)
+      {
+        Item& item = items[x];
+        item.bounds = empty;
+        item.height = 0;
+        for (size_t c=0; c<N; c++) {
+          const int y = item.children[c];
+          if (y < 0) continue;
+          item.bounds.extend(items[y].bounds);
+          item.height = max(item.height,items[y].height+1);
+        }
+        if (item.parent >= 0)
+          items[item.parent].ref.getAABBNode()->setBounds(item.slot,item.bounds);
+      }
+    }
+
+    template<int N>
+    void BVHNRestructure<N>::swap_items(int a, int b)
+    {
+      Item& A = items[a];
+      Item& B = items[b];
+      AABBNode::swap(items[A.parent].ref.getAABBNode(),A.slot,items[B.parent].ref.getAABBNode(),B.slot);
+      items[A.parent].children[A.slot] = b;
+      items[B.parent].children[B.slot] = a;
+      std::swap(A.parent,B.parent);
+      std::swap(A.slot,B.slot);
+      update_ancestors(a);
+      update_ancestors(b);
+    }
+
+    template<int N>
+    void BVHNRestructure<N>::reinsert()
+    {
+      items.clear();
+      gather_items(bvh->root,bvh->root.getAABBNode()->bounds(),-1,0);
+
+      /* select inner nodes that fit their children worst, following the combined metric of Bittner et al. */
+      std::vector<std::pair<float,int>> candidates;
+      for (size_t i=1; i<items.size(); i++)
+      {
+        const Item& item = items[i];
+        if (!item.ref.isAABBNode()) continue;
+
+        float sumArea = 0.0f, minArea = float(pos_inf); size_t num = 0;
+        for (size_t c=0; c<N; c++) {
+          if (item.children[c] < 0) continue;
+          const float area = halfArea(items[item.children[c]].bounds);
+          sumArea += area; minArea = min(minArea,area); num++;
+        }
+        const float area = halfArea(item.bounds);
+        const float mSum = area*float(num)/max(sumArea,float(ulp));
+        const float mMin = area/max(minArea,float(ulp));
+        candidates.push_back(std::make_pair(area*mSum*mMin,(int)i));
+      }
+
+      const size_t numCandidates = min(candidates.size(),max(size_t(1),candidates.size()/100));
+      std::partial_sort(candidates.begin(),candidates.begin()+numCandidates,candidates.end(),
+                        [] (const std::pair<float,int>& a, const std::pair<float,int>& b) { return a.first > b.first; });
+
+      for (size_t k=0; k<numCandidates && getSeconds() < deadline; k++)
+      {
+        /* descend along the path where the subtree fits best and remember the best exchange on the way */
+        const int a = candidates[k].second;
+        const BBox3fa boundsA = items[a].bounds;
+        int best = -1; float bestCost = 0.0f;
+        for (int x=0; x>=0 && items[x].ref.isAABBNode(); )
+        {
+          int next = -1; float nextGrowth = float(pos_inf);
+          for (size_t c=0; c<N; c++)
+          {
+            const int b = items[x].children[c];
+            if (b < 0 || b == a) continue;
+
+            if (!is_ancestor(b,a) && !is_ancestor(a,b)) {
+              const float cost = swap_cost(a,b);
+              if (cost < bestCost) { bestCost = cost; best = b; }
+            }
+
+            const float growth = halfArea(merge(items[b].bounds,boundsA))-halfArea(items[b].bounds);
+            if (growth < nextGrowth) { nextGrowth = growth; next = b; }
+          }
+          x = next;
+        }
+
+        if (best >= 0) {
+          swap_items(a,best);
+          changes++;
+        }
+      }
+      items.clear();
+    }
+
+    template class BVHNRestructure<4>;
+#if defined(__AVX__)
+    template class BVHNRestructure<8>;
+#endif
+  }
+}
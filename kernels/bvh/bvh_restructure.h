@@ -0,0 +1,97 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "bvh.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Restores the SAH quality of a refitted BVH without rebuilding
+     *  it. First tree rotations get performed in parallel bottom up,
+     *  then subtrees with badly fitting bounds get reinserted at the
+     *  place they fit best. */
+    template<int N>
+    class BVHNRestructure
+    {
+      /*! Type shortcuts */
+      typedef BVHN<N> BVH;
+      typedef typename BVH::AABBNode AABBNode;
+      typedef typename BVH::NodeRef NodeRef;
+
+      /*! node of the tree, used for reinsertions */
+      struct Item
+      {
+        Item ()
+          : ref(BVH::emptyNode), bounds(empty), parent(-1), slot(0), height(0)
+        {
+          for (size_t c=0; c<N; c++) children[c] = -1;
+        }
+
+        Item (NodeRef ref, const BBox3fa& bounds, int parent, unsigned int slot)
+          : ref(ref), bounds(bounds), parent(parent), slot(slot), height(ref.isLeaf() ? 0 : (unsigned int) BVH::maxBuildDepth)
+        {
+          for (size_t c=0; c<N; c++) children[c] = -1;
+        }
+
+        NodeRef ref;
+        BBox3fa bounds;
+        int parent;          //!< index of parent item, -1 for the root
+        unsigned int slot;   //!< child slot in the parent node
+        unsigned int height; //!< height of the subtree
+        int children[N];     //!< indices of child items, -1 for empty slots
+      };
+
+    public:
+
+      /*! Constructor. */
+      BVHNRestructure (BVH* bvh);
+
+      /*! restructures the BVH until no improvement is found or timeBudget seconds passed, returns number of changes */
+      size_t optimize(double timeBudget);
+
+    private:
+
+      /* parallel rotations of the upper levels */
+      size_t rotate_parallel(NodeRef ref, size_t depth);
+
+      /* sequential rotations of a subtree */
+      size_t rotate(NodeRef ref, size_t depth);
+
+      /* performs the best rotation at a node, returns new height of the node */
+      size_t rotate_node(NodeRef ref, size_t depth, const size_t* heights);
+
+      /* reinserts subtrees with high SAH cost */
+      void reinsert();
+
+      /* builds the item array for reinsertions */
+      int gather_items(NodeRef ref, const BBox3fa& bounds, int parent, unsigned int slot);
+
+      /* SAH cost change when exchanging the subtrees of two items */
+      float swap_cost(int a, int b) const;
+
+      /* SAH cost change of the nodes from item p up to (excluding) item lca, when child gets replaced by a subtree with bounds b */
+      float path_cost(int p, int child, const BBox3fa& b, int lca) const;
+
+      /* exchanges the subtrees of two items and updates bounds and heights */
+      void swap_items(int a, int b);
+
+      /* updates bounds and heights of all ancestors of an item */
+      void update_ancestors(int i);
+
+      /* returns depth of an item */
+      size_t depth(int i) const;
+
+      /* tests if item a is an ancestor of item b */
+      bool is_ancestor(int a, int b) const;
+
+    private:
+      BVH* bvh;                    //!< BVH to restructure
+      double deadline;             //!< time when restructuring has to stop
+      std::atomic<size_t> changes; //!< number of changes performed
+      avector<Item> items;         //!< nodes of the BVH for reinsertions
+    };
+  }
+}
@@ -0,0 +1,229 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "bvh_serializer.h"
+#include "../../common/algorithms/parallel_for.h"
+
+namespace embree
+{
+  /*! only leaves without pointers can get stored, all other data is referenced through geomID and primID */
+  static bool isRelocatable(const std::string& primTy)
+  {
+    return primTy == "triangle4"  || primTy == "triangle4v" || primTy == "triangle4i" ||
+           primTy == "quad4v"     || primTy == "quad4i"     || primTy == "object";
+  }
+
+  static __forceinline size_t allocate(std::vector<char>& data, size_t bytes, size_t align)
+  {
+    const size_t ofs = (data.size()+align-1) & ~(align-1);
+    data.resize(ofs+bytes);
+    return ofs;
+  }
+
+  template<int N>
+  void BVHNSerializer<N>::store(AccelData* accel, BVHFileEntry& entry, std::vector<char>& data)
+  {
+    BVH* bvh = (BVH*) accel;
+    const char* name = bvh->primTy->name();
+    if (!isRelocatable(name))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH over " + std::string(name) + " primitives cannot get stored");
+
+    memset(&entry,0,sizeof(BVHFileEntry));
+    entry.N = N;
+    entry.nodeBytes = sizeof(AABBNode);
+    strncpy(entry.primType,name,sizeof(entry.primType)-1);
+    entry.numPrimitives = bvh->numPrimitives;
+
+    const LBBox3fa& bounds = bvh->bounds;
+    const Vec3fa v[4] = { bounds.bounds0.lower, bounds.bounds0.upper, bounds.bounds1.lower, bounds.bounds1.upper };
+    for (size_t i=0; i<4; i++) {
+      entry.bounds[3*i+0] = v[i].x;
+      entry.bounds[3*i+1] = v[i].y;
+      entry.bounds[3*i+2] = v[i].z;
+    }
+
+    /* nodes are stored in depth first order */
+    data.clear();
+    entry.root = storeNode(bvh->root,bvh->primTy,data);
+    entry.bytes = data.size();
+  }
+
+  template<int N>
+  size_t BVHNSerializer<N>::storeNode(NodeRef node, const PrimitiveType* primTy, std::vector<char>& data)
+  {
+    assert(!node.isBarrier());
+    if (node == BVH::emptyNode)
+      return BVH::emptyNode;
+
+    if (node.isLeaf())
+    {
+      size_t num; const char* prims = node.leaf(num);
+      size_t bytes = 0;
+      for (size_t i=0; i<num; i++)
+        bytes += primTy->getBytes(prims+bytes);
+
+      const size_t ofs = allocate(data,bytes,BVH::byteAlignment);
+      memcpy(&data[ofs],prims,bytes);
+      return ofs | node.type();
+    }
+
+    size_t bytes = 0, align = 0;
+    if      (node.isAABBNode())      { bytes = sizeof(AABBNode);      align = BVH::byteNodeAlignment; }
+    else if (node.isQuantizedNode()) { bytes = sizeof(QuantizedNode); align = BVH::byteAlignment; }
+    else throw_RTCError(RTC_ERROR_INVALID_OPERATION,"BVH node type cannot get stored");
+
+    const size_t ofs = allocate(data,bytes,align);
+    memcpy(&data[ofs],node.baseNode(),bytes);
+
+    for (size_t c=0; c<N; c++) {
+      const size_t child = storeNode(node.baseNode()->child(c),primTy,data);
+      ((typename BVH::BaseNode*)&data[ofs])->child(c) = NodeRef(child); // data may got reallocated
+    }
+    return ofs | node.type();
+  }
+
+  template<int N>
+  void BVHNSerializer<N>::load(AccelData* accel, const BVHFileEntry& entry, const char* fileName)
+  {
+    BVH* bvh = (BVH*) accel;
+    if (entry.N != N || entry.nodeBytes != sizeof(AABBNode) || strncmp(entry.primType,bvh->primTy->name(),sizeof(entry.primType)) != 0)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"stored BVH does not match scene");
+
+    bvh->clear();
+    bvh->mappedPtr = (char*) os_map_file(fileName,entry.offset,entry.bytes);
+    bvh->mappedBytes = entry.bytes;
+
+    NodeRef root = entry.root;
+    relocateNode(root,bvh->mappedPtr,entry.bytes,0);
+
+    const float* b = entry.bounds;
+    const LBBox3fa bounds(BBox3fa(Vec3fa(b[0],b[1],b[2]),Vec3fa(b[3],b[4],b[5])),
+                          BBox3fa(Vec3fa(b[6],b[7],b[8]),Vec3fa(b[9],b[10],b[11])));
+    bvh->set(root,bounds,entry.numPrimitives);
+  }
+
+  template<int N>
+  void BVHNSerializer<N>::relocateNode(NodeRef& node, char* base, size_t bytes, size_t depth)
+  {
+    if (node == BVH::emptyNode)
+      return;
+
+    const size_t ofs = node & ~size_t(NodeRef::align_mask);
+    if (ofs >= bytes || (!node.isLeaf() && !node.isAABBNode() && !node.isQuantizedNode()))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"corrupted BVH file");
+
+    node = NodeRef((size_t)base + node);
+    if (node.isLeaf())
+      return;
+
+    /* touching the nodes is what copies them out of the file mapping, thus do upper levels in parallel */
+    typename BVH::BaseNode* n = node.baseNode();
+    if (depth < 3)
+      parallel_for(size_t(N), [&] (size_t c) { relocateNode(n->child(c),base,bytes,depth+1); });
+    else
+      for (size_t c=0; c<N; c++) relocateNode(n->child(c),base,bytes,depth+1);
+  }
+
+#if defined(__AVX__)
+  template class BVHNSerializer<8>;
+#endif
+
+#if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)
+  template class BVHNSerializer<4>;
+#endif
+
+#if defined(EMBREE_LOWEST_ISA)
+
+  static const char bvhFileMagic[8] = { 'e','m','b','r','e','e','B','V' };
+
+  void storeSceneBVH(Scene* scene, const char* fileName)
+  {
+    if (scene->isModified())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (scene->isDynamicAccel())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structures of dynamic scenes cannot get stored");
+    if (scene->isDoubleBuffered())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structures of double buffered scenes cannot get stored");
+
+    const size_t numEntries = scene->accels.size();
+    std::vector<BVHFileEntry> entries(numEntries);
+    std::vector<std::vector<char>> data(numEntries);
+    for (size_t i=0; i<numEntries; i++)
+    {
+      AccelData* accel = scene->accels[i]->intersectors.ptr;
+      if (accel->type == AccelData::TY_BVH4)
+        BVHNSerializer<4>::store(accel,entries[i],data[i]);
+#if defined(EMBREE_TARGET_SIMD8)
+      else if (accel->type == AccelData::TY_BVH8)
+        BVHNSerializer<8>::store(accel,entries[i],data[i]);
+#endif
+      else
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structure cannot get stored");
+    }
+
+    BVHFileHeader header;
+    memset(&header,0,sizeof(BVHFileHeader));
+    memcpy(header.magic,bvhFileMagic,sizeof(header.magic));
+    header.version = RTC_VERSION;
+    header.numEntries = (uint32_t) numEntries;
+    header.numPrimitives = scene->numPrimitives();
+
+    /* data sections start at mappable offsets */
+    size_t offset = sizeof(BVHFileHeader) + numEntries*sizeof(BVHFileEntry);
+    for (size_t i=0; i<numEntries; i++) {
+      offset = (offset+os_map_granularity-1) & ~(os_map_granularity-1);
+      entries[i].offset = offset;
+      offset += entries[i].bytes;
+    }
+
+    std::ofstream file(fileName,std::ios::out | std::ios::binary);
+    if (!file.is_open())
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"cannot open file " + std::string(fileName));
+
+    file.write((const char*)&header,sizeof(BVHFileHeader));
+    file.write((const char*)entries.data(),numEntries*sizeof(BVHFileEntry));
+    const std::vector<char> zeros(os_map_granularity,0);
+    for (size_t i=0; i<numEntries; i++) {
+      file.write(zeros.data(),entries[i].offset-(size_t)file.tellp());
+      file.write(data[i].data(),data[i].size());
+    }
+
+    if (!file)
+      throw_RTCError(RTC_ERROR_UNKNOWN,"error writing file " + std::string(fileName));
+  }
+
+  void loadSceneBVH(Scene* scene, const char* fileName)
+  {
+    std::ifstream file(fileName,std::ios::in | std::ios::binary);
+    if (!file.is_open())
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"cannot open file " + std::string(fileName));
+
+    BVHFileHeader header;
+    if (!file.read((char*)&header,sizeof(BVHFileHeader)) || memcmp(header.magic,bvhFileMagic,sizeof(header.magic)) != 0)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid BVH file " + std::string(fileName));
+    if (header.version != RTC_VERSION)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"BVH file " + std::string(fileName) + " got written by a different Embree version");
+    if (header.numEntries != scene->accels.size() || header.numPrimitives != scene->numPrimitives())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"stored BVH does not match scene");
+
+    std::vector<BVHFileEntry> entries(header.numEntries);
+    if (!file.read((char*)entries.data(),entries.size()*sizeof(BVHFileEntry)))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid BVH file " + std::string(fileName));
+    file.close();
+
+    for (size_t i=0; i<entries.size(); i++)
+    {
+      AccelData* accel = scene->accels[i]->intersectors.ptr;
+      if (accel->type == AccelData::TY_BVH4 && entries[i].N == 4)
+        BVHNSerializer<4>::load(accel,entries[i],fileName);
+#if defined(EMBREE_TARGET_SIMD8)
+      else if (accel->type == AccelData::TY_BVH8 && entries[i].N == 8)
+        BVHNSerializer<8>::load(accel,entries[i],fileName);
+#endif
+      else
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"stored BVH does not match scene");
+    }
+  }
+
+#endif
+}
@@ -0,0 +1,60 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "bvh.h"
+
+namespace embree
+{
+  /*! Header of a stored BVH file, followed by one BVHFileEntry per
+   *  acceleration structure of the scene. Each data section starts at
+   *  a multiple of os_map_granularity, such that it can get mapped
+   *  into memory directly. */
+  struct BVHFileHeader
+  {
+    char magic[8];            //!< file identifier
+    uint32_t version;         //!< version of the library that wrote the file
+    uint32_t numEntries;      //!< number of stored acceleration structures
+    uint64_t numPrimitives;   //!< number of primitives of the scene
+  };
+
+  struct BVHFileEntry
+  {
+    uint32_t N;               //!< BVH branching factor
+    uint32_t nodeBytes;       //!< size of an AABB node, detects incompatible builds
+    char primType[32];        //!< name of the stored primitive type
+    uint64_t numPrimitives;   //!< number of primitives of the BVH
+    uint64_t root;            //!< root node, encoded as offset into the data section
+    float bounds[12];         //!< linear bounds of the BVH
+    uint64_t offset;          //!< file offset of the data section
+    uint64_t bytes;           //!< size of the data section
+  };
+
+  template<int N>
+  class BVHNSerializer
+  {
+    typedef BVHN<N> BVH;
+    typedef typename BVH::NodeRef NodeRef;
+    typedef typename BVH::AABBNode AABBNode;
+    typedef typename BVH::QuantizedNode QuantizedNode;
+
+  public:
+
+    /*! copies all nodes and leaves of the BVH into data, node references get stored as offsets into data */
+    static void store(AccelData* bvh, BVHFileEntry& entry, std::vector<char>& data);
+
+    /*! maps the data section of the entry and relocates its node references, the BVH takes ownership of the mapping */
+    static void load(AccelData* bvh, const BVHFileEntry& entry, const char* fileName);
+
+  private:
+    static size_t storeNode(NodeRef node, const PrimitiveType* primTy, std::vector<char>& data);
+    static void relocateNode(NodeRef& node, char* base, size_t bytes, size_t depth);
+  };
+
+  /*! stores all acceleration structures of a committed scene to a file */
+  void storeSceneBVH(Scene* scene, const char* fileName);
+
+  /*! loads all acceleration structures of a scene from a file written by storeSceneBVH */
+  void loadSceneBVH(Scene* scene, const char* fileName);
+}
@@ -162,4 +162,219 @@ namespace embree
 #if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)
   template class BVHNStatistics<4>;
 #endif
+
+  template<int N>
+  void BVHNQuality<N>::gather(AccelData* accel, unsigned int geomID, BVHQuality& quality)
+  {
+    BVH* bvh = (BVH*) accel;
+    if (bvh->root == BVH::emptyNode) return;
+    const double A = max(0.0f,bvh->getLinearBounds().expectedHalfArea());
+    gather(bvh,bvh->root,0,A,BBox1f(0.0f,1.0f),geomID,quality);
+  }
+
+  template<int N>
+  void BVHNQuality<N>::gather(BVH* bvh, NodeRef node, size_t depth, double A, const BBox1f t0t1, unsigned int geomID, BVHQuality& quality)
+  {
+    if (node.isLeaf()) {
+      gatherLeaf(bvh,node,depth,A,t0t1,geomID,quality);
+      return;
+    }
+
+    /* gather children of all node types */
+    size_t numChildren = 0;
+    NodeRef children[N];
+    BBox3fa bounds[N];
+    double areas[N];
+    BBox1f times[N];
+    size_t bytes = 0;
+
+    if (node.isAABBNode())
+    {
+      AABBNode* n = node.getAABBNode();
+      for (size_t i=0; i<N; i++) {
+        if (n->child(i) == BVH::emptyNode) continue;
+        children[numChildren] = n->child(i); bounds[numChildren] = n->bounds(i); times[numChildren] = t0t1;
+        areas[numChildren++] = max(0.0f,halfArea(n->extend(i)));
+      }
+      bytes = sizeof(AABBNode);
+    }
+    else if (node.isOBBNode())
+    {
+      OBBNode* n = node.ungetAABBNode();
+      for (size_t i=0; i<N; i++) {
+        if (n->child(i) == BVH::emptyNode) continue;
+        children[numChildren] = n->child(i); bounds[numChildren] = empty; times[numChildren] = t0t1;
+        areas[numChildren++] = max(0.0f,halfArea(n->extent(i)));
+      }
+      bytes = sizeof(OBBNode);
+    }
+    else if (node.isAABBNodeMB4D())
+    {
+      AABBNodeMB4D* n = node.getAABBNodeMB4D();
+      for (size_t i=0; i<N; i++) {
+        if (n->child(i) == BVH::emptyNode) continue;
+        const BBox1f t0t1i = intersect(t0t1,n->timeRange(i));
+        children[numChildren] = n->child(i); bounds[numChildren] = n->bounds(i); times[numChildren] = t0t1i;
+        areas[numChildren++] = n->AABBNodeMB::expectedHalfArea(i,t0t1i);
+      }
+      bytes = sizeof(AABBNodeMB4D);
+    }
+    else if (node.isAABBNodeMB())
+    {
+      AABBNodeMB* n = node.getAABBNodeMB();
+      for (size_t i=0; i<N; i++) {
+        if (n->child(i) == BVH::emptyNode) continue;
+        children[numChildren] = n->child(i); bounds[numChildren] = n->bounds(i); times[numChildren] = t0t1;
+        areas[numChildren++] = max(0.0f,n->expectedHalfArea(i,t0t1));
+      }
+      bytes = sizeof(AABBNodeMB);
+    }
+    else if (node.isOBBNodeMB())
+    {
+      OBBNodeMB* n = node.ungetAABBNodeMB();
+      for (size_t i=0; i<N; i++) {
+        if (n->child(i) == BVH::emptyNode) continue;
+        children[numChildren] = n->child(i); bounds[numChildren] = empty; times[numChildren] = t0t1;
+        areas[numChildren++] = max(0.0f,halfArea(n->extent0(i)));
+      }
+      bytes = sizeof(OBBNodeMB);
+    }
+    else if (node.isQuantizedNode())
+    {
+      QuantizedNode* n = node.quantizedNode();
+      for (size_t i=0; i<N; i++) {
+        if (n->child(i) == BVH::emptyNode) continue;
+        children[numChildren] = n->child(i); bounds[numChildren] = n->bounds(i); times[numChildren] = t0t1;
+        areas[numChildren++] = max(0.0f,halfArea(n->extent(i)));
+      }
+      bytes = sizeof(QuantizedNode);
+    }
+    else {
+      throw std::runtime_error("not supported node type in bvh_statistics");
+    }
+
+    /* inner nodes are only reported for the entire scene */
+    if (geomID == RTC_INVALID_GEOMETRY_ID)
+    {
+      const double dt = max(0.0f,t0t1.size());
+      double overlap = 0.0;
+      for (size_t i=0; i<numChildren; i++)
+        for (size_t j=i+1; j<numChildren; j++) {
+          const BBox3fa b = intersect(bounds[i],bounds[j]);
+          if (!b.empty()) overlap += dt*halfArea(b);
+        }
+      
+      BVHQuality::Level& level = quality.level(depth);
+      level.numNodes++;
+      level.sah += dt*A;
+      level.overlap += overlap;
+      quality.numNodes++;
+      quality.nodeSAH += dt*A;
+      quality.overlap += overlap;
+      quality.nodeBytes += bytes;
+    }
+
+    for (size_t i=0; i<numChildren; i++)
+      gather(bvh,children[i],depth+1,areas[i],times[i],geomID,quality);
+  }
+
+  template<int N>
+  void BVHNQuality<N>::gatherLeaf(BVH* bvh, NodeRef node, size_t depth, double A, const BBox1f t0t1, unsigned int geomID, BVHQuality& quality)
+  {
+    size_t num; const char* prim = node.leaf(num);
+    if (num == 0) return;
+
+    size_t numActive = 0, numTotal = 0, numGeom = 0, bytes = 0;
+    for (size_t i=0; i<num; i++)
+    {
+      const size_t active = bvh->primTy->sizeActive(prim);
+      const size_t blockBytes = bvh->primTy->getBytes(prim);
+      numActive += active;
+      numTotal += bvh->primTy->sizeTotal(prim);
+      bytes += blockBytes;
+      if (geomID != RTC_INVALID_GEOMETRY_ID)
+        for (size_t j=0; j<active; j++)
+          numGeom += bvh->primTy->geomID(prim,j) == geomID;
+      prim += blockBytes;
+    }
+
+    /* the leaf cost of some geometry is its share of the primitives of the leaf */
+    double share = 1.0;
+    if (geomID != RTC_INVALID_GEOMETRY_ID) {
+      if (numGeom == 0) return;
+      share = double(numGeom)/double(numActive);
+    }
+
+    const double dt = max(0.0f,t0t1.size());
+    const double sah = dt*A*double(num)*share;
+    BVHQuality::Level& level = quality.level(depth);
+    level.numLeaves++;
+    level.sah += sah;
+    quality.numLeaves++;
+    quality.leafSAH += sah;
+    quality.numPrims += geomID != RTC_INVALID_GEOMETRY_ID ? numGeom : numActive;
+    quality.numPrimBlocks += num;
+    quality.numSlotsActive += numActive;
+    quality.numSlotsTotal += numTotal;
+    quality.leafBytes += double(bytes)*share;
+    quality.depth = max(quality.depth,depth);
+  }
+
+#if defined(__AVX__)
+  template class BVHNQuality<8>;
+#endif
+
+#if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)
+  template class BVHNQuality<4>;
+#endif
+
+#if defined(EMBREE_LOWEST_ISA)
+
+  void BVHQuality::get(double sceneHalfArea, RTCBVHQuality* quality) const
+  {
+    const double rcpA = sceneHalfArea > 0.0 ? 1.0/sceneHalfArea : 0.0;
+    quality->sahCost = float((nodeSAH+leafSAH)*rcpA);
+    quality->nodeSAHCost = float(nodeSAH*rcpA);
+    quality->leafSAHCost = float(leafSAH*rcpA);
+    quality->overlap = float(overlap*rcpA);
+    quality->leafFillRatio = numSlotsTotal ? float(double(numSlotsActive)/double(numSlotsTotal)) : 0.0f;
+    quality->numNodes = numNodes;
+    quality->numLeaves = numLeaves;
+    quality->numPrimitives = numPrims;
+    quality->numPrimitiveBlocks = numPrimBlocks;
+    quality->nodeBytes = nodeBytes;
+    quality->leafBytes = size_t(leafBytes);
+    quality->depth = (unsigned int) depth;
+    for (size_t i=0; i<RTC_BVH_QUALITY_MAX_LEVELS; i++) {
+      quality->levels[i].numNodes = levels[i].numNodes;
+      quality->levels[i].numLeaves = levels[i].numLeaves;
+      quality->levels[i].sahCost = float(levels[i].sah*rcpA);
+      quality->levels[i].overlap = float(levels[i].overlap*rcpA);
+    }
+  }
+
+  void getSceneBVHQuality(Scene* scene, unsigned int geomID, RTCBVHQuality* quality)
+  {
+    if (!scene->isTraversable())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+
+    BVHQuality q;
+    double sceneHalfArea = 0.0;
+    scene->forTraversalAccels([&] (AccelN* accels)
+    {
+      sceneHalfArea = max(0.0f,accels->getLinearBounds().expectedHalfArea());
+      for (size_t i=0; i<accels->accels.size(); i++)
+      {
+        AccelData* accel = accels->accels[i]->intersectors.ptr;
+        if (accel->type == AccelData::TY_BVH4)
+          BVHNQuality<4>::gather(accel,geomID,q);
+#if defined(EMBREE_TARGET_SIMD8)
+        else if (accel->type == AccelData::TY_BVH8)
+          BVHNQuality<8>::gather(accel,geomID,q);
+#endif
+      }
+    });
+    q.get(sceneHalfArea,quality);
+  }
+#endif
 }
@@ -282,4 +282,75 @@ namespace embree
 
   typedef BVHNStatistics<4> BVH4Statistics;
   typedef BVHNStatistics<8> BVH8Statistics;
+
+  /*! BVH quality report with SAH costs, child overlap, and leaf fill
+   *  ratios per BVH level. The costs are accumulated unnormalized and
+   *  get divided by the half area of the scene bounds in the end. */
+  struct BVHQuality
+  {
+    struct Level
+    {
+      Level () : numNodes(0), numLeaves(0), sah(0.0), overlap(0.0) {}
+
+      size_t numNodes;
+      size_t numLeaves;
+      double sah;
+      double overlap;
+    };
+
+    BVHQuality ()
+      : nodeSAH(0.0), leafSAH(0.0), overlap(0.0),
+        numNodes(0), numLeaves(0), numPrims(0), numPrimBlocks(0), numSlotsActive(0), numSlotsTotal(0),
+        nodeBytes(0), leafBytes(0.0), depth(0), levels(RTC_BVH_QUALITY_MAX_LEVELS) {}
+
+    __forceinline Level& level(size_t depth) {
+      return levels[min(depth,levels.size()-1)];
+    }
+
+    /*! writes the report normalized by the half area of the scene bounds */
+    void get(double sceneHalfArea, RTCBVHQuality* quality) const;
+
+  public:
+    double nodeSAH;          //!< SAH of inner nodes
+    double leafSAH;          //!< SAH of leaves
+    double overlap;          //!< half area of overlapping child bounds
+    size_t numNodes;         //!< number of inner nodes
+    size_t numLeaves;        //!< number of leaves
+    size_t numPrims;         //!< number of primitives
+    size_t numPrimBlocks;    //!< number of primitive blocks
+    size_t numSlotsActive;   //!< number of active primitives of the primitive blocks
+    size_t numSlotsTotal;    //!< number of active and inactive primitives of the primitive blocks
+    size_t nodeBytes;        //!< number of bytes of inner nodes
+    double leafBytes;        //!< number of bytes of leaves
+    size_t depth;            //!< depth of the deepest leaf
+    std::vector<Level> levels;
+  };
+
+  template<int N>
+  class BVHNQuality
+  {
+    typedef BVHN<N> BVH;
+    typedef typename BVH::AABBNode AABBNode;
+    typedef typename BVH::OBBNode OBBNode;
+    typedef typename BVH::AABBNodeMB AABBNodeMB;
+    typedef typename BVH::AABBNodeMB4D AABBNodeMB4D;
+    typedef typename BVH::OBBNodeMB OBBNodeMB;
+    typedef typename BVH::QuantizedNode QuantizedNode;
+    typedef typename BVH::NodeRef NodeRef;
+
+  public:
+
+    /*! adds the quality of the BVH to the report, if geomID is valid
+     *  only the leaves containing primitives of that geometry are
+     *  reported with the share of that geometry */
+    static void gather(AccelData* accel, unsigned int geomID, BVHQuality& quality);
+
+  private:
+    static void gather(BVH* bvh, NodeRef node, size_t depth, double A, const BBox1f t0t1, unsigned int geomID, BVHQuality& quality);
+    static void gatherLeaf(BVH* bvh, NodeRef node, size_t depth, double A, const BBox1f t0t1, unsigned int geomID, BVHQuality& quality);
+  };
+
+  /*! writes a quality report of the acceleration structures of a
+   *  scene, or of the leaves containing primitives of some geometry */
+  void getSceneBVHQuality(Scene* scene, unsigned int geomID, RTCBVHQuality* quality);
 }
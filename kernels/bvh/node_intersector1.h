@@ -1077,6 +1077,18 @@ namespace embree
         return true;
       }
     };
+
+    template<int N>
+    struct BVHNNodePointQuerySphere1<N, BVH_AN1_QN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (likely(node.isAABBNode()))             mask = pointQueryNodeSphere(node.getAABBNode(), query, dist);
+        else if (likely(node.isQuantizedNode())) mask = pointQueryNodeSphere((const typename BVHN<N>::QuantizedNode*)node.quantizedNode(), query, dist);
+        else return false;
+        return true;
+      }
+    };
     
     template<int N>
     struct BVHNQuantizedBaseNodePointQuerySphere1
@@ -1175,6 +1187,18 @@ namespace embree
         return true;
       }
     };
+
+    template<int N>
+    struct BVHNNodePointQueryAABB1<N, BVH_AN1_QN1>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (likely(node.isAABBNode()))             mask = pointQueryNodeAABB(node.getAABBNode(), query, dist);
+        else if (likely(node.isQuantizedNode())) mask = pointQueryNodeAABB((const typename BVHN<N>::QuantizedNode*)node.quantizedNode(), query, dist);
+        else return false;
+        return true;
+      }
+    };
     
     template<int N>
     struct BVHNQuantizedBaseNodePointQueryAABB1
@@ -1359,6 +1383,30 @@ namespace embree
       }
     };
 
+    template<int N>
+    struct BVHNNodeIntersector1<N, BVH_AN1_QN1, false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,false>& ray, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (likely(node.isAABBNode()))           mask = intersectNode(node.getAABBNode(), ray, dist);
+        else if (likely(node.isQuantizedNode())) mask = intersectNode((const typename BVHN<N>::QuantizedNode*)node.quantizedNode(), ray, dist);
+        else return false;
+        return true;
+      }
+    };
+
+    template<int N>
+    struct BVHNNodeIntersector1<N, BVH_AN1_QN1, true>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,true>& ray, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (likely(node.isAABBNode()))           mask = intersectNodeRobust(node.getAABBNode(), ray, dist);
+        else if (likely(node.isQuantizedNode())) mask = intersectNode((const typename BVHN<N>::QuantizedNode*)node.quantizedNode(), ray, dist);
+        else return false;
+        return true;
+      }
+    };
+
     /*! Intersects N nodes with K rays */
     template<int N, bool robust>
       struct BVHNQuantizedBaseNodeIntersector1;
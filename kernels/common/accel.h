@@ -63,7 +63,10 @@ namespace embree
     struct Intersectors;
 
     /*! Type of collide function */
-    typedef void (*CollideFunc)(void* bvh0, void* bvh1, RTCCollideFunc callback, void* userPtr);
+    typedef void (*CollideFunc)(void* bvh0, void* bvh1, RTCCollideFunc callback, void* userPtr, bool broadphase);
+
+    /*! Type of continuous collide function */
+    typedef void (*CollideContinuousFunc)(void* bvh0, void* bvh1, const BBox1f& time_range, RTCContinuousCollideFunc callback, void* userPtr);
 
     /*! Type of point query function */
     typedef bool(*PointQueryFunc)(Intersectors* This,          /*!< this pointer to accel */
@@ -133,15 +136,19 @@ namespace embree
     struct Collider
     {
       Collider (ErrorFunc error = nullptr) 
-      : collide((CollideFunc)error), name(nullptr) {}
+      : collide((CollideFunc)error), collideContinuous((CollideContinuousFunc)error), name(nullptr) {}
 
       Collider (CollideFunc collide, const char* name)
-      : collide(collide), name(name) {}
+      : collide(collide), collideContinuous(nullptr), name(name) {}
+
+      Collider (CollideFunc collide, CollideContinuousFunc collideContinuous, const char* name)
+      : collide(collide), collideContinuous(collideContinuous), name(name) {}
 
       operator bool() const { return name; }
 
     public:
       CollideFunc collide;  
+      CollideContinuousFunc collideContinuous;
       const char* name;
     };
     
@@ -296,9 +303,9 @@ namespace embree
       }
 
       /*! collides two scenes */
-      __forceinline void collide (Accel* scene0, Accel* scene1, RTCCollideFunc callback, void* userPtr) {
+      __forceinline void collide (Accel* scene0, Accel* scene1, RTCCollideFunc callback, void* userPtr, bool broadphase = false) {
         assert(collider.collide);
-        collider.collide(scene0->intersectors.ptr,scene1->intersectors.ptr,callback,userPtr);
+        collider.collide(scene0->intersectors.ptr,scene1->intersectors.ptr,callback,userPtr,broadphase);
       }
 
       /*! Intersects a single ray with the scene. */
@@ -478,6 +485,20 @@ namespace embree
                            TOSTRING(isa) "::" TOSTRING(symbol));        \
   }
 
+#define DEFINE_COLLIDER_CCD(symbol,collider,ccd)                        \
+  Accel::Collider symbol() {                                            \
+    return Accel::Collider((Accel::CollideFunc)collider::collide,       \
+                           (Accel::CollideContinuousFunc)ccd::collideContinuous, \
+                           TOSTRING(isa) "::" TOSTRING(symbol));        \
+  }
+
+#define DEFINE_COLLIDER_MB(symbol,ccd)                                  \
+  Accel::Collider symbol() {                                            \
+    return Accel::Collider(nullptr,                                     \
+                           (Accel::CollideContinuousFunc)ccd::collideContinuous, \
+                           TOSTRING(isa) "::" TOSTRING(symbol));        \
+  }
+
 #define DEFINE_INTERSECTOR1(symbol,intersector)                               \
   Accel::Intersector1 symbol() {                                              \
     return Accel::Intersector1((Accel::IntersectFunc )intersector::intersect, \
@@ -146,8 +146,11 @@ namespace embree
     AccelN* This = (AccelN*)This_in->ptr;
     size_t M = N;
     for (size_t i=0; i<This->accels.size(); i++)
+    {
+      if (unlikely(context->isTerminated())) break;
       if (!This->accels[i]->isEmpty())
         This->accels[i]->intersectors.occludedN(ray,M,context);
+    }
   }
 
   void AccelN::accels_print(size_t ident)
@@ -170,7 +170,7 @@ namespace embree
     FastAllocator (Device* device, bool osAllocation) 
       : device(device), slotMask(0), usedBlocks(nullptr), freeBlocks(nullptr), use_single_mode(false), defaultBlockSize(PAGE_SIZE), estimatedSize(0),
         growSize(PAGE_SIZE), maxGrowSize(maxAllocationSize), log2_grow_size_scale(0), bytesUsed(0), bytesFree(0), bytesWasted(0), atype(osAllocation ? OS_MALLOC : ALIGNED_MALLOC),
-        primrefarray(device,0)
+        numaNodes((device && device->numa_alloc) ? device->getNumNumaNodes() : 1), primrefarray(device,0)
     {
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++)
       {
@@ -378,6 +378,22 @@ namespace embree
       if (device->alloc_num_main_slots >= 8 ) slotMask = 0x7;
       if (device->alloc_thread_block_size != 0) defaultBlockSize = device->alloc_thread_block_size;
       if (device->alloc_single_thread_alloc != -1) use_single_mode = device->alloc_single_thread_alloc;
+
+      /* in NUMA mode the slots get partitioned among the NUMA nodes */
+      if (numaNodes > 1) slotMask = MAX_THREAD_USED_BLOCK_SLOTS-1;
+    }
+
+    /*! returns the allocation slot of the calling thread */
+    __forceinline size_t getSlot(ssize_t& numaNode) const
+    {
+      const size_t threadID = TaskScheduler::threadID();
+      if (likely(numaNodes <= 1)) {
+        numaNode = -1;
+        return threadID & slotMask;
+      }
+      numaNode = getNumaNode() % numaNodes;
+      const size_t slotsPerNode = max(size_t(1),MAX_THREAD_USED_BLOCK_SLOTS/numaNodes);
+      return (numaNode*slotsPerNode + threadID%slotsPerNode) & slotMask;
     }
 
     /*! initializes the allocator */
@@ -477,8 +493,8 @@ namespace embree
       while (true)
       {
         /* allocate using current block */
-        size_t threadID = TaskScheduler::threadID();
-        size_t slot = threadID & slotMask;
+        ssize_t numaNode;
+        size_t slot = getSlot(numaNode);
 	Block* myUsedBlocks = threadUsedBlocks[slot];
         if (myUsedBlocks) {
           void* ptr = myUsedBlocks->malloc(device,bytes,align,partial);
@@ -497,7 +513,7 @@ namespace embree
             const size_t alignedBytes = (bytes+(align-1)) & ~(align-1);
             const size_t allocSize = max(min(growSize,maxGrowSize),alignedBytes);
             assert(allocSize >= bytes);
-            threadBlocks[slot] = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,threadBlocks[slot],atype); // FIXME: a large allocation might throw away a block here!
+            threadBlocks[slot] = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,threadBlocks[slot],atype,numaNode); // FIXME: a large allocation might throw away a block here!
             // FIXME: a direct allocation should allocate inside the block here, and not in the next loop! a different thread could do some allocation and make the large allocation fail.
           }
           continue;
@@ -508,7 +524,12 @@ namespace embree
           Lock<SpinLock> lock(mutex);
 	  if (myUsedBlocks == threadUsedBlocks[slot])
 	  {
-            if (freeBlocks.load() != nullptr) {
+            /* in NUMA mode we only reuse blocks that were used on the same NUMA node before */
+            if (numaNodes > 1)
+              freeBlocks = Block::move_numa_block_to_front(freeBlocks.load(),numaNode);
+
+            if (freeBlocks.load() != nullptr && freeBlocks.load()->fitsNumaNode(numaNode)) {
+              freeBlocks.load()->numa_node = (int) numaNode;
 	      Block* nextFreeBlock = freeBlocks.load()->next;
 	      freeBlocks.load()->next = usedBlocks;
 	      __memory_barrier();
@@ -517,7 +538,7 @@ namespace embree
 	      freeBlocks = nextFreeBlock;
 	    } else {
               const size_t allocSize = min(growSize*incGrowSizeScale(),maxGrowSize);
-	      usedBlocks = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,usedBlocks,atype); // FIXME: a large allocation should get delivered directly, like above!
+	      usedBlocks = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,usedBlocks,atype,numaNode); // FIXME: a large allocation should get delivered directly, like above!
 	    }
           }
         }
@@ -672,6 +693,19 @@ namespace embree
         std::cout << "  2M    : " << stat_2M.str(numPrimitives) << std::endl;
         std::cout << "  malloc: " << stat_malloc.str(numPrimitives) << std::endl;
         std::cout << "  shared: " << stat_shared.str(numPrimitives) << std::endl;
+
+        /* process wide page statistics of all OS allocations */
+        const OSAllocStatistics os = os_statistics();
+        std::stringstream str2;
+        str2.setf(std::ios::fixed, std::ios::floatfield);
+        str2 << "  os    : "
+             << "4K = " << std::setw(7) << std::setprecision(3) << 1E-6f*os.bytes4K << " MB, "
+             << "THP = " << std::setw(7) << std::setprecision(3) << 1E-6f*os.bytesTHP << " MB, "
+             << "2M = " << std::setw(7) << std::setprecision(3) << 1E-6f*os.bytes2M << " MB, "
+             << "1G = " << std::setw(7) << std::setprecision(3) << 1E-6f*os.bytes1G << " MB, "
+             << "anon huge = " << std::setw(7) << std::setprecision(3) << 1E-6f*os.bytesAnonHuge << " MB, "
+             << "failed huge allocs = " << os.failedHugePageAllocs;
+        std::cout << str2.str() << std::endl;
       }
 
     private:
@@ -702,7 +736,7 @@ namespace embree
 
     struct Block
     {
-      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype)
+      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype, ssize_t numa_node = -1)
       {
         /* We avoid using os_malloc for small blocks as this could
          * cause a risk of fragmenting the virtual address space and
@@ -738,21 +772,21 @@ namespace embree
             os_advise((void*)(ptr_aligned_begin + 1*PAGE_SIZE_2M),PAGE_SIZE_2M);
             os_advise((void*)(ptr_aligned_begin + 2*PAGE_SIZE_2M),PAGE_SIZE_2M); // may fail if no memory mapped after block
 
-            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment);
+            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment,false,numa_node);
           }
           else
           {
             const size_t alignment = maxAlignment;
             if (device) device->memoryMonitor(bytesAllocate+alignment,false);
             ptr = alignedMalloc(bytesAllocate,alignment);
-            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment);
+            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment,false,numa_node);
           }
         }
         else if (atype == OS_MALLOC)
         {
           if (device) device->memoryMonitor(bytesAllocate,false);
           bool huge_pages; ptr = os_malloc(bytesReserve,huge_pages);
-          return new (ptr) Block(OS_MALLOC,bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,0,huge_pages);
+          return new (ptr) Block(OS_MALLOC,bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,0,huge_pages,numa_node);
         }
         else
           assert(false);
@@ -760,12 +794,31 @@ namespace embree
         return NULL;
       }
 
-      Block (AllocationType atype, size_t bytesAllocate, size_t bytesReserve, Block* next, size_t wasted, bool huge_pages = false)
-      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), wasted(wasted), atype(atype), huge_pages(huge_pages)
+      Block (AllocationType atype, size_t bytesAllocate, size_t bytesReserve, Block* next, size_t wasted, bool huge_pages = false, ssize_t numa_node = -1)
+      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), wasted(wasted), atype(atype), numa_node((int)numa_node), huge_pages(huge_pages)
       {
         assert((((size_t)&data[0]) & (maxAlignment-1)) == 0);
       }
 
+      /*! blocks not used yet fit every NUMA node */
+      __forceinline bool fitsNumaNode(ssize_t node) const {
+        return numa_node < 0 || node < 0 || numa_node == node;
+      }
+
+      /*! moves the first block fitting the NUMA node to the front of the list */
+      static Block* move_numa_block_to_front(Block* head, ssize_t node)
+      {
+        Block** prev_next = &head;
+        for (Block* block = head; block; prev_next = &block->next, block = block->next)
+        {
+          if (!block->fitsNumaNode(node)) continue;
+          *prev_next = block->next;
+          block->next = head;
+          return block;
+        }
+        return head;
+      }
+
       static Block* remove_shared_blocks(Block* head)
       {
         Block** prev_next = &head;
@@ -922,8 +975,9 @@ namespace embree
       Block* next;               //!< pointer to next block in list
       size_t wasted;             //!< amount of memory wasted through block alignment
       AllocationType atype;      //!< allocation mode of the block
+      int numa_node;             //!< NUMA node the block memory got first touched on, -1 if unknown
       bool huge_pages;           //!< whether the block uses huge pages
-      char align[maxAlignment-5*sizeof(size_t)-sizeof(AllocationType)-sizeof(bool)]; //!< align data to maxAlignment
+      char align[maxAlignment-5*sizeof(size_t)-sizeof(AllocationType)-sizeof(int)-sizeof(bool)]; //!< align data to maxAlignment
       char data[1];              //!< here starts memory to use for allocations
     };
 
@@ -953,6 +1007,7 @@ namespace embree
     SpinLock thread_local_allocators_lock;
     std::vector<ThreadLocal2*> thread_local_allocators;
     AllocationType atype;
+    size_t numaNodes;                  //!< number of NUMA nodes with separate block pools
     mvector<PrimRef> primrefarray;     //!< primrefarray used to allocate nodes
   };
 }
@@ -6,6 +6,7 @@
 #include "default.h"
 #include "rtcore.h"
 #include "point_query.h"
+#include "traversal_stats.h"
 
 namespace embree
 {
@@ -15,23 +16,46 @@ namespace embree
   {
   public:
     __forceinline IntersectContext(Scene* scene, RTCIntersectContext* user_context)
-      : scene(scene), user(user_context) {}
+      : scene(scene), user(user_context), flags(user_context ? user_context->flags : RTC_INTERSECT_CONTEXT_FLAG_NONE), maxOccluded(0), numOccluded(0), stats(nullptr) {}
 
     __forceinline bool hasContextFilter() const {
       return user->filter != nullptr;
     }
 
     __forceinline bool isCoherent() const {
-      return embree::isCoherent(user->flags);
+      return embree::isCoherent(flags);
     }
 
     __forceinline bool isIncoherent() const {
-      return embree::isIncoherent(user->flags);
+      return embree::isIncoherent(flags);
+    }
+
+    /* counts filter function invocations of sampled ray queries */
+    __forceinline void countFilterCall() const {
+      if (unlikely(stats)) stats->filters++;
+    }
+
+    /* passes the counters of sampled ray queries on to the context of an instanced scene */
+    __forceinline void enterInstance(IntersectContext& instanceContext) const
+    {
+      if (unlikely(stats)) {
+        stats->instances++;
+        instanceContext.stats = stats;
+      }
+    }
+
+    /* occlusion queries of ray groups may terminate once maxOccluded rays got found occluded */
+    __forceinline bool isTerminated() const {
+      return maxOccluded && numOccluded >= maxOccluded;
     }
     
   public:
     Scene* scene;
     RTCIntersectContext* user;
+    RTCIntersectContextFlags flags; //!< copy of the user context flags, which queries may change internally
+    size_t maxOccluded;  //!< number of occluded rays after which a ray group query terminates, 0 to disable
+    size_t numOccluded;  //!< number of rays of the ray group found occluded so far
+    TraversalCounters* stats; //!< traversal counters of sampled ray queries, nullptr if the query is not sampled
   };
 
   template<int M, typename Geometry>
@@ -87,6 +111,7 @@ namespace embree
       , primID(RTC_INVALID_GEOMETRY_ID)
       , geomID(RTC_INVALID_GEOMETRY_ID)
       , query_radius(query_ws->radius)
+      , neighbors(nullptr)
     { 
       if (query_type == POINT_QUERY_TYPE_AABB) {
         assert(similarityScale == 0.f);
@@ -126,6 +151,8 @@ public:
     unsigned int geomID;
 
     Vec3fa query_radius;  // used if the query is converted to an AABB internally
+
+    PointQueryNeighbors* neighbors; // collects neighbors of native k-nearest-neighbor and radius queries
   };
 }
 
@@ -92,7 +92,7 @@ namespace embree
     if (State::enable_selockmemoryprivilege)
       State::hugepages_success &= win_enable_selockmemoryprivilege(State::verbosity(3));
 #endif
-    State::hugepages_success &= os_init(State::hugepages,State::verbosity(3));
+    State::hugepages_success &= os_init(State::hugepages,State::verbosity(3),State::hugepages_1g);
     
     /*! set tessellation cache size */
     setCacheSize( State::tessellation_cache_size );
@@ -362,7 +362,7 @@ namespace embree
 
     /* create task scheduler */
     size_t maxNumThreads = getMaxNumThreads();
-    TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads);
+    TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads,State::reserved_cores);
 #if USE_TASK_ARENA
     const size_t nThreads = min(maxNumThreads,TaskScheduler::threadCount());
     const size_t uThreads = min(max(numUserThreads,(size_t)1),nThreads);
@@ -382,7 +382,7 @@ namespace embree
     /* or configure new number of threads */
     else {
       size_t maxNumThreads = getMaxNumThreads();
-      TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads);
+      TaskScheduler::create(maxNumThreads,State::set_affinity,State::start_threads,State::reserved_cores);
     }
 #if USE_TASK_ARENA
     arena.reset();
@@ -553,6 +553,18 @@ namespace embree
     case RTC_DEVICE_PROPERTY_PARALLEL_COMMIT_SUPPORTED: return 0;
 #endif
 
+#if defined(EMBREE_GEOMETRY_SUBDIVISION)
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS:      return getTessellationCacheStats().hits;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES:    return getTessellationCacheStats().misses;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS: return getTessellationCacheStats().evictions;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_BYTES:     return getTessellationCacheStats().bytes;
+#else
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS:      return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES:    return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS: return 0;
+    case RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_BYTES:     return 0;
+#endif
+
     default: throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "unknown readable property"); break;
     };
   }
@@ -241,8 +241,34 @@ namespace embree
     args.similarityScale = context->similarityScale;
     
     bool update = false;
-    if(context->func)  update |= context->func(&args);
-    if(pointQueryFunc) update |= pointQueryFunc(&args);
+    if (context->neighbors)
+    {
+      /* native k-nearest-neighbor and radius queries compute distances in world space */
+      RTCPointQueryContext* userContext = context->userContext;
+      const unsigned int stackSize = userContext->instStackSize;
+      float d = 0.0f;
+      bool valid = false;
+      if (stackSize > 0 && context->similarityScale > 0.f) {
+        valid = pointQueryDistance(context->primID, Vec3fa(query->p), query->time, nullptr, d);
+        d /= context->similarityScale;
+      }
+      else if (stackSize > 0) {
+        const AffineSpace3fa inst2world = AffineSpace3fa_load_unaligned((AffineSpace3fa*)userContext->inst2world[stackSize-1]);
+        valid = pointQueryDistance(context->primID, Vec3fa(context->query_ws->p), query->time, &inst2world, d);
+      }
+      else
+        valid = pointQueryDistance(context->primID, Vec3fa(query->p), query->time, nullptr, d);
+
+      if (valid && d <= context->query_ws->radius && context->neighbors->insert(d, context->geomID, context->primID, userContext)) {
+        context->query_ws->radius = context->neighbors->maxDistance();
+        update = true;
+      }
+    }
+    else
+    {
+      if(context->func)  update |= context->func(&args);
+      if(pointQueryFunc) update |= pointQueryFunc(&args);
+    }
 
     if (update && context->userContext->instStackSize > 0)
     {
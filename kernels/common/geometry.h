@@ -353,6 +353,11 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! sets the camera used to calculate view dependent tessellation levels */
+    virtual void setTessellationCamera(const RTCTessellationCamera* camera) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Sets the maximal curve radius scale allowed by min-width feature. */
     virtual void setMaxRadiusScale(float s) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
@@ -374,9 +379,19 @@ namespace embree
     /*! interpolates user data to the specified u/v locations */
     virtual void interpolateN(const RTCInterpolateNArguments* const args);
 
+    /*! interpolates user data to a large number of u/v locations in arbitrary order */
+    virtual void interpolateBatch(const RTCInterpolateNArguments* const args) {
+      interpolateN(args);
+    }
+
     /* point query api */
     bool pointQuery(PointQuery* query, PointQueryContext* context);
 
+    /*! calculates the distance of point p to a primitive with vertices transformed by xfm (if not null), returns false if not supported */
+    virtual bool pointQueryDistance(size_t primID, const Vec3fa& p, float time, const AffineSpace3fa* xfm, float& dist) const {
+      return false;
+    }
+
     /*! for subdivision surfaces only */
   public:
     virtual void setSubdivisionMode (unsigned topologyID, RTCSubdivisionMode mode) {
@@ -455,6 +470,11 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
     }
 
+    /*! Sets the instanced scene of a coarser level of detail */
+    virtual void setInstancedSceneLevel(unsigned int level, const Ref<Scene>& scene, float footprint, float blend) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry");
+    }
+
     /*! Sets transformation of the instance */
     virtual void setTransform(const AffineSpace3fa& transform, unsigned int timeStep) {
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
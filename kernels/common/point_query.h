@@ -122,6 +122,112 @@ namespace embree
   typedef PointQueryK<16> PointQuery16;
   struct PointQueryN;
 
+  /* Calculates the closest point on the triangle abc to the point p */
+  __forceinline Vec3fa closestPointOnTriangle(const Vec3fa& p, const Vec3fa& a, const Vec3fa& b, const Vec3fa& c)
+  {
+    const Vec3fa ab = b - a;
+    const Vec3fa ac = c - a;
+    const Vec3fa ap = p - a;
+
+    const float d1 = dot(ab, ap);
+    const float d2 = dot(ac, ap);
+    if (d1 <= 0.f && d2 <= 0.f) return a;
+
+    const Vec3fa bp = p - b;
+    const float d3 = dot(ab, bp);
+    const float d4 = dot(ac, bp);
+    if (d3 >= 0.f && d4 <= d3) return b;
+
+    const Vec3fa cp = p - c;
+    const float d5 = dot(ab, cp);
+    const float d6 = dot(ac, cp);
+    if (d6 >= 0.f && d5 <= d6) return c;
+
+    const float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+      return a + d1 / (d1 - d3) * ab;
+
+    const float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+      return a + d2 / (d2 - d6) * ac;
+
+    const float va = d3 * d6 - d5 * d4;
+    if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+      return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+
+    const float denom = 1.f / (va + vb + vc);
+    return a + (vb * denom) * ab + (vc * denom) * ac;
+  }
+
+  /* Collects the nearest primitives of a k-nearest-neighbor or radius
+   * query. The distances are kept sorted in a separate padded array,
+   * such that the insertion slot can get located using SIMD compares. */
+  struct PointQueryNeighbors
+  {
+    enum { MAX_LOCAL_NEIGHBORS = 64 };
+
+    /* if shrink is set, the query radius shrinks to the distance of the k'th neighbor found so far */
+    PointQueryNeighbors (RTCPointQueryNeighbor* neighbors, unsigned int capacity, bool shrink)
+      : neighbors(neighbors), capacity(capacity), size(0), found(0), shrink(shrink)
+    {
+      const size_t padded = (capacity+3) & ~size_t(3);
+      distances = padded <= MAX_LOCAL_NEIGHBORS ? localDistances : (float*) alignedMalloc(padded*sizeof(float),16);
+      for (size_t i=0; i<padded; i++) distances[i] = inf;
+    }
+
+    ~PointQueryNeighbors () {
+      if (distances != localDistances) alignedFree(distances);
+    }
+
+    /* returns the culling radius of a full queue */
+    __forceinline float maxDistance() const {
+      return distances[capacity-1];
+    }
+
+    /* inserts a primitive at distance d, returns true if the query radius has to shrink */
+    __forceinline bool insert(float d, unsigned int geomID, unsigned int primID, const RTCPointQueryContext* context)
+    {
+      found++;
+      if (size == capacity && (capacity == 0 || !(d < distances[capacity-1])))
+        return false;
+
+      /* sorted distances produce a prefix mask, thus the slot is the first zero bit */
+      size_t slot = 0;
+      for (size_t i=0; i<size; i+=4)
+      {
+        const size_t n = bsf(~movemask(vfloat4::load(&distances[i]) <= vfloat4(d)));
+        slot += n;
+        if (n < 4) break;
+      }
+      slot = min(slot,size_t(size));
+
+      const size_t last = min(size_t(size),size_t(capacity)-1);
+      for (size_t i=last; i>slot; i--) {
+        distances[i] = distances[i-1];
+        neighbors[i] = neighbors[i-1];
+      }
+
+      distances[slot] = d;
+      RTCPointQueryNeighbor& n = neighbors[slot];
+      n.distance = d;
+      n.geomID = geomID;
+      n.primID = primID;
+      for (unsigned int l=0; l<RTC_MAX_INSTANCE_LEVEL_COUNT; l++)
+        n.instID[l] = l < context->instStackSize ? context->instID[l] : RTC_INVALID_GEOMETRY_ID;
+
+      size = min(size+1,capacity);
+      return shrink && size == capacity;
+    }
+
+    RTCPointQueryNeighbor* neighbors; //!< output array sorted by distance
+    unsigned int capacity;            //!< maximal number of neighbors stored
+    unsigned int size;                //!< number of neighbors stored
+    unsigned int found;               //!< number of primitives found inside the query radius
+    bool shrink;                      //!< shrink query radius when full (k-nearest-neighbor query)
+    float* distances;
+    __aligned(16) float localDistances[MAX_LOCAL_NEIGHBORS];
+  };
+
   /* Outputs point query to stream */
   template<int K>
   __forceinline embree_ostream operator <<(embree_ostream cout, const PointQueryK<K>& query)
@@ -7,6 +7,8 @@
 #include "device.h"
 #include "scene.h"
 #include "context.h"
+#include "../bvh/bvh_serializer.h"
+#include "../bvh/bvh_statistics.h"
 #include "../../include/embree3/rtcore_ray.h"
 using namespace embree;
 
@@ -243,13 +245,105 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API RTCCommit rtcCommitSceneAsync (RTCScene hscene, unsigned int numThreads)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCommitSceneAsync);
+    RTC_VERIFY_HANDLE(hscene);
+    AsyncCommit* commit = new AsyncCommit(scene,numThreads);
+    commit->refInc();
+    return (RTCCommit) commit;
+    RTC_CATCH_END2(scene);
+    return nullptr;
+  }
+
+  RTC_API RTCCommitState rtcGetCommitState (RTCCommit hcommit, float* progress)
+  {
+    AsyncCommit* commit = (AsyncCommit*) hcommit;
+    Scene* scene = commit ? commit->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetCommitState);
+    RTC_VERIFY_HANDLE(hcommit);
+    return commit->getState(progress);
+    RTC_CATCH_END2(scene);
+    return RTC_COMMIT_STATE_FAILED;
+  }
+
+  RTC_API RTCCommitState rtcWaitCommit (RTCCommit hcommit)
+  {
+    AsyncCommit* commit = (AsyncCommit*) hcommit;
+    Scene* scene = commit ? commit->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcWaitCommit);
+    RTC_VERIFY_HANDLE(hcommit);
+    return commit->wait();
+    RTC_CATCH_END2(scene);
+    return RTC_COMMIT_STATE_FAILED;
+  }
+
+  RTC_API void rtcCancelCommit (RTCCommit hcommit)
+  {
+    AsyncCommit* commit = (AsyncCommit*) hcommit;
+    Scene* scene = commit ? commit->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCancelCommit);
+    RTC_VERIFY_HANDLE(hcommit);
+    commit->cancel();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcRetainCommit (RTCCommit hcommit)
+  {
+    AsyncCommit* commit = (AsyncCommit*) hcommit;
+    Scene* scene = commit ? commit->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcRetainCommit);
+    RTC_VERIFY_HANDLE(hcommit);
+    commit->refInc();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcReleaseCommit (RTCCommit hcommit)
+  {
+    AsyncCommit* commit = (AsyncCommit*) hcommit;
+    Scene* scene = commit ? commit->scene.ptr : nullptr;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcReleaseCommit);
+    RTC_VERIFY_HANDLE(hcommit);
+    commit->refDec();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcSaveSceneBVH (RTCScene hscene, const char* filename)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSaveSceneBVH);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(filename);
+    storeSceneBVH(scene,filename);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcLoadSceneBVH (RTCScene hscene, const char* filename)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcLoadSceneBVH);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(filename);
+    scene->commitFromFile(filename);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcGetSceneBounds(RTCScene hscene, RTCBounds* bounds_o)
   {
     Scene* scene = (Scene*) hscene;
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcGetSceneBounds);
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     BBox3fa bounds = scene->bounds.bounds();
     bounds_o->lower_x = bounds.lower.x;
     bounds_o->lower_y = bounds.lower.y;
@@ -270,7 +364,7 @@ RTC_NAMESPACE_BEGIN;
     RTC_VERIFY_HANDLE(hscene);
     if (bounds_o == nullptr)
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid destination pointer");
-    if (scene->isModified())
+    if (!scene->isTraversable())
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     
     bounds_o->bounds0.lower_x = scene->bounds.bounds0.lower.x;
@@ -292,6 +386,15 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  static void checkCollide (Scene* scene0, Scene* scene1)
+  {
+    if (scene0->isDoubleBuffered() || scene1->isDoubleBuffered())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"collision detection not supported for double buffered scenes");
+    if (scene0->numPrimitives() == 0 || scene1->numPrimitives() == 0) return;
+    if (!scene0->intersectors.collider.collide || scene0->intersectors.collider.collide != scene1->intersectors.collider.collide)
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must either only contain user geometries or only triangle meshes with a single timestep");
+  }
+
   RTC_API void rtcCollide (RTCScene hscene0, RTCScene hscene1, RTCCollideFunc callback, void* userPtr)
   {
     Scene* scene0 = (Scene*) hscene0;
@@ -304,13 +407,91 @@ RTC_NAMESPACE_BEGIN;
     if (scene0->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (scene1->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (scene0->device != scene1->device) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes are from different devices");
-    auto nUserPrims0 = scene0->getNumPrimitives (Geometry::MTY_USER_GEOMETRY, false);
-    auto nUserPrims1 = scene1->getNumPrimitives (Geometry::MTY_USER_GEOMETRY, false);
-    if (scene0->numPrimitives() != nUserPrims0 && scene1->numPrimitives() != nUserPrims1) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain user geometries with a single timestep");
 #endif
+    checkCollide(scene0,scene1);
+    if (scene0->numPrimitives() == 0 || scene1->numPrimitives() == 0) return;
     scene0->intersectors.collide(scene0,scene1,callback,userPtr);
     RTC_CATCH_END(scene0->device);
   }
+
+  struct CollideBroadPhaseBuffer
+  {
+    RTCCollision* collisions;
+    size_t maxCollisions;
+    std::atomic<size_t> numCollisions;
+  };
+
+  static void collideBroadPhaseFunc (void* userPtr, RTCCollision* collisions, unsigned int num_collisions)
+  {
+    CollideBroadPhaseBuffer* buffer = (CollideBroadPhaseBuffer*) userPtr;
+    const size_t begin = buffer->numCollisions.fetch_add(num_collisions);
+    if (begin >= buffer->maxCollisions) return;
+    const size_t end = min(begin+num_collisions,buffer->maxCollisions);
+    memcpy(&buffer->collisions[begin],collisions,(end-begin)*sizeof(RTCCollision));
+  }
+
+  RTC_API size_t rtcCollideBroadPhase (RTCScene hscene0, RTCScene hscene1, RTCCollision* collisions, size_t maxCollisions)
+  {
+    Scene* scene0 = (Scene*) hscene0;
+    Scene* scene1 = (Scene*) hscene1;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCollideBroadPhase);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene0);
+    RTC_VERIFY_HANDLE(hscene1);
+    if (scene0->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (scene1->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (scene0->device != scene1->device) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes are from different devices");
+#endif
+    if (maxCollisions && !collisions) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid collision buffer");
+    checkCollide(scene0,scene1);
+    if (scene0->numPrimitives() == 0 || scene1->numPrimitives() == 0) return 0;
+    CollideBroadPhaseBuffer buffer;
+    buffer.collisions = collisions;
+    buffer.maxCollisions = maxCollisions;
+    buffer.numCollisions = 0;
+    scene0->intersectors.collide(scene0,scene1,collideBroadPhaseFunc,&buffer,true);
+    return buffer.numCollisions;
+    RTC_CATCH_END(scene0->device);
+    return 0;
+  }
+
+  RTC_API void rtcCollideContinuous (RTCScene hscene0, RTCScene hscene1, float time0, float time1, RTCContinuousCollideFunc callback, void* userPtr)
+  {
+    Scene* scene0 = (Scene*) hscene0;
+    Scene* scene1 = (Scene*) hscene1;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCollideContinuous);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene0);
+    RTC_VERIFY_HANDLE(hscene1);
+    if (scene0->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (scene1->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (scene0->device != scene1->device) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes are from different devices");
+#endif
+    if (!(time0 >= 0.0f && time0 <= time1 && time1 <= 1.0f)) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid time interval");
+    if (scene0->isDoubleBuffered() || scene1->isDoubleBuffered())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"collision detection not supported for double buffered scenes");
+    
+    /* scenes with static and motion blurred meshes consist of multiple acceleration structures */
+    for (auto accel : scene0->accels)
+      if (!accel->intersectors.collider.collideContinuous) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain triangle meshes");
+    for (auto accel : scene1->accels)
+      if (!accel->intersectors.collider.collideContinuous) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain triangle meshes");
+    
+    for (size_t i=0; i<scene0->accels.size(); i++)
+    {
+      for (size_t j=0; j<scene1->accels.size(); j++)
+      {
+        /* for a scene with itself each pair of acceleration structures is processed only once */
+        if (scene0 == scene1 && j < i) continue;
+        Accel* accel0 = scene0->accels[i];
+        Accel* accel1 = scene1->accels[j];
+        accel0->intersectors.collider.collideContinuous(accel0->intersectors.ptr,accel1->intersectors.ptr,BBox1f(time0,time1),callback,userPtr);
+      }
+    }
+    RTC_CATCH_END(scene0->device);
+  }
   
   inline bool pointQuery(Scene* scene, RTCPointQuery* query, RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void* userPtr)
   {
@@ -350,7 +531,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
     RTC_VERIFY_HANDLE(userContext);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
     if (((size_t)userContext) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "context not aligned to 16 bytes");   
 #endif
@@ -367,7 +548,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
 #endif
@@ -395,7 +576,7 @@ RTC_NAMESPACE_BEGIN;
     
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
 #endif
@@ -423,7 +604,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
 #endif
@@ -443,6 +624,157 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2_FALSE(scene);
   }
 
+  inline unsigned int pointQueryNeighbors(Scene* scene, const PointQuery& query_in, unsigned int capacity, RTCPointQueryNeighbor* neighbors, bool knn)
+  {
+    if (knn && capacity == 0) return 0;
+    
+    /* the query radius shrinks during kNN queries, thus operate on a copy */
+    PointQuery query = query_in;
+    RTCPointQueryContext userContext;
+    rtcInitPointQueryContext(&userContext);
+    PointQueryNeighbors queue(neighbors, capacity, knn);
+    PointQueryContext context(scene, &query, POINT_QUERY_TYPE_SPHERE, nullptr, &userContext, 1.f, nullptr);
+    context.neighbors = &queue;
+    scene->intersectors.pointQuery(&query, &context);
+    return knn ? queue.size : queue.found;
+  }
+
+  template<int K>
+  inline void pointQueryNeighborsK(const int* valid, Scene* scene, PointQueryK<K>* query, unsigned int capacity, RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors, bool knn)
+  {
+    STAT(size_t cnt=0; for (size_t i=0; i<K; i++) cnt += ((int*)valid)[i] == -1;);
+    STAT3(point_query.travs,cnt,cnt,cnt);
+
+    PointQuery query1;
+    for (size_t i=0; i<K; i++) {
+      if (!valid[i]) continue;
+      query->get(i,query1);
+      numNeighbors[i] = pointQueryNeighbors(scene, query1, capacity, neighbors+i*capacity, knn);
+    }
+  }
+
+  RTC_API unsigned int rtcPointQueryKNN(RTCScene hscene, RTCPointQuery* query, unsigned int k, RTCPointQueryNeighbor* neighbors)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQueryKNN);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
+#endif
+    STAT3(point_query.travs,1,1,1);
+    return pointQueryNeighbors(scene, *(PointQuery*)query, k, neighbors, true);
+    RTC_CATCH_END2(scene);
+    return 0;
+  }
+
+  RTC_API unsigned int rtcPointQueryRadius(RTCScene hscene, RTCPointQuery* query, unsigned int maxNeighbors, RTCPointQueryNeighbor* neighbors)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQueryRadius);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
+#endif
+    STAT3(point_query.travs,1,1,1);
+    return pointQueryNeighbors(scene, *(PointQuery*)query, maxNeighbors, neighbors, false);
+    RTC_CATCH_END2(scene);
+    return 0;
+  }
+
+  RTC_API void rtcPointQueryKNN4 (const int* valid, RTCScene hscene, RTCPointQuery4* query, unsigned int k, RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQueryKNN4);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
+#endif
+    pointQueryNeighborsK<4>(valid, scene, (PointQuery4*)query, k, neighbors, numNeighbors, true);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcPointQueryKNN8 (const int* valid, RTCScene hscene, RTCPointQuery8* query, unsigned int k, RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQueryKNN8);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
+#endif
+    pointQueryNeighborsK<8>(valid, scene, (PointQuery8*)query, k, neighbors, numNeighbors, true);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcPointQueryKNN16 (const int* valid, RTCScene hscene, RTCPointQuery16* query, unsigned int k, RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQueryKNN16);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
+#endif
+    pointQueryNeighborsK<16>(valid, scene, (PointQuery16*)query, k, neighbors, numNeighbors, true);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcPointQueryRadius4 (const int* valid, RTCScene hscene, RTCPointQuery4* query, unsigned int maxNeighbors, RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQueryRadius4);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
+#endif
+    pointQueryNeighborsK<4>(valid, scene, (PointQuery4*)query, maxNeighbors, neighbors, numNeighbors, false);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcPointQueryRadius8 (const int* valid, RTCScene hscene, RTCPointQuery8* query, unsigned int maxNeighbors, RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQueryRadius8);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
+#endif
+    pointQueryNeighborsK<8>(valid, scene, (PointQuery8*)query, maxNeighbors, neighbors, numNeighbors, false);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcPointQueryRadius16 (const int* valid, RTCScene hscene, RTCPointQuery16* query, unsigned int maxNeighbors, RTCPointQueryNeighbor* neighbors, unsigned int* numNeighbors)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQueryRadius16);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
+#endif
+    pointQueryNeighborsK<16>(valid, scene, (PointQuery16*)query, maxNeighbors, neighbors, numNeighbors, false);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcIntersect1 (RTCScene hscene, RTCIntersectContext* user_context, RTCRayHit* rayhit) 
   {
     Scene* scene = (Scene*) hscene;
@@ -450,12 +782,22 @@ RTC_NAMESPACE_BEGIN;
     RTC_TRACE(rtcIntersect1);
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)rayhit) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
     STAT3(normal.travs,1,1,1);
     IntersectContext context(scene,user_context);
-    scene->intersectors.intersect(*rayhit,&context);
+    if (unlikely(scene->traversalStats.sample()))
+    {
+      /* attribute the statistics to the hit geometry of this scene */
+      TraversalCounters counters;
+      context.stats = &counters;
+      scene->intersectors.intersect(*rayhit,&context);
+      const unsigned int geomID = rayhit->hit.instID[0] != RTC_INVALID_GEOMETRY_ID ? rayhit->hit.instID[0] : rayhit->hit.geomID;
+      scene->traversalStats.add(RTC_RAY_QUERY_TYPE_INTERSECT,counters,geomID);
+    }
+    else
+      scene->intersectors.intersect(*rayhit,&context);
 #if defined(DEBUG)
     ((RayHit*)rayhit)->verifyHit();
 #endif
@@ -470,7 +812,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)rayhit)   & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 16 bytes");   
 #endif
@@ -501,7 +843,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)valid) & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
     if (((size_t)rayhit)   & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 32 bytes");   
 #endif
@@ -534,7 +876,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)valid) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
     if (((size_t)rayhit)   & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit not aligned to 64 bytes");   
 #endif
@@ -568,7 +910,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)rayhit ) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,M,M,M);
@@ -599,7 +941,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)rn) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,M,M,M);
@@ -630,7 +972,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)rayhit) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(normal.travs,N*M,N*M,N*M);
@@ -668,7 +1010,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)rayhit->ray.org_x ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->ray.org_x not aligned to 4 bytes");   
     if (((size_t)rayhit->ray.org_y ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->ray.org_y not aligned to 4 bytes");   
     if (((size_t)rayhit->ray.org_z ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "rayhit->ray.org_z not aligned to 4 bytes");   
@@ -705,11 +1047,19 @@ RTC_NAMESPACE_BEGIN;
     STAT3(shadow.travs,1,1,1);
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)ray) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
     IntersectContext context(scene,user_context);
-    scene->intersectors.occluded(*ray,&context);
+    if (unlikely(scene->traversalStats.sample()))
+    {
+      TraversalCounters counters;
+      context.stats = &counters;
+      scene->intersectors.occluded(*ray,&context);
+      scene->traversalStats.add(RTC_RAY_QUERY_TYPE_OCCLUDED,counters);
+    }
+    else
+      scene->intersectors.occluded(*ray,&context);
     RTC_CATCH_END2(scene);
   }
   
@@ -721,7 +1071,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)valid) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 16 bytes");   
     if (((size_t)ray)   & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
@@ -752,7 +1102,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)valid) & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 32 bytes");   
     if (((size_t)ray)   & 0x1F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 32 bytes");   
 #endif
@@ -786,7 +1136,7 @@ RTC_NAMESPACE_BEGIN;
 
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)valid) & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "mask not aligned to 64 bytes");   
     if (((size_t)ray)   & 0x3F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 64 bytes");   
 #endif
@@ -821,7 +1171,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,M,M,M);
@@ -850,7 +1200,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,M,M,M);
@@ -881,7 +1231,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
     if (byteStride < sizeof(RTCRayHit)) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"byteStride too small");
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
 #endif
     STAT3(shadow.travs,N*M,N*N,N*N);
@@ -919,7 +1269,7 @@ RTC_NAMESPACE_BEGIN;
 #if defined (EMBREE_RAY_PACKETS)
 #if defined(DEBUG)
     RTC_VERIFY_HANDLE(hscene);
-    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
     if (((size_t)ray->org_x ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "org_x not aligned to 4 bytes");   
     if (((size_t)ray->org_y ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "org_y not aligned to 4 bytes");   
     if (((size_t)ray->org_z ) & 0x03 ) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "org_z not aligned to 4 bytes");   
@@ -940,6 +1290,126 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API unsigned int rtcOccludedGroup(RTCScene hscene, RTCIntersectContext* user_context, RTCRay* ray, unsigned int M, unsigned int maxOccluded)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcOccludedGroup);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (!scene->isTraversable()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene not committed");
+    if (((size_t)ray) & 0x03) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 4 bytes");   
+#endif
+    if (M > MAX_INTERNAL_STREAM_SIZE) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"ray group too large");
+    STAT3(shadow.travs,M,M,M);
+
+    /* invalid rays are never reported as occluded */
+    unsigned int valid = 0;
+    for (unsigned int i=0; i<M; i++)
+      if (ray[i].tnear <= ray[i].tfar && ray[i].tfar >= 0.0f) valid |= 1u << i;
+    if (valid == 0) return 0;
+    
+    IntersectContext context(scene,user_context);
+    context.maxOccluded = maxOccluded ? maxOccluded : M;
+    
+#if defined (EMBREE_RAY_PACKETS)
+    /* the coherent stream codepath traverses the group with a shared frustum */
+    context.flags = (RTCIntersectContextFlags) (context.flags | RTC_INTERSECT_CONTEXT_FLAG_COHERENT);
+    scene->device->rayStreamFilters.occludedAOS(scene,ray,M,sizeof(RTCRay),&context);
+#else
+    for (unsigned int i=0; i<M && !context.isTerminated(); i++)
+    {
+      if (!(valid & (1u << i))) continue;
+      scene->intersectors.occluded(ray[i],&context);
+      if (ray[i].tfar < 0.0f) context.numOccluded++;
+    }
+#endif
+
+    unsigned int occluded = 0;
+    for (unsigned int i=0; i<M; i++)
+      if ((valid & (1u << i)) && ray[i].tfar < 0.0f) occluded |= 1u << i;
+    return occluded;
+    RTC_CATCH_END2(scene);
+    return 0;
+  }
+
+  RTC_API void rtcGetSceneTraversalStatistics(RTCScene hscene, RTCRayQueryType type, RTCTraversalStatistics* stats)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneTraversalStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(stats);
+    if (type != RTC_RAY_QUERY_TYPE_INTERSECT && type != RTC_RAY_QUERY_TYPE_OCCLUDED)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid ray query type");
+    scene->traversalStats.get(type,stats);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcGetGeometryTraversalStatistics(RTCScene hscene, unsigned int geomID, RTCTraversalStatistics* stats)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetGeometryTraversalStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_GEOMID(geomID);
+    RTC_VERIFY_HANDLE(stats);
+    scene->traversalStats.get(geomID,stats);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API size_t rtcExportSceneTraversalStatistics(RTCScene hscene, char* json, size_t capacity)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcExportSceneTraversalStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    const std::string str = scene->traversalStats.json();
+    if (json && capacity) {
+      const size_t bytes = min(str.size(),capacity-1);
+      memcpy(json,str.c_str(),bytes);
+      json[bytes] = 0;
+    }
+    return str.size();
+    RTC_CATCH_END2(scene);
+    return 0;
+  }
+
+  RTC_API void rtcResetSceneTraversalStatistics(RTCScene hscene)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcResetSceneTraversalStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    scene->traversalStats.clear();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcGetSceneBVHQuality(RTCScene hscene, RTCBVHQuality* quality)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneBVHQuality);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(quality);
+    getSceneBVHQuality(scene,RTC_INVALID_GEOMETRY_ID,quality);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcGetGeometryBVHQuality(RTCScene hscene, unsigned int geomID, RTCBVHQuality* quality)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetGeometryBVHQuality);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_GEOMID(geomID);
+    RTC_VERIFY_HANDLE(quality);
+    if (geomID >= scene->size() || scene->get(geomID) == nullptr)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid geometry");
+    getSceneBVHQuality(scene,geomID,quality);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcRetainScene (RTCScene hscene) 
   {
     Scene* scene = (Scene*) hscene;
@@ -972,6 +1442,17 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryInstancedSceneLevel(RTCGeometry hgeometry, unsigned int level, RTCScene hscene, float footprint, float blend)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    Ref<Scene> scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryInstancedSceneLevel);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->setInstancedSceneLevel(level,scene,footprint,blend);
+    RTC_CATCH_END2(geometry);
+  }
+
   AffineSpace3fa loadTransform(RTCFormat format, const float* xfm)
   {
     AffineSpace3fa space = one;
@@ -1349,7 +1830,8 @@ RTC_NAMESPACE_BEGIN;
     if (quality != RTC_BUILD_QUALITY_LOW &&
         quality != RTC_BUILD_QUALITY_MEDIUM &&
         quality != RTC_BUILD_QUALITY_HIGH &&
-        quality != RTC_BUILD_QUALITY_REFIT)
+        quality != RTC_BUILD_QUALITY_REFIT &&
+        quality != RTC_BUILD_QUALITY_PLOC)
       throw std::runtime_error("invalid build quality");
     geometry->setBuildQuality(quality);
     RTC_CATCH_END2(geometry);
@@ -1507,6 +1989,16 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryTessellationCamera (RTCGeometry hgeometry, const RTCTessellationCamera* camera)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryTessellationCamera);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->setTessellationCamera(camera);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryUserData (RTCGeometry hgeometry, void* ptr) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1672,6 +2164,16 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcInterpolateBatch(const RTCInterpolateNArguments* const args)
+  {
+    Geometry* geometry = (Geometry*) args->geometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcInterpolateBatch);
+    RTC_VERIFY_HANDLE(args->geometry);
+    geometry->interpolateBatch(args);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcCommitGeometry (RTCGeometry hgeometry)
   {
     Geometry* geometry = (Geometry*) hgeometry;
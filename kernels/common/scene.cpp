@@ -5,6 +5,7 @@
 
 #include "../bvh/bvh4_factory.h"
 #include "../bvh/bvh8_factory.h"
+#include "../bvh/bvh_serializer.h"
 #include "../../common/algorithms/parallel_reduce.h"
  
 namespace embree
@@ -23,8 +24,13 @@ namespace embree
       scene_flags(RTC_SCENE_FLAG_NONE),
       quality_flags(RTC_BUILD_QUALITY_MEDIUM),
       is_build(false), modified(true),
-      progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0)
+      progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0), async_commit(nullptr),
+      traversalStats(device->traversal_stats_sampling)
   {
+    buffers[0] = buffers[1] = nullptr;
+    frontBuffer = nullptr;
+    accels_version = 0;
+
     device->refInc();
 
     intersectors = Accel::Intersectors(missing_rtcCommit);
@@ -38,6 +44,11 @@ namespace embree
 
   Scene::~Scene() noexcept
   {
+    releaseBuffers();
+
+    /* acceleration structures report freed memory to the device, thus
+     * destroy them before the last reference to the device may get released */
+    accels_init();
     device->refDec();
   }
   
@@ -92,6 +103,16 @@ namespace embree
 #if defined(EMBREE_GEOMETRY_TRIANGLE)
     if (device->tri_accel == "default") 
     {
+#if defined (EMBREE_TARGET_SIMD8)
+      /* robust traversal requires full precision nodes */
+      if (isQuantizedAccel() && !isRobustAccel() && device->canUseAVX())
+      {
+        const BVHFactory::BuildVariant bvariant = quality_flags == RTC_BUILD_QUALITY_LOW ? BVHFactory::BuildVariant::DYNAMIC : BVHFactory::BuildVariant::STATIC;
+        if (isCompactAccel()) accels_add(device->bvh8_factory->BVH8QuantizedTriangle4i(this,bvariant));
+        else                  accels_add(device->bvh8_factory->BVH8QuantizedTriangle4 (this,bvariant));
+      }
+      else
+#endif
       if (quality_flags != RTC_BUILD_QUALITY_LOW)
       {
         int mode =  2*(int)isCompactAccel() + 1*(int)isRobustAccel(); 
@@ -213,6 +234,15 @@ namespace embree
 #if defined(EMBREE_GEOMETRY_QUAD)
     if (device->quad_accel == "default") 
     {
+#if defined (EMBREE_TARGET_SIMD8)
+      /* robust traversal requires full precision nodes */
+      if (isQuantizedAccel() && !isRobustAccel() && device->canUseAVX())
+      {
+        const BVHFactory::BuildVariant bvariant = quality_flags == RTC_BUILD_QUALITY_LOW ? BVHFactory::BuildVariant::DYNAMIC : BVHFactory::BuildVariant::STATIC;
+        accels_add(device->bvh8_factory->BVH8QuantizedQuad4i(this,bvariant));
+      }
+      else
+#endif
       if (quality_flags != RTC_BUILD_QUALITY_LOW)
       {
         /* static */
@@ -656,6 +686,20 @@ namespace embree
       printStatistics();
 
     progress_monitor_counter = 0;
+
+    /* double buffered scenes build into the buffer not used for traversal */
+    SceneBuffer* back = nullptr;
+    bool reuseBackBuffer = false;
+    if (isDoubleBuffered())
+    {
+      back = acquireBackBuffer();
+      accels_init();
+      std::swap(accels,back->accels);
+      reuseBackBuffer = !accels.empty() && back->version == accels_version;
+      back->version = 0;
+    }
+    else
+      releaseBuffers();
     
     /* gather scene stats and call preCommit function of each geometry */
     this->world = parallel_reduce (size_t(0), geometries.size(), GeometryCounts (), 
@@ -678,9 +722,10 @@ namespace embree
     
     /* select acceleration structures to build */
     unsigned int new_enabled_geometry_types = world.enabledGeometryTypesMask();
-    if (flags_modified || new_enabled_geometry_types != enabled_geometry_types)
+    if (flags_modified || new_enabled_geometry_types != enabled_geometry_types || (back && !reuseBackBuffer))
     {
       accels_init();
+      accels_version++;
 
       /* we need to make all geometries modified, otherwise two level builder will 
         not rebuild currently not modified geometries */
@@ -708,16 +753,38 @@ namespace embree
       flags_modified = false;
       enabled_geometry_types = new_enabled_geometry_types;
     }
+
+    /* the reused buffer is two versions old, thus all geometries have to get rebuilt */
+    else if (back)
+    {
+      parallel_for(geometryModCounters_.size(), [&] ( const size_t i ) {
+          geometryModCounters_[i] = 0;
+        });
+    }
     
     /* select fast code path if no filter function is present */
     accels_select(hasFilterFunction());
   
     /* build all hierarchies of this scene */
-    accels_build();
+    if (back)
+    {
+      std::swap(accels,back->accels);
+      back->accels_build();
+    }
+    else if (bvh_file.empty())
+      accels_build();
+
+    /* or load them from file, which makes the builders obsolete */
+    else {
+      accels_immutable();
+      loadSceneBVH(this,bvh_file.c_str());
+      accels_build();
+    }
 
     /* make static geometry immutable */
     if (!isDynamicAccel()) {
-      accels_immutable();
+      if (back) back->accels_immutable();
+      else      accels_immutable();
       flags_modified = true; // in non-dynamic mode we have to re-create accels
     }
 
@@ -729,6 +796,15 @@ namespace embree
           geometryModCounters_[i] = geometries[i]->getModCounter();
         }
       });
+
+    /* swap buffers of double buffered scenes */
+    if (back)
+    {
+      back->version = accels_version;
+      bounds = back->bounds;
+      frontBuffer = back;
+      setFrontBufferInterface();
+    }
       
     updateInterface();
 
@@ -742,6 +818,106 @@ namespace embree
     setModified(false);
   }
 
+  Scene::SceneBuffer* Scene::acquireBackBuffer()
+  {
+    if (!buffers[0]) {
+      buffers[0] = new SceneBuffer;
+      buffers[1] = new SceneBuffer;
+    }
+    SceneBuffer* back = frontBuffer.load() == buffers[0] ? buffers[1] : buffers[0];
+
+    /* wait for traversals that still use the previous version */
+    while (back->users.load())
+      yield();
+    return back;
+  }
+
+  void Scene::releaseBuffers()
+  {
+    if (!buffers[0]) return;
+    frontBuffer = nullptr;
+    for (size_t i=0; i<2; i++) {
+      while (buffers[i]->users.load()) yield();
+      delete buffers[i]; buffers[i] = nullptr;
+    }
+  }
+
+  void Scene::setFrontBufferInterface()
+  {
+    const Accel::Intersectors& front = frontBuffer.load()->intersectors;
+    type = AccelData::TY_ACCELN;
+    intersectors = Accel::Intersectors();
+    intersectors.ptr = this;
+    intersectors.intersector1  = Intersector1(&intersectFront,&occludedFront,&pointQueryFront,front.intersector1 ? "Scene::intersector1" : nullptr);
+    intersectors.intersector4  = Intersector4(&intersect4Front,&occluded4Front,front.intersector4 ? "Scene::intersector4" : nullptr);
+    intersectors.intersector8  = Intersector8(&intersect8Front,&occluded8Front,front.intersector8 ? "Scene::intersector8" : nullptr);
+    intersectors.intersector16 = Intersector16(&intersect16Front,&occluded16Front,front.intersector16 ? "Scene::intersector16" : nullptr);
+    intersectors.intersectorN  = IntersectorN(&intersectNFront,&occludedNFront,front.intersectorN ? "Scene::intersectorN" : nullptr);
+  }
+
+  bool Scene::pointQueryFront (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context) {
+    FrontBuffer front((Scene*)This->ptr); return (*front).pointQuery(query,context);
+  }
+
+  void Scene::intersectFront (Accel::Intersectors* This, RTCRayHit& ray, IntersectContext* context) {
+    FrontBuffer front((Scene*)This->ptr); (*front).intersect(ray,context);
+  }
+
+  void Scene::intersect4Front (const void* valid, Accel::Intersectors* This, RTCRayHit4& ray, IntersectContext* context) {
+    FrontBuffer front((Scene*)This->ptr); (*front).intersect4(valid,ray,context);
+  }
+
+  void Scene::intersect8Front (const void* valid, Accel::Intersectors* This, RTCRayHit8& ray, IntersectContext* context) {
+    FrontBuffer front((Scene*)This->ptr); (*front).intersect8(valid,ray,context);
+  }
+
+  void Scene::intersect16Front (const void* valid, Accel::Intersectors* This, RTCRayHit16& ray, IntersectContext* context) {
+    FrontBuffer front((Scene*)This->ptr); (*front).intersect16(valid,ray,context);
+  }
+
+  void Scene::intersectNFront (Accel::Intersectors* This, RTCRayHitN** ray, const size_t N, IntersectContext* context) {
+    FrontBuffer front((Scene*)This->ptr); (*front).intersectN(ray,N,context);
+  }
+
+  void Scene::occludedFront (Accel::Intersectors* This, RTCRay& ray, IntersectContext* context) {
+    FrontBuffer front((Scene*)This->ptr); (*front).occluded(ray,context);
+  }
+
+  void Scene::occluded4Front (const void* valid, Accel::Intersectors* This, RTCRay4& ray, IntersectContext* context) {
+    FrontBuffer front((Scene*)This->ptr); (*front).occluded4(valid,ray,context);
+  }
+
+  void Scene::occluded8Front (const void* valid, Accel::Intersectors* This, RTCRay8& ray, IntersectContext* context) {
+    FrontBuffer front((Scene*)This->ptr); (*front).occluded8(valid,ray,context);
+  }
+
+  void Scene::occluded16Front (const void* valid, Accel::Intersectors* This, RTCRay16& ray, IntersectContext* context) {
+    FrontBuffer front((Scene*)This->ptr); (*front).occluded16(valid,ray,context);
+  }
+
+  void Scene::occludedNFront (Accel::Intersectors* This, RTCRayN** ray, const size_t N, IntersectContext* context) {
+    FrontBuffer front((Scene*)This->ptr); (*front).occludedN(ray,N,context);
+  }
+
+  void Scene::commitFromFile (const char* fileName)
+  {
+    if (isDynamicAccel())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structures of dynamic scenes cannot get loaded");
+    if (isDoubleBuffered())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"acceleration structures of double buffered scenes cannot get loaded");
+
+    setModified();
+    bvh_file = fileName;
+    try {
+      commit(false);
+    }
+    catch (...) {
+      bvh_file.clear();
+      throw;
+    }
+    bvh_file.clear();
+  }
+
   void Scene::setBuildQuality(RTCBuildQuality quality_flags_i)
   {
     if (quality_flags == quality_flags_i) return;
@@ -755,6 +931,9 @@ namespace embree
 
   void Scene::setSceneFlags(RTCSceneFlags scene_flags_i)
   {
+    /* compact leaves reference the vertex buffers, thus the previous version of the scene would see vertices updated in place */
+    if ((scene_flags_i & RTC_SCENE_FLAG_DOUBLE_BUFFERED) && (scene_flags_i & RTC_SCENE_FLAG_COMPACT))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"compact scenes cannot get double buffered");
     if (scene_flags == scene_flags_i) return;
     scene_flags = scene_flags_i;
     flags_modified = true;
@@ -943,6 +1122,15 @@ namespace embree
 
   void Scene::progressMonitor(double dn)
   {
+    AsyncCommit* commit = async_commit;
+    if (commit)
+    {
+      if (commit->isCancelled())
+        throw_RTCError(RTC_ERROR_CANCELLED,"asynchronous commit got cancelled");
+      if (!progress_monitor_function)
+        progress_monitor_counter.fetch_add(size_t(dn));
+    }
+
     if (progress_monitor_function) {
       size_t n = size_t(dn) + progress_monitor_counter.fetch_add(size_t(dn));
       if (!progress_monitor_function(progress_monitor_ptr, n / (double(numPrimitives())))) {
@@ -950,4 +1138,91 @@ namespace embree
       }
     }
   }
+
+  AsyncCommit::AsyncCommit (Scene* scene, size_t numThreads)
+    : scene(scene), joinBuild(false), numRunning(0), cancelled(false), state(RTC_COMMIT_STATE_RUNNING), error(RTC_ERROR_NONE)
+  {
+    AsyncCommit* none = nullptr;
+    if (!scene->async_commit.compare_exchange_strong(none,this))
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene is already committed asynchronously");
+
+#if defined(TASKING_INTERNAL)
+    joinBuild = numThreads > 0;
+    numThreads = min(numThreads,(size_t)getNumberOfLogicalThreads());
+#endif
+    if (!joinBuild) numThreads = 1;
+
+    numRunning = numThreads;
+    for (size_t i=0; i<numThreads; i++)
+      threads.push_back(createThread((thread_func)commitThread,this,4*1024*1024));
+  }
+
+  AsyncCommit::~AsyncCommit () {
+    join();
+  }
+
+  void AsyncCommit::commitThread(AsyncCommit* commit)
+  {
+    Scene* scene = commit->scene.ptr;
+    RTCError error = RTC_ERROR_NONE;
+    std::string message;
+    try {
+      scene->commit(commit->joinBuild);
+    } catch (std::bad_alloc&) {
+      error = RTC_ERROR_OUT_OF_MEMORY; message = "out of memory";
+    } catch (rtcore_error& e) {
+      error = e.error; message = e.what();
+    } catch (std::exception& e) {
+      error = RTC_ERROR_UNKNOWN; message = e.what();
+    } catch (...) {
+      error = RTC_ERROR_UNKNOWN; message = "unknown exception caught";
+    }
+
+    if (error != RTC_ERROR_NONE) {
+      Lock<SpinLock> lock(commit->errorMutex);
+      if (commit->error == RTC_ERROR_NONE) {
+        commit->error = error;
+        commit->errorMessage = message;
+      }
+    }
+
+    /* the last thread finishes the commit */
+    if (--commit->numRunning == 0)
+    {
+      scene->async_commit = nullptr;
+      if      (commit->error == RTC_ERROR_NONE) commit->state = RTC_COMMIT_STATE_DONE;
+      else if (commit->cancelled && commit->error == RTC_ERROR_CANCELLED) commit->state = RTC_COMMIT_STATE_CANCELLED;
+      else    commit->state = RTC_COMMIT_STATE_FAILED;
+    }
+  }
+
+  RTCCommitState AsyncCommit::getState(float* progress) const
+  {
+    const RTCCommitState s = (RTCCommitState) state.load();
+    if (progress)
+    {
+      if (s == RTC_COMMIT_STATE_DONE) *progress = 1.0f;
+      else {
+        const size_t N = scene->numPrimitives();
+        *progress = N ? min(1.0f,float(scene->progress_monitor_counter)/float(N)) : 0.0f;
+      }
+    }
+    return s;
+  }
+
+  void AsyncCommit::join()
+  {
+    Lock<MutexSys> lock(joinMutex);
+    for (size_t i=0; i<threads.size(); i++)
+      embree::join(threads[i]);
+    threads.clear();
+  }
+
+  RTCCommitState AsyncCommit::wait()
+  {
+    join();
+    if (state == RTC_COMMIT_STATE_FAILED)
+      throw_RTCError(error,errorMessage.c_str());
+    return (RTCCommitState) state.load();
+  }
 }
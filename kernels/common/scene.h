@@ -20,9 +20,12 @@
 
 #include "acceln.h"
 #include "geometry.h"
+#include "traversal_stats.h"
 
 namespace embree
 {
+  class AsyncCommit;
+
   /*! Base class all scenes are derived from */
   class Scene : public AccelN
   {
@@ -181,8 +184,75 @@ namespace embree
     void commit_task ();
     void build () {}
 
+    /*! commits the scene using the acceleration structures stored in a file instead of building them */
+    void commitFromFile (const char* fileName);
+
     void updateInterface();
 
+    /*! invokes the closure with the acceleration structures currently used for traversal */
+    template<typename Closure>
+      void forTraversalAccels(const Closure& closure)
+    {
+      if (isDoubleBuffered() && frontBuffer.load()) {
+        FrontBuffer front(this);
+        closure((AccelN*)front.buffer);
+      }
+      else
+        closure((AccelN*)this);
+    }
+
+  private:
+    /*! acceleration structures of one version of a double buffered scene */
+    struct SceneBuffer : public AccelN
+    {
+      SceneBuffer () : users(0), version(0) {}
+      void build () {}
+      void clear () { accels_clear(); }
+      std::atomic<size_t> users;       //!< number of traversals using this buffer
+      size_t version;                  //!< version of the scene acceleration structure setup the buffer was created with
+    };
+
+    /*! protects the front buffer from getting rebuilt during traversal */
+    struct FrontBuffer
+    {
+      __forceinline FrontBuffer (Scene* scene)
+      {
+        while (true) {
+          buffer = scene->frontBuffer.load();
+          buffer->users++;
+          if (likely(scene->frontBuffer.load() == buffer)) break;
+          buffer->users--;
+        }
+      }
+
+      __forceinline ~FrontBuffer () {
+        buffer->users--;
+      }
+
+      __forceinline Accel::Intersectors& operator* () const { return buffer->intersectors; }
+
+      SceneBuffer* buffer;
+    };
+
+    /*! returns the buffer not traversed, after waiting for all traversals of it to finish */
+    SceneBuffer* acquireBackBuffer();
+    void releaseBuffers();
+    void setFrontBufferInterface();
+
+    static bool pointQueryFront (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
+    static void intersectFront (Accel::Intersectors* This, RTCRayHit& ray, IntersectContext* context);
+    static void intersect4Front (const void* valid, Accel::Intersectors* This, RTCRayHit4& ray, IntersectContext* context);
+    static void intersect8Front (const void* valid, Accel::Intersectors* This, RTCRayHit8& ray, IntersectContext* context);
+    static void intersect16Front (const void* valid, Accel::Intersectors* This, RTCRayHit16& ray, IntersectContext* context);
+    static void intersectNFront (Accel::Intersectors* This, RTCRayHitN** ray, const size_t N, IntersectContext* context);
+    static void occludedFront (Accel::Intersectors* This, RTCRay& ray, IntersectContext* context);
+    static void occluded4Front (const void* valid, Accel::Intersectors* This, RTCRay4& ray, IntersectContext* context);
+    static void occluded8Front (const void* valid, Accel::Intersectors* This, RTCRay8& ray, IntersectContext* context);
+    static void occluded16Front (const void* valid, Accel::Intersectors* This, RTCRay16& ray, IntersectContext* context);
+    static void occludedNFront (Accel::Intersectors* This, RTCRayN** ray, const size_t N, IntersectContext* context);
+
+  public:
+
     /* return number of geometries */
     __forceinline size_t size() const { return geometries.size(); }
     
@@ -192,6 +262,9 @@ namespace embree
     /* determines if scene is modified */
     __forceinline bool isModified() const { return modified; }
 
+    /* determines if the scene can get traversed, which double buffered scenes also allow during commits */
+    __forceinline bool isTraversable() const { return !modified || frontBuffer.load() != nullptr; }
+
     /* sets modified flag */
     __forceinline void setModified(bool f = true) { 
       modified = f; 
@@ -256,8 +329,10 @@ namespace embree
     __forceinline bool isFastAccel() const { return !isCompactAccel() && !isRobustAccel(); }
     __forceinline bool isCompactAccel() const { return scene_flags & RTC_SCENE_FLAG_COMPACT; }
     __forceinline bool isRobustAccel()  const { return scene_flags & RTC_SCENE_FLAG_ROBUST; }
+    __forceinline bool isQuantizedAccel() const { return scene_flags & RTC_SCENE_FLAG_QUANTIZED; }
     __forceinline bool isStaticAccel()  const { return !(scene_flags & RTC_SCENE_FLAG_DYNAMIC); }
     __forceinline bool isDynamicAccel() const { return scene_flags & RTC_SCENE_FLAG_DYNAMIC; }
+    __forceinline bool isDoubleBuffered() const { return scene_flags & RTC_SCENE_FLAG_DOUBLE_BUFFERED; }
     
     __forceinline bool hasContextFilterFunction() const {
       return scene_flags & RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION;
@@ -294,6 +369,10 @@ namespace embree
     bool is_build;
   private:
     bool modified;                   //!< true if scene got modified
+    std::string bvh_file;            //!< file to load the acceleration structures from during commit
+    SceneBuffer* buffers[2];         //!< acceleration structures of double buffered scenes
+    std::atomic<SceneBuffer*> frontBuffer; //!< buffer used for traversal of double buffered scenes
+    size_t accels_version;           //!< incremented whenever the acceleration structures get recreated
 
   public:
     
@@ -321,9 +400,13 @@ namespace embree
     RTCProgressMonitorFunction progress_monitor_function;
     void* progress_monitor_ptr;
     std::atomic<size_t> progress_monitor_counter;
+    std::atomic<AsyncCommit*> async_commit;  //!< asynchronous commit currently building this scene
     void progressMonitor(double nprims);
     void setProgressMonitorFunction(RTCProgressMonitorFunction func, void* ptr);
 
+  public:
+    TraversalStatistics traversalStats; //!< statistics of sampled ray queries
+
   private:
     GeometryCounts world;               //!< counts for geometry
 
@@ -387,4 +470,42 @@ namespace embree
       return iter.maxGeomID();
     }
   };
+
+  /*! Commits a scene on background threads. With the internal tasking
+   *  system these threads join the build exclusively, otherwise a single
+   *  background thread commits using the tasking system threads. */
+  class AsyncCommit : public RefCount
+  {
+  public:
+    AsyncCommit (Scene* scene, size_t numThreads);
+    ~AsyncCommit ();
+
+    /*! returns the state and progress of the commit */
+    RTCCommitState getState(float* progress) const;
+
+    /*! waits for the background threads and reports errors to the calling thread */
+    RTCCommitState wait();
+
+    /*! makes the build terminate at the next progress update */
+    void cancel() { cancelled = true; }
+
+    __forceinline bool isCancelled() const { return cancelled; }
+
+  private:
+    static void commitThread(AsyncCommit* commit);
+    void join();
+
+  public:
+    Ref<Scene> scene;
+  private:
+    bool joinBuild;
+    std::vector<thread_t> threads;
+    std::atomic<size_t> numRunning;
+    std::atomic<bool> cancelled;
+    std::atomic<int> state;
+    RTCError error;
+    std::string errorMessage;
+    SpinLock errorMutex;
+    MutexSys joinMutex;
+  };
 }
@@ -25,6 +25,7 @@ namespace embree
   {
     alignedFree(local2world);
     if (object) object->refDec();
+    for (Level& level : levels) level.object->refDec();
   }
 
   void Instance::setNumTimeSteps (unsigned int numTimeSteps_in)
@@ -56,6 +57,33 @@ namespace embree
     Geometry::update();
   }
 
+  void Instance::setInstancedSceneLevel(unsigned int level, const Ref<Scene>& scene, float footprint, float blend)
+  {
+    if (level == 0 || level > levels.size()+1)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid level of detail");
+
+    /* passing no scene removes this and all coarser levels */
+    if (!scene) {
+      for (size_t i=level-1; i<levels.size(); i++) levels[i].object->refDec();
+      levels.erase(levels.begin()+(level-1),levels.end());
+      Geometry::update();
+      return;
+    }
+
+    if (!(footprint > 0.0f) || !(blend >= 0.0f))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid footprint or blend range");
+
+    Accel* accel = scene.ptr;
+    accel->refInc();
+    if (level <= levels.size()) {
+      levels[level-1].object->refDec();
+      levels[level-1] = Level(accel,footprint,blend);
+    } else {
+      levels.push_back(Level(accel,footprint,blend));
+    }
+    Geometry::update();
+  }
+
 #if 0
   void Instance::preCommit()
   {
@@ -125,6 +153,10 @@ namespace embree
 
   void Instance::commit()
   {
+    for (size_t i=1; i<levels.size(); i++)
+      if (levels[i].footprint <= levels[i-1].footprint*(1.0f+levels[i-1].blend))
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"footprints of instance levels of detail have to increase beyond the blend range of the previous level");
+
     if (unlikely(gsubtype == GTY_SUBTYPE_INSTANCE_QUATERNION))
       world2local0 = rcp(quaternionDecompositionToAffineSpace(local2world[0]));
     else
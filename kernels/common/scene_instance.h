@@ -16,6 +16,24 @@ namespace embree
     ALIGNED_STRUCT_(16);
     static const Geometry::GTypeMask geom_type = Geometry::MTY_INSTANCE;
 
+    /*! coarser level of detail of the instanced scene */
+    struct Level
+    {
+      Level (Accel* object, float footprint, float blend)
+        : object(object), footprint(footprint), blend(blend) {}
+
+      /*! returns true if this level gets used for the ray cone footprint and blend random number u */
+      template<typename T>
+      __forceinline auto selected(const T& footprint, const T& u) const -> decltype(footprint >= footprint) {
+        return footprint >= this->footprint*(1.0f+blend*u);
+      }
+
+    public:
+      Accel* object;    //!< instanced acceleration structure of this level
+      float footprint;  //!< ray cone footprint in object space starting from which this level gets used
+      float blend;      //!< relative size of the footprint range in which rays randomly select this or the previous level
+    };
+
   public:
     Instance (Device* device, Accel* object = nullptr, unsigned int numTimeSteps = 1);
     ~Instance();
@@ -47,6 +65,7 @@ namespace embree
   public:
     virtual void setNumTimeSteps (unsigned int numTimeSteps) override;
     virtual void setInstancedScene(const Ref<Scene>& scene) override;
+    virtual void setInstancedSceneLevel(unsigned int level, const Ref<Scene>& scene, float footprint, float blend) override;
     virtual void setTransform(const AffineSpace3fa& local2world, unsigned int timeStep) override;
     virtual void setQuaternionDecomposition(const AffineSpace3ff& qd, unsigned int timeStep) override;
     virtual AffineSpace3fa getTransform(float time) override;
@@ -61,13 +80,56 @@ namespace embree
     __forceinline BBox3fa bounds(size_t i) const {
       assert(i == 0);
       if (unlikely(gsubtype == GTY_SUBTYPE_INSTANCE_QUATERNION))
-        return xfmBounds(quaternionDecompositionToAffineSpace(local2world[0]),object->bounds.bounds());
-      return xfmBounds(local2world[0],object->bounds.bounds());
+        return xfmBounds(quaternionDecompositionToAffineSpace(local2world[0]),getObjectBounds());
+      return xfmBounds(local2world[0],getObjectBounds());
     }
 
-    /*! gets the bounds of the instanced scene */
-    __forceinline BBox3fa getObjectBounds(size_t itime) const {
-      return object->getBounds(timeStep(itime));
+    /*! gets the bounds of the instanced scene including all levels of detail */
+    __forceinline BBox3fa getObjectBounds() const
+    {
+      BBox3fa bounds = object->bounds.bounds();
+      for (const Level& level : levels)
+        bounds.extend(level.object->bounds.bounds());
+      return bounds;
+    }
+
+    /*! gets the bounds of the instanced scene including all levels of detail */
+    __forceinline BBox3fa getObjectBounds(size_t itime) const
+    {
+      BBox3fa bounds = object->getBounds(timeStep(itime));
+      for (const Level& level : levels)
+        bounds.extend(level.object->getBounds(timeStep(itime)));
+      return bounds;
+    }
+
+    /*! returns the instanced scene of some level of detail */
+    __forceinline Accel* getLevelObject(size_t level) const {
+      return level == 0 ? object : levels[level-1].object;
+    }
+
+    /*! selects the level of detail for a ray cone footprint in object space and a random number u in [0,1) */
+    __forceinline Accel* getLevelObject(float footprint, float u) const
+    {
+      Accel* accel = object;
+      for (const Level& level : levels) {
+        if (!level.selected(footprint,u)) break;
+        accel = level.object;
+      }
+      return accel;
+    }
+
+    /*! selects the level of detail for ray cone footprints in object space and random numbers u in [0,1) */
+    template<int K>
+    __forceinline vint<K> getLevel(const vbool<K>& valid, const vfloat<K>& footprint, const vfloat<K>& u) const
+    {
+      vint<K> ilevel(zero);
+      vbool<K> valid1 = valid;
+      for (size_t i=0; i<levels.size(); i++) {
+        valid1 &= levels[i].selected(footprint,u);
+        if (none(valid1)) break;
+        ilevel = select(valid1,vint<K>(int(i+1)),ilevel);
+      }
+      return ilevel;
     }
 
      /*! calculates the bounds of instance */
@@ -209,6 +271,7 @@ namespace embree
 
   public:
     Accel* object;                 //!< pointer to instanced acceleration structure
+    std::vector<Level> levels;     //!< coarser levels of detail sorted by footprint
     AffineSpace3ff* local2world;   //!< transformation from local space to world space for each timestep (either normal matrix or quaternion decomposition)
     AffineSpace3fa world2local0;   //!< transformation from world space to local space for timestep 0
   };
@@ -153,6 +153,22 @@ namespace embree
       counts.numMBPoints += numPrimitives;
   }
 
+  bool Points::pointQueryDistance(size_t primID, const Vec3fa& p, float time, const AffineSpace3fa* xfm, float& dist) const
+  {
+    /* all point types are treated as spheres */
+    Vec3ff v;
+    if (numTimeSteps == 1) {
+      v = vertex(primID);
+    } else {
+      float ftime; const int itime = timeSegment(time,ftime);
+      v = lerp(vertex(primID,itime),vertex(primID,itime+1),ftime);
+    }
+    Vec3fa c = Vec3fa(v);
+    if (xfm) c = xfmPoint(*xfm,c);
+    dist = max(distance(p,c)-v.w,0.0f);
+    return true;
+  }
+
   bool Points::verify()
   {
     /*! verify consistent size of vertex arrays */
@@ -36,6 +36,7 @@ namespace embree
     bool verify();
     void setMaxRadiusScale(float s);
     void addElementsToCount (GeometryCounts & counts) const;
+    bool pointQueryDistance(size_t primID, const Vec3fa& p, float time, const AffineSpace3fa* xfm, float& dist) const;
 
    public:
     /*! returns the number of vertices */
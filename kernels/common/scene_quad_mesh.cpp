@@ -150,6 +150,25 @@ namespace embree
     else                   counts.numMBQuads += numPrimitives;
   }
 
+  bool QuadMesh::pointQueryDistance(size_t primID, const Vec3fa& p, float time, const AffineSpace3fa* xfm, float& dist) const
+  {
+    const Quad& q = quad(primID);
+    Vec3fa v[4];
+    if (numTimeSteps == 1) {
+      for (size_t i=0; i<4; i++) v[i] = vertex(q.v[i]);
+    } else {
+      float ftime; const int itime = timeSegment(time,ftime);
+      for (size_t i=0; i<4; i++) v[i] = lerp(vertex(q.v[i],itime),vertex(q.v[i],itime+1),ftime);
+    }
+    if (xfm) {
+      for (size_t i=0; i<4; i++) v[i] = xfmPoint(*xfm,v[i]);
+    }
+    const float d0 = distance(p,closestPointOnTriangle(p,v[0],v[1],v[3]));
+    const float d1 = distance(p,closestPointOnTriangle(p,v[2],v[3],v[1]));
+    dist = min(d0,d1);
+    return true;
+  }
+
   bool QuadMesh::verify() 
   {
     /*! verify consistent size of vertex arrays */
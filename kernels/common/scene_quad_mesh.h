@@ -42,6 +42,7 @@ namespace embree
     bool verify();
     void interpolate(const RTCInterpolateArguments* const args);
     void addElementsToCount (GeometryCounts & counts) const;
+    bool pointQueryDistance(size_t primID, const Vec3fa& p, float time, const AffineSpace3fa* xfm, float& dist) const;
 
     template<int N>
       void interpolate_impl(const RTCInterpolateArguments* const args)
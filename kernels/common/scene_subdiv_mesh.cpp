@@ -21,10 +21,12 @@ namespace embree
     : Geometry(device,GTY_SUBDIV_MESH,0,1), 
       displFunc(nullptr),
       tessellationRate(2.0f),
+      useTessellationCamera(false),
       numHalfEdges(0),
       faceStartEdge(device,0),
       halfEdgeFace(device,0),
       invalid_face(device,0),
+      adaptiveLevels(device,0),
       commitCounter(0)
   {
     
@@ -359,6 +361,56 @@ namespace embree
     levels.setModified();
   }
 
+  void SubdivMesh::setTessellationCamera(const RTCTessellationCamera* camera)
+  {
+    if (camera)
+    {
+      if (!(camera->pixelAngle > 0.0f) || !(camera->edgeLength > 0.0f) || !(camera->minLevel <= camera->maxLevel))
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid tessellation camera");
+      tessellationCamera = *camera;
+    }
+    useTessellationCamera = camera != nullptr;
+    levels.setModified();
+  }
+
+  void SubdivMesh::calculateAdaptiveLevels()
+  {
+    adaptiveLevels.resize(numHalfEdges);
+
+    const Vec3fa P(tessellationCamera.position[0],tessellationCamera.position[1],tessellationCamera.position[2]);
+    const float rcpEdgeAngle = rcp(tessellationCamera.pixelAngle*tessellationCamera.edgeLength);
+    const float minLevel = clamp(tessellationCamera.minLevel,1.0f,4096.0f);
+    const float maxLevel = clamp(tessellationCamera.maxLevel,1.0f,4096.0f);
+    const BufferView<Vec3fa>& positions = vertices[0];
+    const BufferView<unsigned int>& indices = topology[0].vertexIndices;
+
+    parallel_for( size_t(0), numFaces(), size_t(4096), [&](const range<size_t>& r) 
+    {
+      for (size_t f=r.begin(); f<r.end(); f++) 
+      {
+        const unsigned e = faceStartEdge[f];
+        const unsigned N = faceVertices[f];
+        for (unsigned de=0; de<N; de++)
+        {
+          const unsigned int v0 = indices[e+de];
+          const unsigned int v1 = indices[e+(de+1)%N];
+          if (v0 >= positions.size() || v1 >= positions.size()) {
+            adaptiveLevels[e+de] = minLevel;
+            continue;
+          }
+
+          /* the level only depends on the edge end points, thus both half edges of an edge get the same level */
+          const Vec3fa p0 = positions[v0];
+          const Vec3fa p1 = positions[v1];
+          const Vec3fa d = p1-p0;
+          const float t = clamp(dot(P-p0,d)*rcp(max(dot(d,d),float(min_rcp_input))),0.0f,1.0f);
+          const float dist = max(length(p0+t*d-P),min_rcp_input);
+          adaptiveLevels[e+de] = clamp(length(d)*rcpEdgeAngle/dist,minLevel,maxLevel);
+        }
+      }
+    });
+  }
+
   __forceinline uint64_t pair64(unsigned int x, unsigned int y) 
   {
     if (x<y) std::swap(x,y);
@@ -691,6 +743,15 @@ namespace embree
           halfEdgeFace[h++] = (unsigned int) f;
     }
     
+    /* calculate view dependent edge levels, changed positions have to update the levels */
+    if (useTessellationCamera && vertices[0])
+    {
+      if (levels.isLocalModified() || vertices[0].isLocalModified() || topology[0].vertexIndices.isLocalModified() || faceVertices.isLocalModified()) {
+        calculateAdaptiveLevels();
+        levels.setModified();
+      }
+    }
+
     /* create set with all vertex creases */
     if (vertex_creases.isLocalModified() || vertex_crease_weights.isLocalModified())
       vertexCreaseMap.init(vertex_creases,vertex_crease_weights);
@@ -815,6 +876,27 @@ namespace embree
   
 #endif
 
+  __forceinline SubdivMesh::InterpolationBuffer SubdivMesh::getInterpolationBuffer(RTCBufferType bufferType, unsigned int bufferSlot)
+  {
+    assert((bufferType == RTC_BUFFER_TYPE_VERTEX && bufferSlot < RTC_MAX_TIME_STEP_COUNT) ||
+           (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE && bufferSlot < RTC_MAX_USER_VERTEX_BUFFERS));
+    InterpolationBuffer buffer;
+    if (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE) {
+      assert(bufferSlot < vertexAttribs.size());
+      buffer.src       = vertexAttribs[bufferSlot].getPtr();
+      buffer.stride    = vertexAttribs[bufferSlot].getStride();
+      buffer.baseEntry = &vertex_attrib_buffer_tags[bufferSlot];
+      buffer.topo      = &topology[vertexAttribs[bufferSlot].userData];
+    } else {
+      assert(bufferSlot < numTimeSteps);
+      buffer.src       = vertices[bufferSlot].getPtr();
+      buffer.stride    = vertices[bufferSlot].getStride();
+      buffer.baseEntry = &vertex_buffer_tags[bufferSlot];
+      buffer.topo      = &topology[0];
+    }
+    return buffer;
+  }
+
   namespace isa
   {
     SubdivMesh* createSubdivMesh(Device* device) {
@@ -837,26 +919,11 @@ namespace embree
       unsigned int valueCount = args->valueCount;
       
       /* calculate base pointer and stride */
-      assert((bufferType == RTC_BUFFER_TYPE_VERTEX && bufferSlot < RTC_MAX_TIME_STEP_COUNT) ||
-             (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE && bufferSlot < RTC_MAX_USER_VERTEX_BUFFERS));
-      const char* src = nullptr; 
-      size_t stride = 0;
-      std::vector<SharedLazyTessellationCache::CacheEntry>* baseEntry = nullptr;
-      Topology* topo = nullptr;
-      if (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE) {
-        assert(bufferSlot < vertexAttribs.size());
-        src    = vertexAttribs[bufferSlot].getPtr();
-        stride = vertexAttribs[bufferSlot].getStride();
-        baseEntry = &vertex_attrib_buffer_tags[bufferSlot];
-        int topologyID = vertexAttribs[bufferSlot].userData;
-        topo = &topology[topologyID];
-      } else {
-        assert(bufferSlot < numTimeSteps);
-        src    = vertices[bufferSlot].getPtr();
-        stride = vertices[bufferSlot].getStride();
-        baseEntry = &vertex_buffer_tags[bufferSlot];
-        topo = &topology[0];
-      }
+      const InterpolationBuffer buffer = getInterpolationBuffer(bufferType,bufferSlot);
+      const char* src = buffer.src;
+      const size_t stride = buffer.stride;
+      std::vector<SharedLazyTessellationCache::CacheEntry>* baseEntry = buffer.baseEntry;
+      Topology* topo = buffer.topo;
       
       bool has_P = P;
       bool has_dP = dPdu;     assert(!has_dP  || dPdv);
@@ -914,26 +981,11 @@ namespace embree
       unsigned int valueCount = args->valueCount;
     
       /* calculate base pointer and stride */
-      assert((bufferType == RTC_BUFFER_TYPE_VERTEX && bufferSlot < RTC_MAX_TIME_STEP_COUNT) ||
-             (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE && bufferSlot < RTC_MAX_USER_VERTEX_BUFFERS));
-      const char* src = nullptr; 
-      size_t stride = 0;
-      std::vector<SharedLazyTessellationCache::CacheEntry>* baseEntry = nullptr;
-      Topology* topo = nullptr;
-      if (bufferType == RTC_BUFFER_TYPE_VERTEX_ATTRIBUTE) {
-        assert(bufferSlot < vertexAttribs.size());
-        src    = vertexAttribs[bufferSlot].getPtr();
-        stride = vertexAttribs[bufferSlot].getStride();
-        baseEntry = &vertex_attrib_buffer_tags[bufferSlot];
-        int topologyID = vertexAttribs[bufferSlot].userData;
-        topo = &topology[topologyID];
-      } else {
-        assert(bufferSlot < numTimeSteps);
-        src    = vertices[bufferSlot].getPtr();
-        stride = vertices[bufferSlot].getStride();
-        baseEntry = &vertex_buffer_tags[bufferSlot];
-        topo = &topology[0];
-      }
+      const InterpolationBuffer buffer = getInterpolationBuffer(bufferType,bufferSlot);
+      const char* src = buffer.src;
+      const size_t stride = buffer.stride;
+      std::vector<SharedLazyTessellationCache::CacheEntry>* baseEntry = buffer.baseEntry;
+      Topology* topo = buffer.topo;
       
       const int* valid = (const int*) valid_i;
       
@@ -965,5 +1017,84 @@ namespace embree
                        });
       }
     }
+
+    void SubdivMeshISA::interpolateBatch(const RTCInterpolateNArguments* const args)
+    {
+      const int* valid = (const int*) args->valid;
+      const unsigned* primIDs = args->primIDs;
+      const float* u = args->u;
+      const float* v = args->v;
+      unsigned int N = args->N;
+      RTCBufferType bufferType = args->bufferType;
+      unsigned int bufferSlot = args->bufferSlot;
+      float* P = args->P;
+      float* dPdu = args->dPdu;
+      float* dPdv = args->dPdv;
+      float* ddPdudu = args->ddPdudu;
+      float* ddPdvdv = args->ddPdvdv;
+      float* ddPdudv = args->ddPdudv;
+      unsigned int valueCount = args->valueCount;
+    
+      /* calculate base pointer and stride */
+      const InterpolationBuffer buffer = getInterpolationBuffer(bufferType,bufferSlot);
+      const char* src = buffer.src;
+      const size_t stride = buffer.stride;
+      std::vector<SharedLazyTessellationCache::CacheEntry>* baseEntry = buffer.baseEntry;
+      Topology* topo = buffer.topo;
+
+      /* sort valid locations by primitive, the location index is stored in the lower bits */
+      std::vector<uint64_t> locations;
+      locations.reserve(N);
+      for (unsigned int i=0; i<N; i++)
+        if (!valid || valid[i] == -1)
+          locations.push_back((uint64_t(primIDs[i]) << 32) | i);
+      std::sort(locations.begin(),locations.end());
+
+      /* the blocks are evaluated into temporary arrays and then scattered to the destination arrays */
+      __aligned(64) float block_u[VSIZEX], block_v[VSIZEX];
+      __aligned(64) float block_P[4*VSIZEX], block_dPdu[4*VSIZEX], block_dPdv[4*VSIZEX];
+      __aligned(64) float block_ddPdudu[4*VSIZEX], block_ddPdvdv[4*VSIZEX], block_ddPdudv[4*VSIZEX];
+      for (size_t i=0; i<VSIZEX; i++) block_u[i] = block_v[i] = 0.0f;
+
+      /* evaluate blocks of locations on the same patch with full SIMD width, reusing the patch cached for that primitive */
+      for (size_t begin=0, end=0; begin<locations.size(); begin=end)
+      {
+        const unsigned int primID = unsigned(locations[begin] >> 32);
+        for (end=begin; end<locations.size() && end-begin<VSIZEX && unsigned(locations[end] >> 32) == primID; end++) {
+          block_u[end-begin] = u[unsigned(locations[end])];
+          block_v[end-begin] = v[unsigned(locations[end])];
+        }
+        const vboolx valid1 = vintx(step) < vintx(int(end-begin));
+        const vfloatx uu = vfloatx::load(block_u);
+        const vfloatx vv = vfloatx::load(block_v);
+
+        for (unsigned int j=0; j<valueCount; j+=4) 
+        {
+          const size_t M = min(4u,valueCount-j);
+          isa::PatchEvalSimd<vboolx,vintx,vfloatx,vfloat4>(baseEntry->at(interpolationSlot(primID,j/4,stride)),commitCounter,
+                                                           topo->getHalfEdge(primID),src+j*sizeof(float),stride,valid1,uu,vv,
+                                                           P ? block_P : nullptr,
+                                                           dPdu ? block_dPdu : nullptr,
+                                                           dPdv ? block_dPdv : nullptr,
+                                                           ddPdudu ? block_ddPdudu : nullptr,
+                                                           ddPdvdv ? block_ddPdvdv : nullptr,
+                                                           ddPdudv ? block_ddPdudv : nullptr,
+                                                           VSIZEX,M);
+
+          auto scatter = [&] (float* dst, const float* block) {
+            if (!dst) return;
+            for (size_t k=begin; k<end; k++)
+              for (size_t m=0; m<M; m++)
+                dst[(j+m)*size_t(N)+unsigned(locations[k])] = block[m*VSIZEX+k-begin];
+          };
+          scatter(P,block_P);
+          scatter(dPdu,block_dPdu);
+          scatter(dPdv,block_dPdv);
+          scatter(ddPdudu,block_ddPdudu);
+          scatter(ddPdvdv,block_ddPdvdv);
+          scatter(ddPdudv,block_ddPdudv);
+        }
+      }
+    }
   }
 }
@@ -61,6 +61,7 @@ namespace embree
     void* getBuffer(RTCBufferType type, unsigned int slot);
     void updateBuffer(RTCBufferType type, unsigned int slot);
     void setTessellationRate(float N);
+    void setTessellationCamera(const RTCTessellationCamera* camera);
     bool verify();
     void commit();
     void addElementsToCount (GeometryCounts & counts) const;
@@ -108,6 +109,9 @@ namespace embree
 
     /*! initializes the half edge data structure */
     void initializeHalfEdgeStructures ();
+
+    /*! calculates view dependent edge levels from the tessellation camera */
+    void calculateAdaptiveLevels ();
  
   public:
 
@@ -119,7 +123,8 @@ namespace embree
     /* returns tessellation level of edge */
     __forceinline float getEdgeLevel(const size_t i) const
     {
-      if (levels) return clamp(levels[i],1.0f,4096.0f); // FIXME: do we want to limit edge level?
+      if (useTessellationCamera) return adaptiveLevels[i];
+      else if (levels) return clamp(levels[i],1.0f,4096.0f); // FIXME: do we want to limit edge level?
       else return clamp(tessellationRate,1.0f,4096.0f); // FIXME: do we want to limit edge level?
     }
 
@@ -256,6 +261,10 @@ namespace embree
     BufferView<float> levels;
     float tessellationRate;  // constant rate that is used when levels is not set
 
+    /*! camera for view dependent edge levels, overrides levels and tessellationRate when set */
+    bool useTessellationCamera;
+    RTCTessellationCamera tessellationCamera;
+
     /*! buffer that marks specific faces as holes */
     BufferView<unsigned> holes;
 
@@ -277,6 +286,9 @@ namespace embree
     /*! fast lookup table to detect invalid faces */
     mvector<char> invalid_face;
 
+    /*! view dependent edge level for each half edge */
+    mvector<float> adaptiveLevels;
+
     /*! test if face i is invalid in timestep j */
     __forceinline       char& invalidFace(size_t i, size_t j = 0)       { return invalid_face[i*numTimeSteps+j]; }
     __forceinline const char& invalidFace(size_t i, size_t j = 0) const { return invalid_face[i*numTimeSteps+j]; }
@@ -293,6 +305,18 @@ namespace embree
     std::vector<std::vector<SharedLazyTessellationCache::CacheEntry>> vertex_buffer_tags;
     std::vector<std::vector<SharedLazyTessellationCache::CacheEntry>> vertex_attrib_buffer_tags;
     std::vector<Patch3fa::Ref> patch_eval_trees;
+
+    /*! source data, cache entries, and topology used to interpolate some buffer */
+    struct InterpolationBuffer
+    {
+      const char* src;
+      size_t stride;
+      std::vector<SharedLazyTessellationCache::CacheEntry>* baseEntry;
+      Topology* topo;
+    };
+
+    /*! calculates base pointer and stride of the interpolated buffer */
+    InterpolationBuffer getInterpolationBuffer(RTCBufferType bufferType, unsigned int bufferSlot);
     
     /*! the following data is only required during construction of the
      *  half edge structure and can be cleared for static scenes */
@@ -319,6 +343,7 @@ namespace embree
 
       void interpolate(const RTCInterpolateArguments* const args);
       void interpolateN(const RTCInterpolateNArguments* const args);
+      void interpolateBatch(const RTCInterpolateNArguments* const args);
     };
   }
 
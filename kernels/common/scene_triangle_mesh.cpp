@@ -150,6 +150,23 @@ namespace embree
     else                   counts.numMBTriangles += numPrimitives;
   }
 
+  bool TriangleMesh::pointQueryDistance(size_t primID, const Vec3fa& p, float time, const AffineSpace3fa* xfm, float& dist) const
+  {
+    const Triangle& tri = triangle(primID);
+    Vec3fa v[3];
+    if (numTimeSteps == 1) {
+      for (size_t i=0; i<3; i++) v[i] = vertex(tri.v[i]);
+    } else {
+      float ftime; const int itime = timeSegment(time,ftime);
+      for (size_t i=0; i<3; i++) v[i] = lerp(vertex(tri.v[i],itime),vertex(tri.v[i],itime+1),ftime);
+    }
+    if (xfm) {
+      for (size_t i=0; i<3; i++) v[i] = xfmPoint(*xfm,v[i]);
+    }
+    dist = distance(p,closestPointOnTriangle(p,v[0],v[1],v[2]));
+    return true;
+  }
+
   bool TriangleMesh::verify() 
   {
     /*! verify size of vertex arrays */
@@ -85,6 +85,14 @@ namespace embree
     useSpatialPreSplits = false;
 
     tessellation_cache_size = 128*1024*1024;
+    subdiv_lazy_build = 0;
+
+    twolevel_refit = true;
+    twolevel_refit_threshold = 1.3f;
+    refit_optimization_budget = 0.0f;
+    qbvh_full_precision_levels = 2;
+    stream_ray_sorting = false;
+    traversal_stats_sampling = 0;
 
     subdiv_accel = "default";
     subdiv_accel_mb = "default";
@@ -117,6 +125,7 @@ namespace embree
 #endif
 
     start_threads = false;
+    reserved_cores = 0;
     enable_selockmemoryprivilege = false;
 #if defined(__LINUX__)
     hugepages = true;
@@ -124,11 +133,15 @@ namespace embree
     hugepages = false;
 #endif
     hugepages_success = true;
+    hugepages_1g = false;
 
     alloc_main_block_size = 0;
     alloc_num_main_slots = 0;
     alloc_thread_block_size = 0;
     alloc_single_thread_alloc = -1;
+    numa_alloc = false;
+    numa_replication_levels = 0;
+    numa_nodes = 0;
 
     error_function = nullptr;
     error_function_userptr = nullptr;
@@ -144,6 +157,10 @@ namespace embree
     return (enabled_cpu_features & isa) == isa;
   }
 
+  size_t State::getNumNumaNodes() const {
+    return numa_nodes ? numa_nodes : getNumberOfNumaNodes();
+  }
+
   bool State::checkISASupport() {
     return (getCPUFeatures() & enabled_cpu_features) == enabled_cpu_features;
   }
@@ -246,6 +263,9 @@ namespace embree
       
       else if (tok == Token::Id("start_threads")&& cin->trySymbol("=")) 
         start_threads = cin->get().Int();
+
+      else if (tok == Token::Id("reserved_cores")&& cin->trySymbol("=")) 
+        reserved_cores = cin->get().Int();
       
       else if (tok == Token::Id("isa") && cin->trySymbol("=")) {
         std::string isa_str = toLowerCase(cin->get().Identifier());
@@ -277,6 +297,9 @@ namespace embree
       else if (tok == Token::Id("hugepages") && cin->trySymbol("=")) {
         hugepages = cin->get().Int();
       }
+      else if (tok == Token::Id("hugepages_1g") && cin->trySymbol("=")) {
+        hugepages_1g = cin->get().Int();
+      }
 
       else if (tok == Token::Id("ignore_config_files") && cin->trySymbol("="))
         ignore_config_files = cin->get().Int();
@@ -404,6 +427,7 @@ namespace embree
             if (flag == Token::Id("dynamic") ) scene_flags |= RTC_SCENE_FLAG_DYNAMIC;
             else if (flag == Token::Id("compact")) scene_flags |= RTC_SCENE_FLAG_COMPACT;
             else if (flag == Token::Id("robust")) scene_flags |= RTC_SCENE_FLAG_ROBUST;
+            else if (flag == Token::Id("quantized")) scene_flags |= RTC_SCENE_FLAG_QUANTIZED;
           } while (cin->trySymbol("|"));
         }
       }
@@ -414,10 +438,25 @@ namespace embree
       else if (tok == Token::Id("presplits") && cin->trySymbol("="))
         useSpatialPreSplits = cin->get().Int() != 0 ? true : false;
 
+      else if (tok == Token::Id("twolevel_refit") && cin->trySymbol("="))
+        twolevel_refit = cin->get().Int() != 0 ? true : false;
+      else if (tok == Token::Id("twolevel_refit_threshold") && cin->trySymbol("="))
+        twolevel_refit_threshold = cin->get().Float();
+      else if (tok == Token::Id("refit_optimization_budget") && cin->trySymbol("="))
+        refit_optimization_budget = cin->get().Float();
+      else if (tok == Token::Id("qbvh_full_precision_levels") && cin->trySymbol("="))
+        qbvh_full_precision_levels = cin->get().Int();
+      else if (tok == Token::Id("stream_ray_sorting") && cin->trySymbol("="))
+        stream_ray_sorting = cin->get().Int() != 0 ? true : false;
+      else if (tok == Token::Id("traversal_stats_sampling") && cin->trySymbol("="))
+        traversal_stats_sampling = cin->get().Int();
+
       else if (tok == Token::Id("tessellation_cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("subdiv_lazy_build") && cin->trySymbol("="))
+        subdiv_lazy_build = cin->get().Int();
 
       else if (tok == Token::Id("alloc_main_block_size") && cin->trySymbol("="))
         alloc_main_block_size = cin->get().Int();
@@ -428,6 +467,13 @@ namespace embree
        else if (tok == Token::Id("alloc_single_thread_alloc") && cin->trySymbol("="))
          alloc_single_thread_alloc = cin->get().Int();
 
+      else if (tok == Token::Id("numa_alloc") && cin->trySymbol("="))
+        numa_alloc = cin->get().Int() != 0 ? true : false;
+      else if (tok == Token::Id("numa_replication_levels") && cin->trySymbol("="))
+        numa_replication_levels = cin->get().Int();
+      else if (tok == Token::Id("numa_nodes") && cin->trySymbol("="))
+        numa_nodes = cin->get().Int();
+
       cin->trySymbol(","); // optional , separator
     }
   }
@@ -443,6 +489,7 @@ namespace embree
     std::cout << "  build user threads = " << numUserThreads   << std::endl;
     std::cout << "  start_threads      = " << start_threads << std::endl;
     std::cout << "  affinity           = " << set_affinity << std::endl;
+    std::cout << "  reserved_cores     = " << reserved_cores << std::endl;
     std::cout << "  frequency_level    = ";
     switch (frequency_level) {
     case FREQUENCY_SIMD128: std::cout << "simd128" << std::endl; break;
@@ -455,10 +502,18 @@ namespace embree
     if (!hugepages) std::cout << "disabled" << std::endl;
     else if (hugepages_success) std::cout << "enabled" << std::endl;
     else std::cout << "failed" << std::endl;
+    std::cout << "  hugepages_1g       = " << hugepages_1g << std::endl;
 
     std::cout << "  verbosity          = " << verbose << std::endl;
     std::cout << "  cache_size         = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  twolevel_refit     = " << twolevel_refit << " (threshold " << twolevel_refit_threshold << ")" << std::endl;
+    std::cout << "  refit_optimization_budget = " << refit_optimization_budget << " ms" << std::endl;
+    std::cout << "  qbvh_full_precision_levels = " << qbvh_full_precision_levels << std::endl;
+    std::cout << "  stream_ray_sorting = " << stream_ray_sorting << std::endl;
+    std::cout << "  traversal_stats_sampling = " << traversal_stats_sampling << std::endl;
+    std::cout << "  numa_alloc         = " << numa_alloc << " (" << getNumNumaNodes() << " nodes)" << std::endl;
+    std::cout << "  numa_replication_levels = " << numa_replication_levels << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel              = " << tri_accel << std::endl;
@@ -502,6 +557,7 @@ namespace embree
     
     std::cout << "subdivision surfaces:" << std::endl;
     std::cout << "  accel              = " << subdiv_accel << std::endl;
+    std::cout << "  lazy_build         = " << subdiv_lazy_build << std::endl;
 
     std::cout << "grids:" << std::endl;
     std::cout << "  accel              = " << grid_accel << std::endl;
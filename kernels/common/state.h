@@ -40,6 +40,9 @@ namespace embree
     /*! checks if some particular ISA is enabled */
     bool hasISA(const int isa);
 
+    /*! returns the number of NUMA nodes BVH memory gets partitioned for */
+    size_t getNumNumaNodes() const;
+
     /*! check whether selected ISA is supported by the HW */    
     bool checkISASupport();
     
@@ -109,6 +112,13 @@ namespace embree
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
     bool useSpatialPreSplits;              //!< use spatial pre-splits instead of the full spatial split builder
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    int subdiv_lazy_build;                 //!< 0 builds all patch grids at commit, 1 builds them at first ray hit, 2 additionally stores them in the tessellation cache
+    bool twolevel_refit;                   //!< update two-level BVHs of dynamic scenes in place if only some objects changed
+    float twolevel_refit_threshold;        //!< rebuild two-level BVHs if the refitted SAH cost exceeds the built one by this factor
+    float refit_optimization_budget;       //!< time in ms spent restructuring a BVH after refitting, 0 disables restructuring
+    size_t qbvh_full_precision_levels;     //!< number of top levels of quantized BVHs that use full precision nodes
+    bool stream_ray_sorting;               //!< sort incoherent ray streams by direction octant and origin before tracing
+    size_t traversal_stats_sampling;       //!< gather traversal statistics of every n'th single ray query of a thread, 0 disables statistics
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -130,6 +140,7 @@ namespace embree
     size_t numUserThreads;                 //!< number of user provided threads to use in builders
     bool set_affinity;                     //!< sets affinity for worker threads
     bool start_threads;                    //!< true when threads should be started at device creation time
+    size_t reserved_cores;                 //!< number of cores not used by worker threads
     int enabled_cpu_features;              //!< CPU ISA features to use
     int enabled_builder_cpu_features;      //!< CPU ISA features to use for builders only
     enum FREQUENCY_LEVEL {
@@ -140,12 +151,16 @@ namespace embree
     bool enable_selockmemoryprivilege;     //!< configures the SeLockMemoryPrivilege under Windows to enable huge pages
     bool hugepages;                        //!< true if huge pages should get used
     bool hugepages_success;                //!< status for enabling huge pages
+    bool hugepages_1g;                     //!< true if the explicit 1GB huge page pool should get used
 
   public:
     size_t alloc_main_block_size;          //!< main allocation block size (shared between threads)
     int alloc_num_main_slots;              //!< number of such shared blocks to be used to allocate
     size_t alloc_thread_block_size;        //!< size of thread local allocator block size
     int alloc_single_thread_alloc;         //!< in single mode nodes and leaves use same thread local allocator
+    bool numa_alloc;                       //!< allocates BVH memory from per NUMA node block pools
+    size_t numa_replication_levels;        //!< number of top BVH levels replicated per NUMA node
+    size_t numa_nodes;                     //!< number of NUMA nodes to use, 0 uses the NUMA nodes of the system
 
   public:
 
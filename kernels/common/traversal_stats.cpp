@@ -0,0 +1,123 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "traversal_stats.h"
+
+namespace embree
+{
+  /* per thread countdown to the next sampled ray query */
+  static __thread size_t samplingCountdown = 0;
+
+  void TraversalStatistics::Counters::clear()
+  {
+    rays.store(0);
+    nodes.store(0);
+    leaves.store(0);
+    prims.store(0);
+    filters.store(0);
+    instances.store(0);
+  }
+
+  void TraversalStatistics::Counters::add(const TraversalCounters& counters)
+  {
+    rays++;
+    nodes += counters.nodes;
+    leaves += counters.leaves;
+    prims += counters.prims;
+    filters += counters.filters;
+    instances += counters.instances;
+  }
+
+  void TraversalStatistics::Counters::get(RTCTraversalStatistics* stats) const
+  {
+    stats->numRays = rays;
+    stats->numNodes = nodes;
+    stats->numLeaves = leaves;
+    stats->numPrimitiveTests = prims;
+    stats->numFilterCalls = filters;
+    stats->numInstanceTransitions = instances;
+  }
+
+  bool TraversalStatistics::sampleThread() const
+  {
+    if (samplingCountdown > 1) {
+      samplingCountdown--;
+      return false;
+    }
+    samplingCountdown = samplingRate;
+    return true;
+  }
+
+  void TraversalStatistics::add(RTCRayQueryType type, const TraversalCounters& ray, unsigned int geomID)
+  {
+    counters[type].add(ray);
+    if (geomID == RTC_INVALID_GEOMETRY_ID)
+      return;
+
+    Lock<SpinLock> lock(geometryMutex);
+    if (geomID >= geometryCounters.size())
+      geometryCounters.resize(geomID+1);
+    if (!geometryCounters[geomID])
+      geometryCounters[geomID].reset(new Counters);
+    geometryCounters[geomID]->add(ray);
+  }
+
+  void TraversalStatistics::get(RTCRayQueryType type, RTCTraversalStatistics* stats) const {
+    counters[type].get(stats);
+  }
+
+  void TraversalStatistics::get(unsigned int geomID, RTCTraversalStatistics* stats) const
+  {
+    Lock<SpinLock> lock(geometryMutex);
+    if (geomID < geometryCounters.size() && geometryCounters[geomID])
+      geometryCounters[geomID]->get(stats);
+    else
+      Counters().get(stats);
+  }
+
+  static void json(std::ostream& out, const RTCTraversalStatistics& stats)
+  {
+    out << "{ \"rays\": " << stats.numRays
+        << ", \"nodes\": " << stats.numNodes
+        << ", \"leaves\": " << stats.numLeaves
+        << ", \"primitive_tests\": " << stats.numPrimitiveTests
+        << ", \"filter_calls\": " << stats.numFilterCalls
+        << ", \"instance_transitions\": " << stats.numInstanceTransitions
+        << " }";
+  }
+
+  std::string TraversalStatistics::json() const
+  {
+    std::stringstream out;
+    RTCTraversalStatistics stats;
+    out << "{" << std::endl;
+    out << "  \"sampling_rate\": " << samplingRate << "," << std::endl;
+    get(RTC_RAY_QUERY_TYPE_INTERSECT,&stats);
+    out << "  \"intersect\": "; embree::json(out,stats); out << "," << std::endl;
+    get(RTC_RAY_QUERY_TYPE_OCCLUDED,&stats);
+    out << "  \"occluded\": "; embree::json(out,stats); out << "," << std::endl;
+    out << "  \"geometries\": {";
+
+    Lock<SpinLock> lock(geometryMutex);
+    bool first = true;
+    for (size_t geomID=0; geomID<geometryCounters.size(); geomID++)
+    {
+      if (!geometryCounters[geomID]) continue;
+      geometryCounters[geomID]->get(&stats);
+      out << (first ? "" : ",") << std::endl << "    \"" << geomID << "\": ";
+      embree::json(out,stats);
+      first = false;
+    }
+    out << (first ? "" : "\n  ") << "}" << std::endl;
+    out << "}" << std::endl;
+    return out.str();
+  }
+
+  void TraversalStatistics::clear()
+  {
+    counters[RTC_RAY_QUERY_TYPE_INTERSECT].clear();
+    counters[RTC_RAY_QUERY_TYPE_OCCLUDED].clear();
+    Lock<SpinLock> lock(geometryMutex);
+    geometryCounters.clear();
+  }
+}
@@ -0,0 +1,82 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "default.h"
+#include "rtcore.h"
+
+namespace embree
+{
+  /*! Traversal counters of a single sampled ray query. The counters
+   *  live on the stack of the tracing thread, thus no synchronization
+   *  is required while the ray traverses the scene. */
+  struct TraversalCounters
+  {
+    __forceinline TraversalCounters ()
+      : nodes(0), leaves(0), prims(0), filters(0), instances(0) {}
+
+  public:
+    size_t nodes;      //!< number of traversed inner nodes
+    size_t leaves;     //!< number of traversed leaf nodes
+    size_t prims;      //!< number of tested primitive blocks
+    size_t filters;    //!< number of invoked filter functions
+    size_t instances;  //!< number of entered instances
+  };
+
+  /*! Traversal statistics of a scene, accumulated from sampled
+   *  single ray queries. Statistics of rays that hit some geometry
+   *  are also attributed to the hit geometry of the scene. */
+  class TraversalStatistics
+  {
+    struct Counters
+    {
+      Counters () { clear(); }
+
+      void clear();
+      void add(const TraversalCounters& counters);
+      void get(RTCTraversalStatistics* stats) const;
+
+    public:
+      std::atomic<size_t> rays;
+      std::atomic<size_t> nodes;
+      std::atomic<size_t> leaves;
+      std::atomic<size_t> prims;
+      std::atomic<size_t> filters;
+      std::atomic<size_t> instances;
+    };
+
+  public:
+    TraversalStatistics (size_t samplingRate)
+      : samplingRate(samplingRate) {}
+
+    /*! returns true if the next ray query of this thread should get sampled */
+    __forceinline bool sample() const {
+      return unlikely(samplingRate != 0) && sampleThread();
+    }
+
+    /*! accumulates the counters of a sampled ray query */
+    void add(RTCRayQueryType type, const TraversalCounters& ray, unsigned int geomID = RTC_INVALID_GEOMETRY_ID);
+
+    /*! returns the statistics of some ray query type */
+    void get(RTCRayQueryType type, RTCTraversalStatistics* stats) const;
+
+    /*! returns the statistics of sampled rays that hit some geometry */
+    void get(unsigned int geomID, RTCTraversalStatistics* stats) const;
+
+    /*! returns all statistics as JSON string */
+    std::string json() const;
+
+    /*! resets all statistics */
+    void clear();
+
+  private:
+    bool sampleThread() const;
+
+  private:
+    size_t samplingRate;                    //!< every samplingRate'th single ray query of a thread gets sampled, 0 disables sampling
+    Counters counters[2];                   //!< statistics per ray query type
+    mutable SpinLock geometryMutex;
+    std::vector<std::unique_ptr<Counters>> geometryCounters; //!< statistics of sampled rays per hit geometry
+  };
+}
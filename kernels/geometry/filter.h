@@ -18,6 +18,7 @@ namespace embree
       {
         assert(context->scene->hasGeometryFilterFunction());
         geometry->intersectionFilterN(args);
+        context->countFilterCall();
 
         if (args->valid[0] == 0)
           return false;
@@ -26,6 +27,7 @@ namespace embree
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
         context->user->filter(args);
+        context->countFilterCall();
 
         if (args->valid[0] == 0)
           return false;
@@ -56,6 +58,7 @@ namespace embree
       if (geometry->intersectionFilterN) {
         assert(context->scene->hasGeometryFilterFunction());
         geometry->intersectionFilterN(filter_args);
+        context->countFilterCall();
       }
       
       //if (args->valid[0] == 0)
@@ -64,6 +67,7 @@ namespace embree
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
         context->user->filter(filter_args);
+        context->countFilterCall();
       }
 #endif
     }
@@ -74,6 +78,7 @@ namespace embree
       {
         assert(context->scene->hasGeometryFilterFunction());
         geometry->occlusionFilterN(args);
+        context->countFilterCall();
 
         if (args->valid[0] == 0)
           return false;
@@ -82,6 +87,7 @@ namespace embree
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
         context->user->filter(args);
+        context->countFilterCall();
 
         if (args->valid[0] == 0)
           return false;
@@ -110,6 +116,7 @@ namespace embree
       if (geometry->occlusionFilterN) {
         assert(context->scene->hasGeometryFilterFunction());
         geometry->occlusionFilterN(filter_args);
+        context->countFilterCall();
       }
       
       //if (args->valid[0] == 0)
@@ -118,6 +125,7 @@ namespace embree
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
         context->user->filter(filter_args);
+        context->countFilterCall();
       }
 #endif
     }
@@ -68,6 +68,31 @@ namespace embree
       }
     }
 
+    GridSOA* GridSOA::lazyBuild(SubdivPatch1Base* patch, const Scene* scene, FastAllocator& alloc)
+    {
+      /* fast path if some thread already published the grid */
+      GridSOA* grid = (GridSOA*) patch->root_ref.get();
+      if (likely(grid)) return grid;
+
+      auto allocGrid = [&] (size_t bytes) { return alloc.malloc(bytes,64,false); };
+      grid = GridSOA::create(patch,1,scene,allocGrid);
+
+      /* publish grid, or use the grid some other thread published in between */
+      int64_t expected = 0;
+      if (!patch->root_ref.compare_exchange(expected,(int64_t)grid))
+        grid = (GridSOA*) expected;
+      return grid;
+    }
+
+    GridSOA* GridSOA::lazyBuildCached(SubdivPatch1Base* patch, const Scene* scene)
+    {
+      /* patches get recreated by each build, thus no commit counter is required to invalidate their cache entries */
+      return SharedLazyTessellationCache::lookup(patch->entry(),0,[&] () {
+          auto alloc = [] (const size_t bytes) { return SharedLazyTessellationCache::malloc(bytes); };
+          return GridSOA::create(patch,1,scene,alloc);
+        });
+    }
+
     size_t GridSOA::getBVHBytes(const GridRange& range, const size_t nodeBytes, const size_t leafBytes)
     {
       if (range.hasLeafSize()) 
@@ -57,6 +57,21 @@ namespace embree
         return create(patches,time_steps,0,patches->grid_u_res-1,0,patches->grid_v_res-1,scene,alloc,bounds_o);
       }
 
+      /*! Returns the grid of a lazily built patch, the grid gets built
+       *  when traversal reaches the patch for the first time. Threads
+       *  that reach the patch concurrently may build the grid
+       *  concurrently, the first finished grid gets published
+       *  atomically and the memory of all other grids stays unused
+       *  until the allocator gets reset. */
+      static GridSOA* lazyBuild(SubdivPatch1Base* patch, const Scene* scene, FastAllocator& alloc);
+
+      /*! Returns the grid of a lazily built patch that is stored in the
+       *  tessellation cache, thus the grid may get discarded under
+       *  memory pressure and rebuilt later. The tessellation cache is
+       *  locked for the calling thread on return, the caller has to
+       *  pin the grid before unlocking it. */
+      static GridSOA* lazyBuildCached(SubdivPatch1Base* patch, const Scene* scene);
+
        /*! returns reference to root */
       __forceinline       BVH4::NodeRef& root(size_t t = 0)       { return (BVH4::NodeRef&)data[rootOffset + t*sizeof(BVH4::NodeRef)]; }
       __forceinline const BVH4::NodeRef& root(size_t t = 0) const { return (BVH4::NodeRef&)data[rootOffset + t*sizeof(BVH4::NodeRef)]; }
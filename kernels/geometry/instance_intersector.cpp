@@ -44,6 +44,82 @@ namespace embree
       context->instID[--context->instStackSize] = RTC_INVALID_GEOMETRY_ID;
     }
 
+    /* Hashes the ray to a random number in [0,1), which is the same for
+     * single rays and ray packets and selects the same levels of detail
+     * for all instances traversed by the ray. */
+    __forceinline float levelRandom(const Vec3ff& org, const Vec3ff& dir)
+    {
+      const float values[6] = { org.x, org.y, org.z, dir.x, dir.y, dir.z };
+      unsigned int h = 0x811C9DC5;
+      for (size_t i=0; i<6; i++) {
+        unsigned int bits; memcpy(&bits,&values[i],sizeof(bits));
+        h = (h ^ bits) * 0x01000193;
+      }
+      h ^= h >> 16; h *= 0x85EBCA6B; h ^= h >> 13;
+      return float(h >> 8) * (1.0f/16777216.0f);
+    }
+
+    template<int K>
+    __forceinline vfloat<K> levelRandom(const Vec3vf<K>& org, const Vec3vf<K>& dir)
+    {
+      const vfloat<K> values[6] = { org.x, org.y, org.z, dir.x, dir.y, dir.z };
+      vint<K> h(int(0x811C9DC5));
+      for (size_t i=0; i<6; i++)
+        h = (h ^ asInt(values[i])) * 0x01000193;
+      h = h ^ srl(h,16); h *= int(0x85EBCA6B); h = h ^ srl(h,13);
+      return vfloat<K>(srl(h,8)) * (1.0f/16777216.0f);
+    }
+
+    /* Selects the level of detail of the instance from the footprint of
+     * the ray cone at the center of the instanced scene. The footprint
+     * is measured in object space using the scaling of the ray direction. */
+    __forceinline Accel* getLevelObject(const Instance* instance, const RTCIntersectContext* context,
+                                        const Vec3ff& org, const Vec3ff& dir, const Vec3ff& local_org, const Vec3ff& local_dir)
+    {
+      if (likely(instance->levels.empty()))
+        return instance->object;
+
+      const Vec3fa center = embree::center(instance->object->bounds.bounds());
+      const float dist = length(center - Vec3fa(local_org));
+      const float scale = length(Vec3fa(local_dir)) * rsqrt(dot(Vec3fa(dir),Vec3fa(dir)));
+      const float footprint = context->coneWidth*scale + context->coneSpread*dist;
+      return instance->getLevelObject(footprint,levelRandom(org,dir));
+    }
+
+    template<int K>
+    __forceinline vint<K> getLevel(const vbool<K>& valid, const Instance* instance, const RTCIntersectContext* context,
+                                   const Vec3vf<K>& org, const Vec3vf<K>& dir, const Vec3vf<K>& local_org, const Vec3vf<K>& local_dir)
+    {
+      const Vec3vf<K> center(Vec3fa(embree::center(instance->object->bounds.bounds())));
+      const vfloat<K> dist = length(center - local_org);
+      const vfloat<K> scale = length(local_dir) * rsqrt(dot(dir,dir));
+      const vfloat<K> footprint = context->coneWidth*scale + context->coneSpread*dist;
+      return instance->getLevel<K>(valid,footprint,levelRandom<K>(org,dir));
+    }
+
+    /* Traces the rays of a packet through the levels of detail they selected. */
+    template<int K, typename Ray, typename Trace>
+    __forceinline void traceLevels(const vbool<K>& valid, const Instance* instance, RTCIntersectContext* user_context,
+                                   const Vec3vf<K>& org, const Vec3vf<K>& dir, Ray& ray, const Trace& trace)
+    {
+      if (likely(instance->levels.empty())) {
+        IntersectContext newcontext((Scene*)instance->object, user_context);
+        trace(valid, instance->object, newcontext);
+        return;
+      }
+
+      const vint<K> ilevel = getLevel<K>(valid, instance, user_context, org, dir, ray.org, ray.dir);
+      vbool<K> valid1 = valid;
+      while (any(valid1))
+      {
+        vbool<K> valid2;
+        const int level = next_unique(valid1, ilevel, valid2);
+        Accel* object = instance->getLevelObject(level);
+        IntersectContext newcontext((Scene*)object, user_context);
+        trace(valid2, object, newcontext);
+      }
+    }
+
     void InstanceIntersector1::intersect(const Precalculations& pre, RayHit& ray, IntersectContext* context, const InstancePrimitive& prim)
     {
       const Instance* instance = prim.instance;
@@ -62,8 +138,10 @@ namespace embree
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
+        Accel* object = getLevelObject(instance, user_context, ray_org, ray_dir, ray.org, ray.dir);
+        IntersectContext newcontext((Scene*)object, user_context);
+        context->enterInstance(newcontext);
+        object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
         instance_id_stack::pop(user_context);
@@ -89,8 +167,10 @@ namespace embree
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.occluded((RTCRay&)ray, &newcontext);
+        Accel* object = getLevelObject(instance, user_context, ray_org, ray_dir, ray.org, ray.dir);
+        IntersectContext newcontext((Scene*)object, user_context);
+        context->enterInstance(newcontext);
+        object->intersectors.occluded((RTCRay&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
         occluded = ray.tfar < 0.0f;
@@ -125,6 +205,7 @@ namespace embree
           context->userContext,
           similarityScale,
           context->userPtr); 
+        context_inst.neighbors = context->neighbors;
 
         bool changed = instance->object->intersectors.pointQuery(&query_inst, &context_inst);
         popInstance(context->userContext);
@@ -151,8 +232,10 @@ namespace embree
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
+        Accel* object = getLevelObject(instance, user_context, ray_org, ray_dir, ray.org, ray.dir);
+        IntersectContext newcontext((Scene*)object, user_context);
+        context->enterInstance(newcontext);
+        object->intersectors.intersect((RTCRayHit&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
         instance_id_stack::pop(user_context);
@@ -178,8 +261,10 @@ namespace embree
         const Vec3ff ray_dir = ray.dir;
         ray.org = Vec3ff(xfmPoint(world2local, ray_org), ray.tnear());
         ray.dir = Vec3ff(xfmVector(world2local, ray_dir), ray.time());
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.occluded((RTCRay&)ray, &newcontext);
+        Accel* object = getLevelObject(instance, user_context, ray_org, ray_dir, ray.org, ray.dir);
+        IntersectContext newcontext((Scene*)object, user_context);
+        context->enterInstance(newcontext);
+        object->intersectors.occluded((RTCRay&)ray, &newcontext);
         ray.org = ray_org;
         ray.dir = ray_dir;
         occluded = ray.tfar < 0.0f;
@@ -213,6 +298,7 @@ namespace embree
           context->userContext,
           similarityScale,
           context->userPtr); 
+        context_inst.neighbors = context->neighbors;
 
         bool changed = instance->object->intersectors.pointQuery(&query_inst, &context_inst);
         popInstance(context->userContext);
@@ -242,8 +328,9 @@ namespace embree
         const Vec3vf<K> ray_dir = ray.dir;
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.intersect(valid, ray, &newcontext);
+        traceLevels<K>(valid, instance, user_context, ray_org, ray_dir, ray, [&] (const vbool<K>& valid, Accel* object, IntersectContext& newcontext) {
+            object->intersectors.intersect(valid, ray, &newcontext);
+          });
         ray.org = ray_org;
         ray.dir = ray_dir;
         instance_id_stack::pop(user_context);
@@ -271,8 +358,9 @@ namespace embree
         const Vec3vf<K> ray_dir = ray.dir;
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.occluded(valid, ray, &newcontext);
+        traceLevels<K>(valid, instance, user_context, ray_org, ray_dir, ray, [&] (const vbool<K>& valid, Accel* object, IntersectContext& newcontext) {
+            object->intersectors.occluded(valid, ray, &newcontext);
+          });
         ray.org = ray_org;
         ray.dir = ray_dir;
         occluded = ray.tfar < 0.0f;
@@ -301,8 +389,9 @@ namespace embree
         const Vec3vf<K> ray_dir = ray.dir;
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.intersect(valid, ray, &newcontext);
+        traceLevels<K>(valid, instance, user_context, ray_org, ray_dir, ray, [&] (const vbool<K>& valid, Accel* object, IntersectContext& newcontext) {
+            object->intersectors.intersect(valid, ray, &newcontext);
+          });
         ray.org = ray_org;
         ray.dir = ray_dir;
         instance_id_stack::pop(user_context);
@@ -330,8 +419,9 @@ namespace embree
         const Vec3vf<K> ray_dir = ray.dir;
         ray.org = xfmPoint(world2local, ray_org);
         ray.dir = xfmVector(world2local, ray_dir);
-        IntersectContext newcontext((Scene*)instance->object, user_context);
-        instance->object->intersectors.occluded(valid, ray, &newcontext);
+        traceLevels<K>(valid, instance, user_context, ray_org, ray_dir, ray, [&] (const vbool<K>& valid, Accel* object, IntersectContext& newcontext) {
+            object->intersectors.occluded(valid, ray, &newcontext);
+          });
         ray.org = ray_org;
         ray.dir = ray_dir;
         occluded = ray.tfar < 0.0f;
@@ -24,6 +24,9 @@ namespace embree
 
     /*! Returns the number of bytes of block. */
     virtual size_t getBytes(const char* This) const = 0;
+
+    /*! Returns the geometry ID of the i'th primitive of a block. */
+    virtual unsigned int geomID(const char* This, size_t i) const { return RTC_INVALID_GEOMETRY_ID; }
   };
   
   template<typename Primitive>
@@ -53,6 +53,15 @@ namespace embree
         return Curve4v::bytes(sizeActive(This));
   }
 
+  template<>
+  unsigned int Curve4v::Type::geomID(const char* This, size_t i) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line4i*)This)->geomID(i);
+    else
+      return ((Curve4v*)This)->geomID(i);
+  }
+
   /********************** Curve4i **************************/
 
   template<>
@@ -87,6 +96,15 @@ namespace embree
       return Curve4i::bytes(sizeActive(This));
   }
 
+  template<>
+  unsigned int Curve4i::Type::geomID(const char* This, size_t i) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line4i*)This)->geomID(i);
+    else
+      return ((Curve4i*)This)->geomID(i);
+  }
+
   /********************** Curve4iMB **************************/
 
   template<>
@@ -121,6 +139,15 @@ namespace embree
       return Curve4iMB::bytes(sizeActive(This));
   }
 
+  template<>
+  unsigned int Curve4iMB::Type::geomID(const char* This, size_t i) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line4i*)This)->geomID(i);
+    else
+      return ((Curve4iMB*)This)->geomID(i);
+  }
+
   /********************** Line4i **************************/
 
   template<>
@@ -143,6 +170,12 @@ namespace embree
     return sizeof(Line4i);
   }
 
+  template<>
+  unsigned int Line4i::Type::geomID(const char* This, size_t i) const
+  {
+    return ((Line4i*)This)->geomID(i);
+  }
+
   /********************** Triangle4 **************************/
 
   template<>
@@ -165,6 +198,12 @@ namespace embree
     return sizeof(Triangle4);
   }
 
+  template<>
+  unsigned int Triangle4::Type::geomID(const char* This, size_t i) const
+  {
+    return ((Triangle4*)This)->geomID(i);
+  }
+
   /********************** Triangle4v **************************/
 
   template<>
@@ -187,6 +226,12 @@ namespace embree
     return sizeof(Triangle4v);
   }
 
+  template<>
+  unsigned int Triangle4v::Type::geomID(const char* This, size_t i) const
+  {
+    return ((Triangle4v*)This)->geomID(i);
+  }
+
   /********************** Triangle4i **************************/
 
   template<>
@@ -209,6 +254,12 @@ namespace embree
     return sizeof(Triangle4i);
   }
 
+  template<>
+  unsigned int Triangle4i::Type::geomID(const char* This, size_t i) const
+  {
+    return ((Triangle4i*)This)->geomID(i);
+  }
+
   /********************** Triangle4vMB **************************/
 
   template<>
@@ -231,6 +282,12 @@ namespace embree
     return sizeof(Triangle4vMB);
   }
 
+  template<>
+  unsigned int Triangle4vMB::Type::geomID(const char* This, size_t i) const
+  {
+    return ((Triangle4vMB*)This)->geomID(i);
+  }
+
   /********************** Quad4v **************************/
 
   template<>
@@ -253,6 +310,12 @@ namespace embree
     return sizeof(Quad4v);
   }
 
+  template<>
+  unsigned int Quad4v::Type::geomID(const char* This, size_t i) const
+  {
+    return ((Quad4v*)This)->geomID(i);
+  }
+
   /********************** Quad4i **************************/
 
   template<>
@@ -275,6 +338,12 @@ namespace embree
     return sizeof(Quad4i);
   }
 
+  template<>
+  unsigned int Quad4i::Type::geomID(const char* This, size_t i) const
+  {
+    return ((Quad4i*)This)->geomID(i);
+  }
+
   /********************** SubdivPatch1 **************************/
 
   const char* SubdivPatch1::Type::name () const {
@@ -313,6 +382,11 @@ namespace embree
     return sizeof(Object);
   }
 
+  unsigned int Object::Type::geomID(const char* This, size_t i) const
+  {
+    return ((Object*)This)->geomID();
+  }
+
   Object::Type Object::type;
 
   /********************** Instance **************************/
@@ -333,6 +407,11 @@ namespace embree
     return sizeof(InstancePrimitive);
   }
 
+  unsigned int InstancePrimitive::Type::geomID(const char* This, size_t i) const
+  {
+    return ((InstancePrimitive*)This)->instID_;
+  }
+
   InstancePrimitive::Type InstancePrimitive::type;
 
   /********************** SubGrid **************************/
@@ -353,6 +432,11 @@ namespace embree
     return sizeof(SubGrid);
   }
 
+  unsigned int SubGrid::Type::geomID(const char* This, size_t i) const
+  {
+    return ((SubGrid*)This)->geomID();
+  }
+
   SubGrid::Type SubGrid::type;
   
   /********************** SubGridQBVH4 **************************/
@@ -53,6 +53,15 @@ namespace embree
        return Curve8v::bytes(sizeActive(This));
   }
 
+  template<>
+  unsigned int Curve8v::Type::geomID(const char* This, size_t i) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line8i*)This)->geomID(i);
+    else
+      return ((Curve8v*)This)->geomID(i);
+  }
+
   /********************** Curve8i **************************/
 
   template<>
@@ -87,6 +96,15 @@ namespace embree
        return Curve8i::bytes(sizeActive(This));
   }
 
+  template<>
+  unsigned int Curve8i::Type::geomID(const char* This, size_t i) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line8i*)This)->geomID(i);
+    else
+      return ((Curve8i*)This)->geomID(i);
+  }
+
   /********************** Curve8iMB **************************/
 
   template<>
@@ -121,6 +139,15 @@ namespace embree
        return Curve8iMB::bytes(sizeActive(This));
   }
 
+  template<>
+  unsigned int Curve8iMB::Type::geomID(const char* This, size_t i) const
+  {
+    if ((*This & Geometry::GType::GTY_BASIS_MASK) == Geometry::GType::GTY_BASIS_LINEAR)
+      return ((Line8i*)This)->geomID(i);
+    else
+      return ((Curve8iMB*)This)->geomID(i);
+  }
+
   /********************** SubGridQBVH8 **************************/
 
   template<>
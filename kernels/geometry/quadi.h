@@ -19,6 +19,7 @@ namespace embree
       size_t sizeActive(const char* This) const;
       size_t sizeTotal(const char* This) const;
       size_t getBytes(const char* This) const;
+      unsigned int geomID(const char* This, size_t i) const;
     };
     static Type type;
 
@@ -159,6 +160,24 @@ namespace embree
       return linearBounds(scene, time_range);
     }
 
+    /* Updates the primitive */
+    __forceinline BBox3fa update(QuadMesh* mesh)
+    {
+      BBox3fa bounds = empty;
+      for (size_t i=0; i<M; i++)
+      {
+        if (!valid(i)) break;
+        const unsigned primId = primID(i);
+        const QuadMesh::Quad& q = mesh->quad(primId);
+        const Vec3fa p0 = mesh->vertex(q.v[0]);
+        const Vec3fa p1 = mesh->vertex(q.v[1]);
+        const Vec3fa p2 = mesh->vertex(q.v[2]);
+        const Vec3fa p3 = mesh->vertex(q.v[3]);
+        bounds.extend(merge(BBox3fa(p0),BBox3fa(p1),BBox3fa(p2),BBox3fa(p3)));
+      }
+      return bounds;
+    }
+
     friend embree_ostream operator<<(embree_ostream cout, const QuadMi& quad) {
       return cout << "QuadMi<" << M << ">( "
 #if !defined(EMBREE_COMPACT_POLYS)
@@ -383,24 +402,6 @@ namespace embree
                               const Scene *const scene,
                               const float time) const;
 
-    /* Updates the primitive */
-    __forceinline BBox3fa update(QuadMesh* mesh)
-    {
-      BBox3fa bounds = empty;
-      for (size_t i=0; i<M; i++)
-      {
-        if (!valid(i)) break;
-        const unsigned primId = primID(i);
-        const QuadMesh::Quad& q = mesh->quad(primId);
-        const Vec3fa p0 = mesh->vertex(q.v[0]);
-        const Vec3fa p1 = mesh->vertex(q.v[1]);
-        const Vec3fa p2 = mesh->vertex(q.v[2]);
-        const Vec3fa p3 = mesh->vertex(q.v[3]);
-        bounds.extend(merge(BBox3fa(p0),BBox3fa(p1),BBox3fa(p2),BBox3fa(p3)));
-      }
-      return bounds;
-    }
-
   private:
 #if !defined(EMBREE_COMPACT_POLYS)
     template<int N> const vuint<M>& getVertexOffset() const;
@@ -21,6 +21,14 @@ namespace embree
     
     static Type type;
 
+    /*! types of the leaves of the BVH over subdivision patches */
+    enum LeafType
+    {
+      GRID_LEAF        = 1, //!< leaf references a grid built at commit
+      LAZY_LEAF        = 2, //!< leaf references a patch whose grid gets built at the first ray hit
+      LAZY_CACHED_LEAF = 3  //!< leaf references a patch whose grid gets built into the tessellation cache at the first ray hit
+    };
+
   public:
 
     /*! constructor for cached subdiv patch */
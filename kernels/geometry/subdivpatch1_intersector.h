@@ -18,7 +18,14 @@ namespace embree
     { 
     public:
       __forceinline SubdivPatch1Precalculations (const Ray& ray, const void* ptr)
-        : T(ray,ptr) {}
+        : T(ray,ptr), pinnedSegment(-1) {}
+
+      __forceinline ~SubdivPatch1Precalculations() {
+        if (unlikely(pinnedSegment >= 0)) SharedLazyTessellationCache::sharedLazyTessellationCache.unpin(pinnedSegment);
+      }
+
+    public:
+      ssize_t pinnedSegment; //!< tessellation cache segment of the current grid, -1 if the grid is not cached
     };
 
     template<int K, typename T>
@@ -26,19 +33,51 @@ namespace embree
     { 
     public:
       __forceinline SubdivPatch1PrecalculationsK (const vbool<K>& valid, RayK<K>& ray)
-        : T(valid,ray) {}
+        : T(valid,ray), pinnedSegment(-1) {}
+
+      __forceinline ~SubdivPatch1PrecalculationsK() {
+        if (unlikely(pinnedSegment >= 0)) SharedLazyTessellationCache::sharedLazyTessellationCache.unpin(pinnedSegment);
+      }
+
+    public:
+      ssize_t pinnedSegment; //!< tessellation cache segment of the current grid, -1 if the grid is not cached
     };
 
+    /*! returns the grid referenced by some leaf of the BVH over subdivision patches */
+    template<typename Precalculations>
+      static __forceinline GridSOA* getSubdivPatch1Grid(Precalculations& pre, const Accel::Intersectors* This, const void* prim, size_t ty)
+    {
+      if (likely(ty == SubdivPatch1::GRID_LEAF))
+        return (GridSOA*) prim;
+
+      SubdivPatch1* patch = (SubdivPatch1*) prim;
+      BVH4* bvh = (BVH4*) This->ptr;
+      if (ty == SubdivPatch1::LAZY_LEAF)
+        return GridSOA::lazyBuild(patch,bvh->scene,bvh->alloc);
+
+      /* the previous grid got traversed completely before reaching this leaf, thus it can get released */
+      SharedLazyTessellationCache& cache = SharedLazyTessellationCache::sharedLazyTessellationCache;
+      if (pre.pinnedSegment >= 0) cache.unpin(pre.pinnedSegment);
+
+      /* the grid stays pinned instead of locked while getting traversed, such that filter functions
+         can invoke rtcInterpolate or nested ray queries without blocking segment switches */
+      GridSOA* grid = GridSOA::lazyBuildCached(patch,bvh->scene);
+      pre.pinnedSegment = cache.pin(grid);
+      SharedLazyTessellationCache::unlock();
+      return grid;
+    }
+
     class SubdivPatch1Intersector1
     {
     public:
       typedef GridSOA Primitive;
       typedef SubdivPatch1Precalculations<GridSOAIntersector1::Precalculations> Precalculations;
 
-      static __forceinline bool processLazyNode(Precalculations& pre, IntersectContext* context, const Primitive* prim, size_t& lazy_node)
+      static __forceinline bool processLazyNode(const Accel::Intersectors* This, Precalculations& pre, IntersectContext* context, const Primitive* prim, size_t ty, size_t& lazy_node)
       {
-        lazy_node = prim->root(0);
-        pre.grid = (Primitive*)prim;
+        GridSOA* grid = getSubdivPatch1Grid(pre,This,prim,ty);
+        lazy_node = grid->root(0);
+        pre.grid = grid;
         return false;
       }
 
@@ -47,7 +86,7 @@ namespace embree
         static __forceinline void intersect(const Accel::Intersectors* This, Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive* prim, size_t ty, const TravRay<N,robust> &tray, size_t& lazy_node) 
       {
         if (likely(ty == 0)) GridSOAIntersector1::intersect(pre,ray,context,prim,lazy_node);
-        else                 processLazyNode(pre,context,prim,lazy_node);
+        else                 processLazyNode(This,pre,context,prim,ty,lazy_node);
       }
 
       template<int N, bool robust>
@@ -60,7 +99,7 @@ namespace embree
       static __forceinline bool occluded(const Accel::Intersectors* This, Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive* prim, size_t ty, const TravRay<N,robust> &tray, size_t& lazy_node)
       {
         if (likely(ty == 0)) return GridSOAIntersector1::occluded(pre,ray,context,prim,lazy_node);
-        else                 return processLazyNode(pre,context,prim,lazy_node);
+        else                 return processLazyNode(This,pre,context,prim,ty,lazy_node);
       }
 
       template<int N, bool robust>
@@ -145,10 +184,11 @@ namespace embree
       typedef GridSOA Primitive;
       typedef SubdivPatch1PrecalculationsK<K,typename GridSOAIntersectorK<K>::Precalculations> Precalculations;
       
-      static __forceinline bool processLazyNode(Precalculations& pre, IntersectContext* context, const Primitive* prim, size_t& lazy_node)
+      static __forceinline bool processLazyNode(const Accel::Intersectors* This, Precalculations& pre, IntersectContext* context, const Primitive* prim, size_t ty, size_t& lazy_node)
       {
-        lazy_node = prim->root(0);
-        pre.grid = (Primitive*)prim;
+        GridSOA* grid = getSubdivPatch1Grid(pre,This,prim,ty);
+        lazy_node = grid->root(0);
+        pre.grid = grid;
         return false;
       }
       
@@ -156,28 +196,28 @@ namespace embree
       static __forceinline void intersect(const vbool<K>& valid, const Accel::Intersectors* This, Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const Primitive* prim, size_t ty, const TravRayK<K, robust> &tray, size_t& lazy_node)
       {
         if (likely(ty == 0)) GridSOAIntersectorK<K>::intersect(valid,pre,ray,context,prim,lazy_node);
-        else                 processLazyNode(pre,context,prim,lazy_node);
+        else                 processLazyNode(This,pre,context,prim,ty,lazy_node);
       }
       
       template<bool robust>        
       static __forceinline vbool<K> occluded(const vbool<K>& valid, const Accel::Intersectors* This, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive* prim, size_t ty, const TravRayK<K, robust> &tray, size_t& lazy_node)
       {
         if (likely(ty == 0)) return GridSOAIntersectorK<K>::occluded(valid,pre,ray,context,prim,lazy_node);
-        else                 return processLazyNode(pre,context,prim,lazy_node);
+        else                 return processLazyNode(This,pre,context,prim,ty,lazy_node);
       }
       
       template<int N, bool robust>              
         static __forceinline void intersect(const Accel::Intersectors* This, Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const Primitive* prim, size_t ty, const TravRay<N,robust> &tray, size_t& lazy_node)
       {
         if (likely(ty == 0)) GridSOAIntersectorK<K>::intersect(pre,ray,k,context,prim,lazy_node);
-        else                 processLazyNode(pre,context,prim,lazy_node);
+        else                 processLazyNode(This,pre,context,prim,ty,lazy_node);
       }
       
       template<int N, bool robust>              
       static __forceinline bool occluded(const Accel::Intersectors* This, Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive* prim, size_t ty, const TravRay<N,robust> &tray, size_t& lazy_node)
       {
         if (likely(ty == 0)) return GridSOAIntersectorK<K>::occluded(pre,ray,k,context,prim,lazy_node);
-        else                 return processLazyNode(pre,context,prim,lazy_node);
+        else                 return processLazyNode(This,pre,context,prim,ty,lazy_node);
       }
     };
 
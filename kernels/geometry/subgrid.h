@@ -19,6 +19,7 @@ namespace embree
           size_t sizeActive(const char* This) const;
           size_t sizeTotal(const char* This) const;
           size_t getBytes(const char* This) const;
+          unsigned int geomID(const char* This, size_t i) const;
         };
         static Type type;
 
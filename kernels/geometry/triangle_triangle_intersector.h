@@ -1,6 +1,8 @@
 // Copyright 2009-2021 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#pragma once
+
 #include "primitive.h"
 
 namespace embree
@@ -125,6 +127,199 @@ namespace embree
         
         return conjoint(ba,bb);
       }
+
+      /* tests K triangle pairs for overlapping bounding boxes */
+      template<int K>
+      __forceinline static vbool<K> overlap_bounds (const Vec3vf<K>& a0, const Vec3vf<K>& a1, const Vec3vf<K>& a2,
+                                                    const Vec3vf<K>& b0, const Vec3vf<K>& b1, const Vec3vf<K>& b2)
+      {
+        const Vec3vf<K> lower = max(min(min(a0,a1),a2),min(min(b0,b1),b2));
+        const Vec3vf<K> upper = min(max(max(a0,a1),a2),max(max(b0,b1),b2));
+        return (lower.x <= upper.x) & (lower.y <= upper.y) & (lower.z <= upper.z);
+      }
+
+      /* conservatively rejects K triangle pairs that lie completely on
+       * one side of the plane of the other triangle, the remaining
+       * pairs have to get tested with intersect_triangle_triangle */
+      template<int K>
+      __forceinline static vbool<K> overlap_planes (const Vec3vf<K>& a0, const Vec3vf<K>& a1, const Vec3vf<K>& a2,
+                                                    const Vec3vf<K>& b0, const Vec3vf<K>& b1, const Vec3vf<K>& b2)
+      {
+        const vfloat<K> eps = 1E-5f;
+        
+        const Vec3vf<K> Na = cross(a1-a0,a2-a0);
+        const vfloat<K> Ca = dot(Na,a0);
+        const Vec3vf<K> Nb = cross(b1-b0,b2-b0);
+        const vfloat<K> Cb = dot(Nb,b0);
+
+        const vfloat<K> da0 = dot(Nb,a0)-Cb;
+        const vfloat<K> da1 = dot(Nb,a1)-Cb;
+        const vfloat<K> da2 = dot(Nb,a2)-Cb;
+        const vfloat<K> db0 = dot(Na,b0)-Ca;
+        const vfloat<K> db1 = dot(Na,b1)-Ca;
+        const vfloat<K> db2 = dot(Na,b2)-Ca;
+
+        const vbool<K> valid_a = (max(da0,da1,da2) >= -eps) & (min(da0,da1,da2) <= eps);
+        const vbool<K> valid_b = (max(db0,db1,db2) >= -eps) & (min(db0,db1,db2) <= eps);
+        return valid_a & valid_b;
+      }
+    };
+
+    /* continuous collision detection of two linearly moving triangles */
+    struct TriangleTriangleCCD
+    {
+      typedef Vec3<double> Vec3d;
+
+      __forceinline static Vec3d todouble(const Vec3fa& v) {
+        return Vec3d(v.x,v.y,v.z);
+      }
+
+      __forceinline static double eval(const double c[4], double u) {
+        return ((c[3]*u+c[2])*u+c[1])*u+c[0];
+      }
+
+      /* calculates the roots of c0+c1*u+c2*u^2+c3*u^3 in [0,1] in increasing order */
+      static size_t cubic_roots(const double c[4], double roots[4])
+      {
+        /* split [0,1] into monotonic pieces at the roots of the derivative */
+        double split[4]; size_t num_split = 0;
+        split[num_split++] = 0.0;
+        const double a = 3.0*c[3], b = 2.0*c[2], d = c[1];
+        if (a != 0.0) {
+          const double disc = b*b-4.0*a*d;
+          if (disc >= 0.0) {
+            const double sq = std::sqrt(disc);
+            double r0 = (-b-sq)/(2.0*a), r1 = (-b+sq)/(2.0*a);
+            if (r0 > r1) std::swap(r0,r1);
+            if (r0 > 0.0 && r0 < 1.0) split[num_split++] = r0;
+            if (r1 > 0.0 && r1 < 1.0 && r1 != r0) split[num_split++] = r1;
+          }
+        } else if (b != 0.0) {
+          const double r = -d/b;
+          if (r > 0.0 && r < 1.0) split[num_split++] = r;
+        }
+        split[num_split++] = 1.0;
+
+        /* values close to zero at a split point are grazing contacts */
+        const double eps = 1E-9*(std::abs(c[0])+std::abs(c[1])+std::abs(c[2])+std::abs(c[3]));
+        size_t num_roots = 0;
+        for (size_t i=0; i+1<num_split; i++)
+        {
+          double l = split[i], r = split[i+1];
+          double fl = eval(c,l), fr = eval(c,r);
+          if (std::abs(fl) <= eps) {
+            if (num_roots == 0 || roots[num_roots-1] != l) roots[num_roots++] = l;
+            continue;
+          }
+          if ((fl < 0.0) == (fr < 0.0)) continue;
+          for (size_t k=0; k<64 && l < r; k++) {
+            const double m = 0.5*(l+r);
+            const double fm = eval(c,m);
+            if ((fm < 0.0) == (fl < 0.0)) { l = m; fl = fm; }
+            else r = m;
+          }
+          roots[num_roots++] = r;
+        }
+        if (std::abs(eval(c,1.0)) <= eps && (num_roots == 0 || roots[num_roots-1] != 1.0))
+          roots[num_roots++] = 1.0;
+        return num_roots;
+      }
+
+      /* calculates the coefficients of the coplanarity function of 4 linearly moving points */
+      static void coplanarity(const Vec3fa p0[4], const Vec3fa p1[4], double c[4])
+      {
+        const Vec3d x0 = todouble(p0[0]), dx = todouble(p1[0])-x0;
+        const Vec3d a0 = todouble(p0[1])-x0, da = todouble(p1[1])-todouble(p0[1])-dx;
+        const Vec3d b0 = todouble(p0[2])-x0, db = todouble(p1[2])-todouble(p0[2])-dx;
+        const Vec3d c0 = todouble(p0[3])-x0, dc = todouble(p1[3])-todouble(p0[3])-dx;
+        const Vec3d C0 = cross(a0,b0);
+        const Vec3d C1 = cross(a0,db)+cross(da,b0);
+        const Vec3d C2 = cross(da,db);
+        c[0] = dot(C0,c0);
+        c[1] = dot(C1,c0)+dot(C0,dc);
+        c[2] = dot(C2,c0)+dot(C1,dc);
+        c[3] = dot(C2,dc);
+      }
+
+      static float segment_segment_distance(const Vec3fa& p0, const Vec3fa& p1, const Vec3fa& q0, const Vec3fa& q1)
+      {
+        const Vec3fa d1 = p1-p0, d2 = q1-q0, r = p0-q0;
+        const float a = dot(d1,d1), e = dot(d2,d2), f = dot(d2,r);
+        float s = 0.0f, t = 0.0f;
+        if (a == 0.0f && e == 0.0f) return distance(p0,q0);
+        if (a == 0.0f) t = clamp(f/e,0.0f,1.0f);
+        else
+        {
+          const float c = dot(d1,r);
+          if (e == 0.0f) s = clamp(-c/a,0.0f,1.0f);
+          else
+          {
+            const float b = dot(d1,d2), denom = a*e-b*b;
+            if (denom != 0.0f) s = clamp((b*f-c*e)/denom,0.0f,1.0f);
+            t = (b*s+f)/e;
+            if      (t < 0.0f) { t = 0.0f; s = clamp(-c/a,0.0f,1.0f); }
+            else if (t > 1.0f) { t = 1.0f; s = clamp((b-c)/a,0.0f,1.0f); }
+          }
+        }
+        return distance(p0+s*d1,q0+t*d2);
+      }
+
+      /* finds the earliest contact of a vertex and a face (edge = false)
+       * or of two edges (edge = true) in [0,umax) */
+      static bool feature_contact(const Vec3fa p0[4], const Vec3fa p1[4], bool edge, float tol, float& umax)
+      {
+        double c[4]; coplanarity(p0,p1,c);
+        double roots[4];
+        const size_t num_roots = cubic_roots(c,roots);
+        for (size_t i=0; i<num_roots; i++)
+        {
+          const float u = float(roots[i]);
+          if (u >= umax) return false;
+          const Vec3fa x0 = lerp(p0[0],p1[0],u), x1 = lerp(p0[1],p1[1],u);
+          const Vec3fa x2 = lerp(p0[2],p1[2],u), x3 = lerp(p0[3],p1[3],u);
+          const float dist = edge ? segment_segment_distance(x0,x1,x2,x3)
+                                  : distance(x3,closestPointOnTriangle(x3,x0,x1,x2));
+          if (dist <= tol) { umax = u; return true; }
+        }
+        return false;
+      }
+
+      /* calculates the earliest time u in [0,1] at which the triangles
+       * a (moving from a0 to a1) and b (moving from b0 to b1) touch,
+       * assuming they do not intersect at u=0 */
+      static bool intersect(const Vec3fa a0[3], const Vec3fa a1[3], const Vec3fa b0[3], const Vec3fa b1[3], float& u)
+      {
+        BBox3fa bounds = empty;
+        for (size_t i=0; i<3; i++) {
+          bounds.extend(a0[i]); bounds.extend(a1[i]);
+          bounds.extend(b0[i]); bounds.extend(b1[i]);
+        }
+        const float tol = 1E-5f*(reduce_max(bounds.size())+reduce_max(max(abs(bounds.lower),abs(bounds.upper))));
+
+        float umax = inf;
+        bool hit = false;
+        
+        /* vertex face contacts */
+        for (size_t i=0; i<3; i++) {
+          const Vec3fa pa0[4] = { b0[0], b0[1], b0[2], a0[i] };
+          const Vec3fa pa1[4] = { b1[0], b1[1], b1[2], a1[i] };
+          hit |= feature_contact(pa0,pa1,false,tol,umax);
+          const Vec3fa pb0[4] = { a0[0], a0[1], a0[2], b0[i] };
+          const Vec3fa pb1[4] = { a1[0], a1[1], a1[2], b1[i] };
+          hit |= feature_contact(pb0,pb1,false,tol,umax);
+        }
+        
+        /* edge edge contacts */
+        for (size_t i=0; i<3; i++) {
+          for (size_t j=0; j<3; j++) {
+            const Vec3fa p0[4] = { a0[i], a0[(i+1)%3], b0[j], b0[(j+1)%3] };
+            const Vec3fa p1[4] = { a1[i], a1[(i+1)%3], b1[j], b1[(j+1)%3] };
+            hit |= feature_contact(p0,p1,true,tol,umax);
+          }
+        }
+        u = umax;
+        return hit;
+      }
     };
   }
 }
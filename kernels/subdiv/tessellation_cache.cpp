@@ -20,9 +20,16 @@ namespace embree
 
   void resetTessellationCache()
   {
-    //SharedLazyTessellationCache::sharedLazyTessellationCache.addCurrentIndex(SharedLazyTessellationCache::NUM_CACHE_SEGMENTS);
     SharedLazyTessellationCache::sharedLazyTessellationCache.reset();
   }
+
+  TessellationCacheStats getTessellationCacheStats() {
+    return SharedLazyTessellationCache::sharedLazyTessellationCache.getStats();
+  }
+
+  void clearTessellationCacheStats() {
+    SharedLazyTessellationCache::sharedLazyTessellationCache.clearStats();
+  }
   
   SharedLazyTessellationCache::SharedLazyTessellationCache()
   {
@@ -30,15 +37,15 @@ namespace embree
     data = nullptr;
     hugepages = false;
     maxBlocks              = size/BLOCK_SIZE;
+    segmentBlocks          = maxBlocks/NUM_CACHE_SEGMENTS;
+    segmentBytes           = max(segmentBlocks,size_t(1))*BLOCK_SIZE;
     localTime              = NUM_CACHE_SEGMENTS;
     next_block             = 0;
+    switch_block_threshold = 0;
     numRenderThreads       = 0;
-#if FORCE_SIMPLE_FLUSH == 1
-    switch_block_threshold = maxBlocks;
-#else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
-#endif
     threadWorkState     = new ThreadWorkState[NUM_PREALLOC_THREAD_WORK_STATES];
+    for (size_t i=0; i<NUM_CACHE_SEGMENTS; i++) segmentPins[i] = 0;
+    resetSegments();
 
     //reset_state.reset();
     //linkedlist_mtx.reset();
@@ -81,47 +88,125 @@ namespace embree
      }
    }
 
+  void SharedLazyTessellationCache::lockAllThreads()
+  {
+    /* lock the linked list of thread states */
+    linkedlist_mtx.lock();
+
+    /* block all threads */
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
+        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+  }
+
+  void SharedLazyTessellationCache::unlockAllThreads()
+  {
+    /* release all blocked threads */
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
+      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
+
+    /* unlock the linked list of thread states */
+    linkedlist_mtx.unlock();
+  }
+
+  void SharedLazyTessellationCache::resetSegments()
+  {
+    /* invalidate all entries and restart with the minimal number of segments */
+    numSegments = MIN_CACHE_SEGMENTS;
+    for (size_t i=0; i<NUM_CACHE_SEGMENTS; i++) {
+      segmentTime[i] = 0;
+      segmentEntries[i] = 0;
+      segmentReferenced[i] = false;
+    }
+    currentSegment = 0;
+    unreferencedSwitches = 0;
+    localTime += NUM_CACHE_SEGMENTS;
+    segmentTime[0] = localTime;
+    next_block = 0;
+    switch_block_threshold = segmentBlocks;
+  }
+
+  void SharedLazyTessellationCache::evictSegment(const size_t segment, ThreadWorkState* t_state)
+  {
+    if (segmentTime[segment] != 0)
+      ThreadWorkState::inc(t_state->evictions,segmentEntries[segment]);
+
+    segmentTime[segment] = 0;
+    segmentEntries[segment] = 0;
+    segmentReferenced[segment] = false;
+  }
+
+  void SharedLazyTessellationCache::startSegment(const size_t segment, ThreadWorkState* t_state)
+  {
+    evictSegment(segment,t_state);
+
+    localTime++;
+    currentSegment = segment;
+    segmentTime[segment] = localTime;
+    next_block = segment * segmentBlocks;
+    switch_block_threshold = next_block + segmentBlocks;
+    assert( switch_block_threshold <= maxBlocks );
+  }
+
+  size_t SharedLazyTessellationCache::selectSegment(ThreadWorkState* t_state)
+  {
+    /* the most recently filled segments may still get referenced by patches under construction */
+    auto recyclable = [&] (size_t segment) {
+      return segmentTime[segment] + MIN_SEGMENT_LIFETIME <= localTime && segmentPins[segment] == 0;
+    };
+
+    /* no second chance during a full turn of the clock hand, thus the working set fits into fewer segments */
+    if (unreferencedSwitches >= numSegments && numSegments > MIN_CACHE_SEGMENTS && recyclable(numSegments-1))
+    {
+      evictSegment(--numSegments,t_state);
+      unreferencedSwitches = 0;
+    }
+
+    /* advance the clock hand and give referenced segments a second chance */
+    size_t segment = currentSegment;
+    bool secondChance = false;
+    for (size_t i=0; i<numSegments; i++)
+    {
+      segment = (segment+1) % numSegments;
+      if (!recyclable(segment)) continue;
+      if (!segmentReferenced[segment]) {
+        unreferencedSwitches = secondChance ? 0 : unreferencedSwitches+1;
+        return segment;
+      }
+      segmentReferenced[segment] = false;
+      secondChance = true;
+    }
+    unreferencedSwitches = 0;
+
+    /* all segments got referenced, thus grow the cache if possible */
+    if (numSegments < NUM_CACHE_SEGMENTS)
+      return numSegments++;
+
+    /* otherwise recycle the first segment after the clock hand */
+    for (size_t i=0; i<numSegments; i++) {
+      segment = (segment+1) % numSegments;
+      if (recyclable(segment)) return segment;
+    }
+
+    /* all segments are pinned, thus retry once some pin got released */
+    return (size_t)-1;
+  }
+
   void SharedLazyTessellationCache::allocNextSegment() 
   {
     if (reset_state.try_lock())
     {
       if (next_block >= switch_block_threshold)
       {
-        /* lock the linked list of thread states */
-        
-        linkedlist_mtx.lock();
-        
-        /* block all threads */
-        for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-          if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-            waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+        lockAllThreads();
         
         /* switch to the next segment */
-        addCurrentIndex();
-        CACHE_STATS(PRINT("RESET TESS CACHE"));
-        
-#if FORCE_SIMPLE_FLUSH == 1
-        next_block = 0;
-        switch_block_threshold = maxBlocks;
-#else
-        const size_t region = localTime % NUM_CACHE_SEGMENTS;
-        next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-        switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
-        assert( switch_block_threshold <= maxBlocks );
-#endif
-        
-        CACHE_STATS(SharedTessellationCacheStats::cache_flushes++);
-        
-        /* release all blocked threads */
-        
-        for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-          unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-        
-        /* unlock the linked list of thread states */
-        
-        linkedlist_mtx.unlock();
-	
-        
+        ThreadWorkState* t_state = threadState();
+        const size_t segment = selectSegment(t_state);
+        if (segment != (size_t)-1) startSegment(segment,t_state);
+
+        unlockAllThreads();
+        if (segment == (size_t)-1) _mm_pause();
       }
       reset_state.unlock();
     }
@@ -135,31 +220,9 @@ namespace embree
     /* lock the reset_state */
     reset_state.lock();
 
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
-
-    /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
-
-    /* reset to the first segment */
-    next_block = 0;
-#if FORCE_SIMPLE_FLUSH == 1
-    switch_block_threshold = maxBlocks;
-#else
-    switch_block_threshold = maxBlocks/NUM_CACHE_SEGMENTS;
-#endif
-
-    /* reset local time */
-    localTime = NUM_CACHE_SEGMENTS;
-
-    /* release all blocked threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
-
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
+    lockAllThreads();
+    resetSegments();
+    unlockAllThreads();
 
     /* unlock the reset_state */
     reset_state.unlock();
@@ -170,77 +233,57 @@ namespace embree
     /* lock the reset_state */
     reset_state.lock();
 
-    /* lock the linked list of thread states */
-    linkedlist_mtx.lock();
-
-    /* block all threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      if (lockThread(t,THREAD_BLOCK_ATOMIC_ADD) != 0)
-        waitForUsersLessEqual(t,THREAD_BLOCK_ATOMIC_ADD);
+    lockAllThreads();
 
-    /* reallocate data */
+    /* reallocate data, pinned entries must not be in use as their memory gets freed */
     if (data) os_free(data,size,hugepages);
     size      = new_size;
     data      = nullptr;
     if (size) data = (float*)os_malloc(size,hugepages);
     maxBlocks = size/BLOCK_SIZE;    
+    segmentBlocks = maxBlocks/NUM_CACHE_SEGMENTS;
+    segmentBytes = max(segmentBlocks,size_t(1))*BLOCK_SIZE;
 
     /* invalidate entire cache */
-    localTime += NUM_CACHE_SEGMENTS; 
-
-    /* reset to the first segment */
-#if FORCE_SIMPLE_FLUSH == 1
-    next_block = 0;
-    switch_block_threshold = maxBlocks;
-#else
-    const size_t region = localTime % NUM_CACHE_SEGMENTS;
-    next_block = region * (maxBlocks/NUM_CACHE_SEGMENTS);
-    switch_block_threshold = next_block + (maxBlocks/NUM_CACHE_SEGMENTS);
-    assert( switch_block_threshold <= maxBlocks );
-#endif
-
-    /* release all blocked threads */
-    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next)
-      unlockThread(t,-THREAD_BLOCK_ATOMIC_ADD);
+    resetSegments();
 
-    /* unlock the linked list of thread states */
-    linkedlist_mtx.unlock();	    
+    unlockAllThreads();
 
     /* unlock the reset_state */
     reset_state.unlock();
   }
 
-
-  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
-  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
-  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-  std::atomic<size_t> SharedTessellationCacheStats::cache_accesses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_hits(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_misses(0);
-  std::atomic<size_t> SharedTessellationCacheStats::cache_flushes(0);  
-  SpinLock   SharedTessellationCacheStats::mtx;  
-  size_t SharedTessellationCacheStats::cache_num_patches(0);
-
-  void SharedTessellationCacheStats::printStats()
+  TessellationCacheStats SharedLazyTessellationCache::getStats()
   {
-    PRINT(cache_accesses);
-    PRINT(cache_misses);
-    PRINT(cache_hits);
-    PRINT(cache_flushes);
-    PRINT(100.0f * cache_hits / cache_accesses);
-    assert(cache_hits + cache_misses == cache_accesses);
-    PRINT(cache_num_patches);
+    TessellationCacheStats stats;
+    stats.hits = stats.misses = stats.evictions = 0;
+
+    linkedlist_mtx.lock();
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next) {
+      stats.hits += t->hits.load(std::memory_order_relaxed);
+      stats.misses += t->misses.load(std::memory_order_relaxed);
+      stats.evictions += t->evictions.load(std::memory_order_relaxed);
+    }
+    stats.bytes = numSegments*segmentBlocks*BLOCK_SIZE;
+    linkedlist_mtx.unlock();
+    return stats;
   }
 
-  void SharedTessellationCacheStats::clearStats()
+  void SharedLazyTessellationCache::clearStats()
   {
-    SharedTessellationCacheStats::cache_accesses  = 0;
-    SharedTessellationCacheStats::cache_hits      = 0;
-    SharedTessellationCacheStats::cache_misses    = 0;
-    SharedTessellationCacheStats::cache_flushes   = 0;
+    linkedlist_mtx.lock();
+    for (ThreadWorkState *t=current_t_state;t!=nullptr;t=t->next) {
+      t->hits = 0;
+      t->misses = 0;
+      t->evictions = 0;
+    }
+    linkedlist_mtx.unlock();
   }
 
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
   struct cache_regression_test : public RegressionTest
   {
     BarrierSys barrier;
@@ -316,11 +359,64 @@ namespace embree
   };
 
   cache_regression_test cache_regression;
+
+  struct cache_budget_regression_test : public RegressionTest
+  {
+    static const size_t numEntries = 2048;
+    static const size_t numReusedEntries = 40;
+    SharedLazyTessellationCache::CacheEntry entry[numEntries];
+
+    cache_budget_regression_test()
+      : RegressionTest("cache_budget_regression_test")
+    {
+      registerRegressionTest(this);
+    }
+
+    void lookup(size_t elt)
+    {
+      SharedLazyTessellationCache::lookup(entry[elt],0,[&] () {
+          return SharedLazyTessellationCache::sharedLazyTessellationCache.malloc(16*1024);
+        });
+      SharedLazyTessellationCache::sharedLazyTessellationCache.unlock();
+    }
+
+    bool run ()
+    {
+      SharedLazyTessellationCache& cache = SharedLazyTessellationCache::sharedLazyTessellationCache;
+      const size_t oldSize = cache.getSize();
+      cache.realloc(1024*1024); // 7 entries per segment
+      for (size_t i=0; i<numEntries; i++) entry[i].tag.reset();
+
+      /* random lookups of a working set larger than the initial budget grow the cache */
+      size_t rnd = 1;
+      for (size_t i=0; i<4096; i++) {
+        rnd = rnd*1103515245+12345;
+        lookup((rnd >> 16) % numReusedEntries);
+      }
+      const size_t bytesReused = cache.getStats().bytes;
+
+      /* patches that never get reused shrink the cache again */
+      for (size_t i=numReusedEntries; i<numEntries; i++)
+        lookup(i);
+      const size_t bytesStreamed = cache.getStats().bytes;
+      const size_t bytesMin = SharedLazyTessellationCache::MIN_CACHE_SEGMENTS*cache.maxAllocSize()*SharedLazyTessellationCache::BLOCK_SIZE;
+
+      cache.realloc(oldSize);
+      return bytesReused > bytesMin && bytesStreamed < bytesReused;
+    }
+  };
+
+  cache_budget_regression_test cache_budget_regression;
 };
 
 extern "C" void printTessCacheStats()
 {
   PRINT("SHARED TESSELLATION CACHE");
-  embree::SharedTessellationCacheStats::printStats();
-  embree::SharedTessellationCacheStats::clearStats();
+  const embree::TessellationCacheStats stats = embree::getTessellationCacheStats();
+  PRINT(stats.hits);
+  PRINT(stats.misses);
+  PRINT(stats.evictions);
+  PRINT(100.0f * stats.hits / embree::max(size_t(1),stats.hits+stats.misses));
+  PRINT(stats.bytes);
+  embree::clearTessellationCacheStats();
 }
@@ -5,37 +5,23 @@
 
 #include "../common/default.h"
 
-/* force a complete cache invalidation when running out of allocation space */
-#define FORCE_SIMPLE_FLUSH 0
-
 #define THREAD_BLOCK_ATOMIC_ADD 4
 
-#if defined(DEBUG)
-#define CACHE_STATS(x) 
-#else
-#define CACHE_STATS(x) 
-#endif
-
 namespace embree
 {
-  class SharedTessellationCacheStats
+  /*! statistics of the shared tessellation cache, accumulated over all threads */
+  struct TessellationCacheStats
   {
-  public:
-    /* stats */
-    static std::atomic<size_t> cache_accesses;
-    static std::atomic<size_t> cache_hits;
-    static std::atomic<size_t> cache_misses;
-    static std::atomic<size_t> cache_flushes;                
-    static size_t        cache_num_patches;
-    __aligned(64) static SpinLock mtx;
-    
-    /* print stats for debugging */                 
-    static void printStats();
-    static void clearStats();
+    size_t hits;       //!< number of lookups that found a valid cache entry
+    size_t misses;     //!< number of lookups that had to construct the cache entry
+    size_t evictions;  //!< number of valid cache entries discarded by segment recycling
+    size_t bytes;      //!< memory budget of the segments currently in use
   };
-  
+
   void resizeTessellationCache(size_t new_size);
   void resetTessellationCache();
+  TessellationCacheStats getTessellationCacheStats();
+  void clearTessellationCacheStats();
   
  ////////////////////////////////////////////////////////////////////////////////
  ////////////////////////////////////////////////////////////////////////////////
@@ -49,20 +35,46 @@ namespace embree
    ThreadWorkState* next;
    bool allocated;
 
+   /* cache statistics, only incremented by the owning thread */
+   std::atomic<size_t> hits;
+   std::atomic<size_t> misses;
+   std::atomic<size_t> evictions;
+
    __forceinline ThreadWorkState(bool allocated = false) 
-     : counter(0), next(nullptr), allocated(allocated) 
+     : counter(0), next(nullptr), allocated(allocated), hits(0), misses(0), evictions(0)
    {
      assert( ((size_t)this % 64) == 0 ); 
    }   
+
+   static __forceinline void inc(std::atomic<size_t>& v, size_t n = 1) {
+     v.store(v.load(std::memory_order_relaxed)+n,std::memory_order_relaxed);
+   }
  };
 
+ /*! The cache memory is split into segments that are filled one after
+  *  another. When the current segment is full, a segment gets recycled
+  *  using the CLOCK replacement policy: segments that contained some
+  *  cache hit since the clock hand passed them last get a second
+  *  chance, and the most recently filled segments are never recycled
+  *  such that patches under construction stay valid. Cache entries are
+  *  trees of pointers into the cache memory, thus they cannot get
+  *  evicted or moved individually. The number of segments in use
+  *  starts small and grows up to the configured cache size when all
+  *  segments get referenced, and shrinks again when a full turn of the
+  *  clock hand found no referenced segment, thus the used memory
+  *  adapts to the working set. Segments can get pinned to keep cache
+  *  entries valid without keeping the cache locked, e.g. while rays
+  *  traverse a lazily built grid and invoke user callbacks. */
  class __aligned(64) SharedLazyTessellationCache 
  {
  public:
    
-   static const size_t NUM_CACHE_SEGMENTS              = 8;
+   static const size_t NUM_CACHE_SEGMENTS              = 8;  // a patch has to fit into a single segment
+   static const size_t MIN_CACHE_SEGMENTS              = 4;
+   static const size_t MIN_SEGMENT_LIFETIME            = 3; // has to be smaller than MIN_CACHE_SEGMENTS
    static const size_t NUM_PREALLOC_THREAD_WORK_STATES = 512;
    static const size_t COMMIT_INDEX_SHIFT              = 32+8;
+   static const uint64_t COMMIT_INDEX_MASK             = (uint64_t(1) << (64-COMMIT_INDEX_SHIFT))-1;
 #if defined(__X86_64__)
    static const size_t REF_TAG_MASK                    = 0xffffffffff;
 #else
@@ -112,12 +124,13 @@ namespace embree
      __forceinline int64_t get() const { return data.load(); }
      __forceinline void set( int64_t v ) { data.store(v); }
      __forceinline void reset() { data.store(0); }
+     __forceinline bool compare_exchange(int64_t& expected, int64_t v) { return data.compare_exchange_strong(expected,v); }
 
    private:
      atomic<int64_t> data;
    };
 
-   static __forceinline size_t extractCommitIndex(const int64_t v) { return v >> SharedLazyTessellationCache::COMMIT_INDEX_SHIFT; }
+   static __forceinline size_t extractCommitIndex(const int64_t v) { return (uint64_t)v >> SharedLazyTessellationCache::COMMIT_INDEX_SHIFT; }
 
    struct CacheEntry
    {
@@ -131,6 +144,8 @@ namespace embree
    bool hugepages;
    size_t size;
    size_t maxBlocks;
+   size_t segmentBlocks;
+   size_t segmentBytes;
    ThreadWorkState *threadWorkState;
       
    __aligned(64) std::atomic<size_t> localTime;
@@ -140,6 +155,14 @@ namespace embree
    __aligned(64) std::atomic<size_t> switch_block_threshold;
    __aligned(64) std::atomic<size_t> numRenderThreads;
 
+   /* segment state, only modified while all threads are blocked */
+   __aligned(64) size_t numSegments;                        //!< number of segments in use
+   size_t currentSegment;                                   //!< segment allocations are made from, position of the clock hand
+   size_t unreferencedSwitches;                             //!< number of segment switches since the last second chance
+   size_t segmentTime[NUM_CACHE_SEGMENTS];                  //!< local time the segment got filled at, 0 for unused segments
+   std::atomic<size_t> segmentEntries[NUM_CACHE_SEGMENTS];  //!< number of cache entries stored in the segment
+   __aligned(64) std::atomic<bool> segmentReferenced[NUM_CACHE_SEGMENTS]; //!< set by cache hits
+   __aligned(64) std::atomic<size_t> segmentPins[NUM_CACHE_SEGMENTS];     //!< number of pins preventing the recycling of the segment
 
  public:
 
@@ -150,17 +173,15 @@ namespace embree
    void getNextRenderThreadWorkState();
 
    __forceinline size_t maxAllocSize() const {
-     return switch_block_threshold;
+     return segmentBlocks;
    }
 
    __forceinline size_t getCurrentIndex() { return localTime.load(); }
-   __forceinline void   addCurrentIndex(const size_t i=1) { localTime.fetch_add(i); }
 
    __forceinline size_t getTime(const size_t globalTime) {
      return localTime.load()+NUM_CACHE_SEGMENTS*globalTime;
    }
 
-
    __forceinline size_t lockThread  (ThreadWorkState *const t_state, const ssize_t plus=1) { return t_state->counter.fetch_add(plus);  }
    __forceinline size_t unlockThread(ThreadWorkState *const t_state, const ssize_t plus=-1) { assert(isLocked(t_state)); return t_state->counter.fetch_add(plus); }
 
@@ -172,10 +193,6 @@ namespace embree
    static __forceinline size_t getState() { return threadState()->counter.load(); }
    static __forceinline void lockThreadLoop() { sharedLazyTessellationCache.lockThreadLoop(threadState()); }
 
-   static __forceinline size_t getTCacheTime(const size_t globalTime) {
-     return sharedLazyTessellationCache.getTime(globalTime);
-   }
-
    /* per thread lock */
    __forceinline void lockThreadLoop (ThreadWorkState *const t_state) 
    { 
@@ -196,25 +213,21 @@ namespace embree
    static __forceinline void* lookup(CacheEntry& entry, size_t globalTime)
    {   
      const int64_t subdiv_patch_root_ref = entry.tag.get(); 
-     CACHE_STATS(SharedTessellationCacheStats::cache_accesses++);
-     
      if (likely(subdiv_patch_root_ref != 0)) 
      {
-       const size_t subdiv_patch_root = (subdiv_patch_root_ref & REF_TAG_MASK) + (size_t)sharedLazyTessellationCache.getDataPtr();
-       const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
-       
-       if (likely( sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime) ))
+       const size_t offset = subdiv_patch_root_ref & REF_TAG_MASK;
+       const size_t segment = sharedLazyTessellationCache.getSegment(offset);
+       if (likely( sharedLazyTessellationCache.validCacheIndex(segment,extractCommitIndex(subdiv_patch_root_ref),globalTime) ))
        {
-         CACHE_STATS(SharedTessellationCacheStats::cache_hits++);
-         return (void*) subdiv_patch_root;
+         sharedLazyTessellationCache.markReferenced(segment);
+         return (void*) (offset + (size_t)sharedLazyTessellationCache.getDataPtr());
        }
      }
-     CACHE_STATS(SharedTessellationCacheStats::cache_misses++);
      return nullptr;
    }
 
    template<typename Constructor>
-     static __forceinline auto lookup (CacheEntry& entry, size_t globalTime, const Constructor constructor, const bool before=false) -> decltype(constructor())
+     static __forceinline auto lookup (CacheEntry& entry, size_t globalTime, const Constructor constructor) -> decltype(constructor())
    {
      ThreadWorkState *t_state = SharedLazyTessellationCache::threadState();
 
@@ -222,20 +235,29 @@ namespace embree
      {
        sharedLazyTessellationCache.lockThreadLoop(t_state);
        void* patch = SharedLazyTessellationCache::lookup(entry,globalTime);
-       if (patch) return (decltype(constructor())) patch;
+       if (patch) {
+         ThreadWorkState::inc(t_state->hits);
+         return (decltype(constructor())) patch;
+       }
        
        if (entry.mutex.try_lock())
        {
          if (!validTag(entry.tag,globalTime)) 
          {
-           auto timeBefore = sharedLazyTessellationCache.getTime(globalTime);
+           ThreadWorkState::inc(t_state->misses);
+           auto timeBefore = sharedLazyTessellationCache.getCurrentIndex();
            auto ret = constructor(); // thread is locked here!
            assert(ret);
            /* this should never return nullptr */
-           auto timeAfter = sharedLazyTessellationCache.getTime(globalTime);
-           auto time = before ? timeBefore : timeAfter;
+           auto timeAfter = sharedLazyTessellationCache.getCurrentIndex();
            __memory_barrier();
-           entry.tag = SharedLazyTessellationCache::Tag(ret,time);
+           /* all allocations are in the current segment if no segment got recycled in between */
+           if (likely(timeBefore == timeAfter)) {
+             entry.tag = SharedLazyTessellationCache::Tag(ret,sharedLazyTessellationCache.getTime(globalTime));
+             sharedLazyTessellationCache.addEntry();
+           }
+           else
+             entry.tag.reset();
            __memory_barrier();
            entry.mutex.unlock();
            return ret;
@@ -245,19 +267,46 @@ namespace embree
        SharedLazyTessellationCache::sharedLazyTessellationCache.unlockThread(t_state);
      }
    }
+
+   __forceinline size_t getSegment(const size_t offset) const {
+     return min(offset/segmentBytes,NUM_CACHE_SEGMENTS-1); // clamping handles stale entries after resizing the cache
+   }
+
+   __forceinline void markReferenced(const size_t segment)
+   {
+     if (!segmentReferenced[segment].load(std::memory_order_relaxed))
+       segmentReferenced[segment].store(true,std::memory_order_relaxed);
+   }
+
+   __forceinline void addEntry() {
+     segmentEntries[currentSegment]++;
+   }
+
+   /* pins the segment of some cache entry, the calling thread has to be locked */
+   __forceinline size_t pin(const void* ptr)
+   {
+     assert(isLocked(threadState()));
+     const size_t segment = getSegment((size_t)ptr - (size_t)getDataPtr());
+     segmentPins[segment]++;
+     return segment;
+   }
+
+   __forceinline void unpin(const size_t segment) {
+     segmentPins[segment]--;
+   }
    
-   __forceinline bool validCacheIndex(const size_t i, const size_t globalTime)
+   /* an entry is valid if its segment did not get recycled and the commit counter did not change since the entry was created */
+   __forceinline bool validCacheIndex(const size_t segment, const size_t i, const size_t globalTime)
    {
-#if FORCE_SIMPLE_FLUSH == 1
-     return i == getTime(globalTime);
-#else
-     return i+(NUM_CACHE_SEGMENTS-1) >= getTime(globalTime);
-#endif
+     assert(segment < NUM_CACHE_SEGMENTS);
+     const size_t time = segmentTime[segment];
+     return time != 0 && i == ((time+NUM_CACHE_SEGMENTS*globalTime) & COMMIT_INDEX_MASK);
    }
 
+   /* allocations stay valid for some segment switches, as the most recently filled segments are not recycled */
    static __forceinline bool validTime(const size_t oldtime, const size_t newTime)
    {
-     return oldtime+(NUM_CACHE_SEGMENTS-1) >= newTime;
+     return oldtime+MIN_SEGMENT_LIFETIME >= newTime;
    }
 
 
@@ -265,8 +314,8 @@ namespace embree
     {
       const int64_t subdiv_patch_root_ref = tag.get(); 
       if (subdiv_patch_root_ref == 0) return false;
-      const size_t subdiv_patch_cache_index = extractCommitIndex(subdiv_patch_root_ref);
-      return sharedLazyTessellationCache.validCacheIndex(subdiv_patch_cache_index,globalTime);
+      const size_t segment = sharedLazyTessellationCache.getSegment(subdiv_patch_root_ref & REF_TAG_MASK);
+      return sharedLazyTessellationCache.validCacheIndex(segment,extractCommitIndex(subdiv_patch_root_ref),globalTime);
     }
 
    void waitForUsersLessEqual(ThreadWorkState *const t_state,
@@ -274,10 +323,9 @@ namespace embree
     
    __forceinline size_t alloc(const size_t blocks)
    {
-     if (unlikely(blocks >= switch_block_threshold))
+     if (unlikely(blocks >= segmentBlocks))
        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"allocation exceeds size of tessellation cache segment");
 
-     assert(blocks < switch_block_threshold);
      size_t index = next_block.fetch_add(blocks);
      if (unlikely(index + blocks >= switch_block_threshold)) return (size_t)-1;
      return index;
@@ -292,7 +340,7 @@ namespace embree
        block_index = sharedLazyTessellationCache.alloc((bytes+BLOCK_SIZE-1)/BLOCK_SIZE);
        if (block_index == (size_t)-1)
        {
-         sharedLazyTessellationCache.unlockThread(t_state);		  
+         sharedLazyTessellationCache.unlockThread(t_state);
          sharedLazyTessellationCache.allocNextSegment();
          sharedLazyTessellationCache.lockThread(t_state);
          continue; 
@@ -320,6 +368,19 @@ namespace embree
 
    void reset();
 
+   TessellationCacheStats getStats();
+   void clearStats();
+
+ private:
+   void lockAllThreads();
+   void unlockAllThreads();
+   void resetSegments();
+   void startSegment(const size_t segment, ThreadWorkState* t_state);
+   void evictSegment(const size_t segment, ThreadWorkState* t_state);
+   size_t selectSegment(ThreadWorkState* t_state);
+
+ public:
+
    static SharedLazyTessellationCache sharedLazyTessellationCache;
  };
 }
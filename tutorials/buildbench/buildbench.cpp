@@ -6,6 +6,9 @@
 namespace embree
 {
   uint32_t g_num_user_threads = 0;
+  bool g_numa_benchmark = false;
+  bool g_hugepages_benchmark = false;
+  bool g_scaling_benchmark = false;
   
   struct Tutorial : public SceneLoadingTutorialApplication
   {
@@ -20,6 +23,18 @@ namespace embree
           rtcore += ",user_threads=" + toString(g_num_user_threads);
           rtcore += ",start_threads=0,set_affinity=0";
         }, "--user_threads <int>: invokes user thread benchmark with specified number of application provided build threads");
+
+      registerOption("numa", [this] (Ref<ParseStream> cin, const FileName& path) {
+          g_numa_benchmark = true;
+        }, "--numa: compares traversal performance with and without NUMA aware BVH allocation and top level replication");
+
+      registerOption("hugepages", [this] (Ref<ParseStream> cin, const FileName& path) {
+          g_hugepages_benchmark = true;
+        }, "--hugepages: compares traversal performance and TLB misses with and without huge page allocation");
+
+      registerOption("scaling", [this] (Ref<ParseStream> cin, const FileName& path) {
+          g_scaling_benchmark = true;
+        }, "--scaling: measures build performance for 1 to N build threads");
     }
     
     void postParseCommandLine() override
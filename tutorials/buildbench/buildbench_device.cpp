@@ -3,17 +3,31 @@
 
 #include "../common/tutorial/tutorial_device.h"
 #include "../common/tutorial/scene_device.h"
+#include "../common/math/random_sampler.h"
 #include <thread>
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <string.h>
+#endif
+
 namespace embree {
 
   extern uint32_t g_num_user_threads;
+  extern bool g_numa_benchmark;
+  extern bool g_hugepages_benchmark;
+  extern bool g_scaling_benchmark;
 
   static const MAYBE_UNUSED size_t skip_iterations               = 5;
   static const MAYBE_UNUSED size_t iterations_dynamic_deformable = 200;
   static const MAYBE_UNUSED size_t iterations_dynamic_dynamic    = 200;
   static const MAYBE_UNUSED size_t iterations_dynamic_static     = 50;
   static const MAYBE_UNUSED size_t iterations_static_static      = 30;
+  static const MAYBE_UNUSED size_t iterations_traversal          = 10;
+  static const MAYBE_UNUSED size_t rays_traversal                = 4*1024*1024;
 
   extern "C" ISPCScene* g_ispc_scene;
 
@@ -394,6 +408,180 @@ namespace embree {
   }
 
 
+  /* counts data TLB misses of the calling thread, reports -1 if not supported */
+  struct TLBMissCounter
+  {
+#if defined(__linux__)
+    TLBMissCounter ()
+    {
+      perf_event_attr attr;
+      memset(&attr,0,sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fd = (int) syscall(__NR_perf_event_open,&attr,0,-1,-1,0);
+    }
+
+    ~TLBMissCounter () {
+      if (fd >= 0) close(fd);
+    }
+
+    void start()
+    {
+      if (fd < 0) return;
+      ioctl(fd,PERF_EVENT_IOC_RESET,0);
+      ioctl(fd,PERF_EVENT_IOC_ENABLE,0);
+    }
+
+    long long stop()
+    {
+      if (fd < 0) return -1;
+      ioctl(fd,PERF_EVENT_IOC_DISABLE,0);
+      long long count = 0;
+      if (read(fd,&count,sizeof(count)) != sizeof(count)) return -1;
+      return count;
+    }
+
+    int fd;
+#else
+    void start() {}
+    long long stop() { return -1; }
+#endif
+  };
+
+  void trace_random_rays(const Vec3fa& lower, const Vec3fa& upper, size_t begin, size_t end)
+  {
+    RTCIntersectContext context;
+    rtcInitIntersectContext(&context);
+    RandomSampler sampler;
+    for (size_t j=begin; j<end; j++)
+    {
+      RandomSampler_init(sampler,(int)j);
+      const Vec3fa org = lower + (upper-lower)*RandomSampler_get3D(sampler);
+      const Vec3fa dir = RandomSampler_get3D(sampler)-Vec3fa(0.5f);
+      Ray ray;
+      init_Ray(ray,org,dir,0.0f,inf);
+      rtcIntersect1(g_scene,&context,RTCRayHit_(ray));
+    }
+  }
+
+  void Benchmark_Static_Traverse(ISPCScene* scene_in, size_t benchmark_iterations, const char* cfg)
+  {
+    assert(g_scene == nullptr);
+
+    /* the NUMA configuration is a device setting, thus use a separate device */
+    RTCDevice device = g_device;
+    g_device = rtcNewDevice(cfg);
+    g_scene = createScene(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM);
+    convertScene(g_scene,scene_in,RTC_BUILD_QUALITY_MEDIUM);
+    rtcCommitScene (g_scene);
+
+    RTCBounds bounds;
+    rtcGetSceneBounds(g_scene,&bounds);
+    const Vec3fa lower(bounds.lower_x,bounds.lower_y,bounds.lower_z);
+    const Vec3fa upper(bounds.upper_x,bounds.upper_y,bounds.upper_z);
+
+    size_t iterations = 0;
+    double time = 0.0;
+    for (size_t i=0; i<benchmark_iterations+skip_iterations; i++)
+    {
+      double t0 = getSeconds();
+      parallel_for(size_t(0),rays_traversal,size_t(1024),[&](const range<size_t>& r) {
+        trace_random_rays(lower,upper,r.begin(),r.end());
+      });
+      double t1 = getSeconds();
+      if (i >= skip_iterations)
+      {
+        time += t1 - t0;
+        iterations++;
+      }
+    }
+
+    /* count TLB misses of a single threaded pass, as the counter only observes the calling thread */
+    const size_t tlb_rays = rays_traversal/16;
+    TLBMissCounter tlb;
+    tlb.start();
+    trace_random_rays(lower,upper,0,tlb_rays);
+    const long long tlb_misses = tlb.stop();
+
+    if (iterations == 0) iterations = 1;
+    std::cout << "BENCHMARK_TRAVERSE_STATIC (" << cfg << ") "
+              << getNumPrimitives(scene_in) << " primitives, " << getNumObjects(scene_in) << " objects, "
+              << time/iterations << " s, "
+              << 1.0 / (time/iterations) * rays_traversal / 1000000.0 << " Mrays/s";
+    if (tlb_misses >= 0) std::cout << ", " << double(tlb_misses)/double(tlb_rays) << " DTLB misses/ray";
+    std::cout << std::endl;
+
+    rtcReleaseScene (g_scene);
+    g_scene = nullptr;
+    rtcReleaseDevice(g_device);
+    g_device = device;
+  }
+
+  double Benchmark_Static_Create_Threads(ISPCScene* scene_in, size_t benchmark_iterations, const std::string& cfg, size_t numThreads)
+  {
+    assert(g_scene == nullptr);
+    size_t primitives = getNumPrimitives(scene_in);
+    size_t objects = getNumObjects(scene_in);
+    size_t iterations = 0;
+    double time = 0.0;
+
+    /* the number of threads is a device setting and the tasking system
+     * uses the maximum of all devices, thus use only a single device */
+    g_device = rtcNewDevice((cfg + ",threads=" + toString(numThreads)).c_str());
+    rtcSetDeviceErrorFunction(g_device,error_handler,nullptr);
+
+    for (size_t i=0; i<benchmark_iterations+skip_iterations; i++)
+    {
+      g_scene = createScene(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM);
+      convertScene(g_scene,scene_in,RTC_BUILD_QUALITY_MEDIUM);
+
+      double t0 = getSeconds();
+      rtcCommitScene (g_scene);
+      double t1 = getSeconds();
+      if (i >= skip_iterations)
+      {
+        time += t1 - t0;
+        iterations++;
+      }
+      rtcReleaseScene (g_scene);
+    }
+    g_scene = nullptr;
+
+    rtcReleaseDevice(g_device);
+    g_device = nullptr;
+
+    if (iterations == 0) iterations = 1;
+    time /= iterations;
+    std::cout << "BENCHMARK_SCALING_THREADS_" << numThreads << " "
+              << primitives << " primitives, " << objects << " objects, "
+              << time << " s, "
+              << 1.0 / time * primitives / 1000000.0 << " Mprims/s";
+    return time;
+  }
+
+  void Benchmark_Thread_Scaling(ISPCScene* scene_in, size_t benchmark_iterations, const char* cfg)
+  {
+    /* release the default device to let only the benchmarked devices configure the tasking system */
+    rtcReleaseDevice(g_device);
+
+    const size_t N = getNumberOfLogicalThreads();
+    double time1 = 0.0;
+    for (size_t numThreads=1; numThreads<=N; numThreads = numThreads < N && 2*numThreads > N ? N : 2*numThreads)
+    {
+      const double time = Benchmark_Static_Create_Threads(scene_in,benchmark_iterations,cfg,numThreads);
+      if (numThreads == 1) time1 = time;
+      const double speedup = time1/time;
+      std::cout << ", speedup " << speedup << ", efficiency " << 100.0*speedup/numThreads << "%" << std::endl;
+    }
+
+    g_device = rtcNewDevice(cfg);
+    rtcSetDeviceErrorFunction(g_device,error_handler,nullptr);
+  }
+
   void Pause()
   {
     std::cout << "sleeping..." << std::flush;
@@ -405,7 +593,25 @@ namespace embree {
   /* called by the C++ code for initialization */
   extern "C" void device_init (char* cfg)
   {
-    if (g_num_user_threads == 0)
+    if (g_numa_benchmark)
+    {
+      Benchmark_Static_Traverse(g_ispc_scene,iterations_traversal,"numa_alloc=0,numa_replication_levels=0");
+      Pause();
+      Benchmark_Static_Traverse(g_ispc_scene,iterations_traversal,"numa_alloc=1,numa_replication_levels=3");
+    }
+    else if (g_hugepages_benchmark)
+    {
+      Benchmark_Static_Traverse(g_ispc_scene,iterations_traversal,"hugepages=0");
+      Pause();
+      Benchmark_Static_Traverse(g_ispc_scene,iterations_traversal,"hugepages=1");
+      Pause();
+      Benchmark_Static_Traverse(g_ispc_scene,iterations_traversal,"hugepages=1,hugepages_1g=1");
+    }
+    else if (g_scaling_benchmark)
+    {
+      Benchmark_Thread_Scaling(g_ispc_scene,iterations_static_static,cfg);
+    }
+    else if (g_num_user_threads == 0)
     {
       /* set error handler */
       Benchmark_Dynamic_Update(g_ispc_scene,iterations_dynamic_dynamic,RTC_BUILD_QUALITY_REFIT);
@@ -0,0 +1,325 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "binary_loader.h"
+#include "texture.h"
+#include "../../../common/sys/alloc.h"
+
+#include <fstream>
+#include <map>
+
+namespace embree
+{
+  using namespace BinaryScene;
+
+  static const size_t RECORD_BYTES = offsetof(Record,arrays);
+
+  BinarySceneFile::BinarySceneFile (const FileName& fileName)
+    : path(fileName.path()), ptr(nullptr), bytes(0)
+  {
+    std::ifstream file(fileName.str().c_str(), std::ios::binary | std::ios::ate);
+    if (!file.is_open()) THROW_RUNTIME_ERROR("cannot open " + fileName.str());
+    bytes = (size_t) file.tellg();
+    file.close();
+
+    if (bytes < sizeof(Header)) THROW_RUNTIME_ERROR("invalid binary scene file " + fileName.str());
+    ptr = (char*) os_map_file(fileName.c_str(),0,bytes);
+
+    const Header* header = (const Header*) ptr;
+    if (header->magic != MAGIC || header->version != VERSION) {
+      os_unmap_file(ptr,bytes);
+      THROW_RUNTIME_ERROR("invalid binary scene file " + fileName.str());
+    }
+  }
+
+  BinarySceneFile::~BinarySceneFile () {
+    os_unmap_file(ptr,bytes);
+  }
+
+  size_t BinarySceneFile::numNodes() const {
+    return ((const Header*)ptr)->numNodes;
+  }
+
+  const Record& BinarySceneFile::record(size_t nodeID) const
+  {
+    const Header* header = (const Header*) ptr;
+    if (nodeID >= header->numNodes || header->nodeTable > bytes || header->numNodes > (bytes-header->nodeTable)/sizeof(uint64_t))
+      THROW_RUNTIME_ERROR("corrupted binary scene file");
+
+    const uint64_t offset = ((const uint64_t*)(ptr+header->nodeTable))[nodeID];
+    if (offset % sizeof(uint64_t) || offset > bytes || bytes-offset < RECORD_BYTES)
+      THROW_RUNTIME_ERROR("corrupted binary scene file");
+
+    const Record& rec = *(const Record*)(ptr+offset);
+    if (rec.numArrays > (bytes-offset-RECORD_BYTES)/sizeof(Array))
+      THROW_RUNTIME_ERROR("corrupted binary scene file");
+    return rec;
+  }
+
+  const void* BinarySceneFile::data(const Array& array, size_t elementBytes) const
+  {
+    if (array.offset % ALIGNMENT || array.offset > bytes || array.size > (bytes-array.offset)/elementBytes)
+      THROW_RUNTIME_ERROR("corrupted binary scene file");
+    return ptr+array.offset;
+  }
+
+  std::string BinarySceneFile::string(const Array& array) const {
+    return std::string(data<char>(array),array.size);
+  }
+
+  void BinarySceneFile::setVertexBuffers(RTCGeometry geom, const Record& rec, RTCFormat format) const
+  {
+    const Array& first = rec.arrays[1];
+    rtcSetGeometryTimeStepCount(geom,rec.numTimeSteps);
+    rtcSetGeometryTimeRange(geom,rec.time_range[0],rec.time_range[1]);
+    for (unsigned int t=0; t<rec.numTimeSteps; t++)
+    {
+      const Array& positions = rec.arrays[1+t];
+      if (positions.size != first.size) THROW_RUNTIME_ERROR("corrupted binary scene file");
+      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,t,format,data<Vec3fa>(positions),0,sizeof(Vec3fa),positions.size);
+    }
+  }
+
+  void BinarySceneFile::addNode(RTCDevice device, RTCScene scene, size_t nodeID, std::map<size_t,RTCScene>& instancedScenes)
+  {
+    const Record& rec = record(nodeID);
+    const size_t numArrays = 1+rec.numTimeSteps+rec.numNormalSteps;
+    switch (rec.type)
+    {
+    case TRIANGLE_MESH:
+    case QUAD_MESH:
+    {
+      if (rec.numTimeSteps == 0 || rec.numArrays != numArrays+2) THROW_RUNTIME_ERROR("corrupted binary scene file");
+      const bool quads = rec.type == QUAD_MESH;
+      const Array& indices = rec.arrays[numArrays+1];
+      RTCGeometry geom = rtcNewGeometry(device, quads ? RTC_GEOMETRY_TYPE_QUAD : RTC_GEOMETRY_TYPE_TRIANGLE);
+      setVertexBuffers(geom,rec,RTC_FORMAT_FLOAT3);
+      if (quads) rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT4,data<SceneGraph::QuadMeshNode::Quad>(indices),0,sizeof(SceneGraph::QuadMeshNode::Quad),indices.size);
+      else       rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,data<SceneGraph::TriangleMeshNode::Triangle>(indices),0,sizeof(SceneGraph::TriangleMeshNode::Triangle),indices.size);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      break;
+    }
+    case HAIR_SET:
+    {
+      if (rec.numTimeSteps == 0 || rec.numArrays != numArrays+2) THROW_RUNTIME_ERROR("corrupted binary scene file");
+      const Array& hairs = rec.arrays[numArrays+0];
+      const Array& flags = rec.arrays[numArrays+1];
+      RTCGeometry geom = rtcNewGeometry(device,(RTCGeometryType)rec.subtype);
+      setVertexBuffers(geom,rec,RTC_FORMAT_FLOAT4);
+      for (unsigned int t=0; t<rec.numNormalSteps; t++) {
+        const Array& normals = rec.arrays[1+rec.numTimeSteps+t];
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_NORMAL,t,RTC_FORMAT_FLOAT3,data<Vec3fa>(normals),0,sizeof(Vec3fa),normals.size);
+      }
+      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT,data<SceneGraph::HairSetNode::Hair>(hairs),0,sizeof(SceneGraph::HairSetNode::Hair),hairs.size);
+      if (flags.size) rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_FLAGS,0,RTC_FORMAT_UCHAR,data<unsigned char>(flags),0,sizeof(unsigned char),flags.size);
+      rtcSetGeometryTessellationRate(geom,(float)rec.tessellationRate);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      break;
+    }
+    case MATERIAL:
+      break;
+    case TRANSFORM:
+    {
+      if (rec.child < 0 || size_t(rec.child) >= nodeID || rec.numArrays != 2) THROW_RUNTIME_ERROR("corrupted binary scene file");
+      RTCScene& child = instancedScenes[rec.child];
+      if (!child) {
+        child = rtcNewScene(device);
+        addNode(device,child,rec.child,instancedScenes);
+        rtcCommitScene(child);
+      }
+      const Array& spaces = rec.arrays[1];
+      const AffineSpace3ff* xfm = data<AffineSpace3ff>(spaces);
+      RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(geom,child);
+      rtcSetGeometryTimeStepCount(geom,(unsigned int)spaces.size);
+      rtcSetGeometryTimeRange(geom,rec.time_range[0],rec.time_range[1]);
+      for (size_t t=0; t<spaces.size; t++)
+      {
+        if (rec.subtype) {
+          QuaternionDecomposition qd = quaternionDecomposition(xfm[t]);
+          rtcSetGeometryTransformQuaternion(geom,(unsigned int)t,(RTCQuaternionDecomposition*)&qd);
+        } else {
+          rtcSetGeometryTransform(geom,(unsigned int)t,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,&xfm[t].l.vx.x);
+        }
+      }
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      break;
+    }
+    case GROUP:
+    {
+      if (rec.numArrays != 2) THROW_RUNTIME_ERROR("corrupted binary scene file");
+      const Array& children = rec.arrays[1];
+      const int64_t* childIDs = data<int64_t>(children);
+      for (size_t i=0; i<children.size; i++) {
+        if (childIDs[i] < 0 || size_t(childIDs[i]) >= nodeID) THROW_RUNTIME_ERROR("corrupted binary scene file");
+        addNode(device,scene,childIDs[i],instancedScenes);
+      }
+      break;
+    }
+    default:
+      THROW_RUNTIME_ERROR("corrupted binary scene file");
+    }
+  }
+
+  RTCScene BinarySceneFile::createScene(RTCDevice device)
+  {
+    std::map<size_t,RTCScene> instancedScenes;
+    RTCScene scene = rtcNewScene(device);
+    if (numNodes()) addNode(device,scene,numNodes()-1,instancedScenes);
+    rtcCommitScene(scene);
+    for (auto& i : instancedScenes) rtcReleaseScene(i.second);
+    return scene;
+  }
+
+  static Ref<SceneGraph::MaterialNode> createMaterial(int type, const float* p)
+  {
+    switch (type)
+    {
+    case MATERIAL_OBJ: {
+      Ref<OBJMaterial> material = new OBJMaterial;
+      material->d = p[0]; material->Ns = p[1]; material->Ni = p[2]; material->illum = (int) p[3];
+      material->Ka = Vec3fa(p[4],p[5],p[6]);
+      material->Kd = Vec3fa(p[7],p[8],p[9]);
+      material->Ks = Vec3fa(p[10],p[11],p[12]);
+      material->Kt = Vec3fa(p[13],p[14],p[15]);
+      return material.dynamicCast<SceneGraph::MaterialNode>();
+    }
+    case MATERIAL_THIN_DIELECTRIC:
+      return new ThinDielectricMaterial(Vec3fa(p[0],p[1],p[2]),p[3],p[4]);
+    case MATERIAL_METAL:
+      return new MetalMaterial(Vec3fa(p[0],p[1],p[2]),Vec3fa(p[3],p[4],p[5]),Vec3fa(p[6],p[7],p[8]),p[9]);
+    case MATERIAL_REFLECTIVE_METAL:
+      return new ReflectiveMetalMaterial(Vec3fa(p[0],p[1],p[2]),Vec3fa(p[3],p[4],p[5]),Vec3fa(p[6],p[7],p[8]));
+    case MATERIAL_VELVET:
+      return new VelvetMaterial(Vec3fa(p[0],p[1],p[2]),p[3],Vec3fa(p[4],p[5],p[6]),p[7]);
+    case MATERIAL_DIELECTRIC:
+      return new DielectricMaterial(Vec3fa(p[0],p[1],p[2]),Vec3fa(p[3],p[4],p[5]),p[6],p[7]);
+    case MATERIAL_METALLIC_PAINT:
+      return new MetallicPaintMaterial(Vec3fa(p[0],p[1],p[2]),Vec3fa(p[3],p[4],p[5]),p[6],p[7]);
+    case MATERIAL_MATTE:
+      return new MatteMaterial(Vec3fa(p[0],p[1],p[2]));
+    case MATERIAL_MIRROR:
+      return new MirrorMaterial(Vec3fa(p[0],p[1],p[2]));
+    case MATERIAL_HAIR:
+      return new HairMaterial(Vec3fa(p[0],p[1],p[2]),Vec3fa(p[3],p[4],p[5]),p[6],p[7]);
+    default:
+      THROW_RUNTIME_ERROR("corrupted binary scene file");
+    }
+  }
+
+  Ref<SceneGraph::Node> BinarySceneFile::createNode(size_t nodeID, std::vector<Ref<SceneGraph::Node>>& nodes)
+  {
+    const Record& rec = record(nodeID);
+    const BBox1f time_range(rec.time_range[0],rec.time_range[1]);
+    const size_t numArrays = 1+rec.numTimeSteps+rec.numNormalSteps;
+
+    Ref<SceneGraph::MaterialNode> material;
+    if (rec.type <= HAIR_SET && rec.child >= 0) {
+      if (size_t(rec.child) >= nodeID || !nodes[rec.child].dynamicCast<SceneGraph::MaterialNode>())
+        THROW_RUNTIME_ERROR("corrupted binary scene file");
+      material = nodes[rec.child].dynamicCast<SceneGraph::MaterialNode>();
+    }
+
+    Ref<SceneGraph::Node> node;
+    switch (rec.type)
+    {
+    case TRIANGLE_MESH: {
+      if (rec.numArrays != numArrays+2) THROW_RUNTIME_ERROR("corrupted binary scene file");
+      Ref<SceneGraph::TriangleMeshNode> mesh = new SceneGraph::TriangleMeshNode(material,time_range,rec.numTimeSteps);
+      for (size_t t=0; t<rec.numTimeSteps; t++) copy(mesh->positions[t],rec.arrays[1+t]);
+      mesh->normals.resize(rec.numNormalSteps);
+      for (size_t t=0; t<rec.numNormalSteps; t++) copy(mesh->normals[t],rec.arrays[1+rec.numTimeSteps+t]);
+      copy(mesh->texcoords,rec.arrays[numArrays+0]);
+      copy(mesh->triangles,rec.arrays[numArrays+1]);
+      node = mesh.dynamicCast<SceneGraph::Node>();
+      break;
+    }
+    case QUAD_MESH: {
+      if (rec.numArrays != numArrays+2) THROW_RUNTIME_ERROR("corrupted binary scene file");
+      Ref<SceneGraph::QuadMeshNode> mesh = new SceneGraph::QuadMeshNode(material,time_range,rec.numTimeSteps);
+      for (size_t t=0; t<rec.numTimeSteps; t++) copy(mesh->positions[t],rec.arrays[1+t]);
+      mesh->normals.resize(rec.numNormalSteps);
+      for (size_t t=0; t<rec.numNormalSteps; t++) copy(mesh->normals[t],rec.arrays[1+rec.numTimeSteps+t]);
+      copy(mesh->texcoords,rec.arrays[numArrays+0]);
+      copy(mesh->quads,rec.arrays[numArrays+1]);
+      node = mesh.dynamicCast<SceneGraph::Node>();
+      break;
+    }
+    case HAIR_SET: {
+      if (rec.numArrays != numArrays+2) THROW_RUNTIME_ERROR("corrupted binary scene file");
+      Ref<SceneGraph::HairSetNode> hair = new SceneGraph::HairSetNode((RTCGeometryType)rec.subtype,material,time_range,rec.numTimeSteps);
+      for (size_t t=0; t<rec.numTimeSteps; t++) copy(hair->positions[t],rec.arrays[1+t]);
+      hair->normals.resize(rec.numNormalSteps);
+      for (size_t t=0; t<rec.numNormalSteps; t++) copy(hair->normals[t],rec.arrays[1+rec.numTimeSteps+t]);
+      copy(hair->hairs,rec.arrays[numArrays+0]);
+      copy(hair->flags,rec.arrays[numArrays+1]);
+      hair->tessellation_rate = rec.tessellationRate;
+      node = hair.dynamicCast<SceneGraph::Node>();
+      break;
+    }
+    case MATERIAL: {
+      Ref<SceneGraph::MaterialNode> mat = createMaterial(rec.subtype,rec.params);
+      if (rec.subtype == MATERIAL_OBJ)
+      {
+        if (rec.numArrays != 6) THROW_RUNTIME_ERROR("corrupted binary scene file");
+        std::shared_ptr<Texture>* maps[5];
+        Ref<OBJMaterial> obj = mat.dynamicCast<OBJMaterial>();
+        maps[0] = &obj->_map_d; maps[1] = &obj->_map_Kd; maps[2] = &obj->_map_Ks; maps[3] = &obj->_map_Ns; maps[4] = &obj->_map_Displ;
+        for (size_t i=0; i<5; i++) {
+          const std::string src = string(rec.arrays[1+i]);
+          if (src != "") *maps[i] = Texture::load(path+src);
+        }
+      }
+      node = mat.dynamicCast<SceneGraph::Node>();
+      break;
+    }
+    case TRANSFORM: {
+      if (rec.child < 0 || size_t(rec.child) >= nodeID || rec.numArrays != 2) THROW_RUNTIME_ERROR("corrupted binary scene file");
+      SceneGraph::Transformations spaces;
+      spaces.time_range = time_range;
+      spaces.quaternion = rec.subtype != 0;
+      copy(spaces.spaces,rec.arrays[1]);
+      node = new SceneGraph::TransformNode(spaces,nodes[rec.child]);
+      break;
+    }
+    case GROUP: {
+      if (rec.numArrays != 2) THROW_RUNTIME_ERROR("corrupted binary scene file");
+      const Array& children = rec.arrays[1];
+      const int64_t* childIDs = data<int64_t>(children);
+      Ref<SceneGraph::GroupNode> group = new SceneGraph::GroupNode;
+      for (size_t i=0; i<children.size; i++) {
+        if (childIDs[i] < 0 || size_t(childIDs[i]) >= nodeID) THROW_RUNTIME_ERROR("corrupted binary scene file");
+        group->add(nodes[childIDs[i]]);
+      }
+      node = group.dynamicCast<SceneGraph::Node>();
+      break;
+    }
+    default:
+      THROW_RUNTIME_ERROR("corrupted binary scene file");
+    }
+
+    if (rec.numArrays) node->name = string(rec.arrays[0]);
+    return node;
+  }
+
+  Ref<SceneGraph::Node> BinarySceneFile::createSceneGraph()
+  {
+    std::vector<Ref<SceneGraph::Node>> nodes(numNodes());
+    for (size_t i=0; i<nodes.size(); i++)
+      nodes[i] = createNode(i,nodes);
+    if (nodes.empty()) return new SceneGraph::GroupNode;
+    return nodes.back();
+  }
+
+  Ref<SceneGraph::Node> loadBinary(const FileName& fileName)
+  {
+    Ref<BinarySceneFile> file = new BinarySceneFile(fileName);
+    return file->createSceneGraph();
+  }
+}
@@ -0,0 +1,105 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "scenegraph.h"
+
+#include <map>
+
+namespace embree
+{
+  /*! Binary scene format. All arrays are stored 64 byte aligned, such
+   *  that a memory mapped file can directly be used as geometry buffer
+   *  data. Nodes are stored after all nodes they reference, thus the
+   *  last node is the root of the scene. */
+  namespace BinaryScene
+  {
+    static const uint64_t MAGIC = 0x314e435342524d45; // "EMRBSCN1"
+    static const uint64_t VERSION = 1;
+    static const uint64_t ALIGNMENT = 64;
+
+    enum NodeType
+    {
+      TRIANGLE_MESH = 0,  //!< arrays: name, positions[numTimeSteps], normals[numNormalSteps], texcoords, triangles
+      QUAD_MESH = 1,      //!< arrays: name, positions[numTimeSteps], normals[numNormalSteps], texcoords, quads
+      HAIR_SET = 2,       //!< arrays: name, positions[numTimeSteps], normals[numNormalSteps], hairs, flags
+      MATERIAL = 3,       //!< arrays: name, texture file names of OBJ materials
+      TRANSFORM = 4,      //!< arrays: name, spaces
+      GROUP = 5           //!< arrays: name, child node indices
+    };
+
+    struct Header
+    {
+      uint64_t magic;
+      uint64_t version;
+      uint64_t numNodes;
+      uint64_t nodeTable;      //!< file offset of the table of node record offsets
+    };
+
+    struct Array
+    {
+      uint64_t offset;         //!< file offset of the first element
+      uint64_t size;           //!< number of elements
+    };
+
+    struct Record
+    {
+      uint32_t type;           //!< node type
+      uint32_t subtype;        //!< curve type of hair sets, material type of materials, quaternion flag of transforms
+      int64_t  child;          //!< material of geometries and child of transforms, -1 if not present
+      uint32_t numTimeSteps;   //!< number of position arrays
+      uint32_t numNormalSteps; //!< number of normal arrays
+      uint32_t numArrays;      //!< number of array descriptors following the record
+      uint32_t tessellationRate;
+      float time_range[2];
+      float params[32];        //!< material parameters
+      Array arrays[1];         //!< array descriptors
+    };
+  }
+
+  /*! Memory mapped binary scene file. */
+  class BinarySceneFile : public RefCount
+  {
+  public:
+    BinarySceneFile (const FileName& fileName);
+    ~BinarySceneFile ();
+
+    /*! creates an Embree scene that shares all geometry data with the
+     *  mapped file, thus the file has to stay alive while the scene is
+     *  used. Materials are ignored. */
+    RTCScene createScene(RTCDevice device);
+
+    /*! converts the file into scene graph nodes, which requires a copy
+     *  of all arrays as the nodes own their data */
+    Ref<SceneGraph::Node> createSceneGraph();
+
+  private:
+    size_t numNodes() const;
+    const BinaryScene::Record& record(size_t nodeID) const;
+    const void* data(const BinaryScene::Array& array, size_t elementBytes) const;
+
+    template<typename T> const T* data(const BinaryScene::Array& array) const {
+      return (const T*) data(array,sizeof(T));
+    }
+
+    template<typename Vector> void copy(Vector& vec, const BinaryScene::Array& array) const
+    {
+      const typename Vector::value_type* src = data<typename Vector::value_type>(array);
+      vec.resize(array.size);
+      if (array.size) memcpy((void*)vec.data(),src,array.size*sizeof(typename Vector::value_type));
+    }
+
+    std::string string(const BinaryScene::Array& array) const;
+    void setVertexBuffers(RTCGeometry geom, const BinaryScene::Record& rec, RTCFormat format) const;
+    void addNode(RTCDevice device, RTCScene scene, size_t nodeID, std::map<size_t,RTCScene>& instancedScenes);
+    Ref<SceneGraph::Node> createNode(size_t nodeID, std::vector<Ref<SceneGraph::Node>>& nodes);
+
+  private:
+    FileName path;
+    char* ptr;
+    size_t bytes;
+  };
+
+  Ref<SceneGraph::Node> loadBinary(const FileName& fileName);
+}
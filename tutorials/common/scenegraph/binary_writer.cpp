@@ -0,0 +1,294 @@
+// Copyright 2009-2021 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "binary_writer.h"
+#include "binary_loader.h"
+#include "texture.h"
+
+#include <fstream>
+#include <map>
+
+namespace embree
+{
+  using namespace BinaryScene;
+
+  class BinaryWriter
+  {
+  public:
+
+    BinaryWriter(Ref<SceneGraph::Node> root, const FileName& fileName);
+
+  private:
+    void align(size_t alignment);
+    Array store(const void* ptr, size_t elementBytes, size_t size);
+    Array store(const std::string& str);
+    template<typename Vector> Array store(const Vector& vec) {
+      return store(vec.data(),sizeof(typename Vector::value_type),vec.size());
+    }
+
+    int64_t storeRecord(Record& rec, const std::vector<Array>& arrays);
+    template<typename Mesh> void storeVertices(Record& rec, std::vector<Array>& arrays, Ref<Mesh> mesh);
+
+    int64_t store(Ref<SceneGraph::MaterialNode> material);
+    int64_t store(Ref<SceneGraph::TriangleMeshNode> mesh);
+    int64_t store(Ref<SceneGraph::QuadMeshNode> mesh);
+    int64_t store(Ref<SceneGraph::HairSetNode> hair);
+    int64_t store(Ref<SceneGraph::TransformNode> node);
+    int64_t store(Ref<SceneGraph::GroupNode> group);
+    int64_t store(Ref<SceneGraph::Node> node);
+
+  private:
+    std::fstream file;
+    std::vector<uint64_t> nodeTable;                  //!< file offsets of node records
+    std::map<Ref<SceneGraph::Node>, int64_t> nodeMap; //!< node indices of already stored nodes
+  };
+
+  void BinaryWriter::align(size_t alignment)
+  {
+    const size_t offset = file.tellp();
+    const char zeros[ALIGNMENT] = { 0 };
+    file.write(zeros,(alignment-offset%alignment)%alignment);
+  }
+
+  Array BinaryWriter::store(const void* ptr, size_t elementBytes, size_t size)
+  {
+    align(ALIGNMENT);
+    Array array;
+    array.offset = file.tellp();
+    array.size = size;
+    if (size) file.write((const char*)ptr,elementBytes*size);
+    return array;
+  }
+
+  Array BinaryWriter::store(const std::string& str) {
+    return store(str.data(),1,str.size());
+  }
+
+  int64_t BinaryWriter::storeRecord(Record& rec, const std::vector<Array>& arrays)
+  {
+    align(sizeof(uint64_t));
+    nodeTable.push_back(file.tellp());
+    rec.numArrays = (uint32_t) arrays.size();
+    file.write((const char*)&rec,offsetof(Record,arrays));
+    file.write((const char*)arrays.data(),arrays.size()*sizeof(Array));
+    return nodeTable.size()-1;
+  }
+
+  static Record newRecord(NodeType type, const BBox1f& time_range)
+  {
+    Record rec;
+    memset(&rec,0,sizeof(Record));
+    rec.type = type;
+    rec.child = -1;
+    rec.time_range[0] = time_range.lower;
+    rec.time_range[1] = time_range.upper;
+    return rec;
+  }
+
+  template<typename Mesh>
+  void BinaryWriter::storeVertices(Record& rec, std::vector<Array>& arrays, Ref<Mesh> mesh)
+  {
+    if (mesh->material) rec.child = store(mesh->material);
+    arrays.push_back(store(mesh->name));
+    rec.numTimeSteps = (uint32_t) mesh->positions.size();
+    for (const auto& positions : mesh->positions) arrays.push_back(store(positions));
+    rec.numNormalSteps = (uint32_t) mesh->normals.size();
+    for (const auto& normals : mesh->normals) arrays.push_back(store(normals));
+  }
+
+  int64_t BinaryWriter::store(Ref<SceneGraph::MaterialNode> node)
+  {
+    if (nodeMap.find(node.dynamicCast<SceneGraph::Node>()) != nodeMap.end())
+      return nodeMap[node.dynamicCast<SceneGraph::Node>()];
+
+    Record rec = newRecord(MATERIAL,BBox1f(0.0f,1.0f));
+    std::vector<Array> arrays;
+    arrays.push_back(store(node->name));
+
+    float* p = rec.params;
+    rec.subtype = node->material()->type;
+    switch (rec.subtype)
+    {
+    case MATERIAL_OBJ: {
+      Ref<OBJMaterial> m = node.dynamicCast<OBJMaterial>();
+      p[0] = m->d; p[1] = m->Ns; p[2] = m->Ni; p[3] = (float) m->illum;
+      p[4]  = m->Ka.x; p[5]  = m->Ka.y; p[6]  = m->Ka.z;
+      p[7]  = m->Kd.x; p[8]  = m->Kd.y; p[9]  = m->Kd.z;
+      p[10] = m->Ks.x; p[11] = m->Ks.y; p[12] = m->Ks.z;
+      p[13] = m->Kt.x; p[14] = m->Kt.y; p[15] = m->Kt.z;
+      const std::shared_ptr<Texture> maps[5] = { m->_map_d, m->_map_Kd, m->_map_Ks, m->_map_Ns, m->_map_Displ };
+      for (size_t i=0; i<5; i++)
+        arrays.push_back(store(maps[i] ? maps[i]->fileName : std::string()));
+      break;
+    }
+    case MATERIAL_THIN_DIELECTRIC: {
+      Ref<ThinDielectricMaterial> m = node.dynamicCast<ThinDielectricMaterial>();
+      p[0] = m->transmission.x; p[1] = m->transmission.y; p[2] = m->transmission.z;
+      p[3] = m->eta; p[4] = m->thickness;
+      break;
+    }
+    case MATERIAL_METAL:
+    case MATERIAL_REFLECTIVE_METAL: {
+      Ref<MetalMaterial> m = node.dynamicCast<MetalMaterial>();
+      p[0] = m->reflectance.x; p[1] = m->reflectance.y; p[2] = m->reflectance.z;
+      p[3] = m->eta.x; p[4] = m->eta.y; p[5] = m->eta.z;
+      p[6] = m->k.x; p[7] = m->k.y; p[8] = m->k.z;
+      p[9] = m->roughness;
+      break;
+    }
+    case MATERIAL_VELVET: {
+      Ref<VelvetMaterial> m = node.dynamicCast<VelvetMaterial>();
+      p[0] = m->reflectance.x; p[1] = m->reflectance.y; p[2] = m->reflectance.z;
+      p[3] = m->backScattering;
+      p[4] = m->horizonScatteringColor.x; p[5] = m->horizonScatteringColor.y; p[6] = m->horizonScatteringColor.z;
+      p[7] = m->horizonScatteringFallOff;
+      break;
+    }
+    case MATERIAL_DIELECTRIC: {
+      Ref<DielectricMaterial> m = node.dynamicCast<DielectricMaterial>();
+      p[0] = m->transmissionOutside.x; p[1] = m->transmissionOutside.y; p[2] = m->transmissionOutside.z;
+      p[3] = m->transmissionInside.x; p[4] = m->transmissionInside.y; p[5] = m->transmissionInside.z;
+      p[6] = m->etaOutside; p[7] = m->etaInside;
+      break;
+    }
+    case MATERIAL_METALLIC_PAINT: {
+      Ref<MetallicPaintMaterial> m = node.dynamicCast<MetallicPaintMaterial>();
+      p[0] = m->shadeColor.x; p[1] = m->shadeColor.y; p[2] = m->shadeColor.z;
+      p[3] = m->glitterColor.x; p[4] = m->glitterColor.y; p[5] = m->glitterColor.z;
+      p[6] = m->glitterSpread; p[7] = m->eta;
+      break;
+    }
+    case MATERIAL_MATTE: {
+      Ref<MatteMaterial> m = node.dynamicCast<MatteMaterial>();
+      p[0] = m->reflectance.x; p[1] = m->reflectance.y; p[2] = m->reflectance.z;
+      break;
+    }
+    case MATERIAL_MIRROR: {
+      Ref<MirrorMaterial> m = node.dynamicCast<MirrorMaterial>();
+      p[0] = m->reflectance.x; p[1] = m->reflectance.y; p[2] = m->reflectance.z;
+      break;
+    }
+    case MATERIAL_HAIR: {
+      Ref<HairMaterial> m = node.dynamicCast<HairMaterial>();
+      p[0] = m->Kr.x; p[1] = m->Kr.y; p[2] = m->Kr.z;
+      p[3] = m->Kt.x; p[4] = m->Kt.y; p[5] = m->Kt.z;
+      p[6] = m->nx; p[7] = m->ny;
+      break;
+    }
+    default:
+      throw std::runtime_error("unknown material type");
+    }
+
+    return nodeMap[node.dynamicCast<SceneGraph::Node>()] = storeRecord(rec,arrays);
+  }
+
+  int64_t BinaryWriter::store(Ref<SceneGraph::TriangleMeshNode> mesh)
+  {
+    Record rec = newRecord(TRIANGLE_MESH,mesh->time_range);
+    std::vector<Array> arrays;
+    storeVertices(rec,arrays,mesh);
+    arrays.push_back(store(mesh->texcoords));
+    arrays.push_back(store(mesh->triangles));
+    return storeRecord(rec,arrays);
+  }
+
+  int64_t BinaryWriter::store(Ref<SceneGraph::QuadMeshNode> mesh)
+  {
+    Record rec = newRecord(QUAD_MESH,mesh->time_range);
+    std::vector<Array> arrays;
+    storeVertices(rec,arrays,mesh);
+    arrays.push_back(store(mesh->texcoords));
+    arrays.push_back(store(mesh->quads));
+    return storeRecord(rec,arrays);
+  }
+
+  int64_t BinaryWriter::store(Ref<SceneGraph::HairSetNode> hair)
+  {
+    if (hair->tangents.size() || hair->dnormals.size())
+      throw std::runtime_error("Hermite curves are not supported by binary scene files");
+
+    Record rec = newRecord(HAIR_SET,hair->time_range);
+    rec.subtype = hair->type;
+    rec.tessellationRate = hair->tessellation_rate;
+    std::vector<Array> arrays;
+    storeVertices(rec,arrays,hair);
+    arrays.push_back(store(hair->hairs));
+    arrays.push_back(store(hair->flags));
+    return storeRecord(rec,arrays);
+  }
+
+  int64_t BinaryWriter::store(Ref<SceneGraph::TransformNode> node)
+  {
+    const int64_t child = store(node->child);
+    if (child < 0) return -1;
+
+    Record rec = newRecord(TRANSFORM,node->spaces.time_range);
+    rec.subtype = node->spaces.quaternion;
+    rec.child = child;
+    std::vector<Array> arrays;
+    arrays.push_back(store(node->name));
+    arrays.push_back(store(node->spaces.spaces));
+    return storeRecord(rec,arrays);
+  }
+
+  int64_t BinaryWriter::store(Ref<SceneGraph::GroupNode> group)
+  {
+    std::vector<int64_t> children;
+    for (const auto& child : group->children) {
+      const int64_t id = store(child);
+      if (id >= 0) children.push_back(id);
+    }
+
+    Record rec = newRecord(GROUP,BBox1f(0.0f,1.0f));
+    std::vector<Array> arrays;
+    arrays.push_back(store(group->name));
+    arrays.push_back(store(children));
+    return storeRecord(rec,arrays);
+  }
+
+  int64_t BinaryWriter::store(Ref<SceneGraph::Node> node)
+  {
+    if (nodeMap.find(node) != nodeMap.end())
+      return nodeMap[node];
+
+    /* lights and cameras are not part of the binary format and get skipped */
+    int64_t id = -1;
+    if      (Ref<SceneGraph::LightNode> cnode = node.dynamicCast<SceneGraph::LightNode>()) id = -1;
+    else if (Ref<SceneGraph::PerspectiveCameraNode> cnode = node.dynamicCast<SceneGraph::PerspectiveCameraNode>()) id = -1;
+    else if (Ref<SceneGraph::MaterialNode> cnode = node.dynamicCast<SceneGraph::MaterialNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::TriangleMeshNode> cnode = node.dynamicCast<SceneGraph::TriangleMeshNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::QuadMeshNode> cnode = node.dynamicCast<SceneGraph::QuadMeshNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::HairSetNode> cnode = node.dynamicCast<SceneGraph::HairSetNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::TransformNode> cnode = node.dynamicCast<SceneGraph::TransformNode>()) id = store(cnode);
+    else if (Ref<SceneGraph::GroupNode> cnode = node.dynamicCast<SceneGraph::GroupNode>()) id = store(cnode);
+    else throw std::runtime_error("node type not supported by binary scene files");
+    return nodeMap[node] = id;
+  }
+
+  BinaryWriter::BinaryWriter(Ref<SceneGraph::Node> root, const FileName& fileName)
+  {
+    file.exceptions (std::fstream::failbit | std::fstream::badbit);
+    file.open (fileName, std::fstream::out | std::fstream::binary);
+
+    Header header;
+    memset(&header,0,sizeof(Header));
+    file.write((const char*)&header,sizeof(Header));
+
+    /* the root is the last stored node, store an empty group if nothing got stored */
+    if (store(root) < 0)
+      store(Ref<SceneGraph::GroupNode>(new SceneGraph::GroupNode));
+
+    align(sizeof(uint64_t));
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.numNodes = nodeTable.size();
+    header.nodeTable = file.tellp();
+    file.write((const char*)nodeTable.data(),nodeTable.size()*sizeof(uint64_t));
+    file.seekp(0);
+    file.write((const char*)&header,sizeof(Header));
+  }
+
+  void SceneGraph::storeBinary(Ref<SceneGraph::Node> root, const FileName& fileName) {
+    BinaryWriter(root,fileName);
+  }
+}
@@ -3,6 +3,7 @@
 
 #include "obj_loader.h"
 #include "texture.h"
+#include "../../../common/algorithms/parallel_for.h"
 
 namespace embree
 {
@@ -614,5 +615,250 @@ namespace embree
     OBJLoader loader(fileName,subdivMode,combineIntoSingleObject); 
     return loader.group.cast<SceneGraph::Node>();
   }
+
+  class OBJStreamLoader
+  {
+    /*! Part of a chunk that gets parsed by one task. */
+    struct Range
+    {
+      size_t begin, end;                  //!< byte range of lines
+      size_t vertexBase;                  //!< global index of first vertex of the range
+      size_t numVertices;                 //!< number of vertices in the range
+      std::vector<unsigned int> triangles; //!< triangle indices of the range
+      std::vector<size_t> groupBreaks;    //!< number of triangles at each usemtl statement
+    };
+
+  public:
+
+    /*! Constructor. Creates scene graph nodes if no scene is specified. */
+    OBJStreamLoader(RTCDevice device, RTCScene scene, const bool combineIntoSingleObject)
+      : data(new OBJStreamData), group(new SceneGraph::GroupNode), device(device), scene(scene), combineIntoSingleObject(combineIntoSingleObject) {}
+
+    /*! loads file chunk by chunk */
+    void load(const FileName& fileName, const size_t chunkSize)
+    {
+      FILE* file = fopen(fileName.c_str(),"rb");
+      if (!file) THROW_RUNTIME_ERROR("cannot open " + fileName.str());
+
+      std::vector<char> buffer(chunkSize+1);
+      size_t carry = 0;
+      bool eof = false;
+      try
+      {
+        while (!eof)
+        {
+          const size_t bytes = carry + fread(buffer.data()+carry,1,chunkSize-carry,file);
+          eof = bytes < chunkSize;
+
+          /* only parse complete lines, the remainder is parsed with the next chunk */
+          size_t end = bytes;
+          if (!eof) {
+            while (end > 0 && buffer[end-1] != '\n') end--;
+            if (end == 0) THROW_RUNTIME_ERROR("line exceeds chunk size in " + fileName.str());
+          }
+          /* the terminator overwrites the first character of the remainder */
+          const char next = buffer[end];
+          buffer[end] = 0;
+          parseChunk(buffer.data(),end);
+          buffer[end] = next;
+
+          carry = bytes-end;
+          memmove(buffer.data(),buffer.data()+end,carry);
+        }
+        flushGroup();
+      }
+      catch (...) {
+        fclose(file);
+        throw;
+      }
+      fclose(file);
+    }
+
+    Ref<OBJStreamData> data;
+    Ref<SceneGraph::GroupNode> group;
+
+  private:
+
+    /*! returns begin of next line */
+    static inline size_t nextLine(const char* text, size_t i, size_t end)
+    {
+      const char* p = (const char*) memchr(text+i,'\n',end-i);
+      return p ? size_t(p-text)+1 : end;
+    }
+
+    /*! tests if line is a vertex position */
+    static inline bool isVertex(const char* token) {
+      token += strspn(token, " \t");
+      return token[0] == 'v' && isSep(token[1]);
+    }
+
+    /*! parses a chunk of complete lines in parallel */
+    void parseChunk(char* text, size_t bytes)
+    {
+      /* split chunk into ranges of complete lines */
+      const size_t numRanges = min(size_t(256),(bytes+65535)/65536);
+      std::vector<Range> ranges(numRanges);
+      for (size_t i=0, begin=0; i<numRanges; i++) {
+        ranges[i].begin = begin;
+        ranges[i].end = begin = (i+1 == numRanges) ? bytes : max(begin,nextLine(text,(i+1)*bytes/numRanges,bytes));
+      }
+
+      /* count vertices to know the global vertex index at each line */
+      parallel_for(numRanges, [&] (size_t r) {
+          size_t n = 0;
+          for (size_t i=ranges[r].begin; i<ranges[r].end; i=nextLine(text,i,ranges[r].end))
+            n += isVertex(text+i);
+          ranges[r].numVertices = n;
+        });
+
+      size_t numVertices = data->numVertices;
+      for (auto& range : ranges) {
+        range.vertexBase = numVertices;
+        numVertices += range.numVertices;
+      }
+      while (data->vertices.size()*OBJStreamData::BLOCK_SIZE < numVertices)
+        data->vertices.emplace_back(size_t(OBJStreamData::BLOCK_SIZE));
+
+      parallel_for(numRanges, [&] (size_t r) { parseRange(text,ranges[r]); });
+      data->numVertices = numVertices;
+
+      /* append triangles to current group in file order */
+      for (auto& range : ranges)
+      {
+        size_t begin = 0;
+        for (size_t end : range.groupBreaks) {
+          triangles.insert(triangles.end(),range.triangles.begin()+begin,range.triangles.begin()+end);
+          flushGroup();
+          begin = end;
+        }
+        triangles.insert(triangles.end(),range.triangles.begin()+begin,range.triangles.end());
+      }
+    }
+
+    /*! parses vertices and faces of a range */
+    void parseRange(char* text, Range& range)
+    {
+      size_t vertexID = range.vertexBase;
+      std::vector<unsigned int> face;
+      for (size_t i=range.begin; i<range.end; )
+      {
+        const size_t next = nextLine(text,i,range.end);
+        if (next > i && text[next-1] == '\n') text[next-1] = 0;
+        const char* token = trimEnd(text + i + strspn(text+i, " \t"));
+        i = next;
+
+        /*! parse position */
+        if (token[0] == 'v' && isSep(token[1])) {
+          data->vertices[vertexID >> OBJStreamData::BLOCK_BITS][vertexID & (OBJStreamData::BLOCK_SIZE-1)] = Vec3fa(getVec3f(token += 2));
+          vertexID++;
+          continue;
+        }
+
+        /*! parse face and triangulate it with a triangle fan */
+        if (token[0] == 'f' && isSep(token[1]))
+        {
+          parseSep(token += 1);
+          face.clear();
+          while (token[0]) {
+            const int index = getInt(token);
+            face.push_back(index > 0 ? index - 1 : (index == 0 ? 0 : (unsigned int) (int64_t(vertexID) + index)));
+            parseSepOpt(token);
+          }
+          for (size_t k=2; k<face.size(); k++) {
+            range.triangles.push_back(face[0]);
+            range.triangles.push_back(face[k-1]);
+            range.triangles.push_back(face[k]);
+          }
+          continue;
+        }
+
+        /*! use material */
+        if (!strncmp(token, "usemtl", 6) && isSep(token[6]) && !combineIntoSingleObject)
+          range.groupBreaks.push_back(range.triangles.size());
+      }
+    }
+
+    /*! creates a triangle mesh of the current group */
+    void flushGroup()
+    {
+      if (triangles.empty()) return;
+
+      unsigned int lower = std::numeric_limits<unsigned int>::max(), upper = 0;
+      for (unsigned int index : triangles) {
+        lower = min(lower,index);
+        upper = max(upper,index);
+      }
+      if (upper >= data->numVertices) THROW_RUNTIME_ERROR("corrupted OBJ file: vertex index out of range");
+      for (unsigned int& index : triangles) index -= lower;
+
+      const size_t numTriangles = triangles.size()/3;
+      data->numTriangles += numTriangles;
+      if (scene == nullptr) {
+        createTriangleMeshNode(lower,upper);
+        return;
+      }
+
+      RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_TRIANGLE);
+      const size_t block = lower >> OBJStreamData::BLOCK_BITS;
+      const size_t numVertices = size_t(upper-lower)+1;
+      if (block == (upper >> OBJStreamData::BLOCK_BITS)) {
+        const size_t offset = (lower & (OBJStreamData::BLOCK_SIZE-1))*sizeof(Vec3fa);
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,data->vertices[block].data(),offset,sizeof(Vec3fa),numVertices);
+      }
+      else {
+        /* vertices of groups that span multiple blocks have to be copied */
+        Vec3fa* vertices = (Vec3fa*) rtcSetNewGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,sizeof(Vec3fa),numVertices);
+        for (size_t i=0; i<numVertices; i++) {
+          const size_t vertexID = lower+i;
+          vertices[i] = data->vertices[vertexID >> OBJStreamData::BLOCK_BITS][vertexID & (OBJStreamData::BLOCK_SIZE-1)];
+        }
+      }
+
+      data->indices.emplace_back();
+      data->indices.back().swap(triangles);
+      rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,data->indices.back().data(),0,3*sizeof(unsigned int),numTriangles);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+    }
+
+    /*! creates a scene graph node of the current group, vertices get copied */
+    void createTriangleMeshNode(unsigned int lower, unsigned int upper)
+    {
+      if (!defaultMaterial) defaultMaterial = new OBJMaterial("default");
+      Ref<SceneGraph::TriangleMeshNode> mesh = new SceneGraph::TriangleMeshNode(defaultMaterial,BBox1f(0,1),1);
+      mesh->positions[0].resize(size_t(upper-lower)+1);
+      for (size_t i=0; i<mesh->positions[0].size(); i++) {
+        const size_t vertexID = lower+i;
+        mesh->positions[0][i] = data->vertices[vertexID >> OBJStreamData::BLOCK_BITS][vertexID & (OBJStreamData::BLOCK_SIZE-1)];
+      }
+      mesh->triangles.resize(triangles.size()/3);
+      for (size_t i=0; i<mesh->triangles.size(); i++)
+        mesh->triangles[i] = SceneGraph::TriangleMeshNode::Triangle(triangles[3*i+0],triangles[3*i+1],triangles[3*i+2]);
+      triangles.clear();
+      group->add(mesh.cast<SceneGraph::Node>());
+    }
+
+  private:
+    RTCDevice device;
+    RTCScene scene;
+    bool combineIntoSingleObject;
+    std::vector<unsigned int> triangles; //!< triangles of current group
+    Ref<SceneGraph::MaterialNode> defaultMaterial;
+  };
+
+  Ref<OBJStreamData> loadOBJStreaming(RTCDevice device, RTCScene scene, const FileName& fileName, const bool combineIntoSingleObject, const size_t chunkSize)
+  {
+    OBJStreamLoader loader(device,scene,combineIntoSingleObject);
+    loader.load(fileName,chunkSize);
+    return loader.data;
+  }
+
+  Ref<SceneGraph::Node> loadOBJStreaming(const FileName& fileName, const bool combineIntoSingleObject, const size_t chunkSize)
+  {
+    OBJStreamLoader loader(nullptr,nullptr,combineIntoSingleObject);
+    loader.load(fileName,chunkSize);
+    return loader.group.cast<SceneGraph::Node>();
+  }
 }
 
@@ -5,9 +5,44 @@
 
 #include "scenegraph.h"
 
+#include <deque>
+
 namespace embree
 {
   Ref<SceneGraph::Node> loadOBJ(const FileName& fileName, 
                                 const bool subdivMode = false,
                                 const bool combineIntoSingleObject = false);
+
+  /*! Vertex and index data of a streamed OBJ file. Geometries created
+   *  by loadOBJStreaming reference this data through shared buffers,
+   *  thus it has to stay alive as long as the scene is used. */
+  struct OBJStreamData : public RefCount
+  {
+    static const size_t BLOCK_BITS = 20;
+    static const size_t BLOCK_SIZE = size_t(1) << BLOCK_BITS;
+
+    OBJStreamData () : numVertices(0), numTriangles(0) {}
+
+    std::deque<avector<Vec3fa>> vertices;       //!< vertices in blocks of BLOCK_SIZE that never move
+    std::deque<std::vector<unsigned int>> indices; //!< index buffer of each geometry
+    size_t numVertices;
+    size_t numTriangles;
+  };
+
+  /*! Streams the faces of an OBJ file directly into triangle meshes of
+   *  an Embree scene, without building scene graph nodes. The file is
+   *  read in chunks of chunkSize bytes which get parsed in parallel and
+   *  freed before the next chunk is read. A new geometry is started at
+   *  each usemtl statement unless combineIntoSingleObject is set.
+   *  Materials, normals, and texture coordinates are ignored. */
+  Ref<OBJStreamData> loadOBJStreaming(RTCDevice device, RTCScene scene, const FileName& fileName,
+                                      const bool combineIntoSingleObject = false,
+                                      const size_t chunkSize = 64*1024*1024);
+
+  /*! Parses an OBJ file chunk by chunk like the loader above, but
+   *  creates a triangle mesh node with the default material for each
+   *  group. Vertices get copied into the nodes. */
+  Ref<SceneGraph::Node> loadOBJStreaming(const FileName& fileName,
+                                         const bool combineIntoSingleObject = false,
+                                         const size_t chunkSize = 64*1024*1024);
 }
@@ -7,6 +7,8 @@
 #include "obj_loader.h"
 #include "ply_loader.h"
 #include "corona_loader.h"
+#include "binary_loader.h"
+#include "binary_writer.h"
 
 namespace embree
 {
@@ -18,6 +20,7 @@ namespace embree
     else if (toLowerCase(filename.ext()) == std::string("ply" )) return loadPLY(filename);
     else if (toLowerCase(filename.ext()) == std::string("xml" )) return loadXML(filename);
     else if (toLowerCase(filename.ext()) == std::string("scn" )) return loadCorona(filename);
+    else if (toLowerCase(filename.ext()) == std::string("ebs" )) return loadBinary(filename);
     else throw std::runtime_error("unknown scene format: " + filename.ext());
   }
 
@@ -26,6 +29,9 @@ namespace embree
     if (toLowerCase(filename.ext()) == std::string("xml")) {
       storeXML(root,filename,embedTextures,referenceMaterials);
     }
+    else if (toLowerCase(filename.ext()) == std::string("ebs")) {
+      storeBinary(root,filename);
+    }
     else
       throw std::runtime_error("unknown scene format: " + filename.ext());
   }
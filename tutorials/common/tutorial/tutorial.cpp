@@ -337,12 +337,17 @@ namespace embree
       remove_non_mblur(false),
       sceneFilename(),
       instancing_mode(SceneGraph::INSTANCING_NONE),
+      stream_obj(false),
       print_scene_cameras(false)
   {
     registerOption("i", [this] (Ref<ParseStream> cin, const FileName& path) {
         sceneFilename.push_back(path + cin->getFileName());
       }, "-i <filename>: parses scene from <filename>");
 
+    registerOption("stream-obj", [this] (Ref<ParseStream> cin, const FileName& path) {
+        stream_obj = true;
+      }, "--stream-obj: parses .obj files in parallel chunks, materials, normals, and texture coordinates get ignored");
+
     registerOption("animlist", [this] (Ref<ParseStream> cin, const FileName& path) {
         FileName listFilename = path + cin->getFileName();
 
@@ -721,6 +726,16 @@ namespace embree
     std::cout << "BENCHMARK_RENDER_MRAYPS_AVG_SIGMA " << mraypsStat.getAvgSigma() << std::endl;
 #endif
 
+    /* tessellation cache statistics of subdivision geometry interpolation */
+    const ssize_t cacheHits   = rtcGetDeviceProperty(g_device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS);
+    const ssize_t cacheMisses = rtcGetDeviceProperty(g_device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES);
+    if (cacheHits+cacheMisses)
+    {
+      std::cout << "BENCHMARK_TESSELLATION_CACHE_HIT_RATE " << 100.0*double(cacheHits)/double(cacheHits+cacheMisses) << std::endl;
+      std::cout << "BENCHMARK_TESSELLATION_CACHE_EVICTIONS " << rtcGetDeviceProperty(g_device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_EVICTIONS) << std::endl;
+      std::cout << "BENCHMARK_TESSELLATION_CACHE_MB " << 1E-6*double(rtcGetDeviceProperty(g_device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_BYTES)) << std::endl;
+    }
+
     std::cout << std::flush;
   }
 
@@ -1287,7 +1302,9 @@ namespace embree
     {
       for (auto& file : sceneFilename)
       {
-        if (toLowerCase(file.ext()) == std::string("obj"))
+        if (toLowerCase(file.ext()) == std::string("obj") && stream_obj && subdiv_mode == "")
+          scene->add(loadOBJStreaming(file));
+        else if (toLowerCase(file.ext()) == std::string("obj"))
           scene->add(loadOBJ(file,subdiv_mode != ""));
         else if (file.ext() != "")
           scene->add(SceneGraph::load(file));
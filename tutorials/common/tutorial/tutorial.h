@@ -232,6 +232,7 @@ namespace embree
     std::vector<FileName> keyFramesFilenames;
     SceneGraph::InstancingMode instancing_mode;
     std::string subdiv_mode;
+    bool stream_obj;
     bool print_scene_cameras;
     std::string camera_name;
   };
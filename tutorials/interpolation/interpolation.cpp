@@ -5,11 +5,19 @@
 
 namespace embree
 {
+  extern "C" {
+    unsigned int g_bake_benchmark_samples = 0;
+  }
+
   struct Tutorial : public TutorialApplication 
   {
     Tutorial()
       : TutorialApplication("interpolation",FEATURE_RTCORE) 
     {
+      registerOption("bake-benchmark", [] (Ref<ParseStream> cin, const FileName& path) {
+          g_bake_benchmark_samples = cin->getInt();
+        }, "--bake-benchmark <int>: measures the interpolation of the given number of random locations with rtcInterpolate1, rtcInterpolateN, and rtcInterpolateBatch (C++ version only)");
+
       /* set default camera */
       camera.from = Vec3fa(9.0f,4.0f,1.0f);
       camera.to   = Vec3fa(0.0f,0.0f,1.0f);
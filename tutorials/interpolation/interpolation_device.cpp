@@ -3,6 +3,7 @@
 
 #include "interpolation_device.h"
 #include "../common/tutorial/optics.h"
+#include "../common/math/random_sampler.h"
 
 namespace embree {
 
@@ -13,6 +14,8 @@ namespace embree {
 #define MIN_EDGE_LEVEL  4.0f
 #define LEVEL_FACTOR  128.0f
 
+extern "C" unsigned int g_bake_benchmark_samples;
+
 /* scene data */
 RTCScene g_scene = nullptr;
 TutorialData data;
@@ -311,6 +314,64 @@ unsigned int addGroundPlane (RTCScene scene_i)
   return geomID;
 }
 
+/* evaluates positions and derivatives at random locations of a subdivision geometry, as done when baking textures */
+void bakeBenchmark(RTCGeometry geom, unsigned int numFaces, unsigned int N)
+{
+  N = (N+3)/4*4; // rtcInterpolateN requires a multiple of 4 locations
+  std::vector<unsigned int> primIDs(N);
+  std::vector<float> u(N), v(N), P(3*N), dPdu(3*N), dPdv(3*N);
+  RandomSampler sampler;
+  RandomSampler_init(sampler,0);
+  for (unsigned int i=0; i<N; i++) {
+    primIDs[i] = RandomSampler_getUInt(sampler) % numFaces;
+    u[i] = RandomSampler_get1D(sampler);
+    v[i] = RandomSampler_get1D(sampler);
+  }
+
+  RTCInterpolateNArguments args;
+  args.geometry = geom;
+  args.valid = nullptr;
+  args.primIDs = primIDs.data();
+  args.u = u.data();
+  args.v = v.data();
+  args.N = N;
+  args.bufferType = RTC_BUFFER_TYPE_VERTEX;
+  args.bufferSlot = 0;
+  args.P = P.data();
+  args.dPdu = dPdu.data();
+  args.dPdv = dPdv.data();
+  args.ddPdudu = nullptr;
+  args.ddPdvdv = nullptr;
+  args.ddPdudv = nullptr;
+  args.valueCount = 3;
+
+  /* the first round only warms up the caches and is not measured, the
+   * remaining rounds interleave the methods and keep the fastest time */
+  const unsigned int numRounds = 4;
+  double dt1 = inf, dtN = inf, dtBatch = inf;
+  for (unsigned int round=0; round<=numRounds; round++)
+  {
+    double t0 = getSeconds();
+    for (unsigned int i=0; i<N; i++) {
+      Vec3fa Pi, dPdui, dPdvi;
+      rtcInterpolate1(geom,primIDs[i],u[i],v[i],RTC_BUFFER_TYPE_VERTEX,0,&Pi.x,&dPdui.x,&dPdvi.x,3);
+    }
+    double t1 = getSeconds();
+    rtcInterpolateN(&args);
+    double t2 = getSeconds();
+    rtcInterpolateBatch(&args);
+    double t3 = getSeconds();
+    if (round == 0) continue;
+    dt1     = min(dt1,    t1-t0);
+    dtN     = min(dtN,    t2-t1);
+    dtBatch = min(dtBatch,t3-t2);
+  }
+
+  std::cout << "BENCHMARK_INTERPOLATE1 " << 1E-6*double(N)/dt1 << " Msamples/s" << std::endl;
+  std::cout << "BENCHMARK_INTERPOLATEN " << 1E-6*double(N)/dtN << " Msamples/s" << std::endl;
+  std::cout << "BENCHMARK_INTERPOLATE_BATCH " << 1E-6*double(N)/dtBatch << " Msamples/s" << std::endl;
+}
+
 /* called by the C++ code for initialization */
 extern "C" void device_init (char* cfg)
 {
@@ -330,6 +391,9 @@ extern "C" void device_init (char* cfg)
 
   /* commit changes to scene */
   rtcCommitScene (g_scene);
+
+  if (g_bake_benchmark_samples)
+    bakeBenchmark(rtcGetGeometry(g_scene,quadCubeID),NUM_QUAD_FACES,g_bake_benchmark_samples);
 }
 
 /* task that renders a single screen tile */
@@ -9,7 +9,15 @@ namespace embree
     int g_spp = 1;
     int g_max_path_length = 8;
     bool g_accumulate = 1;
+    bool g_wavefront = false;
+
+    /* per stage timings of the wavefront renderer of the last frame and summed over all frames */
+    double g_wavefront_times[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    double g_wavefront_total_times[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    size_t g_wavefront_frames = 0;
   }
+
+  static const char* wavefront_stage_names[6] = { "generate", "intersect", "shade", "occluded", "compact", "resolve" };
   
   struct Tutorial : public SceneLoadingTutorialApplication
   {
@@ -27,6 +35,18 @@ namespace embree
       registerOption("accumulate", [] (Ref<ParseStream> cin, const FileName& path) {
           g_accumulate = cin->getInt();
         }, "--accumulate <bool>: accumulate samples (on by default)");
+
+      registerOption("wavefront", [] (Ref<ParseStream> cin, const FileName& path) {
+          g_wavefront = true;
+        }, "--wavefront: traces all paths bounce by bounce using ray streams and reports per stage timings (C++ version only)");
+    }
+
+    ~Tutorial()
+    {
+      if (g_wavefront_frames == 0) return;
+      std::cout << "wavefront stage timings (average per frame):" << std::endl;
+      for (size_t i=0; i<6; i++)
+        std::cout << "  " << std::setw(10) << wavefront_stage_names[i] << ": " << 1000.0*g_wavefront_total_times[i]/double(g_wavefront_frames) << " ms" << std::endl;
     }
     
     void postParseCommandLine() override
@@ -46,6 +66,9 @@ namespace embree
       ImGui::DragInt("",&g_max_path_length,1.0f,1,16);
       ImGui::Text("samples per pixel");
       ImGui::DragInt("",&g_spp,1.0f,1,16);
+      if (g_wavefront_frames)
+        for (size_t i=0; i<6; i++)
+          ImGui::Text("%s: %3.2f ms",wavefront_stage_names[i],1000.0*g_wavefront_times[i]);
     }
 #endif
   };
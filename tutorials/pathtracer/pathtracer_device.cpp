@@ -7,6 +7,7 @@
 #include "../common/tutorial/tutorial_device.h"
 #include "../common/tutorial/scene_device.h"
 #include "../common/tutorial/optics.h"
+#include "../../common/algorithms/parallel_filter.h"
 
 namespace embree {
 
@@ -29,6 +30,7 @@ namespace embree {
 extern "C" int g_spp;
 extern "C" int g_max_path_length;
 extern "C" bool g_accumulate;
+extern "C" bool g_wavefront;
 
 bool g_subdiv_mode = false;
 unsigned int keyframeID = 0;
@@ -854,6 +856,15 @@ void occlusionFilterOBJ(const RTCFilterFunctionNArguments* args);
 
 void occlusionFilterHair(const RTCFilterFunctionNArguments* args);
 
+/* filter functions of the wavefront renderer */
+void intersectionFilterOBJN(const RTCFilterFunctionNArguments* args);
+
+void occlusionFilterOpaqueN(const RTCFilterFunctionNArguments* args);
+
+void occlusionFilterOBJN(const RTCFilterFunctionNArguments* args);
+
+void occlusionFilterHairN(const RTCFilterFunctionNArguments* args);
+
 /* accumulation buffer */
 Vec3ff* g_accu = nullptr;
 unsigned int g_accu_width = 0;
@@ -881,17 +892,24 @@ void device_key_pressed_handler(int key)
 void assignShaders(ISPCGeometry* geometry)
 {
   RTCGeometry geom = geometry->geometry;
+
+  /* ray streams invoke filter functions with ray packets */
+  RTCFilterFunctionN intersectionFilterOBJ_ = g_wavefront ? intersectionFilterOBJN : intersectionFilterOBJ;
+  RTCFilterFunctionN occlusionFilterOpaque_ = g_wavefront ? occlusionFilterOpaqueN : occlusionFilterOpaque;
+  RTCFilterFunctionN occlusionFilterOBJ_    = g_wavefront ? occlusionFilterOBJN    : occlusionFilterOBJ;
+  RTCFilterFunctionN occlusionFilterHair_   = g_wavefront ? occlusionFilterHairN   : occlusionFilterHair;
+
   if (geometry->type == SUBDIV_MESH)
   {
 #if ENABLE_FILTER_FUNCTION == 1
-    rtcSetGeometryOccludedFilterFunction(geom,occlusionFilterOpaque);
+    rtcSetGeometryOccludedFilterFunction(geom,occlusionFilterOpaque_);
 #endif
   }
   else if (geometry->type == TRIANGLE_MESH)
   {
     ISPCTriangleMesh* mesh = (ISPCTriangleMesh* ) geometry;
 #if ENABLE_FILTER_FUNCTION == 1
-    rtcSetGeometryOccludedFilterFunction(geom,occlusionFilterOpaque);
+    rtcSetGeometryOccludedFilterFunction(geom,occlusionFilterOpaque_);
 
     ISPCMaterial* material = g_ispc_scene->materials[mesh->geom.materialID];
     //if (material->type == MATERIAL_DIELECTRIC || material->type == MATERIAL_THIN_DIELECTRIC)
@@ -901,8 +919,8 @@ void assignShaders(ISPCGeometry* geometry)
     {
       ISPCOBJMaterial* obj = (ISPCOBJMaterial*) material;
       if (obj->d != 1.0f || obj->map_d) {
-        rtcSetGeometryIntersectFilterFunction(geom,intersectionFilterOBJ);
-        rtcSetGeometryOccludedFilterFunction   (geom,occlusionFilterOBJ);
+        rtcSetGeometryIntersectFilterFunction(geom,intersectionFilterOBJ_);
+        rtcSetGeometryOccludedFilterFunction   (geom,occlusionFilterOBJ_);
       }
     }
 #endif
@@ -911,7 +929,7 @@ void assignShaders(ISPCGeometry* geometry)
   else if (geometry->type == QUAD_MESH)
   {
     ISPCQuadMesh* mesh = (ISPCQuadMesh*) geometry;
-    rtcSetGeometryOccludedFilterFunction(geom,occlusionFilterOpaque);
+    rtcSetGeometryOccludedFilterFunction(geom,occlusionFilterOpaque_);
 
     ISPCMaterial* material = g_ispc_scene->materials[mesh->geom.materialID];
     //if (material->type == MATERIAL_DIELECTRIC || material->type == MATERIAL_THIN_DIELECTRIC)
@@ -921,15 +939,15 @@ void assignShaders(ISPCGeometry* geometry)
     {
       ISPCOBJMaterial* obj = (ISPCOBJMaterial*) material;
       if (obj->d != 1.0f || obj->map_d) {
-        rtcSetGeometryIntersectFilterFunction(geom,intersectionFilterOBJ);
-        rtcSetGeometryOccludedFilterFunction   (geom,occlusionFilterOBJ);
+        rtcSetGeometryIntersectFilterFunction(geom,intersectionFilterOBJ_);
+        rtcSetGeometryOccludedFilterFunction   (geom,occlusionFilterOBJ_);
       }
     }
   }
   else if (geometry->type == GRID_MESH)
   {
     ISPCGridMesh* mesh = (ISPCGridMesh*) geometry;
-    rtcSetGeometryOccludedFilterFunction(geom,occlusionFilterOpaque);
+    rtcSetGeometryOccludedFilterFunction(geom,occlusionFilterOpaque_);
 
     ISPCMaterial* material = g_ispc_scene->materials[mesh->geom.materialID];
     //if (material->type == MATERIAL_DIELECTRIC || material->type == MATERIAL_THIN_DIELECTRIC)
@@ -939,15 +957,15 @@ void assignShaders(ISPCGeometry* geometry)
     {
       ISPCOBJMaterial* obj = (ISPCOBJMaterial*) material;
       if (obj->d != 1.0f || obj->map_d) {
-        rtcSetGeometryIntersectFilterFunction(geom,intersectionFilterOBJ);
-        rtcSetGeometryOccludedFilterFunction   (geom,occlusionFilterOBJ);
+        rtcSetGeometryIntersectFilterFunction(geom,intersectionFilterOBJ_);
+        rtcSetGeometryOccludedFilterFunction   (geom,occlusionFilterOBJ_);
       }
     }
   }
 
   else if (geometry->type == CURVES)
   {
-    rtcSetGeometryOccludedFilterFunction(geom,occlusionFilterHair);
+    rtcSetGeometryOccludedFilterFunction(geom,occlusionFilterHair_);
   }
 #endif
   else if (geometry->type == GROUP) {
@@ -1567,6 +1585,106 @@ void occlusionFilterHair(const RTCFilterFunctionNArguments* args)
     valid_i[0] = 0;
 }
 
+/* filter functions of the wavefront renderer, the ray ID of shadow rays indexes their transparency */
+inline Ray getRayFromRayN(RTCRayN* rayN, unsigned int N, unsigned int i)
+{
+  return Ray(Vec3fa(RTCRayN_org_x(rayN,N,i),RTCRayN_org_y(rayN,N,i),RTCRayN_org_z(rayN,N,i)),
+             Vec3fa(RTCRayN_dir_x(rayN,N,i),RTCRayN_dir_y(rayN,N,i),RTCRayN_dir_z(rayN,N,i)),
+             RTCRayN_tnear(rayN,N,i),RTCRayN_tfar(rayN,N,i),RTCRayN_time(rayN,N,i));
+}
+
+inline Vec3fa transmissionOBJ(const Ray& ray, RTCHitN* hit, unsigned int N, unsigned int i)
+{
+  /* compute differential geometry */
+  DifferentialGeometry dg;
+  dg.instID = RTCHitN_instID(hit,N,i,0);
+  dg.geomID = RTCHitN_geomID(hit,N,i);
+  dg.primID = RTCHitN_primID(hit,N,i);
+  dg.u = RTCHitN_u(hit,N,i);
+  dg.v = RTCHitN_v(hit,N,i);
+  Vec3fa Ng = Vec3fa(RTCHitN_Ng_x(hit,N,i),RTCHitN_Ng_y(hit,N,i),RTCHitN_Ng_z(hit,N,i));
+  dg.P  = ray.org+ray.tfar*ray.dir;
+  dg.Ng = Ng;
+  dg.Ns = Ng;
+  int materialID = postIntersect(ray,dg);
+  dg.Ng = face_forward(ray.dir,normalize(dg.Ng));
+  if (length(dg.Ns) < 1E-6f) dg.Ns = dg.Ng;
+  else dg.Ns = face_forward(ray.dir,normalize(dg.Ns));
+  const Vec3fa wo = neg(ray.dir);
+
+  /* calculate BRDF */
+  BRDF brdf; brdf.Kt = Vec3fa(0,0,0);
+  int numMaterials = g_ispc_scene->numMaterials;
+  ISPCMaterial** material_array = &g_ispc_scene->materials[0];
+  Medium medium = make_Medium_Vacuum();
+  Material__preprocess(material_array,materialID,numMaterials,brdf,wo,dg,medium);
+  return brdf.Kt;
+}
+
+inline Vec3fa transmissionHair(unsigned int geomID)
+{
+  ISPCGeometry* geometry = g_ispc_scene->geometries[geomID];
+  if (geometry->type != CURVES) return Vec3fa(0.0f);
+  ISPCMaterial* material = g_ispc_scene->materials[((ISPCHairSet*)geometry)->geom.materialID];
+  if (material->type != MATERIAL_HAIR) return Vec3fa(0.0f);
+  return Vec3fa(((ISPCHairMaterial*)material)->Kt);
+}
+
+void intersectionFilterOBJN(const RTCFilterFunctionNArguments* args)
+{
+  const unsigned int N = args->N;
+  for (unsigned int i=0; i<N; i++)
+  {
+    if (!args->valid[i]) continue;
+    const Vec3fa Kt = transmissionOBJ(getRayFromRayN(args->ray,N,i),args->hit,N,i);
+    if (min(min(Kt.x,Kt.y),Kt.z) >= 1.0f)
+      args->valid[i] = 0;
+  }
+}
+
+void occlusionFilterOpaqueN(const RTCFilterFunctionNArguments* args)
+{
+  Vec3fa* transparency = (Vec3fa*) ((IntersectContext*) args->context)->userRayExt;
+  if (!transparency) return;
+
+  const unsigned int N = args->N;
+  for (unsigned int i=0; i<N; i++)
+    if (args->valid[i])
+      transparency[RTCRayN_id(args->ray,N,i)] = Vec3fa(0.0f);
+}
+
+void occlusionFilterOBJN(const RTCFilterFunctionNArguments* args)
+{
+  Vec3fa* transparency = (Vec3fa*) ((IntersectContext*) args->context)->userRayExt;
+  if (!transparency) return;
+
+  const unsigned int N = args->N;
+  for (unsigned int i=0; i<N; i++)
+  {
+    if (!args->valid[i]) continue;
+    Vec3fa& T = transparency[RTCRayN_id(args->ray,N,i)];
+    T = T * transmissionOBJ(getRayFromRayN(args->ray,N,i),args->hit,N,i);
+    if (max(max(T.x,T.y),T.z) > 0.0f)
+      args->valid[i] = 0;
+  }
+}
+
+void occlusionFilterHairN(const RTCFilterFunctionNArguments* args)
+{
+  Vec3fa* transparency = (Vec3fa*) ((IntersectContext*) args->context)->userRayExt;
+  if (!transparency) return;
+
+  const unsigned int N = args->N;
+  for (unsigned int i=0; i<N; i++)
+  {
+    if (!args->valid[i]) continue;
+    Vec3fa& T = transparency[RTCRayN_id(args->ray,N,i)];
+    T = T * transmissionHair(RTCHitN_geomID(args->hit,N,i));
+    if (max(max(T.x,T.y),T.z) > 0.0f)
+      args->valid[i] = 0;
+  }
+}
+
 Vec3fa renderPixelFunction(float x, float y, RandomSampler& sampler, const ISPCCamera& camera, RayStats& stats)
 {
   /* radiance accumulator and weight */
@@ -1737,6 +1855,318 @@ void renderTileTask (int taskIndex, int threadIndex, int* pixels,
 }
 
 
+/***************************************************************************************/
+/*                               wavefront path tracer                                 */
+/***************************************************************************************/
+
+/* maximal number of paths traced at once and number of rays passed to a single stream call */
+#define WAVEFRONT_MAX_PATHS (1 << 18)
+#define WAVEFRONT_STREAM_SIZE 256
+
+enum WavefrontStage
+{
+  STAGE_GENERATE = 0,
+  STAGE_INTERSECT = 1,
+  STAGE_SHADE = 2,
+  STAGE_OCCLUDED = 3,
+  STAGE_COMPACT = 4,
+  STAGE_RESOLVE = 5,
+  NUM_WAVEFRONT_STAGES = 6
+};
+
+extern "C" double g_wavefront_times[NUM_WAVEFRONT_STAGES];
+extern "C" double g_wavefront_total_times[NUM_WAVEFRONT_STAGES];
+extern "C" size_t g_wavefront_frames;
+
+/* state of a path between two bounces */
+struct WavefrontPath
+{
+  Vec3fa L;               //!< radiance accumulator
+  Vec3fa Lw;              //!< path throughput
+  Medium medium;          //!< medium the path currently travels through
+  RandomSampler sampler;
+  bool alive;
+};
+
+/* path and shadow ray queues */
+size_t g_wavefront_paths_capacity = 0;
+size_t g_wavefront_shadows_capacity = 0;
+WavefrontPath* g_wavefront_paths = nullptr;
+Ray* g_wavefront_rays = nullptr;            //!< current ray of each path
+unsigned int* g_wavefront_active = nullptr; //!< IDs of all paths still alive
+Ray* g_wavefront_shadows = nullptr;         //!< shadow rays of all alive paths and lights
+Vec3fa* g_wavefront_weights = nullptr;      //!< contribution of each shadow ray if not occluded
+Vec3fa* g_wavefront_transparency = nullptr; //!< transparency along each shadow ray
+
+void freeWavefrontQueues()
+{
+  alignedFree(g_wavefront_paths);        g_wavefront_paths = nullptr;
+  alignedFree(g_wavefront_rays);         g_wavefront_rays = nullptr;
+  alignedFree(g_wavefront_active);       g_wavefront_active = nullptr;
+  alignedFree(g_wavefront_shadows);      g_wavefront_shadows = nullptr;
+  alignedFree(g_wavefront_weights);      g_wavefront_weights = nullptr;
+  alignedFree(g_wavefront_transparency); g_wavefront_transparency = nullptr;
+  g_wavefront_paths_capacity = 0;
+  g_wavefront_shadows_capacity = 0;
+}
+
+void resizeWavefrontQueues(size_t numPaths, size_t numShadows)
+{
+  if (numPaths > g_wavefront_paths_capacity)
+  {
+    alignedFree(g_wavefront_paths);
+    alignedFree(g_wavefront_rays);
+    alignedFree(g_wavefront_active);
+    g_wavefront_paths  = (WavefrontPath*) alignedMalloc(numPaths*sizeof(WavefrontPath),64);
+    g_wavefront_rays   = (Ray*) alignedMalloc(numPaths*sizeof(Ray),64);
+    g_wavefront_active = (unsigned int*) alignedMalloc(numPaths*sizeof(unsigned int),64);
+    g_wavefront_paths_capacity = numPaths;
+  }
+
+  if (numShadows > g_wavefront_shadows_capacity)
+  {
+    alignedFree(g_wavefront_shadows);
+    alignedFree(g_wavefront_weights);
+    alignedFree(g_wavefront_transparency);
+    g_wavefront_shadows      = (Ray*) alignedMalloc(numShadows*sizeof(Ray),64);
+    g_wavefront_weights      = (Vec3fa*) alignedMalloc(numShadows*sizeof(Vec3fa),64);
+    g_wavefront_transparency = (Vec3fa*) alignedMalloc(numShadows*sizeof(Vec3fa),64);
+    g_wavefront_shadows_capacity = numShadows;
+  }
+}
+
+inline void endWavefrontStage(WavefrontStage stage, double& t0)
+{
+  const double t1 = getSeconds();
+  g_wavefront_times[stage] += t1-t0;
+  t0 = t1;
+}
+
+/* shades the hit of a path and generates its shadow rays, returns true if the path continues */
+bool shadeWavefrontPath(WavefrontPath& path, Ray& ray, Ray* shadows, Vec3fa* weights, Vec3fa* transparency, unsigned int shadowID, bool lastBounce)
+{
+  const unsigned int numLights = g_ispc_scene->numLights;
+  for (unsigned int i=0; i<numLights; i++)
+    init_Ray(shadows[i],Vec3fa(0.0f),Vec3fa(0.0f,0.0f,1.0f),0.0f,neg_inf);
+
+  const Vec3fa wo = neg(ray.dir);
+  const float time = ray.time();
+  DifferentialGeometry dg;
+
+  /* invoke environment lights if nothing hit */
+  if (ray.geomID == RTC_INVALID_GEOMETRY_ID)
+  {
+    dg.P = ray.org;
+    for (unsigned int i=0; i<numLights; i++)
+    {
+      const Light* l = g_ispc_scene->lights[i];
+      Light_EvalRes le = l->eval(l,dg,ray.dir);
+      path.L = path.L + path.Lw*le.value;
+    }
+    return false;
+  }
+
+  /* compute differential geometry */
+  dg.instID = ray.instID[0];
+  dg.geomID = ray.geomID;
+  dg.primID = ray.primID;
+  dg.u = ray.u;
+  dg.v = ray.v;
+  dg.P  = ray.org+ray.tfar*ray.dir;
+  dg.Ng = ray.Ng;
+  dg.Ns = normalize(ray.Ng);
+  int materialID = postIntersect(ray,dg);
+  dg.Ng = face_forward(ray.dir,normalize(dg.Ng));
+  dg.Ns = face_forward(ray.dir,normalize(dg.Ns));
+
+  /*! Compute  simple volumetric effect. */
+  Vec3fa c = Vec3fa(1.0f);
+  const Vec3fa transmission = path.medium.transmission;
+  if (ne(transmission,Vec3fa(1.0f)))
+    c = c * pow(transmission,ray.tfar);
+
+  /* calculate BRDF */
+  BRDF brdf;
+  int numMaterials = g_ispc_scene->numMaterials;
+  ISPCMaterial** material_array = &g_ispc_scene->materials[0];
+  Material__preprocess(material_array,materialID,numMaterials,brdf,wo,dg,path.medium);
+
+  /* sample BRDF at hit point */
+  Sample3f wi1;
+  c = c * Material__sample(material_array,materialID,numMaterials,brdf,path.Lw, wo, dg, wi1, path.medium, RandomSampler_get2D(path.sampler));
+
+  /* generate one shadow ray per light */
+  for (unsigned int i=0; i<numLights; i++)
+  {
+    const Light* l = g_ispc_scene->lights[i];
+    Light_SampleRes ls = l->sample(l,dg,RandomSampler_get2D(path.sampler));
+    if (ls.pdf <= 0.0f) continue;
+    init_Ray(shadows[i],dg.P,ls.dir,dg.eps,ls.dist,time);
+    shadows[i].id = shadowID+i;
+    weights[i] = path.Lw*ls.weight*Material__eval(material_array,materialID,numMaterials,brdf,wo,dg,ls.dir);
+    transparency[i] = Vec3fa(1.0f);
+  }
+
+  if (lastBounce || wi1.pdf <= 1E-4f /* 0.0f */) return false;
+  path.Lw = path.Lw*c/wi1.pdf;
+
+  /* terminate if contribution too low */
+  if (max(path.Lw.x,max(path.Lw.y,path.Lw.z)) < 0.01f)
+    return false;
+
+  /* setup secondary ray */
+  float sign = dot(wi1.v,dg.Ng) < 0.0f ? -1.0f : 1.0f;
+  dg.P = dg.P + sign*dg.eps*dg.Ng;
+  init_Ray(ray, dg.P,normalize(wi1.v),dg.eps,inf,time);
+  return true;
+}
+
+/* renders the frame bounce by bounce, tracing the rays of all paths through the stream API */
+void renderFrameWavefront (int* pixels,
+                           const unsigned int width,
+                           const unsigned int height,
+                           const float time,
+                           const ISPCCamera& camera)
+{
+  const size_t spp = max(g_spp,1);
+  const size_t numLights = g_ispc_scene->numLights;
+  const size_t numPixels = size_t(width)*size_t(height);
+  const size_t wavePixels = max(size_t(WAVEFRONT_MAX_PATHS)/spp,size_t(1));
+  resizeWavefrontQueues(min(numPixels,wavePixels)*spp,min(numPixels,wavePixels)*spp*numLights);
+
+  for (size_t i=0; i<NUM_WAVEFRONT_STAGES; i++)
+    g_wavefront_times[i] = 0.0;
+
+  for (size_t p0=0; p0<numPixels; p0+=wavePixels)
+  {
+    const size_t p1 = min(p0+wavePixels,numPixels);
+    const size_t numPaths = (p1-p0)*spp;
+    double t0 = getSeconds();
+
+    /* generate camera rays */
+    parallel_for(size_t(0),numPaths,[&](const range<size_t>& range) {
+      for (size_t i=range.begin(); i<range.end(); i++)
+      {
+        const unsigned int x = (unsigned int)((p0+i/spp) % width);
+        const unsigned int y = (unsigned int)((p0+i/spp) / width);
+        WavefrontPath& path = g_wavefront_paths[i];
+        RandomSampler_init(path.sampler, (int)x, (int)y, (int)(g_accu_count*spp+i%spp));
+        const float fx = x + RandomSampler_get1D(path.sampler);
+        const float fy = y + RandomSampler_get1D(path.sampler);
+        const float ptime = RandomSampler_get1D(path.sampler);
+        path.L = Vec3fa(0.0f);
+        path.Lw = Vec3fa(1.0f);
+        path.medium = make_Medium_Vacuum();
+        path.alive = true;
+        init_Ray(g_wavefront_rays[i],Vec3fa(camera.xfm.p),Vec3fa(normalize(fx*camera.xfm.l.vx + fy*camera.xfm.l.vy + camera.xfm.l.vz)),0.0f,inf,ptime);
+        g_wavefront_active[i] = (unsigned int) i;
+      }
+    });
+    endWavefrontStage(STAGE_GENERATE,t0);
+
+    size_t numActive = numPaths;
+    for (int depth=0; depth<g_max_path_length && numActive; depth++)
+    {
+      /* intersect camera rays as coherent streams, and later bounces through streams of pointers to the rays of alive paths */
+      parallel_for(size_t(0),numActive,size_t(WAVEFRONT_STREAM_SIZE),[&](const range<size_t>& range) {
+        const int threadIndex = (int)TaskScheduler::threadIndex();
+        IntersectContext context;
+        InitIntersectionContext(&context);
+        context.context.flags = (depth == 0) ? g_iflags_coherent : g_iflags_incoherent;
+        for (size_t i=range.begin(); i<range.end(); i+=WAVEFRONT_STREAM_SIZE)
+        {
+          const unsigned int N = (unsigned int) min(range.end()-i,size_t(WAVEFRONT_STREAM_SIZE));
+          if (depth == 0)
+            rtcIntersect1M(g_scene,&context.context,RTCRayHit1_(g_wavefront_rays[i]),N,sizeof(Ray));
+          else
+          {
+            RTCRayHit* rays[WAVEFRONT_STREAM_SIZE];
+            for (unsigned int j=0; j<N; j++)
+              rays[j] = RTCRayHit1_(g_wavefront_rays[g_wavefront_active[i+j]]);
+            rtcIntersect1Mp(g_scene,&context.context,rays,N);
+          }
+          for (unsigned int j=0; j<N; j++)
+            RayStats_addRay(g_stats[threadIndex]);
+        }
+      });
+      endWavefrontStage(STAGE_INTERSECT,t0);
+
+      /* shade hits and generate shadow rays */
+      const bool lastBounce = depth+1 == g_max_path_length;
+      parallel_for(size_t(0),numActive,[&](const range<size_t>& range) {
+        for (size_t i=range.begin(); i<range.end(); i++)
+        {
+          const unsigned int pathID = g_wavefront_active[i];
+          const size_t shadowID = i*numLights;
+          WavefrontPath& path = g_wavefront_paths[pathID];
+          path.alive = shadeWavefrontPath(path,g_wavefront_rays[pathID],&g_wavefront_shadows[shadowID],&g_wavefront_weights[shadowID],&g_wavefront_transparency[shadowID],(unsigned int)shadowID,lastBounce);
+        }
+      });
+      endWavefrontStage(STAGE_SHADE,t0);
+
+      /* trace shadow rays and add the contribution of unoccluded ones */
+      const size_t numShadows = numActive*numLights;
+      parallel_for(size_t(0),numShadows,size_t(WAVEFRONT_STREAM_SIZE),[&](const range<size_t>& range) {
+        const int threadIndex = (int)TaskScheduler::threadIndex();
+        IntersectContext context;
+        InitIntersectionContext(&context);
+        context.context.flags = g_iflags_incoherent;
+        context.userRayExt = g_wavefront_transparency;
+        for (size_t i=range.begin(); i<range.end(); i+=WAVEFRONT_STREAM_SIZE)
+        {
+          const unsigned int N = (unsigned int) min(range.end()-i,size_t(WAVEFRONT_STREAM_SIZE));
+          rtcOccluded1M(g_scene,&context.context,RTCRay1_(g_wavefront_shadows[i]),N,sizeof(Ray));
+          for (unsigned int j=0; j<N; j++)
+            RayStats_addShadowRay(g_stats[threadIndex]);
+        }
+      });
+
+      parallel_for(size_t(0),numActive,[&](const range<size_t>& range) {
+        for (size_t i=range.begin(); i<range.end(); i++)
+        {
+          WavefrontPath& path = g_wavefront_paths[g_wavefront_active[i]];
+          for (size_t j=i*numLights; j<(i+1)*numLights; j++)
+          {
+            const Vec3fa& T = g_wavefront_transparency[j];
+            if (g_wavefront_shadows[j].tfar >= 0.0f && max(max(T.x,T.y),T.z) > 0.0f)
+              path.L = path.L + g_wavefront_weights[j]*T;
+          }
+        }
+      });
+      endWavefrontStage(STAGE_OCCLUDED,t0);
+
+      /* remove terminated paths from the queue */
+      numActive = parallel_filter(g_wavefront_active,size_t(0),numActive,size_t(1024),[&](unsigned int pathID) {
+          return g_wavefront_paths[pathID].alive;
+        });
+      endWavefrontStage(STAGE_COMPACT,t0);
+    }
+
+    /* average the samples of each pixel and write them to the framebuffer */
+    parallel_for(p0,p1,[&](const range<size_t>& range) {
+      for (size_t p=range.begin(); p<range.end(); p++)
+      {
+        Vec3fa L = Vec3fa(0.0f);
+        for (size_t i=(p-p0)*spp; i<(p-p0+1)*spp; i++)
+          L = L + g_wavefront_paths[i].L;
+        const Vec3fa color = L/(float)spp;
+
+        Vec3ff accu_color = g_accu[p] + Vec3ff(color.x,color.y,color.z,1.0f); g_accu[p] = accu_color;
+        float f = rcp(max(0.001f,accu_color.w));
+        unsigned int r = (unsigned int) (255.01f * clamp(accu_color.x*f,0.0f,1.0f));
+        unsigned int g = (unsigned int) (255.01f * clamp(accu_color.y*f,0.0f,1.0f));
+        unsigned int b = (unsigned int) (255.01f * clamp(accu_color.z*f,0.0f,1.0f));
+        pixels[p] = (b << 16) + (g << 8) + r;
+      }
+    });
+    endWavefrontStage(STAGE_RESOLVE,t0);
+  }
+
+  for (size_t i=0; i<NUM_WAVEFRONT_STAGES; i++)
+    g_wavefront_total_times[i] += g_wavefront_times[i];
+  g_wavefront_frames++;
+}
+
 /***************************************************************************************/
 
 inline float updateEdgeLevel( ISPCSubdivMesh* mesh, const Vec3fa& cam_pos, const unsigned int e0, const unsigned int e1)
@@ -1815,6 +2245,11 @@ extern "C" void renderFrameStandard (int* pixels,
                           const float time,
                           const ISPCCamera& camera)
 {
+  if (g_wavefront) {
+    renderFrameWavefront(pixels,width,height,time,camera);
+    return;
+  }
+
   /* render image */
   const int numTilesX = (width +TILE_SIZE_X-1)/TILE_SIZE_X;
   const int numTilesY = (height+TILE_SIZE_Y-1)/TILE_SIZE_Y;
@@ -1877,6 +2312,7 @@ extern "C" void device_cleanup ()
 {
   rtcReleaseScene (g_scene); g_scene = nullptr;
   alignedFree(g_accu); g_accu = nullptr;
+  freeWavefrontQueues();
   g_accu_width = 0;
   g_accu_height = 0;
   g_accu_count = 0;
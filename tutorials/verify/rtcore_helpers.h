@@ -615,7 +615,9 @@ namespace embree
     else ret += "Static";
     if (scene_flags & RTC_SCENE_FLAG_COMPACT) ret += "Compact";
     if (scene_flags & RTC_SCENE_FLAG_ROBUST ) ret += "Robust";
-    if (!(scene_flags & RTC_SCENE_FLAG_COMPACT) && !(scene_flags & RTC_SCENE_FLAG_ROBUST)) ret += "Fast"; 
+    if (scene_flags & RTC_SCENE_FLAG_QUANTIZED) ret += "Quantized";
+    if (scene_flags & RTC_SCENE_FLAG_DOUBLE_BUFFERED) ret += "DoubleBuffered";
+    if (!(scene_flags & RTC_SCENE_FLAG_COMPACT) && !(scene_flags & RTC_SCENE_FLAG_ROBUST) && !(scene_flags & RTC_SCENE_FLAG_QUANTIZED)) ret += "Fast"; 
     return ret;
   }
   
@@ -625,6 +627,7 @@ namespace embree
     else if (quality_flags == RTC_BUILD_QUALITY_MEDIUM) return "MediumQuality";
     else if (quality_flags == RTC_BUILD_QUALITY_HIGH  ) return "HighQuality";
     else if (quality_flags == RTC_BUILD_QUALITY_REFIT ) return "RefitQuality";
+    else if (quality_flags == RTC_BUILD_QUALITY_PLOC  ) return "PLOCQuality";
     else { assert(false); return ""; }
   }
 
@@ -6,6 +6,8 @@
 #include "verify.h"
 #include "../common/scenegraph/scenegraph.h"
 #include "../common/scenegraph/geometry_creation.h"
+#include "../common/scenegraph/obj_loader.h"
+#include "../common/scenegraph/binary_loader.h"
 #include "../common/math/closest_point.h"
 #include "../../common/algorithms/parallel_for.h"
 #include "../../kernels/common/context.h"
@@ -13,6 +15,7 @@
 #include "../../kernels/common/scene.h"
 #include <regex>
 #include <stack>
+#include <queue>
 
 #define random  use_random_function_of_test // do use random_int() and random_float() from Test class
 #define drand48 use_random_function_of_test // do use random_int() and random_float() from Test class
@@ -861,6 +864,159 @@ namespace embree
     }
   };
 
+  struct OBJStreamingTest : public VerifyApplication::Test
+  {
+    OBJStreamingTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    /* writes a height field with quads, triangles, relative indices, and material groups */
+    static void writeOBJ(const FileName& fileName, unsigned int N)
+    {
+      std::ofstream file(fileName.c_str());
+      for (unsigned int y=0; y<=N; y++)
+      {
+        if (y%7 == 0) file << "usemtl material" << y << std::endl;
+        for (unsigned int x=0; x<=N; x++)
+          file << "v " << float(x) << " " << float(y) << " " << sinf(0.1f*float(x*y)) << std::endl;
+        if (y == 0) continue;
+
+        for (unsigned int x=0; x<N; x++) {
+          const int v00 = (y-1)*(N+1)+x+1, v01 = v00+1, v10 = v00+N+1, v11 = v10+1;
+          if (x%2) file << "f " << v00 << " " << v01 << " " << v11 << " " << v10 << std::endl;
+          else {
+            const int base = (y+1)*(N+1)+1;
+            file << "f " << v00-base << " " << v01-base << " " << v11-base << std::endl;
+            file << "f\t" << v00-base << "\t" << v11-base << "\t" << v10-base << " " << std::endl;
+          }
+        }
+      }
+    }
+
+    static bool equal(Ref<SceneGraph::Node> node0, Ref<SceneGraph::Node> node1)
+    {
+      Ref<SceneGraph::GroupNode> group0 = node0.dynamicCast<SceneGraph::GroupNode>();
+      Ref<SceneGraph::GroupNode> group1 = node1.dynamicCast<SceneGraph::GroupNode>();
+      if (!group0 || !group1 || group0->size() != group1->size()) return false;
+
+      for (size_t i=0; i<group0->size(); i++)
+      {
+        Ref<SceneGraph::TriangleMeshNode> mesh0 = group0->child(i).dynamicCast<SceneGraph::TriangleMeshNode>();
+        Ref<SceneGraph::TriangleMeshNode> mesh1 = group1->child(i).dynamicCast<SceneGraph::TriangleMeshNode>();
+        if (!mesh0 || !mesh1 || mesh0->numPrimitives() != mesh1->numPrimitives()) return false;
+
+        /* the loaders number vertices differently, thus compare the vertex positions */
+        for (size_t j=0; j<mesh0->numPrimitives(); j++)
+        {
+          const SceneGraph::TriangleMeshNode::Triangle& tri0 = mesh0->triangles[j];
+          const SceneGraph::TriangleMeshNode::Triangle& tri1 = mesh1->triangles[j];
+          if (mesh0->positions[0][tri0.v0] != mesh1->positions[0][tri1.v0]) return false;
+          if (mesh0->positions[0][tri0.v1] != mesh1->positions[0][tri1.v1]) return false;
+          if (mesh0->positions[0][tri0.v2] != mesh1->positions[0][tri1.v2]) return false;
+        }
+      }
+      return true;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      const FileName fileName = "verify_obj_streaming_" + stringOfISA(isa) + ".obj";
+      writeOBJ(fileName,64);
+      bool passed = true;
+
+      /* small chunks such that lines and material groups cross chunk boundaries */
+      Ref<SceneGraph::Node> node = loadOBJ(fileName);
+      passed &= equal(node,loadOBJStreaming(fileName,false,4096));
+      passed &= equal(loadOBJ(fileName,false,true),loadOBJStreaming(fileName,true,4096));
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      Ref<OBJStreamData> data = loadOBJStreaming(device,scene,fileName,false,4096);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+      remove(fileName.c_str());
+
+      BBox3fa bounds;
+      rtcGetSceneBounds(scene,(RTCBounds*)&bounds);
+      AssertNoError(device);
+      passed &= bounds == node->bounds();
+      passed &= data->numTriangles == node->numPrimitives();
+      passed &= data->indices.size() == node.dynamicCast<SceneGraph::GroupNode>()->size();
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct BinarySceneRoundTripTest : public VerifyApplication::Test
+  {
+    BinarySceneRoundTripTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      Ref<SceneGraph::GroupNode> group = new SceneGraph::GroupNode;
+      group->add(SceneGraph::createTriangleSphere(Vec3fa(0,0,0),1.0f,20));
+      group->add(SceneGraph::createQuadSphere(Vec3fa(3,0,0),1.0f,20)->set_motion_vector(Vec3fa(0,1,0)));
+      group->add(SceneGraph::createHairyPlane(1,Vec3fa(0,3,0),Vec3fa(1,0,0),Vec3fa(0,0,1),0.2f,0.01f,100,SceneGraph::FLAT_CURVE));
+      group->add(new SceneGraph::TransformNode(AffineSpace3fa::translate(Vec3fa(0,0,3)),SceneGraph::createTriangleSphere(zero,0.5f,10)));
+
+      const FileName fileName = "verify_binary_scene_" + stringOfISA(isa) + ".ebs";
+      SceneGraph::store(group.dynamicCast<SceneGraph::Node>(),fileName,false,false);
+      bool passed = true;
+
+      /* the scene graph has to contain the same geometries */
+      Ref<SceneGraph::GroupNode> group1 = SceneGraph::load(fileName).dynamicCast<SceneGraph::GroupNode>();
+      passed &= group1 && group1->size() == group->size();
+      for (size_t i=0; passed && i<group->size(); i++)
+      {
+        passed &= group->child(i)->numPrimitives() == group1->child(i)->numPrimitives();
+        passed &= group->child(i)->lbounds().bounds0 == group1->child(i)->lbounds().bounds0;
+        passed &= group->child(i)->lbounds().bounds1 == group1->child(i)->lbounds().bounds1;
+      }
+
+      /* the scene that shares the mapped buffers has to behave like the original scene */
+      VerifyScene scene0(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      for (size_t i=0; i<group->size(); i++)
+        scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,group->child(i));
+      rtcCommitScene (scene0);
+      AssertNoError(device);
+
+      Ref<BinarySceneFile> file = new BinarySceneFile(fileName);
+      RTCScene scene1 = file->createScene(device);
+      AssertNoError(device);
+
+      BBox3fa bounds0, bounds1;
+      rtcGetSceneBounds(scene0,(RTCBounds*)&bounds0);
+      rtcGetSceneBounds(scene1,(RTCBounds*)&bounds1);
+      passed &= bounds0 == bounds1;
+
+      RandomSampler sampler;
+      RandomSampler_init(sampler,0);
+      for (size_t i=0; i<1000; i++)
+      {
+        const Vec3fa org = Vec3fa(-5.0f,-5.0f,-5.0f) + 15.0f*RandomSampler_get3D(sampler);
+        const Vec3fa dir = Vec3fa(1.5f,1.5f,1.5f) - org;
+        RTCRayHit ray0 = makeRay(org,dir);
+        ray0.ray.time = RandomSampler_get1D(sampler);
+        RTCRayHit ray1 = ray0;
+        IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,scene0,&ray0,1);
+        IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,scene1,&ray1,1);
+        passed &= ray0.hit.geomID == ray1.hit.geomID && ray0.hit.primID == ray1.hit.primID && ray0.ray.tfar == ray1.ray.tfar;
+      }
+      AssertNoError(device);
+
+      rtcReleaseScene(scene1);
+      file = nullptr;
+      remove(fileName.c_str());
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct GetUserDataTest : public VerifyApplication::Test
   {
     GetUserDataTest (std::string name, int isa)
@@ -1205,6 +1361,222 @@ namespace embree
     }
   };
 
+  struct AsyncCommitTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality; 
+
+    AsyncCommitTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      Ref<SceneGraph::Node> nodes[3] = {
+        SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,100),
+        SceneGraph::createQuadSphere    (Vec3fa(+1,0,0),1.0f,100),
+        SceneGraph::createSubdivSphere  (Vec3fa(0,1,0),1.0f,8,20)
+      };
+
+      VerifyScene scene0(device,sflags);
+      for (auto& node : nodes) scene0.addGeometry(quality,node);
+      rtcCommitScene (scene0);
+      AssertNoError(device);
+
+      /* trace rays into scene0 while scene1 gets built in the background */
+      VerifyScene scene1(device,sflags);
+      for (auto& node : nodes) scene1.addGeometry(quality,node);
+      RTCCommit commit = rtcCommitSceneAsync(scene1,2);
+      AssertNoError(device);
+
+      float progress = 0.0f, lastProgress = 0.0f;
+      bool monotonic = true;
+      while (rtcGetCommitState(commit,&progress) == RTC_COMMIT_STATE_RUNNING)
+      {
+        monotonic &= progress >= lastProgress && progress <= 1.0f;
+        lastProgress = progress;
+        RTCRayHit ray = makeRay(Vec3fa(-1,0,-4),Vec3fa(0,0,1));
+        RTCIntersectContext context;
+        rtcInitIntersectContext(&context);
+        rtcIntersect1(scene0,&context,&ray);
+      }
+      if (rtcWaitCommit(commit) != RTC_COMMIT_STATE_DONE) return VerifyApplication::FAILED;
+      rtcGetCommitState(commit,&progress);
+      rtcReleaseCommit(commit);
+      AssertNoError(device);
+      if (!monotonic || progress != 1.0f) return VerifyApplication::FAILED;
+
+      size_t numFailures = 0;
+      for (size_t i=0; i<size_t(1000*state->intensity); i++)
+      {
+        const Vec3fa org = 6.0f*random_Vec3fa()-Vec3fa(3.0f);
+        const Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+        RTCRayHit ray0 = makeRay(org,dir);
+        RTCRayHit ray1 = makeRay(org,dir);
+        RTCIntersectContext context;
+        rtcInitIntersectContext(&context);
+        rtcIntersect1(scene0,&context,&ray0);
+        rtcIntersect1(scene1,&context,&ray1);
+        numFailures += ray0.hit.geomID != ray1.hit.geomID || ray0.hit.primID != ray1.hit.primID;
+      }
+      AssertNoError(device);
+
+      /* a cancelled commit leaves the scene uncommitted, thus commit again */
+      VerifyScene scene2(device,sflags);
+      for (auto& node : nodes) scene2.addGeometry(quality,node);
+      commit = rtcCommitSceneAsync(scene2,0);
+      rtcCancelCommit(commit);
+      const RTCCommitState cancelState = rtcWaitCommit(commit);
+      rtcReleaseCommit(commit);
+      AssertNoError(device);
+      if (cancelState != RTC_COMMIT_STATE_CANCELLED && cancelState != RTC_COMMIT_STATE_DONE)
+        return VerifyApplication::FAILED;
+
+      rtcCommitScene(scene2);
+      AssertNoError(device);
+      RTCRayHit ray = makeRay(Vec3fa(-1,0,-4),Vec3fa(0,0,1));
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      rtcIntersect1(scene2,&context,&ray);
+      numFailures += ray.hit.geomID == RTC_INVALID_GEOMETRY_ID;
+
+      return (VerifyApplication::TestReturnValue) (numFailures == 0);
+    }
+  };
+
+  struct DoubleBufferedCommitTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality; 
+
+    DoubleBufferedCommitTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* compact scenes cannot get double buffered */
+      if (sflags.sflags & RTC_SCENE_FLAG_COMPACT)
+      {
+        RTCSceneRef scene = rtcNewScene(device);
+        rtcSetSceneFlags(scene,RTCSceneFlags(sflags.sflags | RTC_SCENE_FLAG_DOUBLE_BUFFERED));
+        AssertError(device,RTC_ERROR_INVALID_OPERATION);
+        return VerifyApplication::PASSED;
+      }
+
+      Ref<SceneGraph::TriangleMeshNode> mesh = SceneGraph::createTriangleSphere(Vec3fa(-2,0,0),1.0f,100).dynamicCast<SceneGraph::TriangleMeshNode>();
+
+      SceneFlags dflags(RTCSceneFlags(sflags.sflags | RTC_SCENE_FLAG_DOUBLE_BUFFERED),sflags.qflags);
+      VerifyScene scene(device,dflags);
+      unsigned int geomID = scene.addGeometry(quality,mesh.dynamicCast<SceneGraph::Node>());
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      /* move the sphere back and forth, the scene has to stay traversable during each commit */
+      size_t numFailures = 0;
+      for (size_t i=1; i<5; i++)
+      {
+        const float prev = (i%2) ? -2.0f : +2.0f;
+        const float next = (i%2) ? +2.0f : -2.0f;
+        for (auto& p : mesh->positions[0]) p.x += next-prev;
+        RTCGeometry geom = rtcGetGeometry(scene,geomID);
+        rtcUpdateGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0);
+        rtcCommitGeometry(geom);
+        
+        RTCCommit commit = rtcCommitSceneAsync(scene,1);
+        AssertNoError(device);
+        while (rtcGetCommitState(commit,nullptr) == RTC_COMMIT_STATE_RUNNING)
+        {
+          RTCIntersectContext context;
+          rtcInitIntersectContext(&context);
+          RTCRayHit ray0 = makeRay(Vec3fa(prev,0,-4),Vec3fa(0,0,1));
+          RTCRayHit ray1 = makeRay(Vec3fa(next,0,-4),Vec3fa(0,0,1));
+          rtcIntersect1(scene,&context,&ray0);
+          rtcIntersect1(scene,&context,&ray1);
+          numFailures += ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID && ray1.hit.geomID == RTC_INVALID_GEOMETRY_ID;
+        }
+        if (rtcWaitCommit(commit) != RTC_COMMIT_STATE_DONE) return VerifyApplication::FAILED;
+        rtcReleaseCommit(commit);
+        AssertNoError(device);
+
+        RTCIntersectContext context;
+        rtcInitIntersectContext(&context);
+        RTCRayHit ray0 = makeRay(Vec3fa(prev,0,-4),Vec3fa(0,0,1));
+        RTCRayHit ray1 = makeRay(Vec3fa(next,0,-4),Vec3fa(0,0,1));
+        rtcIntersect1(scene,&context,&ray0);
+        rtcIntersect1(scene,&context,&ray1);
+        numFailures += ray0.hit.geomID != RTC_INVALID_GEOMETRY_ID || ray1.hit.geomID != geomID;
+      }
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) (numFailures == 0);
+    }
+  };
+
+  struct SaveLoadBVHTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality; 
+
+    SaveLoadBVHTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      const std::string fileName = "embree_verify_" + stringOfISA(isa) + "_" + to_string(sflags) + ".bvh";
+
+      Ref<SceneGraph::Node> nodes[2] = {
+        SceneGraph::createTriangleSphere(Vec3fa(-1,0,0),1.0f,50),
+        SceneGraph::createQuadSphere    (Vec3fa(+1,0,0),1.0f,50)
+      };
+      
+      VerifyScene scene0(device,sflags);
+      for (auto& node : nodes) scene0.addGeometry(quality,node);
+      rtcCommitScene (scene0);
+      rtcSaveSceneBVH(scene0,fileName.c_str());
+      AssertNoError(device);
+
+      /* the loaded scene has to use the same geometries */
+      VerifyScene scene1(device,sflags);
+      for (auto& node : nodes) scene1.addGeometry(quality,node);
+      rtcLoadSceneBVH(scene1,fileName.c_str());
+      AssertNoError(device);
+
+      size_t numFailures = 0;
+      for (size_t i=0; i<size_t(1000*state->intensity); i++)
+      {
+        const Vec3fa org = 6.0f*random_Vec3fa()-Vec3fa(3.0f);
+        const Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+        RTCRayHit ray0 = makeRay(org,dir);
+        RTCRayHit ray1 = makeRay(org,dir);
+        RTCIntersectContext context;
+        rtcInitIntersectContext(&context);
+        rtcIntersect1(scene0,&context,&ray0);
+        rtcIntersect1(scene1,&context,&ray1);
+        numFailures += ray0.hit.geomID != ray1.hit.geomID || ray0.hit.primID != ray1.hit.primID || ray0.ray.tfar != ray1.ray.tfar;
+      }
+      AssertNoError(device);
+
+      /* a file that does not match the scene has to get rejected */
+      VerifyScene scene2(device,sflags);
+      scene2.addGeometry(quality,nodes[0]);
+      rtcLoadSceneBVH(scene2,fileName.c_str());
+      AssertError(device,RTC_ERROR_INVALID_OPERATION);
+      
+      std::remove(fileName.c_str());
+      return (VerifyApplication::TestReturnValue) (numFailures == 0);
+    }
+  };
+
   struct OverlappingGeometryTest : public VerifyApplication::Test
   {
     SceneFlags sflags;
@@ -1342,6 +1714,7 @@ namespace embree
           case RTC_SCENE_FLAG_NONE: return has_avx ?  70.0f*NN :  63.0f*NN; // triangle4
           case RTC_SCENE_FLAG_ROBUST : return has_avx ?  70.0f*NN :  63.0f*NN; // triangle4v
           case RTC_SCENE_FLAG_COMPACT: return has_avx ?  35.0f*NN :  35.0f*NN; // triangle4i
+          case RTC_SCENE_FLAG_QUANTIZED: return has_avx ? 56.0f*NN :  63.0f*NN; // qbvh8.triangle4
           default: return inf;
           }
           
@@ -1357,6 +1730,7 @@ namespace embree
           case RTC_SCENE_FLAG_NONE: return has_avx ? 85.0f*NN : 79.0f*NN; // quad4v
           case RTC_SCENE_FLAG_ROBUST : return has_avx ? 85.0f*NN : 79.0f*NN; // quad4v
           case RTC_SCENE_FLAG_COMPACT: return has_avx ? 41.0f*NN : 41.0f*NN; // quad4i
+          case RTC_SCENE_FLAG_QUANTIZED: return has_avx ? 41.0f*NN : 79.0f*NN; // qbvh8.quad4i
           default: return inf;
           }
         case QUAD_MESH_MB: switch (sflags.sflags) {
@@ -1781,6 +2155,92 @@ namespace embree
     }
   };
 
+  struct TwoLevelRefitTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    std::string options;
+
+    TwoLevelRefitTest (std::string name, int isa, SceneFlags sflags, std::string options = "")
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), options(options) {}
+
+    void move_node(const Ref<SceneGraph::Node>& node, const Vec3fa& ds, float jitter)
+    {
+      if (Ref<SceneGraph::TriangleMeshNode> mesh = node.dynamicCast<SceneGraph::TriangleMeshNode>())
+        for (auto& p : mesh->positions[0]) p += ds + jitter*(random_Vec3fa()-Vec3fa(0.5f));
+      else if (Ref<SceneGraph::QuadMeshNode> mesh = node.dynamicCast<SceneGraph::QuadMeshNode>())
+        for (auto& p : mesh->positions[0]) p += ds + jitter*(random_Vec3fa()-Vec3fa(0.5f));
+    }
+    
+    VerifyApplication::TestReturnValue run (VerifyApplication* state, bool silent)
+    {
+      /* second device always rebuilds the two-level BVH */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice((cfg+options).c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",twolevel_refit=0").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+
+      /* small geometries and meshes with refit quality get updated in place */
+      std::vector<Ref<SceneGraph::Node>> nodes;
+      for (size_t i=0; i<16; i++)
+        nodes.push_back(SceneGraph::createTrianglePlane(Vec3fa(3.0f*float(i%4),0,3.0f*float(i/4)),Vec3fa(1,0,0),Vec3fa(0,0,1),1,1));
+      nodes.push_back(SceneGraph::createTriangleSphere(Vec3fa(4.5f,0,4.5f),2.0f,20));
+      nodes.push_back(SceneGraph::createQuadSphere(Vec3fa(4.5f,3,4.5f),1.0f,20));
+
+      VerifyScene scene0(device0,sflags);
+      VerifyScene scene1(device1,sflags);
+      for (auto& node : nodes) {
+        scene0.addGeometry(RTC_BUILD_QUALITY_REFIT,node);
+        scene1.addGeometry(RTC_BUILD_QUALITY_REFIT,node);
+      }
+
+      size_t numFailures = 0;
+      for (size_t frame=0; frame<8; frame++)
+      {
+        for (unsigned int i=0; i<nodes.size(); i++)
+        {
+          if (random_int() % 3) continue;
+          move_node(nodes[i],0.5f*random_Vec3fa()-Vec3fa(0.25f),i >= 16 ? 0.2f : 0.0f);
+          for (RTCScene scene : { (RTCScene) scene0, (RTCScene) scene1 }) {
+            RTCGeometry geom = rtcGetGeometry(scene,i);
+            rtcUpdateGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0);
+            rtcCommitGeometry(geom);
+          }
+        }
+        rtcCommitScene(scene0);
+        rtcCommitScene(scene1);
+        AssertNoError(device0);
+        AssertNoError(device1);
+
+        for (size_t i=0; i<size_t(100*state->intensity); i++)
+        {
+          const Vec3fa org = Vec3fa(12.0f,8.0f,12.0f)*random_Vec3fa()-Vec3fa(1.5f,4.0f,1.5f);
+          const Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+          RTCRayHit ray0 = makeRay(org,dir);
+          RTCRayHit ray1 = makeRay(org,dir);
+          RTCIntersectContext context;
+          rtcInitIntersectContext(&context);
+          rtcIntersect1(scene0,&context,&ray0);
+          rtcIntersect1(scene1,&context,&ray1);
+          numFailures += ray0.hit.geomID != ray1.hit.geomID || ray0.hit.primID != ray1.hit.primID || ray0.ray.tfar != ray1.ray.tfar;
+        }
+      }
+
+      /* the BVHs of the deformed spheres have to be restructured, thus differ from the only refitted ones,
+       * only low quality dynamic scenes use two-level BVHs that get refitted per geometry */
+      if (!options.empty() && sflags.qflags == RTC_BUILD_QUALITY_LOW)
+      {
+        RTCBVHQuality quality0, quality1;
+        rtcGetSceneBVHQuality(scene0,&quality0);
+        rtcGetSceneBVHQuality(scene1,&quality1);
+        numFailures += quality0.sahCost == quality1.sahCost;
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return (VerifyApplication::TestReturnValue) (numFailures == 0);
+    }
+  };
+
   struct GarbageGeometryTest : public VerifyApplication::Test
   {
     GarbageGeometryTest (std::string name, int isa)
@@ -2222,60 +2682,404 @@ namespace embree
     0, 3, 6, 9
   };
 
-  struct InterpolateHairTest : public VerifyApplication::Test
+  struct TessellationCacheTest : public VerifyApplication::Test
   {
-    size_t N;
-    
-    InterpolateHairTest (std::string name, int isa, size_t N)
-      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), N(N) {}
-    
-    bool checkHairInterpolation(RTCGeometry geom, int primID, float u, float v, int v0, RTCBufferType bufferType, unsigned int bufferSlot, float* data, size_t N, size_t N_total)
-    {
-      assert(N<256);
-      bool passed = true;
-      float P[256], dPdu[256], dPdv[256];
-      rtcInterpolate1(geom,primID,u,v,bufferType,bufferSlot,P,dPdu,dPdv,(unsigned int)N);
-      
-      for (size_t i=0; i<N; i++) {
-        const float p00 = data[(v0+0)*N_total+i];
-        const float p01 = data[(v0+1)*N_total+i];
-        const float p02 = data[(v0+2)*N_total+i];
-        const float p03 = data[(v0+3)*N_total+i];
-        const float t0 = 1.0f - u, t1 = u;
-        const float p10 = p00 * t0 + p01 * t1;
-        const float p11 = p01 * t0 + p02 * t1;
-        const float p12 = p02 * t0 + p03 * t1;
-        const float p20 = p10 * t0 + p11 * t1;
-        const float p21 = p11 * t0 + p12 * t1;
-        const float p30 = p20 * t0 + p21 * t1;
-        passed &= fabs(p30-P[i]) < 1E-4f;
-      }
-      return passed;
-    }
-    
-    bool checkHairInterpolation(RTCGeometry geom, RTCBufferType bufferType, unsigned int bufferSlot, float* vertices0, size_t N, size_t N_total)
-    {
-      bool passed = true;
-      passed &= checkHairInterpolation(geom,0,0.0f,0.0f,0,bufferType,bufferSlot,vertices0,N,N_total);
-      passed &= checkHairInterpolation(geom,1,0.5f,0.0f,3,bufferType,bufferSlot,vertices0,N,N_total);
-      passed &= checkHairInterpolation(geom,2,0.0f,0.0f,6,bufferType,bufferSlot,vertices0,N,N_total);
-      passed &= checkHairInterpolation(geom,3,0.2f,0.0f,9,bufferType,bufferSlot,vertices0,N,N_total);
-      return passed;
-    }
+    TessellationCacheTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
     
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
       std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_SUBDIVISION_GEOMETRY_SUPPORTED))
+        return VerifyApplication::SKIPPED;
 
-      size_t M = num_interpolation_hair_vertices*N+16; // padds the arrays with some valid data
-      
-      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_ROUND_BEZIER_CURVE);
+      Ref<SceneGraph::Node> mesh = SceneGraph::createSubdivSphere(zero,1.0f,8,4);
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      unsigned int geomID = scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,mesh);
+      rtcCommitScene(scene);
       AssertNoError(device);
-      rtcSetGeometryVertexAttributeCount(geom,2);
-      
-      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT, interpolation_hair_indices, 0, sizeof(unsigned int), num_interpolation_hairs);
+
+      /* the second interpolation of each patch has to hit the cache */
+      const ssize_t hits0 = rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS);
+      RTCGeometry geom = rtcGetGeometry(scene,geomID);
+      const unsigned int numPrimitives = (unsigned int) mesh->numPrimitives();
+      for (size_t i=0; i<2; i++) {
+        for (unsigned int primID=0; primID<numPrimitives; primID++) {
+          Vec3fa P;
+          rtcInterpolate1(geom,primID,0.5f,0.5f,RTC_BUFFER_TYPE_VERTEX,0,&P.x,nullptr,nullptr,3);
+        }
+      }
+      AssertNoError(device);
+
+      bool passed = true;
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_HITS) >= hits0 + ssize_t(numPrimitives);
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_MISSES) > 0;
+      passed &= rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_TESSELLATION_CACHE_BYTES) > 0;
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct InterpolateBatchTest : public VerifyApplication::Test
+  {
+    InterpolateBatchTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_SUBDIVISION_GEOMETRY_SUPPORTED))
+        return VerifyApplication::SKIPPED;
+
+      Ref<SceneGraph::Node> mesh = SceneGraph::createSubdivSphere(zero,1.0f,8,4);
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      unsigned int geomID = scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,mesh);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* unsorted locations with some invalid lanes have to give the same results as rtcInterpolateN */
+      const unsigned int N = 1000;
+      const unsigned int numPrimitives = (unsigned int) mesh->numPrimitives();
+      std::vector<int> valid(N);
+      std::vector<unsigned int> primIDs(N);
+      std::vector<float> u(N), v(N);
+      for (unsigned int i=0; i<N; i++) {
+        valid[i] = random_int() % 8 ? -1 : 0;
+        primIDs[i] = random_int() % numPrimitives;
+        u[i] = random_float();
+        v[i] = random_float();
+      }
+      std::vector<float> P0(3*N,0.0f), dPdu0(3*N,0.0f), dPdv0(3*N,0.0f);
+      std::vector<float> P1(3*N,0.0f), dPdu1(3*N,0.0f), dPdv1(3*N,0.0f);
+
+      RTCInterpolateNArguments args;
+      args.geometry = rtcGetGeometry(scene,geomID);
+      args.valid = valid.data();
+      args.primIDs = primIDs.data();
+      args.u = u.data();
+      args.v = v.data();
+      args.N = N;
+      args.bufferType = RTC_BUFFER_TYPE_VERTEX;
+      args.bufferSlot = 0;
+      args.ddPdudu = nullptr;
+      args.ddPdvdv = nullptr;
+      args.ddPdudv = nullptr;
+      args.valueCount = 3;
+
+      args.P = P0.data(); args.dPdu = dPdu0.data(); args.dPdv = dPdv0.data();
+      rtcInterpolateN(&args);
+      args.P = P1.data(); args.dPdu = dPdu1.data(); args.dPdv = dPdv1.data();
+      rtcInterpolateBatch(&args);
+      AssertNoError(device);
+
+      bool passed = true;
+      for (size_t i=0; i<3*N; i++) {
+        passed &= fabsf(P0[i]-P1[i]) < 1E-4f;
+        passed &= fabsf(dPdu0[i]-dPdu1[i]) < 1E-3f;
+        passed &= fabsf(dPdv0[i]-dPdv1[i]) < 1E-3f;
+      }
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct TessellationCameraTest : public VerifyApplication::Test
+  {
+    TessellationCameraTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+
+    static bool memoryMonitor(void* userPtr, const ssize_t bytes, const bool /*post*/)
+    {
+      *(std::atomic<ssize_t>*)userPtr += bytes;
+      return true;
+    }
+
+    /* returns the memory used by the scene, which is dominated by the grids of the tessellated patches */
+    static ssize_t sceneBytes(const RTCDeviceRef& device, std::atomic<ssize_t>& bytes, const float rate, const RTCTessellationCamera* camera)
+    {
+      const ssize_t bytes0 = bytes;
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      unsigned int geomID = scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createSubdivSphere(zero,1.0f,16,4));
+      RTCGeometry geom = rtcGetGeometry(scene,geomID);
+      rtcSetGeometryTessellationRate(geom,rate);
+      rtcSetGeometryTessellationCamera(geom,camera);
+      rtcCommitGeometry(geom);
+      rtcCommitScene(scene);
+      return bytes-bytes0;
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::atomic<ssize_t> bytes(0);
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",subdiv_lazy_build=0";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_SUBDIVISION_GEOMETRY_SUPPORTED))
+        return VerifyApplication::SKIPPED;
+      rtcSetDeviceMemoryMonitorFunction(device,memoryMonitor,&bytes);
+
+      VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+      unsigned int geomID = scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createSubdivSphere(zero,1.0f,16,4));
+      RTCGeometry geom = rtcGetGeometry(scene,geomID);
+
+      /* camera close to one side of the sphere, such that the edge levels vary strongly */
+      RTCTessellationCamera camera;
+      camera.position[0] = 1.5f; camera.position[1] = 0.0f; camera.position[2] = 0.0f;
+      camera.pixelAngle = 0.01f;
+      camera.edgeLength = 2.0f;
+      camera.minLevel = 1.0f;
+      camera.maxLevel = 32.0f;
+      rtcSetGeometryTessellationCamera(geom,&camera);
+      rtcCommitGeometry(geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* rays from the center have to hit the sphere, as differing edge levels must not cause cracks */
+      bool passed = true;
+      for (size_t i=0; i<1000; i++)
+      {
+        RTCIntersectContext context;
+        rtcInitIntersectContext(&context);
+        RTCRayHit rayhit = makeRay(zero,normalize(2.0f*random_Vec3fa()-Vec3fa(1.0f)));
+        rtcIntersect1(scene,&context,&rayhit);
+        passed &= rayhit.hit.geomID == geomID;
+      }
+
+      /* the near side gets tessellated with the maximal level and the far side with lower levels,
+         thus the grids need less memory than uniform maximal levels, and more than a distant camera */
+      RTCTessellationCamera farCamera = camera;
+      farCamera.position[0] = 100.0f;
+      const ssize_t bytesUniform = sceneBytes(device,bytes,camera.maxLevel,nullptr);
+      const ssize_t bytesNear    = sceneBytes(device,bytes,camera.maxLevel,&camera);
+      const ssize_t bytesFar     = sceneBytes(device,bytes,camera.maxLevel,&farCamera);
+      AssertNoError(device);
+      passed &= bytesNear < bytesUniform;
+      passed &= bytesFar < bytesNear;
+
+      /* disabling the camera and invalid cameras */
+      rtcSetGeometryTessellationCamera(geom,nullptr);
+      rtcCommitGeometry(geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+      camera.pixelAngle = 0.0f;
+      rtcSetGeometryTessellationCamera(geom,&camera);
+      passed &= rtcGetDeviceError(device) == RTC_ERROR_INVALID_ARGUMENT;
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct SubdivLazyBuildTest : public VerifyApplication::Test
+  {
+    SubdivLazyBuildTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS) {}
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::vector<RTCRayHit> rays;
+      for (size_t i=0; i<1000; i++) {
+        const Vec3fa org = 6.0f*random_Vec3fa()-Vec3fa(3.0f);
+        rays.push_back(makeRay(org,normalize(0.5f*random_Vec3fa()-org)));
+      }
+
+      /* lazily built grids have to give the same hits as grids built at commit, also when they get discarded by a small tessellation cache */
+      bool passed = true;
+      std::vector<RTCRayHit> reference;
+      const char* configs[3] = { ",subdiv_lazy_build=0", ",subdiv_lazy_build=1", ",subdiv_lazy_build=2,tessellation_cache_size=1" };
+      for (size_t mode=0; mode<3; mode++)
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+configs[mode];
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(nullptr,rtcGetDeviceError(device));
+        if (!rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_SUBDIVISION_GEOMETRY_SUPPORTED))
+          return VerifyApplication::SKIPPED;
+
+        VerifyScene scene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+        scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createSubdivSphere(zero,1.0f,32,16));
+        rtcCommitScene(scene);
+        AssertNoError(device);
+
+        for (size_t iter=0; iter<2; iter++)
+        {
+          for (size_t i=0; i<rays.size(); i++)
+          {
+            RTCIntersectContext context;
+            rtcInitIntersectContext(&context);
+            RTCRayHit rayhit = rays[i];
+            rtcIntersect1(scene,&context,&rayhit);
+            if (mode == 0 && iter == 0) { reference.push_back(rayhit); continue; }
+            passed &= rayhit.hit.geomID == reference[i].hit.geomID;
+            if (rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID)
+              passed &= fabs(rayhit.ray.tfar-reference[i].ray.tfar) < 1E-4f;
+          }
+        }
+        AssertNoError(device);
+      }
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct SubdivLazyBuildFilterTest : public VerifyApplication::Test
+  {
+    static const size_t numThreads = 4;
+
+    RTCScene scene;
+    RTCGeometry geom;
+    std::vector<RTCRayHit> rays;
+    std::vector<RTCRayHit> reference;
+    std::atomic<size_t> threadIDCounter;
+    std::atomic<size_t> numFailures;
+
+    SubdivLazyBuildFilterTest (std::string name, int isa)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), scene(nullptr), geom(nullptr), threadIDCounter(0), numFailures(0) {}
+
+    /* interpolates the surface at each hit while the grid of the hit patch gets traversed */
+    static void interpolateFilterN(const RTCFilterFunctionNArguments* const args)
+    {
+      SubdivLazyBuildFilterTest* This = (SubdivLazyBuildFilterTest*) args->geometryUserPtr;
+      for (unsigned int i=0; i<args->N; i++)
+      {
+        if (args->valid[i] != -1) continue;
+        const unsigned int primID = RTCHitN_primID(args->hit,args->N,i);
+        const float u = RTCHitN_u(args->hit,args->N,i);
+        const float v = RTCHitN_v(args->hit,args->N,i);
+        Vec3fa P = zero;
+        rtcInterpolate1(This->geom,primID,u,v,RTC_BUFFER_TYPE_VERTEX,0,&P.x,nullptr,nullptr,3);
+        if (!(fabs(length(P)-1.0f) < 0.1f)) This->numFailures++;
+      }
+    }
+
+    static void traceThread(SubdivLazyBuildFilterTest* This)
+    {
+      const size_t threadID = This->threadIDCounter++;
+      for (size_t iter=0; iter<2; iter++)
+      {
+        for (size_t i=threadID; i<This->rays.size(); i+=numThreads)
+        {
+          RTCIntersectContext context;
+          rtcInitIntersectContext(&context);
+          RTCRayHit rayhit = This->rays[i];
+          rtcIntersect1(This->scene,&context,&rayhit);
+          const RTCRayHit& ref = This->reference[i];
+          if (rayhit.hit.geomID != ref.hit.geomID) This->numFailures++;
+          else if (rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID && fabs(rayhit.ray.tfar-ref.ray.tfar) > 1E-4f) This->numFailures++;
+
+          RTCRay ray = This->rays[i].ray;
+          rtcOccluded1(This->scene,&context,&ray);
+          if ((ray.tfar < 0.0f) != (ref.hit.geomID != RTC_INVALID_GEOMETRY_ID)) This->numFailures++;
+        }
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      rays.clear(); reference.clear(); numFailures = 0;
+      for (size_t i=0; i<1000; i++) {
+        const Vec3fa org = 6.0f*random_Vec3fa()-Vec3fa(3.0f);
+        rays.push_back(makeRay(org,normalize(0.5f*random_Vec3fa()-org)));
+      }
+
+      /* filter functions that interpolate must not block segment switches of the tessellation cache triggered by other threads */
+      const char* configs[2] = { ",subdiv_lazy_build=0", ",subdiv_lazy_build=2,tessellation_cache_size=1" };
+      for (size_t mode=0; mode<2; mode++)
+      {
+        std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+configs[mode];
+        RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+        errorHandler(nullptr,rtcGetDeviceError(device));
+        if (!rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_SUBDIVISION_GEOMETRY_SUPPORTED) ||
+            !rtcGetDeviceProperty(device,RTC_DEVICE_PROPERTY_FILTER_FUNCTION_SUPPORTED))
+          return VerifyApplication::SKIPPED;
+
+        VerifyScene vscene(device,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM));
+        unsigned int geomID = vscene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createSubdivSphere(zero,1.0f,32,16));
+        scene = vscene;
+        geom = rtcGetGeometry(scene,geomID);
+        rtcSetGeometryUserData(geom,this);
+        rtcSetGeometryIntersectFilterFunction(geom,interpolateFilterN);
+        rtcSetGeometryOccludedFilterFunction(geom,interpolateFilterN);
+        rtcCommitScene(scene);
+        AssertNoError(device);
+
+        if (mode == 0)
+        {
+          for (size_t i=0; i<rays.size(); i++) {
+            RTCIntersectContext context;
+            rtcInitIntersectContext(&context);
+            RTCRayHit rayhit = rays[i];
+            rtcIntersect1(scene,&context,&rayhit);
+            reference.push_back(rayhit);
+          }
+          continue;
+        }
+
+        threadIDCounter = 0;
+        std::vector<thread_t> threads;
+        for (size_t i=0; i<numThreads; i++)
+          threads.push_back(createThread((thread_func)traceThread,this));
+        for (size_t i=0; i<threads.size(); i++)
+          join(threads[i]);
+        AssertNoError(device);
+      }
+      return (VerifyApplication::TestReturnValue) (numFailures == 0);
+    }
+  };
+
+  struct InterpolateHairTest : public VerifyApplication::Test
+  {
+    size_t N;
+    
+    InterpolateHairTest (std::string name, int isa, size_t N)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), N(N) {}
+    
+    bool checkHairInterpolation(RTCGeometry geom, int primID, float u, float v, int v0, RTCBufferType bufferType, unsigned int bufferSlot, float* data, size_t N, size_t N_total)
+    {
+      assert(N<256);
+      bool passed = true;
+      float P[256], dPdu[256], dPdv[256];
+      rtcInterpolate1(geom,primID,u,v,bufferType,bufferSlot,P,dPdu,dPdv,(unsigned int)N);
+      
+      for (size_t i=0; i<N; i++) {
+        const float p00 = data[(v0+0)*N_total+i];
+        const float p01 = data[(v0+1)*N_total+i];
+        const float p02 = data[(v0+2)*N_total+i];
+        const float p03 = data[(v0+3)*N_total+i];
+        const float t0 = 1.0f - u, t1 = u;
+        const float p10 = p00 * t0 + p01 * t1;
+        const float p11 = p01 * t0 + p02 * t1;
+        const float p12 = p02 * t0 + p03 * t1;
+        const float p20 = p10 * t0 + p11 * t1;
+        const float p21 = p11 * t0 + p12 * t1;
+        const float p30 = p20 * t0 + p21 * t1;
+        passed &= fabs(p30-P[i]) < 1E-4f;
+      }
+      return passed;
+    }
+    
+    bool checkHairInterpolation(RTCGeometry geom, RTCBufferType bufferType, unsigned int bufferSlot, float* vertices0, size_t N, size_t N_total)
+    {
+      bool passed = true;
+      passed &= checkHairInterpolation(geom,0,0.0f,0.0f,0,bufferType,bufferSlot,vertices0,N,N_total);
+      passed &= checkHairInterpolation(geom,1,0.5f,0.0f,3,bufferType,bufferSlot,vertices0,N,N_total);
+      passed &= checkHairInterpolation(geom,2,0.0f,0.0f,6,bufferType,bufferSlot,vertices0,N,N_total);
+      passed &= checkHairInterpolation(geom,3,0.2f,0.0f,9,bufferType,bufferSlot,vertices0,N,N_total);
+      return passed;
+    }
+    
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      size_t M = num_interpolation_hair_vertices*N+16; // padds the arrays with some valid data
+      
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_ROUND_BEZIER_CURVE);
+      AssertNoError(device);
+      rtcSetGeometryVertexAttributeCount(geom,2);
+      
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT, interpolation_hair_indices, 0, sizeof(unsigned int), num_interpolation_hairs);
       AssertNoError(device);
       
       std::vector<float> vertices0(M);
@@ -2864,6 +3668,323 @@ namespace embree
     }
   };
 
+  struct InstanceLevelsTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    static const unsigned int numRays = 256;
+
+    InstanceLevelsTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    /* returns the number of rays that hit level 0 and level 1 */
+    std::pair<size_t,size_t> countLevels(RTCScene scene, float coneSpread, bool& consistent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      context.coneSpread = coneSpread;
+
+      std::vector<RTCRayHit> rays(numRays), rays1(numRays);
+      for (size_t i=0; i<numRays; i++) {
+        const Vec3fa dir = normalize(Vec3fa(0.1f*random_float()-0.05f,0.1f*random_float()-0.05f,1.0f));
+        rays[i] = rays1[i] = makeRay(zero,dir);
+      }
+      IntersectWithMode(imode,ivariant,scene,rays.data(),numRays,&context);
+
+      /* rays have to select the same levels when traced as single rays */
+      std::pair<size_t,size_t> counts(0,0);
+      for (size_t i=0; i<numRays; i++) {
+        rtcIntersect1(scene,&context,&rays1[i]);
+        consistent &= rays[i].hit.geomID == rays1[i].hit.geomID && fabsf(rays[i].ray.tfar-rays1[i].ray.tfar) < 1E-4f;
+        if (rays[i].hit.geomID == RTC_INVALID_GEOMETRY_ID) continue;
+        if (rays[i].ray.tfar < 8.5f) counts.first++; else counts.second++;
+      }
+      return counts;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* the coarser level is a sphere of half the radius, such that the hit distance identifies the level */
+      VerifyScene level0(device,sflags), level1(device,sflags);
+      level0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,1.0f,50));
+      level1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(zero,0.5f,10));
+      rtcCommitScene(level0);
+      rtcCommitScene(level1);
+
+      /* the instance is scaled by 2, thus the footprint in object space is 5 times coneSpread at distance 10 */
+      VerifyScene scene(device,sflags);
+      RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_INSTANCE);
+      rtcSetGeometryInstancedScene(geom,level0);
+      rtcSetGeometryInstancedSceneLevel(geom,1,level1,1.0f,1.0f);
+      const AffineSpace3fa xfm = AffineSpace3fa::translate(Vec3fa(0,0,10))*AffineSpace3fa::scale(Vec3fa(2.0f));
+      rtcSetGeometryTransform(geom,0,RTC_FORMAT_FLOAT4X4_COLUMN_MAJOR,&xfm);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      bool passed = true;
+      std::pair<size_t,size_t> fine = countLevels(scene,0.0f,passed);
+      passed &= fine.first == numRays && fine.second == 0;
+      std::pair<size_t,size_t> coarse = countLevels(scene,1.0f,passed);
+      passed &= coarse.first == 0 && coarse.second == numRays;
+      std::pair<size_t,size_t> blend = countLevels(scene,0.3f,passed);
+      passed &= blend.first > 0 && blend.second > 0 && blend.first+blend.second == numRays;
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct StreamRaySortingTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+    static const size_t numRays = 1000;
+
+    StreamRaySortingTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* second device traces streams in input order */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device0 = rtcNewDevice((cfg+",stream_ray_sorting=1").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device0));
+      RTCDeviceRef device1 = rtcNewDevice((cfg+",stream_ray_sorting=0").c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device1));
+      if (!supportsIntersectMode(device0,imode))
+        return VerifyApplication::SKIPPED;
+
+      VerifyScene scene0(device0,sflags);
+      VerifyScene scene1(device1,sflags);
+      for (size_t i=0; i<4; i++) {
+        Ref<SceneGraph::Node> node = SceneGraph::createTriangleSphere(Vec3fa(4.0f*float(i),0,0),1.5f,30);
+        scene0.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+        scene1.addGeometry(RTC_BUILD_QUALITY_MEDIUM,node);
+      }
+      rtcCommitScene(scene0);
+      rtcCommitScene(scene1);
+      AssertNoError(device0);
+      AssertNoError(device1);
+
+      size_t numFailures = 0;
+      for (size_t i=0; i<size_t(10*state->intensity); i++)
+      {
+        std::vector<RTCRayHit> rays0(numRays), rays1(numRays);
+        for (size_t j=0; j<numRays; j++)
+        {
+          const Vec3fa org = Vec3fa(16.0f,4.0f,4.0f)*random_Vec3fa()-Vec3fa(2.0f);
+          const Vec3fa dir = 2.0f*random_Vec3fa()-Vec3fa(1.0f);
+          rays0[j] = rays1[j] = makeRay(org,dir);
+          if (j%7 == 0) rays0[j].ray.tnear = rays1[j].ray.tnear = pos_inf; // some inactive rays
+        }
+        IntersectWithMode(imode,ivariant,scene0,rays0.data(),numRays);
+        IntersectWithMode(imode,ivariant,scene1,rays1.data(),numRays);
+        for (size_t j=0; j<numRays; j++)
+          numFailures += neq_ray_special(rays0[j],rays1[j]);
+      }
+      AssertNoError(device0);
+      AssertNoError(device1);
+      return (VerifyApplication::TestReturnValue) (numFailures == 0);
+    }
+  };
+
+  struct OccludedGroupTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    static const unsigned int M = 32;
+
+    OccludedGroupTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,sflags);
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(-1,0,4),1.0f,30));
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createQuadSphere    (Vec3fa(+1,0,4),1.0f,30));
+      /* curves get traversed per ray packet instead of using the stream traversal */
+      scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createHairyPlane(1,Vec3fa(-1.5f,0.0f,2.0f),Vec3fa(3,0,0),Vec3fa(0,0,1),0.6f,0.02f,200,SceneGraph::FLAT_CURVE));
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      size_t numFailures = 0;
+      for (size_t i=0; i<size_t(10*state->intensity); i++)
+      {
+        /* group of rays with common origin, some are occluded by the spheres */
+        RTCRay rays[M];
+        const Vec3fa org = Vec3fa(0.5f,0.5f,0.0f)*random_Vec3fa();
+        for (unsigned int j=0; j<M; j++) {
+          const Vec3fa dir = Vec3fa(4.0f,2.0f,0.0f)*random_Vec3fa()-Vec3fa(2.0f,1.0f,-4.0f);
+          rays[j] = makeRay(org,dir).ray;
+          if (j%11 == 5) rays[j].tnear = pos_inf; // some inactive rays
+        }
+
+        /* reference mask using single rays */
+        unsigned int expected = 0;
+        for (unsigned int j=0; j<M; j++) {
+          RTCRay ray = rays[j];
+          RTCIntersectContext context;
+          rtcInitIntersectContext(&context);
+          if (ray.tnear <= ray.tfar) rtcOccluded1(scene,&context,&ray);
+          if (ray.tfar < 0.0f) expected |= 1u << j;
+        }
+
+        /* without early termination the masks have to match, otherwise
+           at least maxOccluded of the occluded rays have to be reported */
+        for (unsigned int maxOccluded : { 0u, 1u, 4u })
+        {
+          RTCRay group[M];
+          for (unsigned int j=0; j<M; j++) group[j] = rays[j];
+          RTCIntersectContext context;
+          rtcInitIntersectContext(&context);
+          const unsigned int mask = rtcOccludedGroup(scene,&context,group,M,maxOccluded);
+          numFailures += context.flags != RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT; // user context stays unmodified
+          if (maxOccluded == 0) numFailures += mask != expected;
+          else numFailures += (mask & ~expected) || popcnt(size_t(mask)) < min(size_t(maxOccluded),popcnt(size_t(expected)));
+          for (unsigned int j=0; j<M; j++)
+            numFailures += ((mask >> j) & 1) != (group[j].tfar < 0.0f);
+        }
+      }
+      AssertNoError(device);
+      return (VerifyApplication::TestReturnValue) (numFailures == 0);
+    }
+  };
+
+  struct TraversalStatisticsTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    TraversalStatisticsTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",traversal_stats_sampling=2";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,sflags);
+      unsigned int geomID0 = scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createTriangleSphere(Vec3fa(-1,0,4),1.0f,30));
+      unsigned int geomID1 = scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,SceneGraph::createQuadSphere    (Vec3fa(+1,0,4),1.0f,30));
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      /* every second ray query of this thread gets sampled */
+      const size_t numRays = 1000;
+      for (size_t i=0; i<2*numRays; i++)
+      {
+        RTCIntersectContext context;
+        rtcInitIntersectContext(&context);
+        RTCRayHit rayhit = makeRay(zero,Vec3fa(4.0f,2.0f,0.0f)*random_Vec3fa()-Vec3fa(2.0f,1.0f,-4.0f));
+        rtcIntersect1(scene,&context,&rayhit);
+      }
+      for (size_t i=0; i<2*numRays; i++)
+      {
+        RTCIntersectContext context;
+        rtcInitIntersectContext(&context);
+        RTCRay ray = makeRay(zero,Vec3fa(4.0f,2.0f,0.0f)*random_Vec3fa()-Vec3fa(2.0f,1.0f,-4.0f)).ray;
+        rtcOccluded1(scene,&context,&ray);
+      }
+      AssertNoError(device);
+
+      RTCTraversalStatistics stats[2], geom0, geom1;
+      rtcGetSceneTraversalStatistics(scene,RTC_RAY_QUERY_TYPE_INTERSECT,&stats[0]);
+      rtcGetSceneTraversalStatistics(scene,RTC_RAY_QUERY_TYPE_OCCLUDED,&stats[1]);
+      rtcGetGeometryTraversalStatistics(scene,geomID0,&geom0);
+      rtcGetGeometryTraversalStatistics(scene,geomID1,&geom1);
+      AssertNoError(device);
+
+      bool passed = true;
+      for (auto& s : stats) {
+        passed &= s.numRays == numRays;
+        passed &= s.numNodes > 0 && s.numLeaves > 0 && s.numPrimitiveTests >= s.numLeaves;
+      }
+      passed &= geom0.numRays > 0 && geom1.numRays > 0 && geom0.numRays + geom1.numRays <= numRays;
+      passed &= geom0.numNodes + geom1.numNodes <= stats[0].numNodes;
+
+      /* the JSON export has to report the same statistics */
+      const size_t length = rtcExportSceneTraversalStatistics(scene,nullptr,0);
+      std::vector<char> json(length+1);
+      passed &= rtcExportSceneTraversalStatistics(scene,json.data(),json.size()) == length;
+      passed &= std::string(json.data()).find("\"rays\": " + std::to_string(numRays)) != std::string::npos;
+
+      rtcResetSceneTraversalStatistics(scene);
+      rtcGetSceneTraversalStatistics(scene,RTC_RAY_QUERY_TYPE_INTERSECT,&stats[0]);
+      rtcGetGeometryTraversalStatistics(scene,geomID0,&geom0);
+      passed &= stats[0].numRays == 0 && geom0.numRays == 0;
+      AssertNoError(device);
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
+  struct BVHQualityTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+
+    BVHQualityTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      Ref<SceneGraph::Node> mesh0 = SceneGraph::createTriangleSphere(Vec3fa(-1,0,4),1.0f,30);
+      Ref<SceneGraph::Node> mesh1 = SceneGraph::createQuadSphere    (Vec3fa(+1,0,4),1.0f,30);
+      VerifyScene scene(device,sflags);
+      unsigned int geomID0 = scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,mesh0);
+      unsigned int geomID1 = scene.addGeometry(RTC_BUILD_QUALITY_MEDIUM,mesh1);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+
+      RTCBVHQuality quality, geom0, geom1;
+      rtcGetSceneBVHQuality(scene,&quality);
+      rtcGetGeometryBVHQuality(scene,geomID0,&geom0);
+      rtcGetGeometryBVHQuality(scene,geomID1,&geom1);
+      AssertNoError(device);
+
+      /* spatial splits of high quality builds may reference primitives from multiple leaves */
+      auto countMatches = [&] (size_t numLeafPrimitives, size_t numPrimitives) {
+        return sflags.qflags == RTC_BUILD_QUALITY_HIGH ? numLeafPrimitives >= numPrimitives : numLeafPrimitives == numPrimitives;
+      };
+
+      bool passed = true;
+      passed &= countMatches(quality.numPrimitives,mesh0->numPrimitives() + mesh1->numPrimitives());
+      passed &= quality.numLeaves > 0 && quality.numPrimitiveBlocks >= quality.numLeaves;
+      passed &= quality.sahCost > 0.0f && std::abs(quality.sahCost - quality.nodeSAHCost - quality.leafSAHCost) <= 1E-3f*quality.sahCost;
+      passed &= quality.leafFillRatio > 0.0f && quality.leafFillRatio <= 1.0f;
+
+      /* the per level statistics have to add up to the totals */
+      size_t numNodes = 0, numLeaves = 0;
+      for (size_t i=0; i<RTC_BVH_QUALITY_MAX_LEVELS; i++) {
+        numNodes += quality.levels[i].numNodes;
+        numLeaves += quality.levels[i].numLeaves;
+      }
+      passed &= numNodes == quality.numNodes && numLeaves == quality.numLeaves;
+
+      /* the leaf costs get distributed to the geometries */
+      passed &= countMatches(geom0.numPrimitives,mesh0->numPrimitives()) && countMatches(geom1.numPrimitives,mesh1->numPrimitives());
+      passed &= geom0.numNodes == 0 && geom0.leafSAHCost > 0.0f && geom1.leafSAHCost > 0.0f;
+      passed &= std::abs(geom0.leafSAHCost + geom1.leafSAHCost - quality.leafSAHCost) <= 1E-3f*quality.leafSAHCost;
+
+      rtcGetGeometryBVHQuality(scene,geomID1+1,&geom1);
+      passed &= rtcGetDeviceError(device) == RTC_ERROR_INVALID_ARGUMENT;
+
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct WatertightTest : public VerifyApplication::IntersectTest
   {
     ALIGNED_STRUCT_(16);
@@ -3477,7 +4598,7 @@ namespace embree
         rtcInitPointQueryContext(&context);
         uint32_t numCalls = 0;
         rtcPointQuery(scene, &query, &context, queryFunc, (void*)&numCalls);
-        if (numCalls != 0)
+        if (numCalls != 10)
         {
           return VerifyApplication::FAILED;
         }
@@ -3486,99 +4607,416 @@ namespace embree
 
       return VerifyApplication::PASSED;
     }
-  };
-  
-  struct PointQueryTest : public VerifyApplication::Test
-  {
-    SceneFlags sflags; 
-    std::string tri_accel;
+  };
+  
+  struct PointQueryTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags; 
+    std::string tri_accel;
+
+    PointQueryTest (std::string name, int isa, SceneFlags sflags, std::string tri_accel = "")
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), tri_accel(tri_accel) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + ((tri_accel != "") ? ",tri_accel="+tri_accel : "");
+      //printf("run test %s\n", cfg.c_str());
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+     
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+      
+      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryBuildQuality(geom,sflags.qflags);
+
+      Vec3f* vertices = (Vec3f*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), 3*32);
+      Triangle* triangles = (Triangle*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT3, sizeof(Triangle), 32);
+      for (int i = 0; i < 32; ++i) {
+        float xi = random_float();
+        vertices[3*i+0] = Vec3f(0.0f,          0.0f,          (float)i);
+        vertices[3*i+1] = Vec3f(1.0f + 5.f*xi, 0.0f,          (float)i);
+        vertices[3*i+2] = Vec3f(0.0f,          1.0f + 5.f*xi, (float)i);
+        triangles[i] = Triangle(3*i+0, 3*i+1, 3*i+2);
+      };
+
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      struct UserData
+      {
+        Vec3f* vertices;
+        Triangle* triangles;
+        Vec3f result;
+        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
+      };
+
+      for (int i = 0; i < 64; ++i)
+      {
+        RTCPointQuery query;
+        query.x = 0.25f;
+        query.y = 0.75f;
+        query.z = -0.25f + i * 0.5f;
+        query.time = 0.f;
+        query.radius = inf;
+
+        UserData data;
+        data.vertices  = vertices;
+        data.triangles = triangles;
+
+        RTCPointQueryContext context;
+        rtcInitPointQueryContext(&context);
+        rtcPointQuery(scene, &query, &context, [](RTCPointQueryFunctionArguments* args) -> bool
+        {
+          UserData* data = (UserData*)args->userPtr;
+          // get triangle info
+          Triangle const& t = data->triangles[args->primID];
+          Vec3f const& v0 = data->vertices[t.v0];
+          Vec3f const& v1 = data->vertices[t.v1];
+          Vec3f const& v2 = data->vertices[t.v2];
+          
+          // determine closest point on triangle
+          const Vec3f q(args->query->x, args->query->y, args->query->z);
+          const Vec3f p = closestPointTriangle(q, v0, v1, v2);
+          const float d = distance(q, p);
+
+          if (d < args->query->radius) {
+            args->query->radius = d;
+            data->result = p;
+            data->primID = args->primID;
+            return true;
+          }
+          return false; 
+        }, &data);
+
+        if ((int)data.primID != i/2) return VerifyApplication::FAILED;
+        if (abs(data.result.x- 0.25f) > 1e-4f)        return VerifyApplication::FAILED;
+        if (abs(data.result.y- 0.75f) > 1e-4f)        return VerifyApplication::FAILED;
+        if (abs(data.result.z- (float)(i/2)) > 1e-4f) return VerifyApplication::FAILED;
+        AssertNoError(device);
+      }
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct PointQueryKNNTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags; 
+
+    PointQueryKNNTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      RTCSceneRef scene = rtcNewScene(device);
+      rtcSetSceneFlags(scene,sflags.sflags);
+      rtcSetSceneBuildQuality(scene,sflags.qflags);
+
+      /* random sphere points and triangles */
+      const unsigned int numPoints = 256, numTriangles = 64;
+      RTCGeometry points = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_SPHERE_POINT);
+      rtcSetGeometryBuildQuality(points,sflags.qflags);
+      Vec3ff* centers = (Vec3ff*)rtcSetNewGeometryBuffer(points, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT4, sizeof(Vec3ff), numPoints);
+      for (unsigned int i=0; i<numPoints; i++)
+        centers[i] = Vec3ff(random_float(),random_float(),random_float(),0.01f*random_float());
+      rtcCommitGeometry(points);
+      const unsigned int pointsID = rtcAttachGeometry(scene,points);
+      rtcReleaseGeometry(points);
+
+      RTCGeometry mesh = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryBuildQuality(mesh,sflags.qflags);
+      Vec3f* vertices = (Vec3f*)rtcSetNewGeometryBuffer(mesh, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), 3*numTriangles);
+      Triangle* triangles = (Triangle*)rtcSetNewGeometryBuffer(mesh, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), numTriangles);
+      for (unsigned int i=0; i<numTriangles; i++) {
+        const Vec3f p(random_float(),random_float(),random_float());
+        for (unsigned int j=0; j<3; j++)
+          vertices[3*i+j] = p + 0.1f*Vec3f(random_float(),random_float(),random_float());
+        triangles[i] = Triangle(3*i+0, 3*i+1, 3*i+2);
+      }
+      rtcCommitGeometry(mesh);
+      rtcAttachGeometry(scene,mesh);
+      rtcReleaseGeometry(mesh);
+      rtcCommitScene (scene);
+      AssertNoError(device);
+
+      const unsigned int k = 8;
+      const float radius = 0.2f;
+      for (size_t i=0; i<16; i++)
+      {
+        RTCPointQuery query;
+        query.x = random_float(); query.y = random_float(); query.z = random_float();
+        query.time = 0.0f;
+        query.radius = inf;
+
+        /* brute force reference distances */
+        std::vector<float> reference;
+        const Vec3fa q(query.x,query.y,query.z);
+        for (unsigned int j=0; j<numPoints; j++)
+          reference.push_back(max(distance(q,Vec3fa(centers[j].x,centers[j].y,centers[j].z))-centers[j].w,0.0f));
+        for (unsigned int j=0; j<numTriangles; j++)
+          reference.push_back(distance(q,closestPointTriangle(q,vertices[3*j+0],vertices[3*j+1],vertices[3*j+2])));
+        std::sort(reference.begin(),reference.end());
+
+        RTCPointQueryNeighbor neighbors[k];
+        if (rtcPointQueryKNN(scene,&query,k,neighbors) != k) return VerifyApplication::FAILED;
+        for (unsigned int j=0; j<k; j++) {
+          if (abs(neighbors[j].distance-reference[j]) > 1E-5f) return VerifyApplication::FAILED;
+          const bool isPoint = neighbors[j].geomID == pointsID;
+          if (isPoint && neighbors[j].primID >= numPoints) return VerifyApplication::FAILED;
+          if (!isPoint && neighbors[j].primID >= numTriangles) return VerifyApplication::FAILED;
+        }
+
+        /* the query itself stays unmodified */
+        if (query.radius != float(inf)) return VerifyApplication::FAILED;
+
+        query.radius = radius;
+        const unsigned int expected = (unsigned int) (std::upper_bound(reference.begin(),reference.end(),radius)-reference.begin());
+        if (rtcPointQueryRadius(scene,&query,0,nullptr) != expected) return VerifyApplication::FAILED;
+        if (rtcPointQueryRadius(scene,&query,k,neighbors) != expected) return VerifyApplication::FAILED;
+        for (unsigned int j=0; j<min(k,expected); j++)
+          if (abs(neighbors[j].distance-reference[j]) > 1E-5f) return VerifyApplication::FAILED;
+
+        /* packet queries match single queries */
+        RTCPointQuery4 query4;
+        __aligned(16) int valid4[4] = { -1, 0, -1, -1 };
+        for (size_t l=0; l<4; l++) {
+          query4.x[l] = query.x + 0.1f*l; query4.y[l] = query.y; query4.z[l] = query.z;
+          query4.time[l] = 0.0f; query4.radius[l] = inf;
+        }
+        RTCPointQueryNeighbor neighbors4[4*k];
+        unsigned int numNeighbors4[4] = { 0, 0, 0, 0 };
+        rtcPointQueryKNN4(valid4,scene,&query4,k,neighbors4,numNeighbors4);
+        if (numNeighbors4[1] != 0) return VerifyApplication::FAILED;
+        for (size_t l=2; l<4; l++)
+        {
+          RTCPointQuery query1;
+          query1.x = query4.x[l]; query1.y = query4.y[l]; query1.z = query4.z[l];
+          query1.time = 0.0f; query1.radius = inf;
+          if (rtcPointQueryKNN(scene,&query1,k,neighbors) != numNeighbors4[l]) return VerifyApplication::FAILED;
+          for (unsigned int j=0; j<k; j++)
+            if (neighbors[j].distance != neighbors4[l*k+j].distance) return VerifyApplication::FAILED;
+        }
+        AssertNoError(device);
+      }
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CollideTrianglesTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    CollideTrianglesTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    struct Collisions
+    {
+      MutexSys mutex;
+      std::vector<RTCCollision> collisions;
+    };
+
+    static void collideFunc (void* userPtr, RTCCollision* collisions, unsigned int num_collisions)
+    {
+      Collisions* c = (Collisions*) userPtr;
+      Lock<MutexSys> lock(c->mutex);
+      c->collisions.insert(c->collisions.end(),collisions,collisions+num_collisions);
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      /* pairs of crossing triangles followed by a strip of adjacent triangles */
+      const unsigned int numCrosses = 64, numStrip = 64;
+      const unsigned int numTriangles = 2*numCrosses+numStrip;
+      std::vector<Vec3f> vertices;
+      std::vector<Triangle> triangles;
+      for (unsigned int i=0; i<numCrosses; i++) {
+        const Vec3f c(3.0f*i,0.0f,0.0f);
+        const unsigned int v = (unsigned int) vertices.size();
+        vertices.push_back(c+Vec3f(-1,0,-1)); vertices.push_back(c+Vec3f(1,0,-1)); vertices.push_back(c+Vec3f(0,0,1));
+        vertices.push_back(c+Vec3f(0,-1,0));  vertices.push_back(c+Vec3f(0,1,0));  vertices.push_back(c+Vec3f(0,0,1));
+        triangles.push_back(Triangle(v+0,v+1,v+2));
+        triangles.push_back(Triangle(v+3,v+4,v+5));
+      }
+      const unsigned int v = (unsigned int) vertices.size();
+      for (unsigned int i=0; i<numStrip/2+1; i++) {
+        vertices.push_back(Vec3f(float(i),10.0f,0.0f));
+        vertices.push_back(Vec3f(float(i),11.0f,0.0f));
+      }
+      for (unsigned int i=0; i<numStrip/2; i++) {
+        triangles.push_back(Triangle(v+2*i+0,v+2*i+2,v+2*i+1));
+        triangles.push_back(Triangle(v+2*i+1,v+2*i+2,v+2*i+3));
+      }
+
+      RTCSceneRef scene0 = rtcNewScene(device);
+      rtcSetSceneFlags(scene0,sflags);
+      RTCGeometry mesh0 = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      Vec3f* vertices0 = (Vec3f*)rtcSetNewGeometryBuffer(mesh0, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), vertices.size());
+      Triangle* triangles0 = (Triangle*)rtcSetNewGeometryBuffer(mesh0, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), triangles.size());
+      std::copy(vertices.begin(),vertices.end(),vertices0);
+      std::copy(triangles.begin(),triangles.end(),triangles0);
+      rtcCommitGeometry(mesh0);
+      const unsigned int geomID0 = rtcAttachGeometry(scene0,mesh0);
+      rtcReleaseGeometry(mesh0);
+      rtcCommitScene (scene0);
+
+      /* large triangle that cuts through all crossing triangles */
+      RTCSceneRef scene1 = rtcNewScene(device);
+      rtcSetSceneFlags(scene1,sflags);
+      RTCGeometry mesh1 = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      Vec3f* vertices1 = (Vec3f*)rtcSetNewGeometryBuffer(mesh1, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), 3);
+      Triangle* triangles1 = (Triangle*)rtcSetNewGeometryBuffer(mesh1, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), 1);
+      vertices1[0] = Vec3f(-10,-10,0.5f); vertices1[1] = Vec3f(1000,-10,0.5f); vertices1[2] = Vec3f(-10,1000,0.5f);
+      triangles1[0] = Triangle(0,1,2);
+      rtcCommitGeometry(mesh1);
+      rtcAttachGeometry(scene1,mesh1);
+      rtcReleaseGeometry(mesh1);
+      rtcCommitScene (scene1);
+      AssertNoError(device);
+
+      /* self collision reports each crossing pair exactly once */
+      Collisions self;
+      rtcCollide(scene0,scene0,collideFunc,&self);
+      AssertNoError(device);
+      if (self.collisions.size() != numCrosses) return VerifyApplication::FAILED;
+      for (auto& c : self.collisions) {
+        if (c.geomID0 != geomID0 || c.geomID1 != geomID0) return VerifyApplication::FAILED;
+        if (c.primID0 % 2 != 0 || c.primID1 != c.primID0+1 || c.primID1 >= 2*numCrosses) return VerifyApplication::FAILED;
+      }
+
+      Collisions other;
+      rtcCollide(scene0,scene1,collideFunc,&other);
+      AssertNoError(device);
+      if (other.collisions.size() != 2*numCrosses) return VerifyApplication::FAILED;
+      for (auto& c : other.collisions)
+        if (c.primID0 >= 2*numCrosses || c.primID1 != 0) return VerifyApplication::FAILED;
+
+      /* broad phase reports all non adjacent pairs with overlapping bounds */
+      size_t expected = 0;
+      for (unsigned int i=0; i<numTriangles; i++) {
+        for (unsigned int j=i+1; j<numTriangles; j++) {
+          const Triangle& ti = triangles[i], &tj = triangles[j];
+          if (ti.v0 == tj.v0 || ti.v0 == tj.v1 || ti.v0 == tj.v2 ||
+              ti.v1 == tj.v0 || ti.v1 == tj.v1 || ti.v1 == tj.v2 ||
+              ti.v2 == tj.v0 || ti.v2 == tj.v1 || ti.v2 == tj.v2) continue;
+          BBox3fa bi = empty; bi.extend(vertices[ti.v0]); bi.extend(vertices[ti.v1]); bi.extend(vertices[ti.v2]);
+          BBox3fa bj = empty; bj.extend(vertices[tj.v0]); bj.extend(vertices[tj.v1]); bj.extend(vertices[tj.v2]);
+          if (!disjoint(bi,bj)) expected++;
+        }
+      }
+      std::vector<RTCCollision> collisions(expected);
+      if (rtcCollideBroadPhase(scene0,scene0,collisions.data(),collisions.size()) != expected) return VerifyApplication::FAILED;
+      for (auto& c : collisions)
+        if (c.primID0 >= c.primID1 || c.primID1 >= numTriangles) return VerifyApplication::FAILED;
+      if (rtcCollideBroadPhase(scene0,scene0,collisions.data(),1) != expected) return VerifyApplication::FAILED;
+      AssertNoError(device);
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct CollideContinuousTest : public VerifyApplication::Test
+  {
+    RTCSceneFlags sflags;
+
+    CollideContinuousTest (std::string name, int isa, RTCSceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    struct Collisions
+    {
+      MutexSys mutex;
+      std::vector<RTCContinuousCollision> collisions;
+    };
+
+    static void collideFunc (void* userPtr, RTCContinuousCollision* collisions, unsigned int num_collisions)
+    {
+      Collisions* c = (Collisions*) userPtr;
+      Lock<MutexSys> lock(c->mutex);
+      c->collisions.insert(c->collisions.end(),collisions,collisions+num_collisions);
+    }
 
-    PointQueryTest (std::string name, int isa, SceneFlags sflags, std::string tri_accel = "")
-      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), tri_accel(tri_accel) {}
+    static unsigned int addTriangle(RTCDevice device, RTCScene scene, const std::vector<Vec3f>& vertices)
+    {
+      const unsigned int numTimeSteps = (unsigned int) vertices.size()/3;
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
+      rtcSetGeometryTimeStepCount(geom,numTimeSteps);
+      for (unsigned int t=0; t<numTimeSteps; t++) {
+        Vec3f* v = (Vec3f*) rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, t, RTC_FORMAT_FLOAT3, sizeof(Vec3f), 3);
+        v[0] = vertices[3*t+0]; v[1] = vertices[3*t+1]; v[2] = vertices[3*t+2];
+      }
+      Triangle* triangles = (Triangle*) rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX, 0, RTC_FORMAT_UINT3, sizeof(Triangle), 1);
+      triangles[0] = Triangle(0,1,2);
+      rtcCommitGeometry(geom);
+      const unsigned int geomID = rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      return geomID;
+    }
 
     VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
     {
-      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + ((tri_accel != "") ? ",tri_accel="+tri_accel : "");
-      //printf("run test %s\n", cfg.c_str());
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
       RTCDeviceRef device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
-     
-      RTCSceneRef scene = rtcNewScene(device);
-      rtcSetSceneFlags(scene,sflags.sflags);
-      rtcSetSceneBuildQuality(scene,sflags.qflags);
-      
-      RTCGeometry geom = rtcNewGeometry (device, RTC_GEOMETRY_TYPE_TRIANGLE);
-      rtcSetGeometryBuildQuality(geom,sflags.qflags);
-
-      Vec3f* vertices = (Vec3f*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT3, sizeof(Vec3f), 3*32);
-      Triangle* triangles = (Triangle*)rtcSetNewGeometryBuffer(geom, RTC_BUFFER_TYPE_INDEX , 0, RTC_FORMAT_UINT3, sizeof(Triangle), 32);
-      for (int i = 0; i < 32; ++i) {
-        float xi = random_float();
-        vertices[3*i+0] = Vec3f(0.0f,          0.0f,          (float)i);
-        vertices[3*i+1] = Vec3f(1.0f + 5.f*xi, 0.0f,          (float)i);
-        vertices[3*i+2] = Vec3f(0.0f,          1.0f + 5.f*xi, (float)i);
-        triangles[i] = Triangle(3*i+0, 3*i+1, 3*i+2);
-      };
 
-      rtcCommitGeometry(geom);
-      rtcAttachGeometry(scene,geom);
-      rtcReleaseGeometry(geom);
-      rtcCommitScene (scene);
+      /* static triangle in the z=0 plane */
+      RTCSceneRef scene0 = rtcNewScene(device);
+      rtcSetSceneFlags(scene0,sflags);
+      const unsigned int geomID0 = addTriangle(device,scene0,{ Vec3f(-1,-1,0), Vec3f(1,-1,0), Vec3f(0,1,0) });
+      rtcCommitScene(scene0);
+
+      /* triangle that passes through the static one in between its
+       * time steps, its lowest vertex hits the plane at time 0.25 */
+      RTCSceneRef scene1 = rtcNewScene(device);
+      rtcSetSceneFlags(scene1,sflags);
+      const unsigned int geomID1 = addTriangle(device,scene1,{ Vec3f(0,0,0.5f), Vec3f(0.2f,0,1), Vec3f(0,0.2f,1),
+                                                               Vec3f(0,0,-1.5f), Vec3f(0.2f,0,-1), Vec3f(0,0.2f,-1) });
+      /* triangle that moves far away from the static one */
+      addTriangle(device,scene1,{ Vec3f(5,0,0.5f), Vec3f(5.2f,0,1), Vec3f(5,0.2f,1),
+                                  Vec3f(9,0,-1.5f), Vec3f(9.2f,0,-1), Vec3f(9,0.2f,-1) });
+      rtcCommitScene(scene1);
       AssertNoError(device);
 
-      struct UserData
-      {
-        Vec3f* vertices;
-        Triangle* triangles;
-        Vec3f result;
-        unsigned int primID = RTC_INVALID_GEOMETRY_ID;
+      auto collide = [&] (RTCScene s0, RTCScene s1, float time0, float time1) {
+        Collisions c;
+        rtcCollideContinuous(s0,s1,time0,time1,collideFunc,&c);
+        return c.collisions;
       };
 
-      for (int i = 0; i < 64; ++i)
-      {
-        RTCPointQuery query;
-        query.x = 0.25f;
-        query.y = 0.75f;
-        query.z = -0.25f + i * 0.5f;
-        query.time = 0.f;
-        query.radius = inf;
-
-        UserData data;
-        data.vertices  = vertices;
-        data.triangles = triangles;
-
-        RTCPointQueryContext context;
-        rtcInitPointQueryContext(&context);
-        rtcPointQuery(scene, &query, &context, [](RTCPointQueryFunctionArguments* args) -> bool
-        {
-          UserData* data = (UserData*)args->userPtr;
-          // get triangle info
-          Triangle const& t = data->triangles[args->primID];
-          Vec3f const& v0 = data->vertices[t.v0];
-          Vec3f const& v1 = data->vertices[t.v1];
-          Vec3f const& v2 = data->vertices[t.v2];
-          
-          // determine closest point on triangle
-          const Vec3f q(args->query->x, args->query->y, args->query->z);
-          const Vec3f p = closestPointTriangle(q, v0, v1, v2);
-          const float d = distance(q, p);
-
-          if (d < args->query->radius) {
-            args->query->radius = d;
-            data->result = p;
-            data->primID = args->primID;
-            return true;
-          }
-          return false; 
-        }, &data);
-
-        if ((int)data.primID != i/2) return VerifyApplication::FAILED;
-        if (abs(data.result.x- 0.25f) > 1e-4f)        return VerifyApplication::FAILED;
-        if (abs(data.result.y- 0.75f) > 1e-4f)        return VerifyApplication::FAILED;
-        if (abs(data.result.z- (float)(i/2)) > 1e-4f) return VerifyApplication::FAILED;
-        AssertNoError(device);
-      }
-
+      std::vector<RTCContinuousCollision> c = collide(scene0,scene1,0.0f,1.0f);
+      AssertNoError(device);
+      if (c.size() != 1) return VerifyApplication::FAILED;
+      if (c[0].geomID0 != geomID0 || c[0].primID0 != 0 || c[0].geomID1 != geomID1 || c[0].primID1 != 0) return VerifyApplication::FAILED;
+      if (abs(c[0].time-0.25f) > 1E-4f) return VerifyApplication::FAILED;
+      
+      /* no impact before 0.25 and already intersecting at the start of the interval */
+      if (collide(scene0,scene1,0.0f,0.2f).size() != 0) return VerifyApplication::FAILED;
+      c = collide(scene0,scene1,0.3f,1.0f);
+      if (c.size() != 1 || c[0].time != 0.3f) return VerifyApplication::FAILED;
+
+      /* scene with static and motion blurred meshes collided with itself */
+      RTCSceneRef scene2 = rtcNewScene(device);
+      rtcSetSceneFlags(scene2,sflags);
+      const unsigned int geomIDs = addTriangle(device,scene2,{ Vec3f(-1,-1,0), Vec3f(1,-1,0), Vec3f(0,1,0) });
+      const unsigned int geomIDm = addTriangle(device,scene2,{ Vec3f(0,0,0.5f), Vec3f(0.2f,0,1), Vec3f(0,0.2f,1),
+                                                               Vec3f(0,0,0.5f), Vec3f(0.2f,0,1), Vec3f(0,0.2f,1),
+                                                               Vec3f(0,0,-1.5f), Vec3f(0.2f,0,-1), Vec3f(0,0.2f,-1) });
+      rtcCommitScene(scene2);
+      c = collide(scene2,scene2,0.0f,1.0f);
+      AssertNoError(device);
+      if (c.size() != 1) return VerifyApplication::FAILED;
+      if (std::min(c[0].geomID0,c[0].geomID1) != std::min(geomIDs,geomIDm) || std::max(c[0].geomID0,c[0].geomID1) != std::max(geomIDs,geomIDm)) return VerifyApplication::FAILED;
+      if (abs(c[0].time-0.625f) > 1E-4f) return VerifyApplication::FAILED;
       return VerifyApplication::PASSED;
     }
   };
@@ -4521,6 +5959,75 @@ namespace embree
     return true;
   }
 
+  struct NumaTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    std::atomic<ssize_t> bytes[3];
+
+    NumaTest (std::string name, int isa, SceneFlags sflags)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    static bool memoryMonitor(void* userPtr, const ssize_t bytes, const bool /*post*/)
+    {
+      *(std::atomic<ssize_t>*)userPtr += bytes;
+      return true;
+    }
+
+    /* packet and single ray kernels may round the hit distance differently */
+    static bool sameHit(const RTCRayHit& ray0, const RTCRayHit& ray1)
+    {
+      if (ray0.hit.geomID != ray1.hit.geomID || ray0.hit.primID != ray1.hit.primID) return false;
+      return ray0.hit.geomID == RTC_INVALID_GEOMETRY_ID || fabs(ray0.ray.tfar-ray1.ray.tfar) < 1E-4f;
+    }
+
+    /* builds the same scene on each device and returns the used memory */
+    ssize_t createScene(const std::string& cfg, Ref<VerifyScene>& scene, std::atomic<ssize_t>& bytes)
+    {
+      bytes = 0;
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      rtcSetDeviceMemoryMonitorFunction(device,memoryMonitor,&bytes);
+
+      RandomSampler sampler;
+      RandomSampler_init(sampler,0);
+      scene = new VerifyScene(device,sflags);
+      for (size_t i=0; i<10; i++) {
+        const Vec3fa pos = 10.0f*RandomSampler_get3D(sampler);
+        scene->addGeometry(sflags.qflags,SceneGraph::createTriangleSphere(pos,1.0f,20));
+        scene->addGeometry(sflags.qflags,SceneGraph::createQuadSphere(pos+Vec3fa(0,0,2),1.0f,20));
+      }
+      rtcCommitScene(*scene);
+      AssertNoError(device);
+      return bytes;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* forcing 2 NUMA nodes enables the NUMA code paths on all systems */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      Ref<VerifyScene> scene0, scene1, scene2;
+      const ssize_t bytes0 = createScene(cfg+",threads=1",scene0,bytes[0]);
+      const ssize_t bytes1 = createScene(cfg+",threads=1,numa_replication_levels=2,numa_nodes=2",scene1,bytes[1]);
+      createScene(cfg+",numa_alloc=1,numa_replication_levels=2,numa_nodes=2",scene2,bytes[2]);
+      bool passed = bytes1 > bytes0; // replicated top levels need additional memory
+
+      RandomSampler sampler;
+      RandomSampler_init(sampler,1);
+      for (size_t i=0; i<1000; i++)
+      {
+        const Vec3fa org = Vec3fa(-5.0f,-5.0f,-5.0f) + 20.0f*RandomSampler_get3D(sampler);
+        const Vec3fa dir = Vec3fa(5.0f,5.0f,5.0f) + 2.0f*RandomSampler_get3D(sampler) - org;
+        RTCRayHit ray0 = makeRay(org,dir), ray1 = ray0, ray2 = ray0;
+        IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,*scene0,&ray0,1);
+        IntersectWithMode(MODE_INTERSECT1,VARIANT_INTERSECT,*scene1,&ray1,1);
+        IntersectWithMode(MODE_INTERSECT4,VARIANT_INTERSECT,*scene2,&ray2,1);
+        passed &= sameHit(ray0,ray1);
+        passed &= sameHit(ray0,ray2);
+      }
+      return (VerifyApplication::TestReturnValue) passed;
+    }
+  };
+
   struct MemoryMonitorTest : public VerifyApplication::Test
   {
     thread_func func;
@@ -4832,13 +6339,14 @@ namespace embree
     IntersectMode imode;
     IntersectVariant ivariant;
     size_t numPhi;
+    std::string options;
     RTCDeviceRef device;
     Ref<VerifyScene> scene;
     static const size_t numRays = 16*1024*1024;
     static const size_t deltaRays = 1024;
     
-    IncoherentRaysBenchmark (std::string name, int isa, GeometryType gtype, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant, size_t numPhi)
-      : ParallelIntersectBenchmark(name,isa,numRays,deltaRays), gtype(gtype), sflags(sflags), quality(quality), imode(imode), ivariant(ivariant), numPhi(numPhi), device(nullptr)  {}
+    IncoherentRaysBenchmark (std::string name, int isa, GeometryType gtype, SceneFlags sflags, RTCBuildQuality quality, IntersectMode imode, IntersectVariant ivariant, size_t numPhi, std::string options = "")
+      : ParallelIntersectBenchmark(name,isa,numRays,deltaRays), gtype(gtype), sflags(sflags), quality(quality), imode(imode), ivariant(ivariant), numPhi(numPhi), options(options), device(nullptr)  {}
 
     size_t setNumPrimitives(size_t N) 
     { 
@@ -4851,7 +6359,7 @@ namespace embree
       if (!ParallelIntersectBenchmark::setup(state))
         return false;
 
-      std::string cfg = state->rtcore + ",start_threads=1,set_affinity=1,isa="+stringOfISA(isa);
+      std::string cfg = state->rtcore + ",start_threads=1,set_affinity=1,isa="+stringOfISA(isa)+options;
       device = rtcNewDevice(cfg.c_str());
       errorHandler(nullptr,rtcGetDeviceError(device));
       rtcSetDeviceErrorFunction(device,errorHandler,nullptr);
@@ -4975,6 +6483,103 @@ namespace embree
 
   static std::atomic<ssize_t> create_geometry_bytes_used(0);
 
+  struct PointQueryKNNBenchmark : public VerifyApplication::Benchmark
+  {
+    bool native;  // true = use rtcPointQueryKNN, false = use a heap in a point query callback
+    unsigned int numPoints;
+    unsigned int numQueries;
+    unsigned int k;
+    RTCDeviceRef device;
+    RTCSceneRef scene;
+    std::vector<Vec3ff> points;
+
+    PointQueryKNNBenchmark (std::string name, int isa, bool native, unsigned int numPoints, unsigned int numQueries, unsigned int k)
+      : VerifyApplication::Benchmark(name,isa,"Mqps",true,10), native(native), numPoints(numPoints), numQueries(numQueries), k(k), device(nullptr), scene(nullptr) {}
+
+    struct CallbackData
+    {
+      const Vec3ff* points;
+      unsigned int k;
+      std::priority_queue<std::pair<float,unsigned int>> heap;
+    };
+
+    static bool knnCallback(RTCPointQueryFunctionArguments* args)
+    {
+      CallbackData* data = (CallbackData*) args->userPtr;
+      const Vec3ff& c = data->points[args->primID];
+      const Vec3fa q(args->query->x,args->query->y,args->query->z);
+      const float d = max(distance(q,Vec3fa(c.x,c.y,c.z))-c.w,0.0f);
+      if (d > args->query->radius) return false;
+      data->heap.push(std::make_pair(d,args->primID));
+      if (data->heap.size() > data->k) data->heap.pop();
+      if (data->heap.size() < data->k) return false;
+      args->query->radius = data->heap.top().first;
+      return true;
+    }
+
+    bool setup(VerifyApplication* state) 
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa) + ",threads=" + std::to_string((long long)numThreads);
+      device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      scene = rtcNewScene(device);
+
+      RandomSampler sampler;
+      RandomSampler_init(sampler,0);
+      points.resize(numPoints);
+      for (auto& p : points)
+        p = Vec3ff(RandomSampler_get3D(sampler),0.001f);
+
+      RTCGeometry geom = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_SPHERE_POINT);
+      rtcSetSharedGeometryBuffer(geom, RTC_BUFFER_TYPE_VERTEX, 0, RTC_FORMAT_FLOAT4, points.data(), 0, sizeof(Vec3ff), numPoints);
+      rtcCommitGeometry(geom);
+      rtcAttachGeometry(scene,geom);
+      rtcReleaseGeometry(geom);
+      rtcCommitScene(scene);
+      AssertNoError(device);
+      return true;
+    }
+
+    float benchmark(VerifyApplication* state)
+    {
+      double t0 = getSeconds();
+      parallel_for(size_t(0),size_t(numQueries),size_t(1024),[&](const range<size_t>& r)
+      {
+        RandomSampler sampler;
+        std::vector<RTCPointQueryNeighbor> neighbors(k);
+        CallbackData data;
+        data.points = points.data();
+        data.k = k;
+        for (size_t i=r.begin(); i<r.end(); i++)
+        {
+          RandomSampler_init(sampler,(int)i);
+          const Vec3fa p = RandomSampler_get3D(sampler);
+          RTCPointQuery query;
+          query.x = p.x; query.y = p.y; query.z = p.z;
+          query.time = 0.0f;
+          query.radius = inf;
+          if (native) {
+            rtcPointQueryKNN(scene,&query,k,neighbors.data());
+          } else {
+            RTCPointQueryContext context;
+            rtcInitPointQueryContext(&context);
+            data.heap = std::priority_queue<std::pair<float,unsigned int>>();
+            rtcPointQuery(scene,&query,&context,knnCallback,&data);
+          }
+        }
+      });
+      double t1 = getSeconds();
+      return 1E-6f * float(numQueries)/float(t1-t0);
+    }
+
+    virtual void cleanup(VerifyApplication* state) 
+    {
+      scene = nullptr;
+      device = nullptr;
+      points.clear();
+    }
+  };
+
   struct CreateGeometryBenchmark : public VerifyApplication::Benchmark
   {
     GeometryType gtype;
@@ -5120,6 +6725,62 @@ namespace embree
     }
   };
 
+  struct BVHQualityBenchmark : public VerifyApplication::Benchmark
+  {
+    GeometryType gtype;
+    RTCBuildQuality quality;
+    size_t numPhi;
+    size_t numMeshes;
+    RTCDeviceRef device;
+    std::vector<Ref<SceneGraph::Node>> geometries;
+    
+    BVHQualityBenchmark (std::string name, int isa, GeometryType gtype, RTCBuildQuality quality, size_t numPhi, size_t numMeshes)
+      : VerifyApplication::Benchmark(name,isa,"SAH",false,1), gtype(gtype), quality(quality), numPhi(numPhi), numMeshes(numMeshes), device(nullptr) {}
+
+    bool setup(VerifyApplication* state) 
+    {
+      std::string cfg = "start_threads=1,set_affinity=1,isa="+stringOfISA(isa) + ",threads=" + std::to_string((long long)numThreads)+","+state->rtcore;
+      device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      rtcSetDeviceErrorFunction(device,errorHandler,nullptr);
+
+      /* randomly placed spheres of different sizes, such that the object BVHs overlap */
+      RandomSampler sampler;
+      RandomSampler_init(sampler,int(numMeshes));
+      for (unsigned int i=0; i<numMeshes; i++)
+      {
+        const Vec3fa pos = 10.0f*RandomSampler_get3D(sampler);
+        const float r = 0.1f+RandomSampler_get1D(sampler);
+        switch (gtype) {
+        case TRIANGLE_MESH: geometries.push_back(SceneGraph::createTriangleSphere(pos,r,numPhi)); break;
+        case QUAD_MESH:     geometries.push_back(SceneGraph::createQuadSphere(pos,r,numPhi)); break;
+        default:            throw std::runtime_error("invalid geometry for benchmark");
+        }
+      }
+      return true;
+    }
+
+    float benchmark(VerifyApplication* state)
+    {
+      Ref<VerifyScene> scene = new VerifyScene(device,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW));
+      for (unsigned int i=0; i<numMeshes; i++)
+        scene->addGeometry(quality,geometries[i]);
+      rtcCommitScene (*scene);
+      AssertNoError(device);
+
+      RTCBVHQuality bvh_quality;
+      rtcGetSceneBVHQuality(*scene,&bvh_quality);
+      AssertNoError(device);
+      return bvh_quality.sahCost;
+    }
+      
+    virtual void cleanup(VerifyApplication* state) 
+    {
+      device = nullptr;
+      geometries.clear();
+    }
+  };
+
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////
@@ -5191,11 +6852,13 @@ namespace embree
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_COMPACT,       RTC_BUILD_QUALITY_MEDIUM));
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_ROBUST | RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_MEDIUM));
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_NONE,       RTC_BUILD_QUALITY_HIGH));
+    sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_QUANTIZED,     RTC_BUILD_QUALITY_MEDIUM));
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,       RTC_BUILD_QUALITY_LOW));
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,       RTC_BUILD_QUALITY_MEDIUM));
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_ROBUST,        RTC_BUILD_QUALITY_LOW));
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_COMPACT,       RTC_BUILD_QUALITY_LOW));
     sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_ROBUST | RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_LOW));
+    sceneFlags.push_back(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_QUANTIZED,     RTC_BUILD_QUALITY_LOW));
 
     sceneFlagsRobust.push_back(SceneFlags(RTC_SCENE_FLAG_ROBUST,        RTC_BUILD_QUALITY_MEDIUM));
     sceneFlagsRobust.push_back(SceneFlags(RTC_SCENE_FLAG_ROBUST | RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_MEDIUM));
@@ -5245,6 +6908,11 @@ namespace embree
       for (auto gtype : gtypes_all)
         groups.top()->add(new GetLinearBoundsTest(to_string(gtype),isa,gtype));
       groups.pop();
+
+      groups.top()->add(new OBJStreamingTest("obj_streaming",isa));
+      groups.top()->add(new BinarySceneRoundTripTest("binary_scene_round_trip",isa));
+      groups.top()->add(new NumaTest("numa_static",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM)));
+      groups.top()->add(new NumaTest("numa_dynamic",isa,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW)));
       
       groups.top()->add(new GetUserDataTest("get_user_data",isa));
 
@@ -5276,6 +6944,22 @@ namespace embree
       for (auto sflags : sceneFlags) 
         groups.top()->add(new BuildTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
       groups.pop();
+
+      push(new TestGroup("async_commit",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new AsyncCommitTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("double_buffered",true,true));
+      for (auto sflags : sceneFlags) 
+        groups.top()->add(new DoubleBufferedCommitTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+      
+      push(new TestGroup("save_load_bvh",true,true));
+      for (auto sflags : sceneFlags) 
+        if (!(sflags.sflags & RTC_SCENE_FLAG_DYNAMIC))
+          groups.top()->add(new SaveLoadBVHTest(to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
       
       push(new TestGroup("overlapping_primitives",true,false));
       for (auto sflags : sceneFlags)
@@ -5304,10 +6988,15 @@ namespace embree
             if (has_variant(imode,ivariant)) {
               groups.top()->add(new UpdateTest("deformable."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_REFIT,imode,ivariant));
               groups.top()->add(new UpdateTest("dynamic."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_LOW,imode,ivariant));
+              groups.top()->add(new UpdateTest("ploc."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_PLOC,imode,ivariant));
             }
           }
         }
       }
+      for (auto sflags : sceneFlagsDynamic) {
+        groups.top()->add(new TwoLevelRefitTest("twolevel_refit."+to_string(sflags),isa,sflags));
+        groups.top()->add(new TwoLevelRefitTest("refit_restructure."+to_string(sflags),isa,sflags,",refit_optimization_budget=10"));
+      }
       groups.pop();
 
 #if !defined(TASKING_PPL) // FIXME: PPL has some issues here!
@@ -5320,6 +7009,7 @@ namespace embree
       sflags_quality_memory.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_MEDIUM), RTC_BUILD_QUALITY_MEDIUM));
       sflags_quality_memory.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_ROBUST ,RTC_BUILD_QUALITY_MEDIUM), RTC_BUILD_QUALITY_MEDIUM));
       sflags_quality_memory.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW)   , RTC_BUILD_QUALITY_LOW));
+      sflags_quality_memory.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_QUANTIZED,RTC_BUILD_QUALITY_MEDIUM), RTC_BUILD_QUALITY_MEDIUM));
 
       if (intensity > 1.0f)
       {
@@ -5353,6 +7043,9 @@ namespace embree
       for (auto s : interpolateTests)
         groups.top()->add(new InterpolateSubdivTest(std::to_string((long long)(s)),isa,s));
       groups.pop();
+
+      groups.top()->add(new TessellationCacheTest("tessellation_cache",isa));
+      groups.top()->add(new InterpolateBatchTest("interpolate_batch",isa));
         
       push(new TestGroup("hair",true,true));
       for (auto s : interpolateTests) 
@@ -5435,6 +7128,13 @@ namespace embree
                 groups.top()->add(new InstancingTest("instancing."+to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,true,imode,ivariant));
       groups.pop();
       
+      push(new TestGroup("instance_levels",true,true));
+      for (auto sflags : sceneFlags)
+        for (auto imode : intersectModes)
+          if (has_variant(imode,VARIANT_INTERSECT_OCCLUDED_INCOHERENT))
+            groups.top()->add(new InstanceLevelsTest(to_string(sflags,imode,VARIANT_INTERSECT_OCCLUDED_INCOHERENT),isa,sflags,imode,VARIANT_INTERSECT_OCCLUDED_INCOHERENT));
+      groups.pop();
+
       push(new TestGroup("inactive_rays",true,true));
       for (auto sflags : sceneFlags) 
         for (auto imode : intersectModes) 
@@ -5443,6 +7143,31 @@ namespace embree
                 if (imode != MODE_INTERSECT1) // INTERSECT1 does not support disabled rays
                   groups.top()->add(new InactiveRaysTest(to_string(sflags,imode,ivariant),isa,sflags,RTC_BUILD_QUALITY_MEDIUM,imode,ivariant));
       groups.pop();
+
+      push(new TestGroup("stream_ray_sorting",true,true));
+      for (auto sflags : sceneFlags)
+        for (auto imode : { MODE_INTERSECT1M, MODE_INTERSECT1Mp })
+          groups.top()->add(new StreamRaySortingTest(to_string(sflags,imode,VARIANT_INTERSECT_INCOHERENT),isa,sflags,imode,VARIANT_INTERSECT_INCOHERENT));
+      groups.pop();
+      
+      push(new TestGroup("occluded_group",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new OccludedGroupTest(to_string(sflags),isa,sflags));
+      groups.pop();
+      
+      push(new TestGroup("traversal_statistics",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new TraversalStatisticsTest(to_string(sflags),isa,sflags));
+      groups.pop();
+      
+      groups.top()->add(new TessellationCameraTest("tessellation_camera",isa));
+      groups.top()->add(new SubdivLazyBuildTest("subdiv_lazy_build",isa));
+      groups.top()->add(new SubdivLazyBuildFilterTest("subdiv_lazy_build_filter",isa));
+
+      push(new TestGroup("bvh_quality",true,true));
+      for (auto sflags : sceneFlags)
+        groups.top()->add(new BVHQualityTest(to_string(sflags),isa,sflags));
+      groups.pop();
       
       push(new TestGroup("watertight_triangles",true,true)); {
         std::string watertightModels [] = {"sphere.triangles", "plane.triangles"};
@@ -5555,9 +7280,20 @@ namespace embree
       /*                      Point Query Tests                                */
       /**************************************************************************/
 
+      push(new TestGroup("collide",true,true));
+      groups.top()->add(new CollideTrianglesTest("collide_triangles",isa,RTC_SCENE_FLAG_NONE));
+      groups.top()->add(new CollideTrianglesTest("collide_triangles_robust",isa,RTC_SCENE_FLAG_ROBUST));
+      groups.top()->add(new CollideTrianglesTest("collide_triangles_compact",isa,RTC_SCENE_FLAG_COMPACT));
+      groups.top()->add(new CollideTrianglesTest("collide_triangles_dynamic",isa,RTC_SCENE_FLAG_DYNAMIC));
+      groups.top()->add(new CollideContinuousTest("collide_continuous",isa,RTC_SCENE_FLAG_NONE));
+      groups.top()->add(new CollideContinuousTest("collide_continuous_robust",isa,RTC_SCENE_FLAG_ROBUST));
+      groups.top()->add(new CollideContinuousTest("collide_continuous_compact",isa,RTC_SCENE_FLAG_COMPACT));
+      groups.pop();
+
       push(new TestGroup("point_query",true,true));
       for (auto sflags : sceneFlags) {
         groups.top()->add(new PointQueryAPICallsTest("point_query_api_calls",isa,sflags));
+        groups.top()->add(new PointQueryKNNTest("point_query_knn."+to_string(sflags),isa,sflags));
         if (stringOfISA(isa) == "SSE4.1" || stringOfISA(isa) == "SSE4.2") {
           groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,"bvh4.triangle4v"));
           groups.top()->add(new PointQueryTest(to_string(sflags),isa,sflags,"bvh4.triangle4i"));
@@ -5613,6 +7349,9 @@ namespace embree
       benchmark_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_COMPACT,       RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
       benchmark_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_ROBUST | RTC_SCENE_FLAG_COMPACT,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
       benchmark_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,       RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_LOW));
+      benchmark_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_QUANTIZED,     RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
+      benchmark_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,       RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_MEDIUM));
+      benchmark_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_QUANTIZED,RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_MEDIUM));
 
       std::vector<std::pair<IntersectMode,IntersectVariant>> benchmark_imodes_ivariants;
       benchmark_imodes_ivariants.push_back(std::make_pair(MODE_INTERSECT1,VARIANT_INTERSECT));
@@ -5656,9 +7395,19 @@ namespace embree
             groups.top()->add(new IncoherentRaysBenchmark("incoherent."+to_string(gtype)+"_1000k."+to_string(sflags.first,imode.first,imode.second),
                                                           isa,gtype,sflags.first,sflags.second,imode.first,imode.second,501));
 
+      for (auto sflags : benchmark_sflags_quality)
+        groups.top()->add(new IncoherentRaysBenchmark("incoherent_sorted."+to_string(TRIANGLE_MESH)+"_1000k."+to_string(sflags.first,MODE_INTERSECT1M,VARIANT_INTERSECT_INCOHERENT),
+                                                      isa,TRIANGLE_MESH,sflags.first,sflags.second,MODE_INTERSECT1M,VARIANT_INTERSECT_INCOHERENT,501,",stream_ray_sorting=1"));
+
+      groups.top()->add(new PointQueryKNNBenchmark("point_query_knn_native.points_1000k",isa,true,1000000,100000,16));
+      groups.top()->add(new PointQueryKNNBenchmark("point_query_knn_callback.points_1000k",isa,false,1000000,100000,16));
+
       std::vector<std::pair<SceneFlags,RTCBuildQuality>> benchmark_create_sflags_quality;
       benchmark_create_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
       benchmark_create_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_LOW));
+      benchmark_create_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_QUANTIZED,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
+      benchmark_create_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_MEDIUM));
+      benchmark_create_sflags_quality.push_back(std::make_pair(SceneFlags(RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_QUANTIZED,RTC_BUILD_QUALITY_LOW),RTC_BUILD_QUALITY_MEDIUM));
 
       GeometryType benchmark_create_gtypes[] = { 
         TRIANGLE_MESH, 
@@ -5703,6 +7452,23 @@ namespace embree
             groups.top()->add(new CreateGeometryBenchmark("update."+to_string(gtype)+"_"+std::get<0>(num_prims)+"."+to_string(sflags.first,sflags.second),
                                                           isa,gtype,sflags.first,sflags.second,std::get<1>(num_prims),std::get<2>(num_prims),true,true));
 
+      /* compares the PLOC builder against the binned SAH and morton builders */
+      GeometryType benchmark_builder_gtypes[] = { TRIANGLE_MESH, QUAD_MESH };
+      RTCBuildQuality benchmark_builder_quality[] = { RTC_BUILD_QUALITY_LOW, RTC_BUILD_QUALITY_MEDIUM, RTC_BUILD_QUALITY_PLOC };
+
+      for (auto gtype : benchmark_builder_gtypes)
+        for (auto quality : benchmark_builder_quality)
+          for (auto num_prims : num_primitives)
+            groups.top()->add(new CreateGeometryBenchmark("builder."+to_string(gtype)+"_"+std::get<0>(num_prims)+"."+to_string(quality),
+                                                          isa,gtype,SceneFlags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW),quality,std::get<1>(num_prims),std::get<2>(num_prims),false,true));
+
+      for (auto gtype : benchmark_builder_gtypes)
+        for (auto quality : benchmark_builder_quality)
+        {
+          groups.top()->add(new BVHQualityBenchmark("sah."+to_string(gtype)+"_100k."+to_string(quality),isa,gtype,quality,159,1));
+          groups.top()->add(new BVHQualityBenchmark("sah."+to_string(gtype)+"_10k_100."+to_string(quality),isa,gtype,quality,51,100));
+        }
+
       groups.pop(); // benchmarks
 
       /**************************************************************************/
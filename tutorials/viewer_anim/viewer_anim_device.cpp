@@ -18,6 +18,7 @@ extern "C" ISPCScene* g_ispc_scene;
 
 /* scene data */
 RTCScene g_scene   = nullptr;
+RTCCommit g_commit = nullptr;
 Vec3fa* ls_positions = nullptr;
 
 /* animation data */
@@ -105,7 +106,7 @@ RTCScene createScene(ISPCScene* scene_in)
 {
   RTCScene scene = rtcNewScene(g_device);
   rtcSetSceneBuildQuality(scene,RTC_BUILD_QUALITY_LOW);
-  rtcSetSceneFlags(scene, RTC_SCENE_FLAG_DYNAMIC);
+  rtcSetSceneFlags(scene, RTC_SCENE_FLAG_DYNAMIC | RTC_SCENE_FLAG_DOUBLE_BUFFERED);
   return scene;
 }
 
@@ -438,6 +439,13 @@ extern "C" void device_render (int* pixels,
   const double fracpart = atime - (double)intpart;
   const unsigned int keyFrameID = intpart;
 
+  /* wait for the previous frame's rebuild, the double buffered scene
+     keeps rendering the last committed version meanwhile */
+  if (g_commit) {
+    rtcWaitCommit(g_commit);
+    rtcReleaseCommit(g_commit); g_commit = nullptr;
+  }
+
   unsigned int numObjects = getNumObjects(g_ispc_scene);
   for (unsigned int i=0;i<numObjects;i++)
     updateVertexData(i, g_ispc_scene, g_scene, keyFrameID, (float)fracpart);
@@ -446,7 +454,7 @@ extern "C" void device_render (int* pixels,
   /* rebuild bvh */
   /* =========== */
 
-  rtcCommitScene(g_scene);
+  g_commit = rtcCommitSceneAsync(g_scene,0);
 
 #endif
 }
@@ -454,6 +462,10 @@ extern "C" void device_render (int* pixels,
 /* called by the C++ code for cleanup */
 extern "C" void device_cleanup ()
 {
+  if (g_commit) {
+    rtcWaitCommit(g_commit);
+    rtcReleaseCommit(g_commit); g_commit = nullptr;
+  }
   rtcReleaseScene (g_scene); g_scene = nullptr;
 }
 